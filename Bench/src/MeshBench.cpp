@@ -0,0 +1,93 @@
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "Flock.hpp"
+#include "Graphics/MeshOptimizer.hpp"
+
+using namespace Flock;
+using namespace Flock::Graphics;
+
+namespace {
+    struct ModelStats {
+        usize            triangles = 0;
+        usize            vertices  = 0;
+        usize            indexSize = 0;
+        VertexCacheStats cache     = {};
+    };
+
+    // Triangle weighted over all meshes of the model, ATVR is weighted by vertex count.
+    ModelStats Analyze(const std::vector<MeshData> &meshes) {
+        ModelStats stats;
+        f32        misses = 0.0F;
+
+        for (const auto &mesh: meshes) {
+            const usize            triangles = mesh.indices.size() / 3;
+            const VertexCacheStats cache     = AnalyzeVertexCache(mesh.indices, mesh.vertices.size());
+
+            misses          += cache.acmr * static_cast<f32>(triangles);
+            stats.triangles += triangles;
+            stats.vertices  += mesh.vertices.size();
+            stats.indexSize += mesh.indices.size() * (mesh.vertices.size() <= 0x10000 ? sizeof(u16) : sizeof(u32));
+        }
+
+        if (stats.triangles > 0 && stats.vertices > 0) {
+            stats.cache.acmr = misses / static_cast<f32>(stats.triangles);
+            stats.cache.atvr = misses / static_cast<f32>(stats.vertices);
+        }
+
+        return stats;
+    }
+}
+
+i32 main(const i32 argc, char **argv) {
+    const std::string assets = argc > 1 ? argv[1] : FLK_BENCH_ASSETS;
+
+    const std::vector<std::string> models = {
+        "box.glb",
+        "sphere.glb",
+        "Duck.gltf",
+        "FlightHelmet.gltf",
+        "dragon4.ply",
+        "dragon3.ply",
+    };
+
+    std::printf("%-20s %10s %10s %10s %8s %8s %8s %8s %10s %10s\n",
+                "Model", "Triangles", "Verts", "Verts'", "ACMR", "ACMR'", "ATVR", "ATVR'", "IdxKiB", "IdxKiB'");
+
+    for (const auto &model: models) {
+        std::vector<MeshData> meshes;
+        for (auto &[data, materialIndex]: FileIo::ReadModelMeshes(assets + "/" + model, false)) {
+            meshes.push_back(std::move(data));
+        }
+
+        if (meshes.empty()) {
+            std::printf("%-20s failed to load\n", model.c_str());
+            continue;
+        }
+
+        // The unoptimized import always used 32-bit indices.
+        ModelStats before = Analyze(meshes);
+        before.indexSize  = before.triangles * 3 * sizeof(u32);
+
+        for (auto &mesh: meshes) {
+            OptimizeMesh(mesh);
+        }
+
+        const ModelStats after = Analyze(meshes);
+
+        std::printf("%-20s %10zu %10zu %10zu %8.3f %8.3f %8.3f %8.3f %10.1f %10.1f\n",
+                    model.c_str(),
+                    before.triangles,
+                    before.vertices,
+                    after.vertices,
+                    before.cache.acmr,
+                    after.cache.acmr,
+                    before.cache.atvr,
+                    after.cache.atvr,
+                    static_cast<f64>(before.indexSize) / 1024.0,
+                    static_cast<f64>(after.indexSize) / 1024.0);
+    }
+
+    return 0;
+}
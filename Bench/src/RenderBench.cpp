@@ -0,0 +1,280 @@
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <functional>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "Flock.hpp"
+#include "FileIo/Image.hpp"
+
+using namespace Flock;
+using namespace Flock::Ecs;
+using namespace Flock::Graphics;
+using namespace Flock::Asset;
+
+namespace {
+    constexpr Vector2u s_Size         = {512, 384};
+    constexpr u32      s_WarmUp       = 10;   // Frames left out of the timings, they load and compile.
+    constexpr u8       s_Tolerance    = 8;    // Per channel, rasterizers may differ slightly in rounding.
+    constexpr f64      s_MaxDiffering = 0.25; // Percent of pixels allowed past the tolerance.
+
+    struct Options {
+        std::string           assets = FLK_BENCH_ASSETS;
+        std::filesystem::path golden = FLK_BENCH_GOLDEN;
+        u32                   frames = 300;
+        bool                  update = false; // Overwrites the golden images instead of comparing.
+    };
+
+    struct Scene {
+        std::string                                       name;
+        std::function<void(World &, const std::string &)> setup;
+    };
+
+    struct Samples {
+        std::vector<f64> frame;      // Wall time between frames.
+        std::vector<f64> submission; // CPU time spent in Renderer::Render.
+        std::vector<f64> gpu;        // Sum of the timed GPU passes.
+    };
+
+    void Boxes(World &world, const std::string &assets) {
+        const auto &loader = world.Resource<Assets>();
+        loader.SetPipeline("PBR", assets + "/shader.glsl");
+
+        const AssetHandle<Model> box = loader.Load<Model>(assets + "/box.glb");
+        loader.Get<Model>(assets + "/box.glb")->objects[0].material = {
+            .colorMap = loader.Load<Texture>(assets + "/Checkerboard.png")
+        };
+
+        for (f32 i = -12.0F; i <= 12.0F; i += 4.0F) {
+            for (f32 j = -12.0F; j <= 12.0F; j += 4.0F) {
+                for (f32 k = -12.0F; k <= 12.0F; k += 4.0F) {
+                    world.Registry().Create(
+                        Transform{.position = {i, j, k}},
+                        ModelRenderer{.model = box, .isStatic = true}
+                    );
+                }
+            }
+        }
+
+        world.Registry().Create(DirectionalLight{.position = {-4.0F, 5.0F, -3.0F}, .intensity = 5.0F});
+
+        world.Resource<Camera>().projection         = Projection::Perspective;
+        world.Resource<Camera>().transform.position = {0.0F, -8.0F, -32.0F};
+        world.Resource<AmbientLight>().color        = {20, 20, 20};
+        world.Resource<Skybox>().filePath           = assets + "/sky.png";
+    }
+
+    void Helmet(World &world, const std::string &assets) {
+        const auto &loader = world.Resource<Assets>();
+        loader.SetPipeline("PBR", assets + "/shader.glsl");
+
+        world.Registry().Create(
+            Transform{.scale = {4.0F, 4.0F, 4.0F}},
+            ModelRenderer{.model = loader.Load<Model>(assets + "/FlightHelmet.gltf"), .isStatic = true}
+        );
+
+        world.Registry().Create(DirectionalLight{.position = {2.0F, 3.0F, -4.0F}, .intensity = 3.0F});
+        world.Registry().Create(PointLight{.position = {-1.5F, 1.0F, -1.5F}, .color = {255, 180, 120}, .intensity = 4.0F});
+
+        world.Resource<Camera>().projection         = Projection::Perspective;
+        world.Resource<Camera>().transform.position = {0.0F, 1.3F, -3.0F};
+    }
+
+    void Dragons(World &world, const std::string &assets) {
+        const auto &loader = world.Resource<Assets>();
+        loader.SetPipeline("PBR", assets + "/shader.glsl");
+
+        const AssetHandle<Model> dragon = loader.Load<Model>(assets + "/dragon3.ply");
+        for (f32 x = -6.0F; x <= 6.0F; x += 3.0F) {
+            world.Registry().Create(
+                Transform{.position = {x, 0.0F, 0.0F}, .scale = {10.0F, 10.0F, 10.0F}},
+                ModelRenderer{.model = dragon, .isStatic = true}
+            );
+        }
+
+        world.Registry().Create(DirectionalLight{.position = {-3.0F, 4.0F, -2.0F}, .intensity = 4.0F});
+
+        world.Resource<Camera>().projection         = Projection::Perspective;
+        world.Resource<Camera>().transform.position = {0.0F, 1.0F, -10.0F};
+    }
+
+    // Nearest rank, of sorted samples.
+    f64 Percentile(const std::vector<f64> &samples, const f64 percent) {
+        if (samples.empty()) {
+            return 0.0;
+        }
+
+        const usize rank = static_cast<usize>(percent / 100.0 * static_cast<f64>(samples.size() - 1) + 0.5);
+        return samples[std::min(rank, samples.size() - 1)];
+    }
+
+    void Report(const std::string &name, Samples &samples) {
+        const auto row = [&](const char *label, std::vector<f64> &values) {
+            std::ranges::sort(values);
+            std::printf("%-10s %-12s %10.3f %10.3f %10.3f %10.3f\n",
+                        name.c_str(),
+                        label,
+                        Percentile(values, 50.0),
+                        Percentile(values, 95.0),
+                        Percentile(values, 99.0),
+                        values.empty() ? 0.0 : values.back());
+        };
+
+        row("frame", samples.frame);
+        row("submission", samples.submission);
+        row("gpu", samples.gpu);
+    }
+
+    // Compares against the golden image of a scene, or records it with --update.
+    bool Compare(const std::string &name, const Image &image, const Options &options) {
+        const std::filesystem::path golden = options.golden / (name + ".png");
+
+        std::error_code error;
+        if (options.update) {
+            std::filesystem::create_directories(options.golden, error);
+            if (!FileIo::WriteImage(golden, image)) {
+                return false;
+            }
+
+            std::printf("%-10s recorded %s\n", name.c_str(), golden.string().c_str());
+            return true;
+        }
+
+        // A missing reference fails, or a lost golden image would silently pass.
+        if (!std::filesystem::exists(golden, error)) {
+            std::printf("%-10s no golden image at %s, record it with --update\n", name.c_str(), golden.string().c_str());
+            FileIo::WriteImage(name + ".actual.png", image);
+            return false;
+        }
+
+        const Image reference = FileIo::ReadImage(golden);
+        if (reference.size != image.size || reference.format != image.format) {
+            std::printf("%-10s golden image size or format differs\n", name.c_str());
+            return false;
+        }
+
+        const std::vector<u8> expected = reference.data.Vector<u8>();
+        const std::vector<u8> actual   = image.data.Vector<u8>();
+        const usize           channels = ChannelCount(image.format);
+
+        usize differing = 0;
+        u8    maxDiff   = 0;
+        for (usize i = 0; i + channels <= actual.size() && i + channels <= expected.size(); i += channels) {
+            u8 pixelDiff = 0;
+            for (usize c = 0; c < channels; c++) {
+                const u8 diff = actual[i + c] > expected[i + c] ? actual[i + c] - expected[i + c] : expected[i + c] - actual[i + c];
+                pixelDiff     = std::max(pixelDiff, diff);
+            }
+
+            maxDiff = std::max(maxDiff, pixelDiff);
+            if (pixelDiff > s_Tolerance) {
+                differing++;
+            }
+        }
+
+        const f64  percent = 100.0 * static_cast<f64>(differing) / static_cast<f64>(image.size.x * image.size.y);
+        const bool passed  = percent <= s_MaxDiffering;
+
+        std::printf("%-10s %s, %.3f%% of pixels differ, max difference %u\n",
+                    name.c_str(),
+                    passed ? "matches" : "MISMATCH",
+                    percent,
+                    maxDiff);
+
+        // Written to the working directory for inspection, the golden image is left alone.
+        if (!passed) {
+            FileIo::WriteImage(name + ".actual.png", image);
+        }
+
+        return passed;
+    }
+
+    Options ParseOptions(const i32 argc, char **argv) {
+        Options options;
+
+        for (i32 i = 1; i < argc; i++) {
+            const std::string_view arg  = argv[i];
+            const bool             next = i + 1 < argc;
+
+            if (arg == "--update") {
+                options.update = true;
+            } else if (arg == "--frames" && next) {
+                options.frames = static_cast<u32>(std::max(std::atoi(argv[++i]), 1));
+            } else if (arg == "--assets" && next) {
+                options.assets = argv[++i];
+            } else if (arg == "--golden" && next) {
+                options.golden = argv[++i];
+            } else {
+                std::printf("usage: FlockRenderBench [--frames N] [--assets DIR] [--golden DIR] [--update]\n");
+                std::exit(2);
+            }
+        }
+
+        return options;
+    }
+}
+
+i32 main(const i32 argc, char **argv) {
+    const Options options = ParseOptions(argc, argv);
+
+    // Timing starts after the warm-up, the canned scenes don't move so every frame renders the same image.
+    std::optional<App> app = App::Create({
+        .windowConfig = {.title = "FlockRenderBench", .size = s_Size, .headless = true},
+        .frameLimit   = options.frames + s_WarmUp,
+    });
+
+    if (!app) {
+        std::printf("Failed to create a headless app\n");
+        return 1;
+    }
+
+    const std::vector<Scene> scenes = {
+        {"Boxes", Boxes},
+        {"Helmet", Helmet},
+        {"Dragons", Dragons},
+    };
+
+    std::printf("%-10s %-12s %10s %10s %10s %10s\n", "Scene", "Time (ms)", "p50", "p95", "p99", "Max");
+
+    bool passed = true;
+    for (const Scene &scene: scenes) {
+        Samples samples;
+        u32     frame = 0;
+
+        app->AddSystem(Stage::Startup, [&](World &world) { scene.setup(world, options.assets); }, scene.name);
+
+        // Each frame sees the profile and stats of the one before it.
+        app->AddSystem(Stage::Update, [&](World &world) {
+            if (frame++ < s_WarmUp) {
+                return;
+            }
+
+            const Debug::FrameProfile &profile = world.Resource<Debug::FrameProfile>();
+            samples.frame.push_back(profile.milliseconds);
+            samples.gpu.push_back(world.Resource<RenderStats>().GpuTotal());
+
+            for (const Debug::ProfileEntry &entry: profile.entries) {
+                if (std::string_view(entry.name) == "Renderer::Render") {
+                    samples.submission.push_back(entry.milliseconds);
+                }
+            }
+        });
+
+        app->Run();
+        app->PopSystem(Stage::Startup);
+        app->PopSystem(Stage::Update);
+
+        Report(scene.name, samples);
+
+        const std::optional<Image> image = app->Capture();
+        if (!image || !Compare(scene.name, *image, options)) {
+            passed = false;
+        }
+    }
+
+    return passed ? 0 : 1;
+}
@@ -0,0 +1,97 @@
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+#include "Math/TransformBatch.hpp"
+
+using namespace Flock;
+
+namespace {
+    std::vector<Transform> RandomTransforms(const usize count) {
+        std::mt19937                        rng(42);
+        std::uniform_real_distribution<f32> dist(-100.0F, 100.0F);
+        std::uniform_real_distribution<f32> scale(0.1F, 4.0F);
+
+        std::vector<Transform> transforms(count);
+        for (auto &transform: transforms) {
+            transform = {
+                .position = {dist(rng), dist(rng), dist(rng)},
+                .rotation = Quaternion::Euler({dist(rng), dist(rng), dist(rng)}),
+                .scale    = {scale(rng), scale(rng), scale(rng)},
+            };
+        }
+
+        return transforms;
+    }
+
+    // Summed so the compiler can't drop the matrices.
+    f32 Checksum(const std::vector<Matrix4f> &matrices) {
+        f32 sum = 0.0F;
+        for (const auto &matrix: matrices) {
+            sum += matrix.At(3, 0) + matrix.At(0, 0);
+        }
+
+        return sum;
+    }
+
+    template<typename Func>
+    f64 Measure(const usize count, const u32 iterations, Func &&func) {
+        const auto start = std::chrono::steady_clock::now();
+        for (u32 i = 0; i < iterations; i++) {
+            func();
+        }
+        const auto end = std::chrono::steady_clock::now();
+
+        const f64 ns = std::chrono::duration<f64, std::nano>(end - start).count();
+        return ns / static_cast<f64>(count) / static_cast<f64>(iterations);
+    }
+}
+
+i32 main() {
+    std::printf("SIMD width: %u\n", Simd::WideOps::Width);
+    std::printf("%10s %12s %12s %12s %12s %12s\n", "Count", "Products", "Compose", "Batch AoS", "Batch SoA", "Checksum");
+
+    for (const usize count: {10'000, 100'000, 1'000'000}) {
+        const std::vector<Transform> transforms = RandomTransforms(count);
+        std::vector<Matrix4f>        matrices(count);
+
+        TransformSoA soa;
+        soa.Reserve(count);
+        for (const auto &transform: transforms) {
+            soa.Push(transform);
+        }
+
+        const u32 iterations = static_cast<u32>(10'000'000 / count);
+        f32       checksum   = 0.0F;
+
+        const f64 products = Measure(count, iterations, [&] {
+            for (usize i = 0; i < count; i++) {
+                const Transform &t = transforms[i];
+                matrices[i] = Matrix4f::Scale(t.scale) * Matrix4f::Rotate(t.rotation) * Matrix4f::Translate(t.position);
+            }
+            checksum += Checksum(matrices);
+        });
+
+        const f64 compose = Measure(count, iterations, [&] {
+            for (usize i = 0; i < count; i++) {
+                matrices[i] = transforms[i].Matrix();
+            }
+            checksum += Checksum(matrices);
+        });
+
+        const f64 aos = Measure(count, iterations, [&] {
+            ComputeMatrices(transforms, matrices);
+            checksum += Checksum(matrices);
+        });
+
+        const f64 batch = Measure(count, iterations, [&] {
+            ComputeMatrices(soa, matrices);
+            checksum += Checksum(matrices);
+        });
+
+        std::printf("%10zu %9.2f ns %9.2f ns %9.2f ns %9.2f ns %12.1f\n", count, products, compose, aos, batch, checksum);
+    }
+
+    return 0;
+}
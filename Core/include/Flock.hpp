@@ -3,6 +3,7 @@
 
 #include "Common.hpp"
 #include "Debug/Log.hpp"
+#include "Debug/Profiler.hpp"
 #include "Ecs/Entity.hpp"
 #include "Ecs/Registry.hpp"
 #include "TypeId.hpp"
@@ -21,6 +22,7 @@
 #include "Asset/AssetHandle.hpp"
 #include "App.hpp"
 #include "Graphics/ModelRenderer.hpp"
+#include "Graphics/Occluder.hpp"
 #include "Math/Transform.hpp"
 #include "Input/Input.hpp"
 #include "Ecs/World.hpp"
@@ -50,5 +52,8 @@
 #include "Event/EventRegistry.hpp"
 #include "Gui/Image.hpp"
 #include "Gui/Box.hpp"
+#include "Gui/StatsOverlay.hpp"
+#include "Graphics/RenderStats.hpp"
+#include "Jobs/JobSystem.hpp"
 
 #endif //FLK_FLOCK_HPP
@@ -1,18 +1,24 @@
 #include "App.hpp"
 
 #include <filesystem>
+#include <iomanip>
+#include <optional>
+#include <sstream>
 #include <string>
+#include <string_view>
 #include <utility>
 
 #include "Asset/Assets.hpp"
 #include "Audio/AudioSource.hpp"
 #include "Event/EventRegistry.hpp"
 #include "Graphics/ModelRenderer.hpp"
+#include "Graphics/Occluder.hpp"
 #include "Graphics/Skybox.hpp"
 #include "Graphics/SpriteRenderer.hpp"
 #include "Gui/Box.hpp"
 #include "Gui/Button.hpp"
 #include "Gui/Image.hpp"
+#include "Gui/StatsOverlay.hpp"
 #include "Gui/Text.hpp"
 #include "Input/Input.hpp"
 #include "Math/Transform.hpp"
@@ -20,6 +26,7 @@
 #include "Audio/AudioClip.hpp"
 #include "Audio/AudioListener.hpp"
 #include "Debug/Log.hpp"
+#include "Debug/Profiler.hpp"
 #include "Ecs/Registry.hpp"
 #include "Graphics/Camera.hpp"
 #include "Graphics/CubeMap.hpp"
@@ -28,7 +35,9 @@
 #include "Graphics/Mesh.hpp"
 #include "Graphics/Model.hpp"
 #include "Graphics/Pipeline.hpp"
+#include "Graphics/ProgramCache.hpp"
 #include "Graphics/Texture.hpp"
+#include "Graphics/TextureAtlas.hpp"
 #include "Gui/Font.hpp"
 #include "Gui/RectTransform.hpp"
 #include "Math/Color.hpp"
@@ -49,6 +58,8 @@ namespace Flock {
 
         app.m_Services.window = std::move(window.value());
         app.m_Services.window.MakeCurrent();
+        Graphics::PipelineBuild::EnableParallelCompile();
+        Graphics::ProgramCache::SetDirectory(config.programCache);
 
         auto audioPlayer = Audio::AudioPlayer::Create();
         if (!audioPlayer) {
@@ -59,12 +70,33 @@ namespace Flock {
         app.m_Services.audioPlayer   = std::move(audioPlayer.value());
         app.m_Services.physicsEngine = std::move(Physics::PhysicsEngine::Create());
         app.m_Services.guiRenderer   = std::move(Gui::GuiRenderer::Create());
+        app.m_Services.assetLoader.SetLodConfig(config.lodConfig);
+        app.m_Services.assetLoader.SetPackingConfig(config.packingConfig);
+        app.m_Services.assetLoader.SetGeometryPoolConfig(config.geometryPoolConfig);
+        app.m_Services.renderer.Scene().SetLodConfig(config.lodConfig);
+        app.m_Services.renderer.Scene().SetMaterialBatching(config.materialBatching);
+
+        auto spriteBatch = Graphics::SpriteBatch::Create();
+        if (!spriteBatch) {
+            Debug::LogErr("App::Create: Failed to create sprite batch!");
+            return std::nullopt;
+        }
+
+        app.m_SpriteBatch = std::move(spriteBatch.value());
+
+        if (config.windowConfig.headless && !app.CreateOffscreen()) {
+            Debug::LogErr("App::Create: Failed to create offscreen framebuffer!");
+            return std::nullopt;
+        }
+
+        // Compiled now rather than in the middle of the first frames that need them.
+        Graphics::Renderer::WarmUp();
 
         return app;
     }
 
-    App &App::AddSystem(const Ecs::Stage stage, const Ecs::System &system) {
-        m_Schedule.AddSystem(stage, system);
+    App &App::AddSystem(const Ecs::Stage stage, const Ecs::System &system, const std::string &name) {
+        m_Schedule.AddSystem(stage, system, name);
 
         return *this;
     }
@@ -76,39 +108,125 @@ namespace Flock {
     }
 
     App &App::Run() {
+        Debug::Profiler::SetThreadName("Main");
         m_Services.window.MakeCurrent();
+        m_ShouldClose = false;
         m_Services.inputHandler.HookEvents(m_Services.eventHandler);
 
         m_World = Ecs::World::Default();
         m_World.InsertResource<Asset::Assets>(Asset::Assets{m_Services.assetLoader});
-        m_Schedule.Execute(Ecs::Stage::Startup, m_World);
 
-        while (!m_Services.window.ShouldClose() && !m_ShouldClose) {
-            // Begin
-            m_Services.window.PollEvents(m_Services.eventHandler);
-            m_Services.eventHandler.Update();
+        // The render scene follows these through their changes instead of walking them every frame.
+        m_Services.renderer.Scene().Clear();
+        m_World.Registry().TrackChanges<Graphics::ModelRenderer>();
+        m_World.Registry().TrackChanges<Graphics::Occluder>();
+        m_World.Registry().TrackChanges<Transform>();
+        {
+            FLK_PROFILE_SCOPE("Startup");
+            m_Schedule.Execute(Ecs::Stage::Startup, m_World);
+        }
+
+        if (m_Config.renderThread) {
+            // Loads create GL objects and move the assets a frame in flight may still be drawing.
+            m_Services.assetLoader.SetChangeCallback([this] { m_RenderThread.Acquire(); });
+            m_RenderThread.Start(m_Services.window);
+        }
+
+        u64 frames = 0;
+        while (!m_Services.window.ShouldClose() && !m_ShouldClose &&
+               (m_Config.frameLimit == 0 || frames < m_Config.frameLimit)) {
+            frames++;
+
+            {
+                FLK_PROFILE_SCOPE("Frame");
+
+                // Begin
+                {
+                    FLK_PROFILE_SCOPE("PollEvents");
+                    m_Services.window.PollEvents(m_Services.eventHandler);
+                    m_Services.eventHandler.Update();
+                }
+
+                // Update, while the render thread draws the previous frame
+                {
+                    FLK_PROFILE_SCOPE("Update");
+                    Prepare();
+                    m_Schedule.Execute(Ecs::Stage::Update, m_World);
+                }
+
+                {
+                    FLK_PROFILE_SCOPE("Extract");
+                    Extract();
+                }
+
+                // Sync, the previous frame is done and the render state is free to change
+                {
+                    FLK_PROFILE_SCOPE("WaitForRender");
+                    m_RenderThread.Wait();
+                }
+
+                {
+                    FLK_PROFILE_SCOPE("Sync");
+                    m_World.InsertResource(Graphics::RenderStats{m_Stats});
+                    m_World.InsertResource(Debug::Profiler::LastFrame());
+                    SyncRenderScene();
+                    ExtractFrame();
+                    ExtractGui();
+                }
+
+                // Render
+                m_RenderThread.Submit([this] { RenderFrame(); });
+
+                // Finish
+                m_Services.inputHandler.ResetState();
+            }
 
-            // Update
-            Prepare();
-            m_Schedule.Execute(Ecs::Stage::Update, m_World);
-            Extract();
+            Debug::Profiler::EndFrame();
+        }
 
-            // Render
-            Render();
-            RenderGui();
+        m_RenderThread.Stop();
+        m_Services.assetLoader.SetChangeCallback({});
 
-            // Finish
-            m_Services.window.SwapBuffers();
-            m_Services.inputHandler.ResetState();
+        if (!m_Config.profileTrace.empty()) {
+            Debug::Profiler::WriteChromeTrace(m_Config.profileTrace);
         }
 
         return *this;
     }
 
+    std::optional<Graphics::Image> App::Capture() const {
+        if (!m_Offscreen) {
+            return std::nullopt;
+        }
+
+        return m_Offscreen->ReadColor(m_Config.windowConfig.size);
+    }
+
     Services &App::Services() {
         return m_Services;
     }
 
+    bool App::CreateOffscreen() {
+        using namespace Graphics;
+
+        std::optional<Framebuffer> framebuffer = Framebuffer::Create();
+        if (!framebuffer) {
+            return false;
+        }
+
+        const Vector2u size = m_Config.windowConfig.size;
+        m_OffscreenColor    = Texture::CreateEmpty(size, {.filterMode = Linear, .generateMipmaps = false});
+        m_OffscreenDepth    = Texture::CreateEmpty(size, {.format = TextureFormat::Depth, .generateMipmaps = false});
+
+        if (!framebuffer->Attach(Attachment::Color, m_OffscreenColor) ||
+            !framebuffer->Attach(Attachment::Depth, m_OffscreenDepth)) {
+            return false;
+        }
+
+        m_Offscreen = std::move(framebuffer);
+        return true;
+    }
+
     void App::Prepare() {
         const f64 deltaTime = Time::CurrentTime() - m_World.Resource<Time::Clock>().time;
 
@@ -176,6 +294,7 @@ namespace Flock {
         m_Services.physicsEngine.SetScene(physicsObjects);
 
         while (accumulator >= 0.02F) {
+            FLK_PROFILE_SCOPE("Physics substep");
             m_Services.physicsEngine.Update(0.02F);
             accumulator -= 0.02F;
         }
@@ -183,7 +302,77 @@ namespace Flock {
         m_ShouldClose = m_World.Resource<Application>().shouldClose;
     }
 
-    void App::Render() {
+    void App::SyncRenderScene() {
+        using namespace Graphics;
+
+        Ecs::Registry &registry = m_World.Registry();
+        RenderScene &  scene    = m_Services.renderer.Scene();
+
+        const auto [addedRenderers, removedRenderers, modifiedRenderers]    = registry.TakeChanges<ModelRenderer>();
+        const auto [addedTransforms, removedTransforms, modifiedTransforms] = registry.TakeChanges<Transform>();
+        const auto [addedOccluders, removedOccluders, modifiedOccluders]    = registry.TakeChanges<Occluder>();
+
+        // Reads go through the const registry, so syncing doesn't mark anything as modified again.
+        const auto sync = [&](const EntityId id) {
+            const std::optional<Ecs::Entity> entity = registry.EntityWithId(id);
+            if (!entity || !registry.HasAll<ModelRenderer, Transform>(*entity) ||
+                !registry.AllEnabled<ModelRenderer, Transform>(*entity)) {
+                scene.Remove(id);
+                return;
+            }
+
+            const Ecs::Registry &reader    = registry;
+            const ModelRenderer &renderer  = *reader.Get<ModelRenderer>(*entity);
+            const Transform &    transform = *reader.Get<Transform>(*entity);
+
+            if (!scene.Set(id, renderer.model, transform, renderer.isStatic, m_Services.assetLoader)) {
+                Debug::LogErr("App::SyncRenderScene: Invalid ModelRenderer model");
+                return;
+            }
+
+            const Occluder *occluder = registry.HasAll<Occluder>(*entity) && registry.AllEnabled<Occluder>(*entity)
+                                           ? reader.Get<Occluder>(*entity)
+                                           : nullptr;
+
+            if (!scene.SetOccluder(id, occluder, m_Services.assetLoader)) {
+                Debug::LogErr("App::SyncRenderScene: Invalid Occluder model");
+            }
+        };
+
+        for (const EntityId id: removedRenderers) {
+            scene.Remove(id);
+        }
+
+        for (const EntityId id: removedTransforms) {
+            scene.Remove(id);
+        }
+
+        for (const auto *ids: {&addedRenderers, &modifiedRenderers, &addedTransforms, &addedOccluders,
+                               &removedOccluders, &modifiedOccluders}) {
+            for (const EntityId id: *ids) {
+                sync(id);
+            }
+        }
+
+        for (const EntityId id: modifiedTransforms) {
+            const std::optional<Ecs::Entity> entity = registry.EntityWithId(id);
+            if (!scene.Contains(id) || !entity || !registry.IsEnabled<Transform>(*entity)) {
+                // Also covers a transform being enabled again.
+                if (entity && registry.Has<ModelRenderer>(*entity)) {
+                    sync(id);
+                }
+
+                continue;
+            }
+
+            scene.SetTransform(id, *std::as_const(registry).Get<Transform>(*entity));
+        }
+
+        scene.Refresh(m_Services.assetLoader);
+        m_Services.renderer.SetOcclusionConfig(m_World.Resource<OcclusionConfig>());
+    }
+
+    void App::ExtractFrame() {
         using namespace Graphics;
 
         const Camera       camera = m_World.Resource<Camera>();
@@ -209,90 +398,100 @@ namespace Flock {
             cubeMap = m_Services.assetLoader.Get<CubeMap>(skybox.filePath);
         }
 
-        SceneData scene = {
+        FramePacket &frame = m_Frame;
+        frame.scene        = {
             .camera       = camera,
             .lights       = lights,
             .ambientLight = ambient,
             .skybox       = cubeMap
         };
+        frame.windowSize = m_Services.window.Size();
+        frame.clearColor = Color4u8{ambient.color};
+
+        frame.sprites.clear();
+
+        // Reads go through the const registry, so extracting doesn't mark every sprite's transform as modified.
+        const Ecs::Registry &reader = m_World.Registry();
+        reader.ForEach<SpriteRenderer, Transform>([&](const SpriteRenderer &renderer, const Transform &transform) {
+            Sprite sprite = {
+                .transform = transform,
+                .color     = renderer.color,
+                .layer     = renderer.layer,
+                .blend     = renderer.blend,
+            };
 
-        RenderList commands;
-        m_World.Registry().ForEach<ModelRenderer, Transform>([&](const ModelRenderer &renderer, const Transform &transform) {
-            const auto result = m_Services.assetLoader.Get(renderer.model);
-            if (!result) {
-                Debug::LogErr("App::Render: Invalid ModelRenderer model");
-                return;
+            // Sprites sharing an atlas page share a texture, and a batch.
+            const TextureAtlas *atlas  = m_Services.assetLoader.Get<TextureAtlas>(renderer.atlas);
+            const AtlasRegion * region = atlas ? atlas->Region(renderer.region) : nullptr;
+            if (region) {
+                sprite.texture = atlas->Page(region->page);
+                sprite.uv      = region->uv;
+            } else {
+                sprite.texture = m_Services.assetLoader.Get<Texture>(renderer.sprite);
             }
 
-            auto &[objects] = *result;
-            for (auto &[mesh, mat]: objects) {
-                MaterialProperties props = {
-                    .color     = mat.color,
-                    .metallic  = mat.metallic,
-                    .roughness = mat.roughness,
-                };
-
-                props.colorMap     = m_Services.assetLoader.Get<Texture>(mat.colorMap);
-                props.metallicMap  = m_Services.assetLoader.Get<Texture>(mat.metallicMap);
-                props.roughnessMap = m_Services.assetLoader.Get<Texture>(mat.roughnessMap);
-
-                commands.push_back({
-                    .mesh               = &mesh,
-                    .pipeline           = m_Services.assetLoader.Get(mat.pipeline),
-                    .materialProperties = props,
-                    .transform          = transform,
-                });
-            }
+            frame.sprites.push_back(sprite);
         });
+    }
+
+    void App::RenderFrame() {
+        using namespace Graphics;
+
+        FLK_PROFILE_SCOPE("RenderFrame");
+
+        const FramePacket &frame    = m_Frame;
+        const Rect2u       viewport = {{0, 0}, frame.windowSize};
+
+        GpuTimers &timers = m_Services.renderer.Timers();
+        timers.BeginFrame();
+        FrameCounters::Reset();
+
+        Framebuffer *target = m_Offscreen ? &m_Offscreen.value() : nullptr;
 
-        const Rect2u viewport = {{0, 0}, m_Services.window.Size()};
         m_Services.renderer.Render(
-            commands,
-            scene,
+            frame.scene,
             {
-                .viewport = viewport,
-                .clear    = {.color = Color4u8{ambient.color}}
+                .viewport     = viewport,
+                .clear        = {.color = frame.clearColor},
+                .framebuffer  = target,
+                .depthPrePass = m_Config.depthPrePass
             },
             m_Config.shadowConfig
         );
 
-        commands.clear();
-
-        Mesh      square = Mesh::Square();
-        Pipeline *unlit  = m_Services.assetLoader.Get<Pipeline>("@Unlit");
-        if (unlit) {
-            m_World.Registry().ForEach<SpriteRenderer, Transform>([&](const SpriteRenderer &renderer, const Transform &transform) {
-                MaterialProperties props = {
-                    .color     = renderer.color,
-                    .metallic  = 0.0F,
-                    .roughness = 1.0F,
-                };
-
-
-                props.colorMap = m_Services.assetLoader.Get<Texture>(renderer.sprite);
-
-                commands.push_back({
-                    .mesh               = &square,
-                    .pipeline           = unlit,
-                    .materialProperties = props,
-                    .transform          = transform,
-                });
-            });
+        // The renderer leaves the window bound, sprites and GUI draw on top of the scene.
+        if (target) {
+            target->Bind();
         }
 
-        scene.skybox = nullptr;
-        scene.lights = {};
-        m_Services.renderer.Render(
-            commands,
-            scene,
-            {
-                .viewport = viewport,
-                .clear    = {.clearColor = false, .clearDepth = false}
+        const Camera &camera      = frame.scene.camera;
+        const f32     aspectRatio = static_cast<f32>(frame.windowSize.x) / static_cast<f32>(frame.windowSize.y);
+        {
+            FLK_PROFILE_SCOPE("Sprites");
+            if (!m_SpriteBatch.Render(frame.sprites, camera.ViewMatrix() * camera.ProjMatrix(aspectRatio))) {
+                Debug::LogErr("App::RenderFrame: Failed to render sprites!");
             }
-        );
+        }
+
+        {
+            FLK_PROFILE_SCOPE("Gui");
+            GpuTimers::Scope timer(timers, GpuPass::Gui);
+            m_Services.guiRenderer.Render(frame.gui, frame.windowSize);
+        }
+
+        m_Stats                 = FrameCounters::Counts();
+        m_Stats.gpuMilliseconds = timers.AllMilliseconds();
+
+        if (target) {
+            Framebuffer::Unbind();
+            return;
+        }
+
+        FLK_PROFILE_SCOPE("SwapBuffers");
+        m_Services.window.SwapBuffers();
     }
 
-    void App::RenderGui() {
+    void App::ExtractGui() {
         using namespace Gui;
 
         const auto input = m_World.Resource<Input::InputState>();
@@ -301,23 +500,28 @@ namespace Flock {
         const bool mouseReleased = input.IsMouseReleased();
         const bool mousePressed  = input.IsMousePressed();
 
-        m_Services.guiRenderer.BeginFrame(m_Services.window.Size());
+        GuiList &commands = m_Frame.gui;
+        commands.clear();
 
         m_World.Registry().ForEach<RectTransform, Box>([&](const RectTransform &trans, const Box &box) {
-            m_Services.guiRenderer.RenderRect(
-                trans,
-                box.color
-            );
+            commands.emplace_back(GuiRect{.transform = trans, .color = box.color});
         });
 
         m_World.Registry().ForEach<RectTransform, Image>([&](const RectTransform &trans, const Image &img) {
-            const Graphics::Texture *tex = m_Services.assetLoader.Get<Graphics::Texture>(img.imagePath);
-            if (img.imagePath.empty() || !tex) {
-                m_Services.guiRenderer.RenderRect(trans, Color4u8::White());
-                return;
+            GuiImage image = {.transform = trans};
+            if (!img.imagePath.empty() && img.region != FLK_INVALID) {
+                const auto *atlas  = m_Services.assetLoader.Get<Graphics::TextureAtlas>(img.imagePath);
+                const auto *region = atlas ? atlas->Region(img.region) : nullptr;
+                if (region) {
+                    image.texture = atlas->Page(region->page);
+                    image.uv      = region->uv;
+                }
+            } else if (!img.imagePath.empty()) {
+                image.texture = m_Services.assetLoader.Get<Graphics::Texture>(img.imagePath);
             }
 
-            m_Services.guiRenderer.RenderImage(trans, *tex);
+            // Drawn as a white rect without a texture.
+            commands.emplace_back(image);
         });
 
         m_World.Registry().ForEach<RectTransform, Button>([&](const RectTransform &trans, const Button &button) {
@@ -335,12 +539,12 @@ namespace Flock {
                 tex = m_Services.assetLoader.Get<Graphics::Texture>(button.imagePath);
             }
 
-            m_Services.guiRenderer.RenderButton(
-                trans,
-                button.defaultColor,
-                tint,
-                tex
-            );
+            commands.emplace_back(GuiButton{
+                .transform = trans,
+                .color     = button.defaultColor,
+                .tint      = tint,
+                .texture   = tex
+            });
 
             const auto events = m_World.Resource<Event::EventRegistry>();
 
@@ -356,21 +560,111 @@ namespace Flock {
         m_World.Registry().ForEach<RectTransform, Text>([&](const RectTransform &trans, const Text &text) {
             const auto font = m_Services.assetLoader.Get(text.font);
             if (!font) {
-                Debug::LogErr("App::RenderGui: Invalid Text font", text.font.filePath);
+                Debug::LogErr("App::ExtractGui: Invalid Text font", text.font.filePath);
                 return;
             }
 
-            m_Services.guiRenderer.RenderText(
-                text.content,
-                text.fontSize,
-                *font,
-                trans,
-                text.color,
-                text.horizontalAlignment,
-                text.verticalAlignment
-            );
+            commands.emplace_back(GuiText{
+                .content             = text.content,
+                .fontSize            = text.fontSize,
+                .font                = font,
+                .transform           = trans,
+                .color               = text.color,
+                .horizontalAlignment = text.horizontalAlignment,
+                .verticalAlignment   = text.verticalAlignment
+            });
+        });
+
+        // The view is only written by the render thread, which draws the GUI after updating it.
+        const auto &occlusion = m_World.Resource<Graphics::OcclusionConfig>();
+        if (occlusion.enabled && occlusion.debugView) {
+            const Vector2i size   = {static_cast<i32>(occlusion.resolution.x), static_cast<i32>(occlusion.resolution.y)};
+            const Vector2i window = {static_cast<i32>(m_Frame.windowSize.x), static_cast<i32>(m_Frame.windowSize.y)};
+
+            commands.emplace_back(GuiImage{
+                .transform = {{window - size, size}},
+                .texture   = &m_Services.renderer.OcclusionView(),
+            });
+        }
+
+        ExtractStatsOverlay();
+    }
+
+    void App::ExtractStatsOverlay() {
+        using namespace Gui;
+        using Graphics::GpuPass;
+
+        const StatsOverlay &overlay = m_World.Resource<StatsOverlay>();
+        if (!overlay.visible) {
+            return;
+        }
+
+        const Font *font = m_Services.assetLoader.Get(overlay.font);
+        if (!font) {
+            Debug::LogErr("App::ExtractStatsOverlay: Invalid StatsOverlay font");
+            return;
+        }
+
+        const Graphics::RenderStats &stats = m_World.Resource<Graphics::RenderStats>();
+
+        std::ostringstream text;
+        text << std::fixed << std::setprecision(2);
+        text << "GPU " << stats.GpuTotal() << " ms\n";
+        text << "  shadows " << stats.GpuTime(GpuPass::Shadows) << " ms\n";
+        text << "  skybox " << stats.GpuTime(GpuPass::Skybox) << " ms\n";
+        text << "  scene " << stats.GpuTime(GpuPass::Scene) << " ms\n";
+        text << "  gui " << stats.GpuTime(GpuPass::Gui) << " ms\n";
+        text << "Draw calls " << stats.drawCalls << '\n';
+        text << "Triangles " << stats.triangles << '\n';
+        text << "Binds " << stats.programBinds << " program, " << stats.vertexArrayBinds << " vertex array, "
+                << stats.textureBinds << " texture\n";
+        text << "Uniforms " << stats.uniformUploads << '\n';
+        text << "Uploads " << static_cast<f32>(stats.bufferBytes) / 1024.0F << " KiB";
+
+        i32 lines = 10;
+
+        // The frame scope spans the others, the list starts below it.
+        const Debug::FrameProfile &profile = m_World.Resource<Debug::FrameProfile>();
+        if (!profile.entries.empty() && overlay.cpuScopes > 0) {
+            text << "\nCPU " << profile.milliseconds << " ms";
+            lines++;
+
+            u32 listed = 0;
+            for (const Debug::ProfileEntry &entry: profile.entries) {
+                if (listed == overlay.cpuScopes) {
+                    break;
+                }
+
+                if (std::string_view(entry.name) == "Frame") {
+                    continue;
+                }
+
+                text << "\n  " << entry.name << ' ' << entry.milliseconds << " ms";
+                if (entry.calls > 1) {
+                    text << " (" << entry.calls << "x)";
+                }
+
+                listed++;
+                lines++;
+            }
+        }
+
+        // nanovg breaks the text box at newlines, the background fits the lines.
+        constexpr i32 padding = 6;
+        const i32     height  = lines * static_cast<i32>(overlay.fontSize) * 5 / 4;
+        const Rect2i  rect    = {overlay.position, {static_cast<i32>(overlay.fontSize) * 22, height}};
+
+        m_Frame.gui.emplace_back(GuiRect{
+            .transform = {{rect.origin - Vector2i{padding, padding}, rect.aspect + Vector2i{padding, padding} * 2}},
+            .color     = overlay.background
         });
 
-        m_Services.guiRenderer.EndFrame();
+        m_Frame.gui.emplace_back(GuiText{
+            .content   = text.str(),
+            .fontSize  = overlay.fontSize,
+            .font      = font,
+            .transform = {rect},
+            .color     = overlay.color,
+        });
     }
 }
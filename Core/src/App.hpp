@@ -1,7 +1,9 @@
 #ifndef FLK_APP_HPP
 #define FLK_APP_HPP
 
+#include <filesystem>
 #include <optional>
+#include <string>
 #include <vector>
 
 #include "Common.hpp"
@@ -11,9 +13,18 @@
 #include "Ecs/World.hpp"
 #include "Event/EventHandler.hpp"
 #include "Glfw/Window.hpp"
+#include "Graphics/Framebuffer.hpp"
+#include "Graphics/Image.hpp"
 #include "Graphics/Renderer.hpp"
+#include "Graphics/RenderStats.hpp"
+#include "Graphics/RenderThread.hpp"
+#include "Graphics/SpriteBatch.hpp"
+#include "Graphics/Texture.hpp"
 #include "Gui/GuiRenderer.hpp"
 #include "Input/InputHandler.hpp"
+#include "Math/Color.hpp"
+#include "Math/Rect.hpp"
+#include "Math/Vector.hpp"
 #include "Physics/PhysicsEngine.hpp"
 
 namespace Flock {
@@ -32,19 +43,81 @@ namespace Flock {
     };
 
     struct FLK_API AppConfig {
-        Glfw::WindowConfig     windowConfig;
-        Graphics::ShadowConfig shadowConfig;
+        Glfw::WindowConfig           windowConfig;
+        Graphics::ShadowConfig       shadowConfig;
+        Graphics::LodConfig          lodConfig;
+        Graphics::PackingConfig      packingConfig;
+        Graphics::GeometryPoolConfig geometryPoolConfig;
+
+        /**
+         * Lays down opaque depth before shading, which then only passes equal depth. Every opaque pipeline has to
+         * declare `invariant gl_Position` and compute it exactly like the built-in depth shader, or it loses pixels.
+         */
+        bool depthPrePass = false;
+
+        /**
+         * Packs same-size material textures into texture arrays and instances draws across materials.
+         * The pipelines have to read their materials from instance data, see Graphics::Renderer.
+         */
+        bool materialBatching = false;
+
+        /**
+         * Where linked shader programs are cached between runs, see Graphics::ProgramCache. Empty disables the cache.
+         */
+        std::filesystem::path programCache = "ProgramCache";
+
+        /**
+         * Renders each frame on a render thread while the next one is simulated, at one frame of latency.
+         * Systems must then only create GL resources through the asset loader, which waits for the render thread.
+         */
+        bool renderThread = false;
+
+        /**
+         * Where the profiled scopes are written as a Chrome trace when the app stops, see Debug::Profiler.
+         * Empty writes nothing.
+         */
+        std::filesystem::path profileTrace = "";
+
+        /**
+         * Frames Run() renders before it returns, 0 runs until the app is closed. Mostly for headless runs, see
+         * Glfw::WindowConfig::headless.
+         */
+        u32 frameLimit = 0;
+    };
+
+    /**
+     * @struct FramePacket
+     * @brief What a frame is rendered from, extracted from the world at the sync point.
+     *
+     * The render thread reads only this, the render scene and the assets it points to, so the world is free to
+     * simulate the next frame meanwhile.
+     */
+    struct FLK_API FramePacket {
+        Graphics::SceneData  scene      = {};
+        Graphics::SpriteList sprites    = {};
+        Gui::GuiList         gui        = {};
+        Vector2u             windowSize = {};
+        Color4u8             clearColor = {};
     };
 
     /**
      * @class App
      */
     class FLK_API App {
-        Ecs::World    m_World;
-        Ecs::Schedule m_Schedule;
-        Services      m_Services;
-        AppConfig     m_Config;
-        bool          m_ShouldClose = false;
+        Ecs::World             m_World;
+        Ecs::Schedule          m_Schedule;
+        Services               m_Services;
+        AppConfig              m_Config;
+        Graphics::RenderThread m_RenderThread;
+        FramePacket            m_Frame;
+        Graphics::SpriteBatch  m_SpriteBatch;
+        Graphics::RenderStats  m_Stats; // Of the last rendered frame, written by RenderFrame().
+        bool                   m_ShouldClose = false;
+
+        // What headless apps render into instead of the window.
+        std::optional<Graphics::Framebuffer> m_Offscreen;
+        Graphics::Texture                    m_OffscreenColor;
+        Graphics::Texture                    m_OffscreenDepth;
 
     public:
         /**
@@ -67,9 +140,10 @@ namespace Flock {
          * @brief Adds a system to a stage.
          * @param stage The stage.
          * @param system The system.
+         * @param name The name of the system in profiles, numbered if empty.
          * @return A reference to the app.
          */
-        App &AddSystem(Ecs::Stage stage, const Ecs::System &system);
+        App &AddSystem(Ecs::Stage stage, const Ecs::System &system, const std::string &name = "");
 
         /**
          * @brief Adds multiple systems to a stage; executed in order.
@@ -93,19 +167,39 @@ namespace Flock {
         App &PopSystem(Ecs::Stage stage);
 
         /**
-         * @brief Runs the application loop until the app is closed.
+         * @brief Runs the application loop until the app is closed or AppConfig::frameLimit frames were rendered.
          * @return A reference to the app.
          */
         App &Run();
 
+        /**
+         * @brief Reads back the last frame of a headless app, call it after Run() returned.
+         * @return The frame if the app is headless; std::nullopt otherwise.
+         */
+        [[nodiscard]] std::optional<Graphics::Image> Capture() const;
+
         [[nodiscard]] Services &Services();
 
     private:
+        bool CreateOffscreen();
+
         void Prepare();
         void Extract();
+        void SyncRenderScene();
+
+        void ExtractFrame();
+        void ExtractGui();
+
+        /**
+         * @brief Appends the Gui::StatsOverlay to the GUI commands if it is visible.
+         */
+        void ExtractStatsOverlay();
 
-        void Render();
-        void RenderGui();
+        /**
+         * @brief Renders m_Frame and presents it, on the render thread if there is one. Headless apps render into
+         * m_Offscreen instead.
+         */
+        void RenderFrame();
     };
 
     struct FLK_API Application {
@@ -3,6 +3,7 @@
 
 #include <concepts>
 #include <filesystem>
+#include <functional>
 #include <memory>
 #include <optional>
 #include <string>
@@ -13,6 +14,7 @@
 #include "AssetHandle.hpp"
 #include "Common.hpp"
 #include "TypeId.hpp"
+#include "Debug/Profiler.hpp"
 #include "Audio/AudioClip.hpp"
 #include "Graphics/Model.hpp"
 #include "Graphics/Pipeline.hpp"
@@ -26,7 +28,10 @@
 #include "FileIo/Model.hpp"
 #include "FileIo/Pipeline.hpp"
 #include "Graphics/CubeMap.hpp"
+#include "Graphics/GeometryPool.hpp"
 #include "Graphics/Mesh.hpp"
+#include "Graphics/MeshLod.hpp"
+#include "Graphics/MeshOptimizer.hpp"
 
 namespace Flock::Asset {
     template<typename T>
@@ -45,9 +50,16 @@ namespace Flock::Asset {
      * @brief Loads, unloads, and stores all the in-game assets.
      */
     class FLK_API AssetLoader {
+        // Declared first so it is destroyed after the meshes allocated from it.
+        std::unique_ptr<Graphics::GeometryPool> m_GeometryPool = std::make_unique<Graphics::GeometryPool>();
+
         std::unordered_map<TypeId, std::shared_ptr<void> >                m_AssetPools;
         std::unordered_map<TypeId, AssetPaths>                            m_AssetPaths;
         std::unordered_map<std::string, AssetHandle<Graphics::Pipeline> > m_Pipelines;
+        Graphics::LodConfig                                               m_LodConfig;
+        Graphics::PackingConfig                                           m_PackingConfig;
+        u64                                                               m_Generation = 0;
+        std::function<void()>                                             m_BeforeChange;
 
     public:
         template<typename T>
@@ -83,6 +95,9 @@ namespace Flock::Asset {
                 return AssetHandle<T>{.id = paths.at(filePath.string()), .resolved = true, .filePath = filePath.string()};
             }
 
+            BeforeChange();
+
+            FLK_PROFILE_SCOPE("AssetLoader::Load");
             std::optional<T> maybeAsset = Loader<T>::Load(*this, filePath);
             if (!maybeAsset) {
                 return AssetHandle<T>{};
@@ -91,15 +106,19 @@ namespace Flock::Asset {
             pool.push_back(std::move(maybeAsset.value()));
             const AssetId id         = pool.size() - 1;
             paths[filePath.string()] = id;
+            m_Generation++;
 
             return AssetHandle<T>{.id = id, .resolved = true, .filePath = filePath.string()};
         }
 
         template<typename T>
         AssetHandle<T> Register(T &&value) {
+            BeforeChange();
+
             AssetPool<T> &pool = Pool<T>();
             pool.push_back(std::move(value));
             const AssetId id = pool.size() - 1;
+            m_Generation++;
 
             return AssetHandle<T>{.id = id, .resolved = true};
         }
@@ -121,8 +140,18 @@ namespace Flock::Asset {
                 return false;
             }
 
+            BeforeChange();
+
             AssetPool<T> &pool = Pool<T>();
             pool.at(handle.id) = std::nullopt;
+            m_Generation++;
+
+            if constexpr (std::same_as<T, Graphics::Model>) {
+                if (m_GeometryPool->Fragmentation() > m_GeometryPool->Config().defragThreshold) {
+                    m_GeometryPool->Defragment();
+                }
+            }
+
             return true;
         }
 
@@ -154,6 +183,22 @@ namespace Flock::Asset {
             return Get<T>(handle);
         }
 
+        /**
+         * @brief Changes whenever an asset is added or removed, pointers from Get() may be invalid after that.
+         */
+        [[nodiscard]] u64 Generation() const {
+            return m_Generation;
+        }
+
+        /**
+         * @brief Sets a callback run before an asset is loaded, added or removed.
+         *
+         * Lets a render thread finish with the current assets, and hand over the GL context for the new ones.
+         */
+        void SetChangeCallback(std::function<void()> callback) {
+            m_BeforeChange = std::move(callback);
+        }
+
         bool SetPipeline(const std::string &name, AssetHandle<Graphics::Pipeline> pipeline) {
             Resolve(pipeline);
             if (!pipeline.IsValid()) {
@@ -171,6 +216,43 @@ namespace Flock::Asset {
 
             return AssetHandle<Graphics::Pipeline>{};
         }
+
+        /**
+         * @brief Sets how LODs are generated for models loaded from now on.
+         */
+        void SetLodConfig(const Graphics::LodConfig &config) {
+            m_LodConfig = config;
+        }
+
+        [[nodiscard]] const Graphics::LodConfig &GetLodConfig() const {
+            return m_LodConfig;
+        }
+
+        /**
+         * @brief Sets how the vertices of models loaded from now on are packed.
+         */
+        void SetPackingConfig(const Graphics::PackingConfig &config) {
+            m_PackingConfig = config;
+        }
+
+        [[nodiscard]] const Graphics::PackingConfig &GetPackingConfig() const {
+            return m_PackingConfig;
+        }
+
+        void SetGeometryPoolConfig(const Graphics::GeometryPoolConfig &config) {
+            m_GeometryPool->SetConfig(config);
+        }
+
+        [[nodiscard]] Graphics::GeometryPool &GetGeometryPool() {
+            return *m_GeometryPool;
+        }
+
+    private:
+        void BeforeChange() const {
+            if (m_BeforeChange) {
+                m_BeforeChange();
+            }
+        }
     };
 
     template<>
@@ -245,12 +327,29 @@ namespace Flock::Asset {
             std::vector<FileIo::MeshData> meshes    = FileIo::ReadModelMeshes(filePath);
             const std::vector<Material>   materials = FileIo::ReadModelMaterials(filePath);
 
+            GeometryPool &pool   = loader.GetGeometryPool();
+            const bool    pooled = pool.Config().enabled;
+
+            const auto create = [&](const MeshData &data, const VertexFormat format) {
+                return pooled ? Mesh::Create(data, pool, format).value() : Mesh::Create(data, format).value();
+            };
+
             Model model;
             for (auto &[data, materialIndex]: meshes) {
-                model.objects.push_back({
-                    .mesh     = Mesh::Create(data).value(),
-                    .material = materials[materialIndex]
-                });
+                const VertexFormat format = ChooseVertexFormat(data.vertices, loader.GetPackingConfig());
+
+                RenderObject object = {
+                    .mesh     = create(data, format),
+                    .material = materials[materialIndex],
+                    .bounds   = BoundingSphere::FromMesh(data)
+                };
+
+                for (auto &lod: GenerateLods(data, loader.GetLodConfig())) {
+                    OptimizeMesh(lod);
+                    object.lods.push_back(create(lod, format));
+                }
+
+                model.objects.push_back(std::move(object));
             }
 
             return model;
@@ -0,0 +1,230 @@
+#include "Profiler.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <iomanip>
+#include <memory>
+#include <ranges>
+#include <mutex>
+#include <sstream>
+#include <string_view>
+#include <unordered_map>
+#include <unordered_set>
+
+#include "FileIo/File.hpp"
+
+namespace Flock::Debug {
+    namespace {
+        using Clock = std::chrono::steady_clock;
+
+        constexpr u64 s_Capacity = Profiler::s_BufferEvents;
+
+        struct Event {
+            const char *name  = nullptr;
+            u64         start = 0;
+            u64         end   = 0;
+        };
+
+        struct ThreadBuffer {
+            std::unique_ptr<Event[]> events = std::make_unique<Event[]>(s_Capacity);
+            std::atomic<u64>         head   = 0; // Events ever written, only the owning thread writes it.
+            u32                      id     = 0;
+            std::string              name;
+            u64                      summarized = 0; // Events already in a FrameProfile.
+        };
+
+        struct State {
+            std::mutex                                 mutex;
+            std::vector<std::unique_ptr<ThreadBuffer>> buffers; // Never freed, threads may exit mid trace.
+            std::unordered_set<std::string>            interned;
+            std::atomic<bool>                          enabled    = true;
+            Clock::time_point                          epoch      = Clock::now();
+            u64                                        frameStart = 0;
+            FrameProfile                               last;
+        };
+
+        State &GetState() {
+            static State state;
+            return state;
+        }
+
+        ThreadBuffer &LocalBuffer() {
+            thread_local ThreadBuffer *buffer = nullptr;
+            if (buffer) {
+                return *buffer;
+            }
+
+            // Once per thread, recording itself never locks.
+            State &         state = GetState();
+            std::lock_guard lock(state.mutex);
+
+            auto &owned = state.buffers.emplace_back(std::make_unique<ThreadBuffer>());
+            owned->id   = static_cast<u32>(state.buffers.size());
+            owned->name = "Thread " + std::to_string(owned->id);
+            buffer      = owned.get();
+
+            return *buffer;
+        }
+
+        // Copies the events from index `from` on. The writer keeps going meanwhile, whatever it may have
+        // overwritten during the copy is dropped.
+        std::vector<Event> Snapshot(const ThreadBuffer &buffer, const u64 from, u64 &head) {
+            head = buffer.head.load(std::memory_order_acquire);
+
+            const u64 first = std::max(from, head > s_Capacity ? head - s_Capacity : 0);
+
+            std::vector<Event> events;
+            events.reserve(head - first);
+            for (u64 i = first; i < head; i++) {
+                events.push_back(buffer.events[i % s_Capacity]);
+            }
+
+            // The slot of index after is being written, it held index after - s_Capacity.
+            const u64 after = buffer.head.load(std::memory_order_acquire);
+            const u64 valid = after >= s_Capacity ? after - s_Capacity + 1 : 0;
+            if (valid > first) {
+                events.erase(events.begin(), events.begin() + static_cast<isize>(std::min(valid - first, head - first)));
+            }
+
+            return events;
+        }
+
+        void WriteEscaped(std::ostringstream &out, const std::string_view text) {
+            for (const char c: text) {
+                if (c == '"' || c == '\\') {
+                    out << '\\' << c;
+                } else if (static_cast<u8>(c) < 0x20) {
+                    out << ' ';
+                } else {
+                    out << c;
+                }
+            }
+        }
+    }
+
+    void Profiler::SetEnabled(const bool enabled) {
+        GetState().enabled.store(enabled, std::memory_order_relaxed);
+    }
+
+    bool Profiler::Enabled() {
+        return GetState().enabled.load(std::memory_order_relaxed);
+    }
+
+    void Profiler::SetThreadName(const std::string &name) {
+        ThreadBuffer &  buffer = LocalBuffer();
+        std::lock_guard lock(GetState().mutex);
+        buffer.name = name;
+    }
+
+    const char *Profiler::Intern(const std::string &name) {
+        State &         state = GetState();
+        std::lock_guard lock(state.mutex);
+
+        // Set nodes don't move, so the pointer stays valid as the set grows.
+        return state.interned.insert(name).first->c_str();
+    }
+
+    void Profiler::Record(const char *name, const u64 start, const u64 end) {
+        ThreadBuffer &buffer = LocalBuffer();
+        const u64     index  = buffer.head.load(std::memory_order_relaxed);
+
+        buffer.events[index % s_Capacity] = {.name = name, .start = start, .end = end};
+        buffer.head.store(index + 1, std::memory_order_release);
+    }
+
+    u64 Profiler::Now() {
+        const Clock::duration elapsed = Clock::now() - GetState().epoch;
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count();
+    }
+
+    void Profiler::EndFrame() {
+        State &         state = GetState();
+        const u64       now   = Now();
+        std::lock_guard lock(state.mutex);
+
+        // By name rather than pointer, the same literal may live at different addresses in different libraries.
+        std::unordered_map<std::string_view, ProfileEntry> entries;
+        for (const auto &buffer: state.buffers) {
+            u64 head = 0;
+            for (const Event &event: Snapshot(*buffer, buffer->summarized, head)) {
+                ProfileEntry &entry = entries[event.name];
+                entry.name          = event.name;
+                entry.milliseconds  += static_cast<f64>(event.end - event.start) / 1e6;
+                entry.calls++;
+            }
+
+            buffer->summarized = head;
+        }
+
+        FrameProfile &last = state.last;
+        last.frame++;
+        last.milliseconds = static_cast<f64>(now - state.frameStart) / 1e6;
+        last.entries.clear();
+        for (const ProfileEntry &entry: entries | std::views::values) {
+            last.entries.push_back(entry);
+        }
+
+        std::ranges::sort(last.entries, std::greater{}, &ProfileEntry::milliseconds);
+        state.frameStart = now;
+    }
+
+    FrameProfile Profiler::LastFrame() {
+        State &         state = GetState();
+        std::lock_guard lock(state.mutex);
+        return state.last;
+    }
+
+    bool Profiler::WriteChromeTrace(const std::filesystem::path &filePath) {
+        State &            state = GetState();
+        std::ostringstream out;
+        out << std::fixed << std::setprecision(3);
+
+        {
+            std::lock_guard lock(state.mutex);
+
+            out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+
+            bool first = true;
+            for (const auto &buffer: state.buffers) {
+                out << (first ? "" : ",") << "\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << buffer->id
+                    << ",\"args\":{\"name\":\"";
+                WriteEscaped(out, buffer->name);
+                out << "\"}}";
+                first = false;
+
+                // Complete events, timestamps and durations in microseconds.
+                u64 head = 0;
+                for (const Event &event: Snapshot(*buffer, 0, head)) {
+                    out << ",\n{\"name\":\"";
+                    WriteEscaped(out, event.name);
+                    out << "\",\"cat\":\"flock\",\"ph\":\"X\",\"pid\":1,\"tid\":" << buffer->id
+                        << ",\"ts\":" << static_cast<f64>(event.start) / 1e3
+                        << ",\"dur\":" << static_cast<f64>(event.end - event.start) / 1e3 << '}';
+                }
+            }
+
+            out << "\n]}\n";
+        }
+
+        if (!FileIo::WriteText(filePath, out.str())) {
+            LogErr("Profiler::WriteChromeTrace: Failed to write '{}'!", filePath.string());
+            return false;
+        }
+
+        return true;
+    }
+
+    ProfileScope::ProfileScope(const char *name) {
+        if (Profiler::Enabled()) {
+            m_Name  = name;
+            m_Start = Profiler::Now();
+        }
+    }
+
+    ProfileScope::~ProfileScope() {
+        if (m_Name) {
+            Profiler::Record(m_Name, m_Start, Profiler::Now());
+        }
+    }
+}
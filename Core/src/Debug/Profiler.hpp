@@ -0,0 +1,114 @@
+#ifndef FLK_PROFILER_HPP
+#define FLK_PROFILER_HPP
+
+#include <filesystem>
+#include <string>
+#include <vector>
+
+#include "Common.hpp"
+
+namespace Flock::Debug {
+    /**
+     * @struct ProfileEntry
+     * @brief The time spent in one scope name during a frame, summed over every thread.
+     */
+    struct FLK_API ProfileEntry {
+        const char *name         = nullptr;
+        f64         milliseconds = 0.0;
+        u32         calls        = 0;
+    };
+
+    /**
+     * @struct FrameProfile
+     * @brief A summary of the last frame, a resource of the world updated every frame.
+     */
+    struct FLK_API FrameProfile {
+        u64                       frame        = 0;
+        f64                       milliseconds = 0.0; // Wall time between the last two Profiler::EndFrame() calls.
+        std::vector<ProfileEntry> entries;            // Most expensive first.
+    };
+
+    /**
+     * @class Profiler
+     * @brief Records named CPU scopes into per-thread ring buffers, use it through FLK_PROFILE_SCOPE.
+     *
+     * Each thread only ever writes its own buffer, so recording takes no lock. Once a buffer is full, its oldest
+     * scopes are overwritten. Readers copy events and then drop the ones that were overwritten in the meantime.
+     */
+    class FLK_API Profiler {
+    public:
+        static constexpr usize s_BufferEvents = 1 << 16; // Per thread.
+
+        static void               SetEnabled(bool enabled);
+        [[nodiscard]] static bool Enabled();
+
+        /**
+         * @brief Names the calling thread in exported traces.
+         * @param name The thread name, copied.
+         */
+        static void SetThreadName(const std::string &name);
+
+        /**
+         * @brief Keeps a copy of a string for as long as the program runs, for scope names built at runtime.
+         * @return The stable copy, the same pointer for equal strings.
+         */
+        static const char *Intern(const std::string &name);
+
+        /**
+         * @brief Records a finished scope on the calling thread.
+         * @param name The scope name, must outlive the profiler, e.g. a literal or from Intern().
+         * @param start The start time, from Now().
+         * @param end The end time, from Now().
+         */
+        static void Record(const char *name, u64 start, u64 end);
+
+        /**
+         * @return Nanoseconds since the profiler was first used.
+         */
+        [[nodiscard]] static u64 Now();
+
+        /**
+         * @brief Summarizes the scopes finished since the last call, see LastFrame().
+         */
+        static void EndFrame();
+
+        [[nodiscard]] static FrameProfile LastFrame();
+
+        /**
+         * @brief Writes the recorded scopes as a Chrome trace (chrome://tracing, Perfetto or Tracy's importer).
+         * @param filePath The JSON file to write.
+         * @return true if successful; false otherwise.
+         */
+        static bool WriteChromeTrace(const std::filesystem::path &filePath);
+    };
+
+    /**
+     * @class ProfileScope
+     * @brief Records the time between its construction and destruction.
+     */
+    class FLK_API ProfileScope {
+        const char *m_Name  = nullptr;
+        u64         m_Start = 0;
+
+    public:
+        explicit ProfileScope(const char *name);
+        ~ProfileScope();
+
+        ProfileScope(const ProfileScope &other)            = delete;
+        ProfileScope &operator=(const ProfileScope &other) = delete;
+    };
+}
+
+#ifdef FLK_PROFILE_ENABLED
+
+#define FLK_PROFILE_CONCAT_IMPL(a, b) a##b
+#define FLK_PROFILE_CONCAT(a, b)      FLK_PROFILE_CONCAT_IMPL(a, b)
+#define FLK_PROFILE_SCOPE(name)       Flock::Debug::ProfileScope FLK_PROFILE_CONCAT(flkProfileScope, __LINE__)(name)
+
+#else
+
+#define FLK_PROFILE_SCOPE(name) ((void) 0)
+
+#endif
+
+#endif //FLK_PROFILER_HPP
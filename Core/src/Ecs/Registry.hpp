@@ -203,7 +203,7 @@ namespace Flock::Ecs {
          * @return true if the component is enabled; false otherwise.
          */
         template<typename T>
-        bool IsEnabled(Entity entity) {
+        bool IsEnabled(Entity entity) const {
             if constexpr (std::is_same_v<T, Entity>) {
                 return true;
             } else {
@@ -217,7 +217,7 @@ namespace Flock::Ecs {
          * @return true if one of the components is enabled; false otherwise.
          */
         template<typename... Args>
-        bool AnyEnabled(const Entity entity) {
+        bool AnyEnabled(const Entity entity) const {
             return (IsEnabled<Args>(entity) || ...);
         }
 
@@ -227,7 +227,7 @@ namespace Flock::Ecs {
          * @return true if the components are enabled; false otherwise.
          */
         template<typename... Args>
-        bool AllEnabled(const Entity entity) {
+        bool AllEnabled(const Entity entity) const {
             return (IsEnabled<Args>(entity) && ...);
         }
 
@@ -304,6 +304,66 @@ namespace Flock::Ecs {
             return &entity;
         }
 
+        /**
+         * @brief Retrieves a read-only pointer to the component data of an entity, without marking it as modified.
+         * @tparam T The component type.
+         * @param entity A handle to the entity.
+         * @return A pointer to the component data if it exists; nullptr otherwise.
+         */
+        template<typename T>
+            requires (!std::same_as<T, Entity>)
+        const T *Get(Entity entity) const {
+            if (!Has<T>(entity)) {
+                return nullptr;
+            }
+
+            return std::as_const(*Storage<T>()).Get(entity.id);
+        }
+
+        /**
+         * @brief Starts or stops recording the changes to a component type, see TakeChanges().
+         * @tparam T The component type.
+         * @param tracking Whether to record changes or not.
+         */
+        template<typename T>
+        void TrackChanges(const bool tracking = true) {
+            if (!IsRegistered<T>()) {
+                Register<T>();
+            }
+
+            Storage<T>()->SetTracking(tracking);
+        }
+
+        /**
+         * @brief Retrieves the changes to a component type since the last call.
+         *
+         * Every mutable access through Get() or ForEach() counts as a modification, use the const Get() to read
+         * without one. Writes through a pointer kept from an earlier access need MarkModified().
+         *
+         * @tparam T The component type.
+         * @return The recorded changes, empty if the type isn't tracked.
+         */
+        template<typename T>
+        StorageChanges TakeChanges() {
+            if (!IsRegistered<T>()) {
+                return {};
+            }
+
+            return Storage<T>()->TakeChanges();
+        }
+
+        /**
+         * @brief Marks a component as modified, if its type is tracked.
+         * @tparam T The component type.
+         * @param entity A handle to the entity.
+         */
+        template<typename T>
+        void MarkModified(const Entity entity) {
+            if (IsRegistered<T>()) {
+                Storage<T>()->MarkModified(entity.id);
+            }
+        }
+
         /**
          * @brief Adds a component to an entity, fails if the component already exists.
          * @tparam T The component type.
@@ -437,6 +497,39 @@ namespace Flock::Ecs {
             }
         }
 
+        /**
+         * @brief Invokes a callback for each entity with read-only components, without marking them as modified.
+         * @tparam First The smallest storage.
+         * @tparam Args The component types.
+         * @tparam F The callback type.
+         * @param callback The callback to execute.
+         * @param includeDisabled Whether to include disabled components or not.
+         */
+        template<typename First, typename... Args, typename F>
+            requires (!std::same_as<First, Entity>)
+        void ForEach(F &&callback, bool includeDisabled = false) const {
+            if (!m_Storages.contains(GetTypeId<First>())) {
+                return;
+            }
+
+            const auto &storage = m_Storages.at(GetTypeId<First>());
+            for (const EntityId id: storage->Dense()) {
+                auto maybeEntity = EntityWithId(id);
+                if (!maybeEntity) {
+                    continue;
+                }
+
+                Entity entity = maybeEntity.value();
+                if (HasAll<Args...>(entity) && AllEnabled<Args...>(entity) && !includeDisabled) {
+                    callback(*Get<First>(entity), *Get<Args>(entity)...);
+                }
+
+                if (HasAll<Args...>(entity) && includeDisabled) {
+                    callback(*Get<First>(entity), *Get<Args>(entity)...);
+                }
+            }
+        }
+
         /**
          * @brief Invokes a callback for each entity with its components.
          * @tparam First The smallest storage.
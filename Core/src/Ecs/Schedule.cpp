@@ -1,5 +1,7 @@
 #include "Schedule.hpp"
 
+#include "Debug/Profiler.hpp"
+
 namespace Flock {
 namespace Ecs {
 class World;
@@ -8,17 +10,29 @@ class World;
 
 namespace Flock::Ecs {
     void Schedule::Execute(const Stage stage, World &world) {
-        for (auto &system: m_Systems[stage]) {
-            system(world);
+        std::vector<System> &systems = m_Systems[stage];
+
+        for (usize i = 0; i < systems.size(); i++) {
+            FLK_PROFILE_SCOPE(m_Names[stage][i]);
+            systems[i](world);
         }
     }
 
-    void Schedule::AddSystem(const Stage stage, const System &system) {
-        m_Systems[stage].push_back(system);
+    void Schedule::AddSystem(const Stage stage, const System &system, const std::string &name) {
+        std::vector<System> &systems = m_Systems[stage];
+
+        std::string scope = name;
+        if (scope.empty()) {
+            scope = (stage == Stage::Startup ? "Startup system " : "Update system ") + std::to_string(systems.size());
+        }
+
+        systems.push_back(system);
+        m_Names[stage].push_back(Debug::Profiler::Intern(scope));
     }
 
     void Schedule::PopSystem(const Stage stage) {
         m_Systems[stage].pop_back();
+        m_Names[stage].pop_back();
     }
 
     std::vector<System> Schedule::Systems(const Stage stage) {
@@ -27,5 +41,6 @@ namespace Flock::Ecs {
 
     void Schedule::Clear() {
         m_Systems.clear();
+        m_Names.clear();
     }
 }
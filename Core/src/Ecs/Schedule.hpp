@@ -2,6 +2,7 @@
 #define FLK_SCHEDULE_HPP
 
 #include <functional>
+#include <string>
 #include <unordered_map>
 #include <vector>
 
@@ -25,7 +26,8 @@ namespace Flock::Ecs {
      * @brief Contains the ECS systems.
      */
     class FLK_API Schedule {
-        std::unordered_map<Stage, std::vector<System> > m_Systems;
+        std::unordered_map<Stage, std::vector<System> >       m_Systems;
+        std::unordered_map<Stage, std::vector<const char *> > m_Names; // Profiler scope names, per system.
 
     public:
         /**
@@ -39,8 +41,9 @@ namespace Flock::Ecs {
          * @brief Adds a system to a stage.
          * @param stage The stage.
          * @param system The system.
+         * @param name The name of the system in profiles, numbered by its stage and position if empty.
          */
-        void AddSystem(Stage stage, const System &system);
+        void AddSystem(Stage stage, const System &system, const std::string &name = "");
 
         /**
          * Adds multiple systems to a stage; executed in order.
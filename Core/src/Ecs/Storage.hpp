@@ -1,6 +1,9 @@
 #ifndef FLK_STORAGE_HPP
 #define FLK_STORAGE_HPP
 
+#include <utility>
+#include <vector>
+
 #include "Common.hpp"
 #include "Entity.hpp"
 #include "Serial/Archive.hpp"
@@ -12,6 +15,18 @@ namespace Flock::Ecs {
 
     FLK_ARCHIVE(ComponentConfig, enabled)
 
+    /**
+     * @struct StorageChanges
+     * @brief The entities whose component was added, removed or accessed mutably since the last TakeChanges().
+     *
+     * An entity can be in several lists, removals should be handled first.
+     */
+    struct StorageChanges {
+        std::vector<EntityId> added    = {};
+        std::vector<EntityId> removed  = {};
+        std::vector<EntityId> modified = {};
+    };
+
     class IStorage {
     public:
         virtual ~IStorage() = default;
@@ -36,6 +51,9 @@ namespace Flock::Ecs {
         std::vector<EntityId>        m_Dense;
         std::vector<T>               m_Data;
         std::vector<ComponentConfig> m_Configs;
+        std::vector<u8>              m_Modified; // Per entity ID, whether it's already in m_Changes.modified.
+        StorageChanges               m_Changes;
+        bool                         m_Tracking = false;
 
     public:
         /**
@@ -51,9 +69,14 @@ namespace Flock::Ecs {
             if (m_Sparse[id] != FLK_INVALID) {
                 m_Data[m_Sparse[id]]    = std::move(element);
                 m_Configs[m_Sparse[id]] = {};
+                MarkModified(id);
                 return;
             }
 
+            if (m_Tracking) {
+                m_Changes.added.push_back(id);
+            }
+
             m_Sparse[id] = m_Dense.size();
             m_Dense.push_back(id);
             m_Data.push_back(std::move(element));
@@ -77,6 +100,10 @@ namespace Flock::Ecs {
             usize       idx     = m_Sparse[id];
             const usize lastIdx = m_Dense.size() - 1;
 
+            if (m_Tracking) {
+                m_Changes.removed.push_back(id);
+            }
+
             // Remove
             m_Sparse[id] = FLK_INVALID;
 
@@ -108,7 +135,7 @@ namespace Flock::Ecs {
         }
 
         /**
-         * @brief Retrieves component data at a specified entity ID.
+         * @brief Retrieves component data at a specified entity ID, marking it as modified.
          * @param id The entity ID.
          * @return The component data if found; nullptr otherwise.
          */
@@ -117,6 +144,20 @@ namespace Flock::Ecs {
                 return nullptr;
             }
 
+            MarkModified(id);
+            return &m_Data[m_Sparse[id]];
+        }
+
+        /**
+         * @brief Retrieves component data at a specified entity ID without marking it as modified.
+         * @param id The entity ID.
+         * @return The component data if found; nullptr otherwise.
+         */
+        const T *Get(const EntityId id) const {
+            if (!Has(id)) {
+                return nullptr;
+            }
+
             return &m_Data[m_Sparse[id]];
         }
 
@@ -145,6 +186,7 @@ namespace Flock::Ecs {
             }
 
             m_Configs[m_Sparse[id]].enabled = enabled;
+            MarkModified(id);
             return true;
         }
 
@@ -157,6 +199,10 @@ namespace Flock::Ecs {
             for (auto &cfg: m_Configs) {
                 cfg.enabled = enabled;
             }
+
+            for (const EntityId id: m_Dense) {
+                MarkModified(id);
+            }
         }
 
         /**
@@ -179,12 +225,75 @@ namespace Flock::Ecs {
          * @brief Clears the storage.
          */
         void Clear() override {
+            if (m_Tracking) {
+                m_Changes.removed.insert(m_Changes.removed.end(), m_Dense.begin(), m_Dense.end());
+            }
+
             m_Sparse.clear();
             m_Dense.clear();
             m_Data.clear();
         }
 
+        /**
+         * @brief Starts or stops recording changes, components already stored count as added.
+         * @param tracking Whether to record changes or not.
+         */
+        void SetTracking(const bool tracking) {
+            if (tracking == m_Tracking) {
+                return;
+            }
+
+            TakeChanges();
+            m_Tracking = tracking;
+
+            if (tracking) {
+                m_Changes.added = m_Dense;
+            }
+        }
+
+        [[nodiscard]] bool IsTracking() const {
+            return m_Tracking;
+        }
+
+        /**
+         * @brief Marks the component at a specified entity ID as modified, if changes are being tracked.
+         * @param id The entity ID.
+         */
+        void MarkModified(const EntityId id) {
+            if (!m_Tracking || !Has(id)) {
+                return;
+            }
+
+            if (id >= m_Modified.size()) {
+                m_Modified.resize(id + 1, 0);
+            }
+
+            if (m_Modified[id]) {
+                return;
+            }
+
+            m_Modified[id] = 1;
+            m_Changes.modified.push_back(id);
+        }
+
+        /**
+         * @brief Retrieves the changes recorded since the last call and starts recording anew.
+         * @return The recorded changes.
+         */
+        StorageChanges TakeChanges() {
+            for (const EntityId id: m_Changes.modified) {
+                m_Modified[id] = 0;
+            }
+
+            return std::exchange(m_Changes, {});
+        }
+
         void Archive(Serial::IArchive &archive) {
+            // The archive may replace every component, so it counts as removing and adding all of them.
+            if (m_Tracking) {
+                m_Changes.removed.insert(m_Changes.removed.end(), m_Dense.begin(), m_Dense.end());
+            }
+
             usize count = m_Dense.size();
             archive.BeginArray(NameOf(T{}), count);
 
@@ -211,6 +320,10 @@ namespace Flock::Ecs {
 
                 m_Sparse[id] = i;
             }
+
+            if (m_Tracking) {
+                m_Changes.added.insert(m_Changes.added.end(), m_Dense.begin(), m_Dense.end());
+            }
         }
     };
 }
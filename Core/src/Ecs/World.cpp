@@ -7,16 +7,21 @@
 #include "App.hpp"
 #include "Audio/AudioListener.hpp"
 #include "Audio/AudioSource.hpp"
+#include "Debug/Profiler.hpp"
 #include "Event/EventRegistry.hpp"
 #include "FileIo/File.hpp"
 #include "Graphics/Camera.hpp"
 #include "Graphics/Light.hpp"
 #include "Graphics/ModelRenderer.hpp"
+#include "Graphics/Occluder.hpp"
+#include "Graphics/OcclusionBuffer.hpp"
+#include "Graphics/RenderStats.hpp"
 #include "Graphics/Skybox.hpp"
 #include "Graphics/SpriteRenderer.hpp"
 #include "Gui/Box.hpp"
 #include "Gui/Button.hpp"
 #include "Gui/Image.hpp"
+#include "Gui/StatsOverlay.hpp"
 #include "Gui/Text.hpp"
 #include "Input/Input.hpp"
 #include "Math/Transform.hpp"
@@ -43,6 +48,10 @@ namespace Flock::Ecs {
         InsertResource<Graphics::Camera>();
         InsertResource<Graphics::AmbientLight>();
         InsertResource<Graphics::Skybox>();
+        InsertResource<Graphics::RenderStats>();
+        InsertResource<Graphics::OcclusionConfig>();
+        InsertResource<Debug::FrameProfile>();
+        InsertResource<Gui::StatsOverlay>();
         InsertResource<Audio::AudioListener>();
         InsertResource<Application>();
         InsertResource<Event::EventRegistry>();
@@ -52,6 +61,7 @@ namespace Flock::Ecs {
         Registry().Register<Gui::RectTransform>();
         Registry().Register<Graphics::SpriteRenderer>();
         Registry().Register<Graphics::ModelRenderer>();
+        Registry().Register<Graphics::Occluder>();
         Registry().Register<Graphics::PointLight>();
         Registry().Register<Graphics::DirectionalLight>();
         Registry().Register<Graphics::Light>();
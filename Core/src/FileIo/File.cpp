@@ -56,4 +56,16 @@ namespace Flock::FileIo {
 
         return buffer;
     }
+
+    bool WriteBytes(const std::filesystem::path &filePath, const std::vector<u8> &bytes) {
+        std::ofstream file(filePath, std::ios::binary);
+
+        if (!file.is_open()) {
+            Debug::LogErr("FileIo::WriteBytes: Error creating file '{}'", filePath.string());
+            return false;
+        }
+
+        file.write(reinterpret_cast<const char *>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+        return file.good();
+    }
 }
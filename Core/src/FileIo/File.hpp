@@ -13,6 +13,7 @@ namespace Flock::FileIo {
     bool FLK_API                       WriteText(const std::filesystem::path &filePath, const std::string &text);
 
     std::optional<std::vector<u8>> FLK_API ReadBytes(const std::filesystem::path& filePath);
+    bool FLK_API                           WriteBytes(const std::filesystem::path &filePath, const std::vector<u8> &bytes);
 }
 
 #endif //FLK_FILE_HPP
@@ -1,13 +1,73 @@
 #include "Image.hpp"
 
 #include <../../vendor/stbi/stbi.h>
+#include <algorithm>
+#include <array>
 #include <string>
+#include <vector>
 
 #include "Debug/Log.hpp"
+#include "FileIo/File.hpp"
 #include "Math/Vector.hpp"
 #include "Memory/Buffer.hpp"
 
 namespace Flock::FileIo {
+    namespace {
+        u32 Crc32(const u8 *data, const usize size, u32 crc = 0) {
+            static const std::array<u32, 256> table = [] {
+                std::array<u32, 256> entries = {};
+                for (u32 i = 0; i < 256; i++) {
+                    u32 c = i;
+                    for (u32 k = 0; k < 8; k++) {
+                        c = c & 1 ? 0xEDB88320 ^ (c >> 1) : c >> 1;
+                    }
+
+                    entries[i] = c;
+                }
+
+                return entries;
+            }();
+
+            crc = ~crc;
+            for (usize i = 0; i < size; i++) {
+                crc = table[(crc ^ data[i]) & 0xFF] ^ (crc >> 8);
+            }
+
+            return ~crc;
+        }
+
+        void PushU32(std::vector<u8> &bytes, const u32 value) {
+            bytes.push_back(static_cast<u8>(value >> 24));
+            bytes.push_back(static_cast<u8>(value >> 16));
+            bytes.push_back(static_cast<u8>(value >> 8));
+            bytes.push_back(static_cast<u8>(value));
+        }
+
+        void PushChunk(std::vector<u8> &bytes, const char *type, const std::vector<u8> &data) {
+            PushU32(bytes, static_cast<u32>(data.size()));
+
+            const usize start = bytes.size();
+            bytes.insert(bytes.end(), type, type + 4);
+            bytes.insert(bytes.end(), data.begin(), data.end());
+
+            PushU32(bytes, Crc32(bytes.data() + start, bytes.size() - start));
+        }
+
+        u8 PngColorType(const Graphics::ImageFormat format) {
+            switch (format) {
+                case Graphics::ImageFormat::R:
+                    return 0;
+                case Graphics::ImageFormat::Rg:
+                    return 4;
+                case Graphics::ImageFormat::Rgb:
+                    return 2;
+                case Graphics::ImageFormat::Rgba:
+                default:
+                    return 6;
+            }
+        }
+    }
+
     Graphics::Image ReadImage(const std::filesystem::path &filePath) {
         i32   width, height, channels;
         void *data = stbi_load(filePath.string().c_str(), &width, &height, &channels, 0);
@@ -43,4 +103,67 @@ namespace Flock::FileIo {
 
         return image;
     }
+
+    bool WriteImage(const std::filesystem::path &filePath, const Graphics::Image &image) {
+        const usize channels = Graphics::ChannelCount(image.format);
+        const usize row      = static_cast<usize>(image.size.x) * channels;
+        const auto  pixels   = image.data.Vector<u8>();
+
+        if (image.size.x == 0 || image.size.y == 0 || pixels.size() < row * image.size.y) {
+            Debug::LogErr("FileIo::WriteImage: Invalid image for '{}'!", filePath.string());
+            return false;
+        }
+
+        // Every row starts with filter type 0, i.e. unfiltered.
+        std::vector<u8> raw;
+        raw.reserve((row + 1) * image.size.y);
+        for (usize y = 0; y < image.size.y; y++) {
+            raw.push_back(0);
+            raw.insert(raw.end(), pixels.begin() + y * row, pixels.begin() + (y + 1) * row);
+        }
+
+        // A zlib stream of stored deflate blocks, trading size for not needing a compressor.
+        std::vector<u8> zlib = {0x78, 0x01};
+        u32             a    = 1;
+        u32             b    = 0;
+        for (usize offset = 0; offset < raw.size() || offset == 0;) {
+            const usize length = std::min<usize>(raw.size() - offset, 0xFFFF);
+            const bool  last   = offset + length == raw.size();
+
+            zlib.push_back(last ? 1 : 0);
+            zlib.push_back(static_cast<u8>(length));
+            zlib.push_back(static_cast<u8>(length >> 8));
+            zlib.push_back(static_cast<u8>(~length));
+            zlib.push_back(static_cast<u8>(~length >> 8));
+            zlib.insert(zlib.end(), raw.begin() + offset, raw.begin() + offset + length);
+
+            for (usize i = offset; i < offset + length; i++) {
+                a = (a + raw[i]) % 65521;
+                b = (b + a) % 65521;
+            }
+
+            offset += length;
+            if (last) {
+                break;
+            }
+        }
+
+        PushU32(zlib, b << 16 | a);
+
+        std::vector<u8> header;
+        PushU32(header, image.size.x);
+        PushU32(header, image.size.y);
+        header.push_back(8); // Bits per channel.
+        header.push_back(PngColorType(image.format));
+        header.push_back(0); // Compression, filter and interlace methods.
+        header.push_back(0);
+        header.push_back(0);
+
+        std::vector<u8> bytes = {0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n'};
+        PushChunk(bytes, "IHDR", header);
+        PushChunk(bytes, "IDAT", zlib);
+        PushChunk(bytes, "IEND", {});
+
+        return WriteBytes(filePath, bytes);
+    }
 }
@@ -8,6 +8,14 @@
 
 namespace Flock::FileIo {
     Graphics::Image FLK_API ReadImage(const std::filesystem::path& filePath);
+
+    /**
+     * @brief Writes an image as an uncompressed PNG, readable by ReadImage().
+     * @param filePath The PNG file to write.
+     * @param image The image, top row first.
+     * @return true if successful; false otherwise.
+     */
+    bool FLK_API WriteImage(const std::filesystem::path &filePath, const Graphics::Image &image);
 }
 
 #endif //FLK_FILEIO_IMAGE_HPP
\ No newline at end of file
@@ -3,10 +3,12 @@
 #include <assimp/Importer.hpp>
 #include <assimp/postprocess.h>
 #include <assimp/scene.h>
+#include <cstring>
 #include <string>
 
 #include "Math/Color.hpp"
 #include "Debug/Log.hpp"
+#include "Graphics/MeshOptimizer.hpp"
 #include "assimp/color4.h"
 #include "assimp/material.h"
 #include "assimp/material.inl"
@@ -16,7 +18,7 @@
 namespace Flock::FileIo {
     static constexpr f32 s_ImportScale = 1.0F;
 
-    std::vector<MeshData> ReadModelMeshes(const std::filesystem::path &filePath) {
+    std::vector<MeshData> ReadModelMeshes(const std::filesystem::path &filePath, const bool optimize) {
         Assimp::Importer importer;
 
         u32 flags = aiProcess_Triangulate |
@@ -84,7 +86,12 @@ namespace Flock::FileIo {
                 }
             }
 
-            meshes.push_back({.data = Graphics::MeshData{vertices, indices}, .materialIndex = mesh->mMaterialIndex});
+            Graphics::MeshData data = {vertices, indices};
+            if (optimize) {
+                Graphics::OptimizeMesh(data);
+            }
+
+            meshes.push_back({.data = std::move(data), .materialIndex = mesh->mMaterialIndex});
         }
 
         return meshes;
@@ -129,6 +136,19 @@ namespace Flock::FileIo {
             material->Get(AI_MATKEY_METALLIC_FACTOR, outputMaterial.metallic);
             material->Get(AI_MATKEY_ROUGHNESS_FACTOR, outputMaterial.roughness);
 
+            // glTF alpha modes, other formats only get sorted as transparent when they are see-through.
+            aiString alphaMode;
+            if (material->Get("$mat.gltf.alphaMode", 0, 0, alphaMode) == AI_SUCCESS) {
+                if (std::strcmp(alphaMode.C_Str(), "MASK") == 0) {
+                    outputMaterial.queue = Graphics::RenderQueue::AlphaTested;
+                    material->Get("$mat.gltf.alphaCutoff", 0, 0, outputMaterial.alphaCutoff);
+                } else if (std::strcmp(alphaMode.C_Str(), "BLEND") == 0) {
+                    outputMaterial.queue = Graphics::RenderQueue::Transparent;
+                }
+            } else if (aiColor.a < 1.0F) {
+                outputMaterial.queue = Graphics::RenderQueue::Transparent;
+            }
+
             materials.push_back(outputMaterial);
         }
 
@@ -15,7 +15,13 @@ namespace Flock::FileIo {
         usize              materialIndex = 0;
     };
 
-    FLK_API std::vector<MeshData>           ReadModelMeshes(const std::filesystem::path &filePath);
+    /**
+     * @brief Reads the meshes of a model file.
+     * @param filePath The model path.
+     * @param optimize Whether to reorder indices and vertices for the vertex cache, overdraw and vertex fetch.
+     * @return The meshes, empty on failure.
+     */
+    FLK_API std::vector<MeshData>           ReadModelMeshes(const std::filesystem::path &filePath, bool optimize = true);
     FLK_API std::vector<Graphics::Material> ReadModelMaterials(const std::filesystem::path &filePath);
 }
 
@@ -1,9 +1,12 @@
 #include "Pipeline.hpp"
 
+#include <algorithm>
+#include <set>
 #include <sstream>
 #include <string>
 
 #include "File.hpp"
+#include "Debug/Log.hpp"
 #include "Graphics/Shader.hpp"
 
 namespace Flock::FileIo {
@@ -13,15 +16,105 @@ namespace Flock::FileIo {
     static constexpr auto s_TangentPrepend   = "layout(location = 3) ";
     static constexpr auto s_BitangentPrepend = "layout(location = 4) ";
 
-    std::optional<Graphics::Pipeline> ReadPipeline(const std::filesystem::path &filePath) {
+    namespace {
+        using PathList = std::vector<std::filesystem::path>;
+
+        // The file name of an include directive, empty if the line isn't one.
+        std::string IncludeName(const std::string &line) {
+            const usize start = line.find_first_not_of(" \t");
+            if (start == std::string::npos || line.compare(start, 8, "#include") != 0) {
+                return {};
+            }
+
+            const usize open  = line.find('"', start + 8);
+            const usize close = open == std::string::npos ? open : line.find('"', open + 1);
+            if (close == std::string::npos) {
+                return {};
+            }
+
+            return line.substr(open + 1, close - open - 1);
+        }
+
+        bool ExpandIncludes(
+            const std::filesystem::path &   filePath,
+            std::string &                   out,
+            PathList &                      stack,
+            std::set<std::filesystem::path> &included
+        ) {
+            std::error_code             error;
+            const std::filesystem::path path = std::filesystem::weakly_canonical(filePath, error);
+
+            if (std::ranges::find(stack, path) != stack.end()) {
+                Debug::LogErr("ReadPipeline: '{}' includes itself!", filePath.string());
+                return false;
+            }
+
+            // Include guards by default, a shared header pulled in by two files is only pasted once.
+            if (!included.insert(path).second) {
+                return true;
+            }
+
+            const std::optional<std::string> text = ReadText(filePath);
+            if (!text) {
+                return false;
+            }
+
+            stack.push_back(path);
+
+            std::istringstream stream(text.value());
+            std::string        line;
+            while (std::getline(stream, line)) {
+                const std::string name = IncludeName(line);
+                if (name.empty()) {
+                    out += line + '\n';
+                    continue;
+                }
+
+                if (!ExpandIncludes(filePath.parent_path() / name, out, stack, included)) {
+                    Debug::LogErr("ReadPipeline: Failed to include '{}' from '{}'!", name, filePath.string());
+                    return false;
+                }
+            }
+
+            stack.pop_back();
+            return true;
+        }
+
+        void DefineKeywords(std::string &source, const std::vector<std::string> &keywords) {
+            if (keywords.empty()) {
+                return;
+            }
+
+            std::string defines;
+            for (const std::string &keyword: keywords) {
+                defines += "#define " + keyword + '\n';
+            }
+
+            // GLSL wants #version before anything else.
+            usize at = 0;
+            if (const usize version = source.find("#version"); version != std::string::npos) {
+                const usize end = source.find('\n', version);
+                at              = end == std::string::npos ? source.size() : end + 1;
+            }
+
+            source.insert(at, defines);
+        }
+    }
+
+    std::optional<PipelineSource> PreprocessPipeline(
+        const std::filesystem::path &   filePath,
+        const std::vector<std::string> &keywords
+    ) {
         using namespace Flock::Graphics;
 
-        std::optional<std::string> result = ReadText(filePath);
-        if (!result.has_value()) {
+        std::string                     expanded;
+        PathList                        stack;
+        std::set<std::filesystem::path> included;
+        if (!ExpandIncludes(filePath, expanded, stack, included)) {
             return std::nullopt;
         }
 
-        std::istringstream text(result.value());
+        std::istringstream text(expanded);
 
         std::string vertex;
         std::string fragment;
@@ -74,13 +167,27 @@ namespace Flock::FileIo {
             }
         }
 
-        auto vertShader = Shader::Create(VertexShader, vertex);
-        auto fragShader = Shader::Create(FragmentShader, fragment);
-        if (!vertShader || !fragShader) {
+        // Sorted, so the same set of keywords always gives the same sources.
+        std::vector<std::string> defines = keywords;
+        std::ranges::sort(defines);
+        defines.erase(std::ranges::unique(defines).begin(), defines.end());
+
+        DefineKeywords(vertex, defines);
+        DefineKeywords(fragment, defines);
+
+        return PipelineSource{.vertex = std::move(vertex), .fragment = std::move(fragment)};
+    }
+
+    std::optional<Graphics::Pipeline> ReadPipeline(
+        const std::filesystem::path &   filePath,
+        const std::vector<std::string> &keywords
+    ) {
+        const std::optional<PipelineSource> source = PreprocessPipeline(filePath, keywords);
+        if (!source) {
             return std::nullopt;
         }
 
-        auto pipeline = Pipeline::Create(vertShader.value(), fragShader.value());
-        return pipeline;
+        // Keyed by the preprocessed sources, editing the file or the preprocessing both miss the cache.
+        return Graphics::Pipeline::FromSource(source->vertex, source->fragment);
     }
 }
@@ -3,12 +3,41 @@
 
 #include <filesystem>
 #include <optional>
+#include <string>
+#include <vector>
 
 #include "Graphics/Pipeline.hpp"
 #include "Common.hpp"
 
 namespace Flock::FileIo {
-    std::optional<Graphics::Pipeline> FLK_API ReadPipeline(const std::filesystem::path &filePath);
+    /**
+     * @struct PipelineSource
+     * @brief The preprocessed shader sources of a pipeline file.
+     */
+    struct FLK_API PipelineSource {
+        std::string vertex;
+        std::string fragment;
+    };
+
+    /**
+     * @brief Splits a pipeline file into its shaders, resolving includes and defining keywords.
+     *
+     * `#include "file"` is replaced by the file, relative to the including one and only once per pipeline. Each
+     * keyword becomes a `#define` right after the `#version` line.
+     *
+     * @param filePath The pipeline file.
+     * @param keywords The keywords to define, order and duplicates don't matter.
+     * @return The sources if successful; std::nullopt otherwise.
+     */
+    std::optional<PipelineSource> FLK_API PreprocessPipeline(
+        const std::filesystem::path &   filePath,
+        const std::vector<std::string> &keywords = {}
+    );
+
+    std::optional<Graphics::Pipeline> FLK_API ReadPipeline(
+        const std::filesystem::path &   filePath,
+        const std::vector<std::string> &keywords = {}
+    );
 }
 
-#endif //FLK_FILEIO_PIPELINE_HPP
\ No newline at end of file
+#endif //FLK_FILEIO_PIPELINE_HPP
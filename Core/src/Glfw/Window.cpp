@@ -1,5 +1,8 @@
 #include "Window.hpp"
 
+#include <cstdlib>
+
+#include "Debug/Log.hpp"
 #include "Input/Input.hpp"
 #include "glad/glad.h"
 
@@ -7,6 +10,48 @@ namespace Flock::Glfw {
     static constexpr i32 s_OpenGlVersionMajor = 3;
     static constexpr i32 s_OpenGlVersionMinor = 3;
 
+    // Only matters before GLFW is initialized, i.e. for the first window.
+    static void SelectPlatform(const WindowConfig &config) {
+#if defined(GLFW_PLATFORM_NULL) && defined(__linux__)
+        const char *x11     = std::getenv("DISPLAY");
+        const char *wayland = std::getenv("WAYLAND_DISPLAY");
+        const bool  display = (x11 && *x11) || (wayland && *wayland);
+
+        // The null platform needs no display at all, see CreateNullContext() for its context.
+        glfwInitHint(GLFW_PLATFORM, config.headless && !display ? GLFW_PLATFORM_NULL : GLFW_ANY_PLATFORM);
+#endif
+    }
+
+    static GLFWwindow *CreateGlfwWindow(const WindowConfig &config) {
+        return glfwCreateWindow(
+            static_cast<i32>(config.size.x),
+            static_cast<i32>(config.size.y),
+            config.title.c_str(),
+            nullptr,
+            nullptr
+        );
+    }
+
+    // The null platform's native context is OSMesa, which Mesa 25.1 removed. Surfaceless EGL is tried first.
+    static GLFWwindow *CreateNullContext(const WindowConfig &config) {
+        glfwWindowHint(GLFW_CONTEXT_CREATION_API, GLFW_EGL_CONTEXT_API);
+        GLFWwindow *window = CreateGlfwWindow(config);
+
+        if (window == nullptr) {
+            glfwWindowHint(GLFW_CONTEXT_CREATION_API, GLFW_OSMESA_CONTEXT_API);
+            window = CreateGlfwWindow(config);
+        }
+
+        glfwWindowHint(GLFW_CONTEXT_CREATION_API, GLFW_NATIVE_CONTEXT_API);
+
+        if (window == nullptr) {
+            Debug::LogErr("Window::Create: No headless context without a display, "
+                "needs EGL with EGL_MESA_platform_surfaceless or libOSMesa!");
+        }
+
+        return window;
+    }
+
     void PollEvents() {
         glfwPollEvents();
     }
@@ -21,6 +66,7 @@ namespace Flock::Glfw {
 
     std::optional<Window> Window::Create(const WindowConfig &config) {
         if (s_WindowCount == 0) {
+            SelectPlatform(config);
             if (!InitGlfw()) {
                 return std::nullopt;
             }
@@ -29,20 +75,23 @@ namespace Flock::Glfw {
         glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, s_OpenGlVersionMajor);
         glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, s_OpenGlVersionMinor);
         glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
-        glfwWindowHint(GLFW_SAMPLES, static_cast<i32>(config.samplesPerPixel));
         glfwWindowHint(GLFW_RESIZABLE, GLFW_FALSE);
 
+        // Headless windows are never presented, frames go to an offscreen framebuffer instead.
+        glfwWindowHint(GLFW_VISIBLE, config.headless ? GLFW_FALSE : GLFW_TRUE);
+        glfwWindowHint(GLFW_SAMPLES, config.headless ? 0 : static_cast<i32>(config.samplesPerPixel));
+
 #ifdef __APPLE__
         glfwWindowHint(GLFW_OPENGL_FORWARD_COMPAT, GL_TRUE);
 #endif
 
-        GLFWwindow *windowPtr = glfwCreateWindow(
-            static_cast<i32>(config.size.x),
-            static_cast<i32>(config.size.y),
-            config.title.c_str(),
-            nullptr,
-            nullptr
-        );
+#ifdef GLFW_PLATFORM_NULL
+        GLFWwindow *windowPtr = glfwGetPlatform() == GLFW_PLATFORM_NULL
+                                    ? CreateNullContext(config)
+                                    : CreateGlfwWindow(config);
+#else
+        GLFWwindow *windowPtr = CreateGlfwWindow(config);
+#endif
 
         if (windowPtr == nullptr) {
             if (s_WindowCount == 0) {
@@ -55,7 +104,7 @@ namespace Flock::Glfw {
         GLFWwindow *currentWindow = glfwGetCurrentContext();
 
         glfwMakeContextCurrent(windowPtr);
-        glfwSwapInterval(config.vsync);
+        glfwSwapInterval(config.vsync && !config.headless);
 
         if (gladLoadGLLoader(reinterpret_cast<GLADloadproc>(glfwGetProcAddress)) == 0) {
             if (s_WindowCount == 0) {
@@ -196,6 +245,18 @@ namespace Flock::Glfw {
         glfwMakeContextCurrent(m_GlfwWindowPtr);
     }
 
+    void Window::BindContext() const {
+        if (m_GlfwWindowPtr == nullptr) {
+            return;
+        }
+
+        glfwMakeContextCurrent(m_GlfwWindowPtr);
+    }
+
+    void Window::UnbindContext() {
+        glfwMakeContextCurrent(nullptr);
+    }
+
     void Window::SwapBuffers() const {
         if (m_GlfwWindowPtr == nullptr) {
             return;
@@ -72,6 +72,12 @@ namespace Flock::Glfw {
         Vector2u    size            = {800, 600};
         u32         samplesPerPixel = 4;
         bool        vsync           = true;
+
+        /**
+         * Hides the window and renders offscreen, for CI and benchmarks. Without a display server, GLFW's null
+         * platform is used with a surfaceless EGL context, or OSMesa, e.g. Mesa's llvmpipe.
+         */
+        bool headless = false;
     };
 
     class FLK_API Window {
@@ -111,6 +117,18 @@ namespace Flock::Glfw {
         void MakeCurrent();
         void SwapBuffers() const;
 
+        /**
+         * @brief Makes the GL context current on the calling thread, CurrentWindow() is left as is.
+         *
+         * A context is current on one thread at a time, UnbindContext() it on the other thread first.
+         */
+        void BindContext() const;
+
+        /**
+         * @brief Detaches the GL context current on the calling thread, if any.
+         */
+        static void UnbindContext();
+
         bool operator==(const Window &other) const;
         bool operator!=(const Window &other) const;
 
@@ -1,6 +1,7 @@
 #include "Buffer.hpp"
 
 #include "Gl.hpp"
+#include "RenderStats.hpp"
 #include "Memory/Buffer.hpp"
 #include "glad/glad.h"
 
@@ -15,6 +16,9 @@ namespace Flock::Graphics {
             case BufferType::Index:
                 glBufferType = GL_ELEMENT_ARRAY_BUFFER;
                 break;
+            case BufferType::Texture:
+                glBufferType = GL_TEXTURE_BUFFER;
+                break;
             case BufferType::None:
                 FLK_EXPECT(false, "Invalid buffer type");
         }
@@ -49,12 +53,46 @@ namespace Flock::Graphics {
         FLK_GL_CALL(glBindBuffer(ToGlType(type), buf.m_Id));
 
         FLK_GL_CALL(glBufferData(ToGlType(type), buffer.Size(), buffer.Get(), ToGlType(usage)));
+        if (buffer.Get()) {
+            FrameCounters::BufferUpload(buffer.Size());
+        }
 
         FLK_GL_CALL(glBindBuffer(ToGlType(type), 0));
 
         return buf;
     }
 
+    Buffer Buffer::Allocate(const usize size, const BufferType type, const BufferUsage usage) {
+        Buffer buf{};
+        buf.m_Type = type;
+
+        // The copy targets aren't part of any vertex array state, unlike the index buffer binding.
+        FLK_GL_CALL(glGenBuffers(1, &buf.m_Id));
+        FLK_GL_CALL(glBindBuffer(GL_COPY_WRITE_BUFFER, buf.m_Id));
+        FLK_GL_CALL(glBufferData(GL_COPY_WRITE_BUFFER, size, nullptr, ToGlType(usage)));
+        FLK_GL_CALL(glBindBuffer(GL_COPY_WRITE_BUFFER, 0));
+
+        return buf;
+    }
+
+    bool Buffer::Copy(const Buffer &src, const Buffer &dst, const usize srcOffset, const usize dstOffset, const usize size) {
+        if (src.m_Id == 0 || dst.m_Id == 0) {
+            return false;
+        }
+
+        if (size == 0) {
+            return true;
+        }
+
+        FLK_GL_CALL(glBindBuffer(GL_COPY_READ_BUFFER, src.m_Id));
+        FLK_GL_CALL(glBindBuffer(GL_COPY_WRITE_BUFFER, dst.m_Id));
+        FLK_GL_CALL(glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, srcOffset, dstOffset, size));
+        FLK_GL_CALL(glBindBuffer(GL_COPY_READ_BUFFER, 0));
+        FLK_GL_CALL(glBindBuffer(GL_COPY_WRITE_BUFFER, 0));
+
+        return true;
+    }
+
     Buffer::Buffer(Buffer &&other) noexcept
         : m_Id(other.m_Id), m_Type(other.m_Type) {
         other.m_Id = 0;
@@ -82,6 +120,42 @@ namespace Flock::Graphics {
         return m_Type;
     }
 
+    u32 Buffer::GlId() const {
+        return m_Id;
+    }
+
+    bool Buffer::SetData(const void *data, const usize size, const BufferUsage usage) const {
+        if (m_Id == 0) {
+            return false;
+        }
+
+        FLK_GL_CALL(glBindBuffer(ToGlType(m_Type), m_Id));
+        FLK_GL_CALL(glBufferData(ToGlType(m_Type), size, data, ToGlType(usage)));
+        if (data) {
+            FrameCounters::BufferUpload(size);
+        }
+
+        // Index buffer bindings belong to the bound vertex array, leave them alone.
+        if (m_Type != BufferType::Index) {
+            FLK_GL_CALL(glBindBuffer(ToGlType(m_Type), 0));
+        }
+
+        return true;
+    }
+
+    bool Buffer::SetSubData(const void *data, const usize offset, const usize size) const {
+        if (m_Id == 0) {
+            return false;
+        }
+
+        FLK_GL_CALL(glBindBuffer(GL_COPY_WRITE_BUFFER, m_Id));
+        FLK_GL_CALL(glBufferSubData(GL_COPY_WRITE_BUFFER, offset, size, data));
+        FrameCounters::BufferUpload(size);
+        FLK_GL_CALL(glBindBuffer(GL_COPY_WRITE_BUFFER, 0));
+
+        return true;
+    }
+
     bool Buffer::Bind() const {
         if (m_Id == 0) {
             return false;
@@ -13,6 +13,7 @@ namespace Flock::Graphics {
         None,
         Vertex,
         Index,
+        Texture,
     };
 
     u32 ToGlType(BufferType type);
@@ -47,6 +48,21 @@ namespace Flock::Graphics {
         static Buffer Create(const Memory::Buffer &buffer, BufferType type,
                              BufferUsage           usage = BufferUsage::StaticDraw);
 
+        /**
+         * @brief Static factory method.
+         * @param size The size in bytes, the contents are left undefined.
+         * @param type The type of the buffer.
+         * @param usage How the buffer data are intended to be used.
+         * @return A newly created buffer.
+         */
+        static Buffer Allocate(usize size, BufferType type, BufferUsage usage = BufferUsage::StaticDraw);
+
+        /**
+         * @brief Copies a range between two buffers on the GPU.
+         * @return true if successful; false otherwise.
+         */
+        static bool Copy(const Buffer &src, const Buffer &dst, usize srcOffset, usize dstOffset, usize size);
+
         Buffer() = default;
         ~Buffer();
 
@@ -56,6 +72,24 @@ namespace Flock::Graphics {
         Buffer &operator=(const Buffer &other) = delete;
         Buffer &operator=(Buffer &&other) noexcept;
 
+        /**
+         * @brief Replaces the buffer data store, orphaning the previous one.
+         * @param data The data to copy from, may be null.
+         * @param size The size in bytes.
+         * @param usage How the buffer data are intended to be used.
+         * @return true if successful; false otherwise.
+         */
+        bool SetData(const void *data, usize size, BufferUsage usage = BufferUsage::DynamicDraw) const;
+
+        /**
+         * @brief Overwrites part of the buffer data store.
+         * @param data The data to copy from.
+         * @param offset The offset in bytes.
+         * @param size The size in bytes.
+         * @return true if successful; false otherwise.
+         */
+        bool SetSubData(const void *data, usize offset, usize size) const;
+
         /**
          * @brief Binds the buffer to the current context.
          * @return true if successful; false otherwise.
@@ -78,6 +112,8 @@ namespace Flock::Graphics {
          * @return The type of the buffer.
          */
         [[nodiscard]] BufferType Type() const;
+
+        [[nodiscard]] u32 GlId() const;
     };
 }
 
@@ -4,6 +4,7 @@
 
 #include "Graphics/Gl.hpp"
 #include "Graphics/Image.hpp"
+#include "Graphics/StateCache.hpp"
 #include "Graphics/Texture.hpp"
 #include "Memory/Buffer.hpp"
 #include "glad/glad.h"
@@ -21,14 +22,8 @@ namespace Flock::Graphics {
         CubeMap cubeMap;
         cubeMap.m_Config = config;
 
-        i32 activeUnit;
-        i32 boundTexture;
-
-        FLK_GL_CALL(glGetIntegerv(GL_ACTIVE_TEXTURE, &activeUnit));
-        FLK_GL_CALL(glGetIntegerv(GL_TEXTURE_BINDING_CUBE_MAP, &boundTexture));
-
         FLK_GL_CALL(glGenTextures(1, &cubeMap.m_Id));
-        FLK_GL_CALL(glBindTexture(GL_TEXTURE_CUBE_MAP, cubeMap.m_Id));
+        StateCache::BindTexture(0, GL_TEXTURE_CUBE_MAP, cubeMap.m_Id);
 
         const std::vector images{right, left, down, up, forward, back};
 
@@ -56,9 +51,6 @@ namespace Flock::Graphics {
 
         ConfigureTexture(GL_TEXTURE_CUBE_MAP, config);
 
-        FLK_GL_CALL(glActiveTexture(activeUnit));
-        FLK_GL_CALL(glBindTexture(GL_TEXTURE_CUBE_MAP, boundTexture));
-
         return cubeMap;
     }
 
@@ -97,11 +89,12 @@ namespace Flock::Graphics {
             return;
         }
 
+        StateCache::ForgetTexture(m_Id);
         FLK_GL_CALL(glDeleteTextures(1, &m_Id));
     }
 
     void CubeMap::SetActiveUnit(const u8 unit) {
-        FLK_GL_CALL(glActiveTexture(GL_TEXTURE0 + unit));
+        StateCache::ActiveTexture(unit);
     }
 
     bool CubeMap::Bind() const {
@@ -109,29 +102,18 @@ namespace Flock::Graphics {
             return false;
         }
 
-        FLK_GL_CALL(glBindTexture(GL_TEXTURE_CUBE_MAP, m_Id));
+        StateCache::BindTexture(GL_TEXTURE_CUBE_MAP, m_Id);
         return true;
     }
 
     void CubeMap::Unbind() {
-        FLK_GL_CALL(glBindTexture(GL_TEXTURE_CUBE_MAP, 0));
+        StateCache::BindTexture(GL_TEXTURE_CUBE_MAP, 0);
     }
 
     void CubeMap::Configure(const TextureConfig config) {
         m_Config = config;
 
-        i32 activeUnit;
-        i32 boundTexture;
-
-        FLK_GL_CALL(glGetIntegerv(GL_ACTIVE_TEXTURE, &activeUnit));
-        FLK_GL_CALL(glGetIntegerv(GL_TEXTURE_BINDING_CUBE_MAP, &boundTexture));
-
-        FLK_GL_CALL(glActiveTexture(GL_TEXTURE0));
-        FLK_GL_CALL(glBindTexture(GL_TEXTURE_CUBE_MAP, m_Id));
-
+        StateCache::BindTexture(0, GL_TEXTURE_CUBE_MAP, m_Id);
         ConfigureTexture(GL_TEXTURE_CUBE_MAP, config);
-
-        FLK_GL_CALL(glActiveTexture(activeUnit));
-        FLK_GL_CALL(glBindTexture(GL_TEXTURE_CUBE_MAP, boundTexture));
     }
 }
@@ -0,0 +1,403 @@
+#include "FrameGraph.hpp"
+
+#include <algorithm>
+#include <utility>
+
+#include "Debug/Log.hpp"
+#include "Graphics/StateCache.hpp"
+
+namespace Flock::Graphics {
+    namespace {
+        // Targets unused for longer are freed, so a resized window doesn't keep the old ones around.
+        constexpr u64 s_MaxIdleFrames = 8;
+    }
+
+    RenderTargetPool::Target &RenderTargetPool::Acquire(const TargetDesc &desc) {
+        for (auto &target: m_Targets) {
+            if (!target->inUse && target->desc == desc) {
+                target->inUse     = true;
+                target->lastFrame = m_Frame;
+                return *target;
+            }
+        }
+
+        const TextureConfig config = {.filterMode = Linear, .format = desc.format, .generateMipmaps = false};
+
+        auto target       = std::make_unique<Target>();
+        target->desc      = desc;
+        target->lastFrame = m_Frame;
+        target->inUse     = true;
+
+        if (desc.layers == 0) {
+            target->texture = Texture::CreateEmpty(desc.size, config);
+        } else {
+            target->array = TextureArray::Create(desc.layers, desc.size, config);
+        }
+
+        m_Targets.push_back(std::move(target));
+        return *m_Targets.back();
+    }
+
+    void RenderTargetPool::Release(Target &target) {
+        target.inUse = false;
+    }
+
+    void RenderTargetPool::EndFrame() {
+        m_Frame++;
+
+        std::erase_if(m_Targets, [&](const auto &target) {
+            return !target->inUse && m_Frame - target->lastFrame > s_MaxIdleFrames;
+        });
+    }
+
+    void RenderTargetPool::Clear() {
+        m_Targets.clear();
+    }
+
+    usize RenderTargetPool::TargetCount() const {
+        return m_Targets.size();
+    }
+
+    PassBuilder::PassBuilder(FrameGraph &graph, const u32 pass)
+        : m_Graph(graph), m_Pass(pass) {
+    }
+
+    FrameResource PassBuilder::Create(const std::string &name, const TargetDesc &desc) {
+        return m_Graph.Create(name, desc);
+    }
+
+    FrameResource PassBuilder::Read(const FrameResource resource) {
+        if (resource < m_Graph.m_Resources.size()) {
+            m_Graph.m_Passes[m_Pass].reads.push_back(resource);
+        }
+
+        return resource;
+    }
+
+    FrameResource PassBuilder::Write(const FrameResource resource) {
+        if (resource < m_Graph.m_Resources.size()) {
+            m_Graph.m_Passes[m_Pass].writes.push_back(resource);
+        }
+
+        return resource;
+    }
+
+    void PassBuilder::SideEffect() {
+        m_Graph.m_Passes[m_Pass].sideEffect = true;
+    }
+
+    PassContext::PassContext(const FrameGraph &graph, const Framebuffer *target)
+        : m_Graph(graph), m_Target(target) {
+    }
+
+    const Framebuffer *PassContext::Target() const {
+        return m_Target;
+    }
+
+    const Texture *PassContext::GetTexture(const FrameResource resource) const {
+        if (resource >= m_Graph.m_Resources.size()) {
+            return nullptr;
+        }
+
+        const auto &res = m_Graph.m_Resources[resource];
+        if (res.imported) {
+            return res.texture;
+        }
+
+        if (res.slot == FLK_INVALID || res.desc.layers != 0 || !m_Graph.m_Targets[res.slot]) {
+            return nullptr;
+        }
+
+        return &m_Graph.m_Targets[res.slot]->texture;
+    }
+
+    const TextureArray *PassContext::GetTextureArray(const FrameResource resource) const {
+        if (resource >= m_Graph.m_Resources.size()) {
+            return nullptr;
+        }
+
+        const auto &res = m_Graph.m_Resources[resource];
+        if (res.imported) {
+            return res.array;
+        }
+
+        if (res.slot == FLK_INVALID || res.desc.layers == 0 || !m_Graph.m_Targets[res.slot]) {
+            return nullptr;
+        }
+
+        return &m_Graph.m_Targets[res.slot]->array;
+    }
+
+    FrameResource FrameGraph::Import(const std::string &name, const Texture &texture) {
+        m_Resources.push_back({
+            .name     = name,
+            .desc     = {.size = texture.Size(), .format = texture.Config().format.value_or(TextureFormat::Rgba)},
+            .imported = true,
+            .texture  = &texture
+        });
+
+        return m_Resources.size() - 1;
+    }
+
+    FrameResource FrameGraph::Import(const std::string &name, const TextureArray &array) {
+        m_Resources.push_back({
+            .name     = name,
+            .desc     = {.size = array.Size(), .layers = array.LayerCount()},
+            .imported = true,
+            .array    = &array
+        });
+
+        return m_Resources.size() - 1;
+    }
+
+    FrameResource FrameGraph::Import(const std::string &name) {
+        m_Resources.push_back({.name = name, .imported = true});
+        return m_Resources.size() - 1;
+    }
+
+    FrameResource FrameGraph::Create(const std::string &name, const TargetDesc &desc) {
+        m_Resources.push_back({.name = name, .desc = desc});
+        return m_Resources.size() - 1;
+    }
+
+    void FrameGraph::AddPass(const std::string &name, const PassSetup &setup, PassExecute execute) {
+        m_Passes.push_back({.name = name, .execute = std::move(execute)});
+
+        PassBuilder builder(*this, m_Passes.size() - 1);
+        setup(builder);
+    }
+
+    bool FrameGraph::Compile() {
+        const u32 passCount = m_Passes.size();
+
+        // Passes with visible results are kept, then whatever writes what a kept pass reads.
+        for (auto &pass: m_Passes) {
+            pass.live = pass.sideEffect || std::ranges::any_of(pass.writes, [&](const FrameResource resource) {
+                return m_Resources[resource].imported;
+            });
+        }
+
+        for (bool changed = true; changed;) {
+            changed = false;
+
+            for (u32 p = 0; p < passCount; p++) {
+                if (!m_Passes[p].live) {
+                    continue;
+                }
+
+                for (const FrameResource resource: m_Passes[p].reads) {
+                    for (u32 w = 0; w < passCount; w++) {
+                        if (!m_Passes[w].live && Writes(w, resource)) {
+                            m_Passes[w].live = true;
+                            changed          = true;
+                        }
+                    }
+                }
+            }
+        }
+
+        // Writers run before readers, and passes writing the same resource in the order they were added.
+        std::vector<std::vector<u32> > successors(passCount);
+        std::vector<u32>               predecessors(passCount, 0);
+
+        for (u32 a = 0; a < passCount; a++) {
+            for (u32 b = a + 1; b < passCount; b++) {
+                if (!m_Passes[a].live || !m_Passes[b].live) {
+                    continue;
+                }
+
+                const bool aFirst = std::ranges::any_of(m_Passes[a].writes, [&](const FrameResource resource) {
+                    return Writes(b, resource) || Reads(b, resource);
+                });
+
+                const bool bFirst = std::ranges::any_of(m_Passes[b].writes, [&](const FrameResource resource) {
+                    return !Writes(a, resource) && Reads(a, resource);
+                });
+
+                if (aFirst) {
+                    successors[a].push_back(b);
+                    predecessors[b]++;
+                }
+
+                if (bFirst) {
+                    successors[b].push_back(a);
+                    predecessors[a]++;
+                }
+            }
+        }
+
+        // Ties go to the pass added first, so independent passes keep their submission order.
+        m_Order.clear();
+        std::vector<bool> done(passCount, false);
+
+        const u32 liveCount = std::ranges::count_if(m_Passes, [](const Pass &pass) { return pass.live; });
+        while (m_Order.size() < liveCount) {
+            u32 next = FLK_INVALID;
+            for (u32 p = 0; p < passCount; p++) {
+                if (m_Passes[p].live && !done[p] && predecessors[p] == 0) {
+                    next = p;
+                    break;
+                }
+            }
+
+            if (next == FLK_INVALID) {
+                Debug::LogErr("FrameGraph::Compile: Passes depend on each other in a cycle!");
+                m_Order.clear();
+                return false;
+            }
+
+            done[next] = true;
+            m_Order.push_back(next);
+
+            for (const u32 successor: successors[next]) {
+                predecessors[successor]--;
+            }
+        }
+
+        // A transient target lives from its first to its last use, targets of disjoint lifetimes share a slot.
+        const u32        resourceCount = m_Resources.size();
+        std::vector<u32> first(resourceCount, FLK_INVALID);
+        std::vector<u32> last(resourceCount, 0);
+
+        for (u32 i = 0; i < m_Order.size(); i++) {
+            const Pass &pass = m_Passes[m_Order[i]];
+            for (const auto *resources: {&pass.reads, &pass.writes}) {
+                for (const FrameResource resource: *resources) {
+                    first[resource] = std::min(first[resource], i);
+                    last[resource]  = std::max(last[resource], i);
+                }
+            }
+        }
+
+        std::vector<u32> transients;
+        for (u32 r = 0; r < resourceCount; r++) {
+            m_Resources[r].slot = FLK_INVALID;
+            if (!m_Resources[r].imported && first[r] != FLK_INVALID) {
+                transients.push_back(r);
+            }
+        }
+
+        std::ranges::stable_sort(transients, {}, [&](const u32 resource) { return first[resource]; });
+
+        m_Slots.clear();
+        std::vector<u32> slotEnd;
+
+        for (const u32 resource: transients) {
+            Resource &res = m_Resources[resource];
+
+            for (u32 s = 0; s < m_Slots.size(); s++) {
+                if (m_Slots[s] == res.desc && slotEnd[s] < first[resource]) {
+                    res.slot   = s;
+                    slotEnd[s] = last[resource];
+                    break;
+                }
+            }
+
+            if (res.slot == FLK_INVALID) {
+                res.slot = m_Slots.size();
+                m_Slots.push_back(res.desc);
+                slotEnd.push_back(last[resource]);
+            }
+        }
+
+        return true;
+    }
+
+    bool FrameGraph::Execute(RenderTargetPool &pool) {
+        m_Targets.assign(m_Slots.size(), nullptr);
+        for (usize s = 0; s < m_Slots.size(); s++) {
+            m_Targets[s] = &pool.Acquire(m_Slots[s]);
+        }
+
+        bool success = true;
+        for (const u32 index: m_Order) {
+            const Pass &pass = m_Passes[index];
+
+            // Only the targets this pass writes stay attached, an earlier pass's target may differ in size or be
+            // sampled by this one.
+            const Texture *color = nullptr;
+            const Texture *depth = nullptr;
+            for (const FrameResource resource: pass.writes) {
+                const Resource &res = m_Resources[resource];
+                if (res.imported || res.desc.layers != 0) {
+                    continue;
+                }
+
+                (res.desc.format == TextureFormat::Depth ? depth : color) = &m_Targets[res.slot]->texture;
+            }
+
+            if (!color && !depth) {
+                if (pass.execute) {
+                    pass.execute(PassContext(*this));
+                }
+
+                continue;
+            }
+
+            if (!m_Framebuffer) {
+                m_Framebuffer = Framebuffer::Create();
+            }
+
+            if (m_Framebuffer) {
+                if (!color) {
+                    m_Framebuffer->Detach(Attachment::Color);
+                }
+
+                if (!depth) {
+                    m_Framebuffer->Detach(Attachment::Depth);
+                }
+            }
+
+            const bool attached = m_Framebuffer &&
+                                  (!color || m_Framebuffer->Attach(Attachment::Color, *color)) &&
+                                  (!depth || m_Framebuffer->Attach(Attachment::Depth, *depth));
+
+            if (!attached || !m_Framebuffer->Bind()) {
+                Debug::LogErr("FrameGraph::Execute: Failed to set up the framebuffer for pass", pass.name);
+                success = false;
+                continue;
+            }
+
+            const Vector2u size = (color ? color : depth)->Size();
+            StateCache::Viewport(0, 0, static_cast<i32>(size.x), static_cast<i32>(size.y));
+
+            if (pass.execute) {
+                pass.execute(PassContext(*this, &*m_Framebuffer));
+            }
+        }
+
+        for (auto *target: m_Targets) {
+            pool.Release(*target);
+        }
+
+        return success;
+    }
+
+    void FrameGraph::Reset() {
+        m_Resources.clear();
+        m_Passes.clear();
+        m_Order.clear();
+        m_Slots.clear();
+        m_Targets.clear();
+    }
+
+    const std::vector<u32> &FrameGraph::Order() const {
+        return m_Order;
+    }
+
+    usize FrameGraph::SlotCount() const {
+        return m_Slots.size();
+    }
+
+    u32 FrameGraph::SlotOf(const FrameResource resource) const {
+        return resource < m_Resources.size() ? m_Resources[resource].slot : FLK_INVALID;
+    }
+
+    bool FrameGraph::Writes(const u32 pass, const FrameResource resource) const {
+        return std::ranges::find(m_Passes[pass].writes, resource) != m_Passes[pass].writes.end();
+    }
+
+    bool FrameGraph::Reads(const u32 pass, const FrameResource resource) const {
+        return std::ranges::find(m_Passes[pass].reads, resource) != m_Passes[pass].reads.end();
+    }
+}
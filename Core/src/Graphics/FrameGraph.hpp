@@ -0,0 +1,236 @@
+#ifndef FLK_FRAMEGRAPH_HPP
+#define FLK_FRAMEGRAPH_HPP
+
+#include <functional>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "Common.hpp"
+#include "Framebuffer.hpp"
+#include "Texture.hpp"
+#include "TextureArray.hpp"
+#include "Math/Vector.hpp"
+
+namespace Flock::Graphics {
+    /**
+     * @struct TargetDesc
+     * @brief Describes a transient render target, targets with equal descriptions can share memory.
+     */
+    struct FLK_API TargetDesc {
+        Vector2u      size   = {};
+        TextureFormat format = TextureFormat::Rgba;
+        u32           layers = 0; // A 2D texture if 0, a texture array otherwise.
+
+        bool operator==(const TargetDesc &other) const = default;
+    };
+
+    /**
+     * @class RenderTargetPool
+     * @brief Keeps render targets across frames, so transient targets are only allocated when first needed.
+     */
+    class FLK_API RenderTargetPool {
+    public:
+        struct Target {
+            TargetDesc   desc      = {};
+            Texture      texture   = {};
+            TextureArray array     = {};
+            u64          lastFrame = 0;
+            bool         inUse     = false;
+        };
+
+    private:
+        std::vector<std::unique_ptr<Target> > m_Targets;
+        u64                                   m_Frame = 0;
+
+    public:
+        /**
+         * @brief Gets a target not in use this frame, creating one if none matches.
+         * @param desc The target description.
+         * @return The target, valid until it is released and freed by EndFrame().
+         */
+        Target &Acquire(const TargetDesc &desc);
+
+        /**
+         * @brief Returns a target to the pool, later passes of the same frame may reuse it.
+         */
+        void Release(Target &target);
+
+        /**
+         * @brief Frees targets that have not been used for a few frames.
+         */
+        void EndFrame();
+
+        void Clear();
+
+        [[nodiscard]] usize TargetCount() const;
+    };
+
+    /**
+     * @brief A resource in a FrameGraph, valid until FrameGraph::Reset().
+     */
+    using FrameResource = u32;
+
+    class FrameGraph;
+
+    /**
+     * @class PassBuilder
+     * @brief Declares what a pass reads and writes.
+     */
+    class FLK_API PassBuilder {
+        FrameGraph &m_Graph;
+        u32         m_Pass;
+
+    public:
+        PassBuilder(FrameGraph &graph, u32 pass);
+
+        /**
+         * @brief Creates a transient target, it only exists between its first and last use.
+         * @param name The debug name.
+         * @param desc The target description.
+         * @return The new resource, still to be written by this or another pass.
+         */
+        FrameResource Create(const std::string &name, const TargetDesc &desc);
+
+        FrameResource Read(FrameResource resource);
+        FrameResource Write(FrameResource resource);
+
+        /**
+         * @brief Keeps the pass even if nothing reads what it writes.
+         */
+        void SideEffect();
+    };
+
+    /**
+     * @class PassContext
+     * @brief What a pass gets to execute with.
+     */
+    class FLK_API PassContext {
+        const FrameGraph & m_Graph;
+        const Framebuffer *m_Target;
+
+    public:
+        explicit PassContext(const FrameGraph &graph, const Framebuffer *target = nullptr);
+
+        /**
+         * @return The framebuffer bound for the pass; nullptr if it writes no transient 2D target.
+         */
+        [[nodiscard]] const Framebuffer *Target() const;
+
+        /**
+         * @return The texture of a 2D resource; nullptr for a texture array or external resource.
+         */
+        [[nodiscard]] const Texture *GetTexture(FrameResource resource) const;
+
+        /**
+         * @return The texture array of a layered resource; nullptr for a 2D texture or external resource.
+         */
+        [[nodiscard]] const TextureArray *GetTextureArray(FrameResource resource) const;
+    };
+
+    using PassSetup   = std::function<void(PassBuilder &)>;
+    using PassExecute = std::function<void(const PassContext &)>;
+
+    /**
+     * @class FrameGraph
+     * @brief The passes of a frame and the targets between them.
+     *
+     * Passes declare what they read and write. Compiling culls passes whose output nothing uses, orders the rest
+     * so that writers run before readers, and lets transient targets whose lifetimes don't overlap share memory.
+     * Transient 2D targets written by a pass are attached to a framebuffer that is bound before it executes.
+     */
+    class FLK_API FrameGraph {
+        struct Resource {
+            std::string         name     = {};
+            TargetDesc          desc     = {};
+            bool                imported = false;
+            const Texture *     texture  = nullptr;
+            const TextureArray *array    = nullptr;
+            u32                 slot     = FLK_INVALID; // The physical target of a transient resource.
+        };
+
+        struct Pass {
+            std::string                name       = {};
+            PassExecute                execute    = {};
+            std::vector<FrameResource> reads      = {};
+            std::vector<FrameResource> writes     = {};
+            bool                       sideEffect = false;
+            bool                       live       = false;
+        };
+
+        std::vector<Resource>                   m_Resources;
+        std::vector<Pass>                       m_Passes;
+        std::vector<u32>                        m_Order;
+        std::vector<TargetDesc>                 m_Slots;
+        std::vector<RenderTargetPool::Target *> m_Targets;
+        std::optional<Framebuffer>              m_Framebuffer;
+
+        friend class PassBuilder;
+        friend class PassContext;
+
+    public:
+        /**
+         * @brief Imports a texture that lives outside the graph, passes writing it are never culled.
+         */
+        FrameResource Import(const std::string &name, const Texture &texture);
+        FrameResource Import(const std::string &name, const TextureArray &array);
+
+        /**
+         * @brief Imports an external target without a texture, such as the screen.
+         */
+        FrameResource Import(const std::string &name);
+
+        /**
+         * @brief Creates a transient target up front, so passes can be added in any order.
+         */
+        FrameResource Create(const std::string &name, const TargetDesc &desc);
+
+        /**
+         * @brief Adds a pass, its setup runs right away.
+         * @param name The debug name.
+         * @param setup Declares the resources of the pass.
+         * @param execute Records the pass, called by Execute() if the pass is kept.
+         */
+        void AddPass(const std::string &name, const PassSetup &setup, PassExecute execute);
+
+        /**
+         * @brief Culls, orders and assigns physical targets.
+         * @return true if successful; false if the passes depend on each other in a cycle.
+         */
+        bool Compile();
+
+        /**
+         * @brief Runs the compiled passes in order.
+         * @param pool The pool to take the transient targets from, they are returned once done.
+         * @return true if successful; false otherwise.
+         */
+        bool Execute(RenderTargetPool &pool);
+
+        /**
+         * @brief Removes all passes and resources, for the next frame.
+         */
+        void Reset();
+
+        /**
+         * @return The indices of the passes kept, in execution order.
+         */
+        [[nodiscard]] const std::vector<u32> &Order() const;
+
+        /**
+         * @return The number of physical targets the transient resources need.
+         */
+        [[nodiscard]] usize SlotCount() const;
+
+        /**
+         * @return The physical target index of a transient resource; FLK_INVALID otherwise.
+         */
+        [[nodiscard]] u32 SlotOf(FrameResource resource) const;
+
+    private:
+        [[nodiscard]] bool Writes(u32 pass, FrameResource resource) const;
+        [[nodiscard]] bool Reads(u32 pass, FrameResource resource) const;
+    };
+}
+
+#endif //FLK_FRAMEGRAPH_HPP
@@ -1,6 +1,10 @@
 #include "Framebuffer.hpp"
 
+#include <cstring>
+#include <vector>
+
 #include "Graphics/Gl.hpp"
+#include "Graphics/StateCache.hpp"
 #include "Graphics/Texture.hpp"
 #include "Graphics/TextureArray.hpp"
 
@@ -19,6 +23,7 @@ namespace Flock::Graphics {
 
     Framebuffer::Framebuffer(Framebuffer &&other) noexcept {
         m_Id       = other.m_Id;
+        m_HasColor = other.m_HasColor;
         other.m_Id = 0;
     }
 
@@ -30,6 +35,7 @@ namespace Flock::Graphics {
         Clear();
 
         m_Id       = other.m_Id;
+        m_HasColor = other.m_HasColor;
         other.m_Id = 0;
 
         return *this;
@@ -40,6 +46,7 @@ namespace Flock::Graphics {
             return;
         }
 
+        StateCache::ForgetFramebuffer(m_Id);
         FLK_GL_CALL(glDeleteFramebuffers(1, &m_Id));
     }
 
@@ -48,53 +55,35 @@ namespace Flock::Graphics {
             return false;
         }
 
-        FLK_GL_CALL(glBindFramebuffer(GL_FRAMEBUFFER, m_Id));
-
-        FLK_GL_CALL(glDrawBuffer(GL_NONE));
-        FLK_GL_CALL(glReadBuffer(GL_NONE));
-
-        if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE) {
-            Unbind();
-            return false;
-        }
+        StateCache::BindFramebuffer(GL_FRAMEBUFFER, m_Id);
 
         return true;
     }
 
     void Framebuffer::Unbind() {
-        FLK_GL_CALL(glBindFramebuffer(GL_FRAMEBUFFER, 0));
+        StateCache::BindFramebuffer(GL_FRAMEBUFFER, 0);
     }
 
-    bool Framebuffer::Attach(const Attachment attachment, const Texture &texture) const {
-        i32 boundFramebuffer;
-        i32 boundTexture;
-
-        FLK_GL_CALL(glGetIntegerv(GL_TEXTURE_BINDING_2D, &boundTexture));
-        FLK_GL_CALL(glGetIntegerv(GL_FRAMEBUFFER_BINDING, &boundFramebuffer));
+    bool Framebuffer::Attach(const Attachment attachment, const Texture &texture) {
+        const u32 boundFramebuffer = StateCache::Framebuffer(GL_DRAW_FRAMEBUFFER);
 
-        FLK_GL_CALL(glBindFramebuffer(GL_FRAMEBUFFER, m_Id));
-        FLK_GL_CALL(glBindTexture(GL_TEXTURE_2D, texture.GlId()));
+        StateCache::BindFramebuffer(GL_FRAMEBUFFER, m_Id);
         FLK_GL_CALL(glFramebufferTexture2D(GL_FRAMEBUFFER, ToGlType(attachment), GL_TEXTURE_2D, texture.GlId(), 0));
 
-        FLK_GL_CALL(glBindTexture(GL_TEXTURE_2D, boundTexture));
-        FLK_GL_CALL(glBindFramebuffer(GL_FRAMEBUFFER, boundFramebuffer));
+        const bool complete = Validate(attachment);
+        StateCache::BindFramebuffer(GL_FRAMEBUFFER, boundFramebuffer == StateCache::s_Unknown ? 0 : boundFramebuffer);
 
-        return true;
+        return complete;
     }
 
-    bool Framebuffer::Attach(const Attachment attachment, const TextureArray &textureArray, u32 index) const {
+    bool Framebuffer::Attach(const Attachment attachment, const TextureArray &textureArray, u32 index) {
         if (index >= textureArray.LayerCount()) {
             return false;
         }
 
-        i32 boundFramebuffer;
-        i32 boundTexture;
-
-        FLK_GL_CALL(glGetIntegerv(GL_TEXTURE_BINDING_2D_ARRAY, &boundTexture));
-        FLK_GL_CALL(glGetIntegerv(GL_FRAMEBUFFER_BINDING, &boundFramebuffer));
+        const u32 boundFramebuffer = StateCache::Framebuffer(GL_DRAW_FRAMEBUFFER);
 
-        FLK_GL_CALL(glBindFramebuffer(GL_FRAMEBUFFER, m_Id));
-        FLK_GL_CALL(glBindTexture(GL_TEXTURE_2D_ARRAY, textureArray.GlId()));
+        StateCache::BindFramebuffer(GL_FRAMEBUFFER, m_Id);
         FLK_GL_CALL(
             glFramebufferTextureLayer(
                 GL_FRAMEBUFFER,
@@ -105,9 +94,101 @@ namespace Flock::Graphics {
             )
         );
 
-        FLK_GL_CALL(glBindTexture(GL_TEXTURE_2D_ARRAY, boundTexture));
-        FLK_GL_CALL(glBindFramebuffer(GL_FRAMEBUFFER, boundFramebuffer));
+        const bool complete = Validate(attachment);
+        StateCache::BindFramebuffer(GL_FRAMEBUFFER, boundFramebuffer == StateCache::s_Unknown ? 0 : boundFramebuffer);
+
+        return complete;
+    }
+
+    void Framebuffer::Detach(const Attachment attachment) {
+        const u32 boundFramebuffer = StateCache::Framebuffer(GL_DRAW_FRAMEBUFFER);
+
+        StateCache::BindFramebuffer(GL_FRAMEBUFFER, m_Id);
+        FLK_GL_CALL(glFramebufferTexture2D(GL_FRAMEBUFFER, ToGlType(attachment), GL_TEXTURE_2D, 0, 0));
+
+        if (attachment == Attachment::Color) {
+            m_HasColor = false;
+            FLK_GL_CALL(glDrawBuffer(GL_NONE));
+            FLK_GL_CALL(glReadBuffer(GL_NONE));
+        }
+
+        StateCache::BindFramebuffer(GL_FRAMEBUFFER, boundFramebuffer == StateCache::s_Unknown ? 0 : boundFramebuffer);
+    }
+
+    u32 Framebuffer::AttachedTexture(const Attachment attachment) const {
+        if (m_Id == 0) {
+            return 0;
+        }
+
+        const u32 boundFramebuffer = StateCache::Framebuffer(GL_DRAW_FRAMEBUFFER);
+
+        i32 texture = 0;
+        StateCache::BindFramebuffer(GL_FRAMEBUFFER, m_Id);
+        FLK_GL_CALL(glGetFramebufferAttachmentParameteriv(
+            GL_FRAMEBUFFER,
+            ToGlType(attachment),
+            GL_FRAMEBUFFER_ATTACHMENT_OBJECT_NAME,
+            &texture
+        ));
+
+        StateCache::BindFramebuffer(GL_FRAMEBUFFER, boundFramebuffer == StateCache::s_Unknown ? 0 : boundFramebuffer);
+
+        return texture;
+    }
+
+    bool Framebuffer::Blit(const Framebuffer &target, const Vector2u size, const Attachment attachment) const {
+        if (m_Id == 0 || target.m_Id == 0) {
+            return false;
+        }
+
+        const u32 mask = attachment == Attachment::Depth ? GL_DEPTH_BUFFER_BIT : GL_COLOR_BUFFER_BIT;
+
+        StateCache::BindFramebuffer(GL_READ_FRAMEBUFFER, m_Id);
+        StateCache::BindFramebuffer(GL_DRAW_FRAMEBUFFER, target.m_Id);
+        FLK_GL_CALL(glBlitFramebuffer(0, 0, size.x, size.y, 0, 0, size.x, size.y, mask, GL_NEAREST));
+
+        Unbind();
 
         return true;
     }
+
+    std::optional<Image> Framebuffer::ReadColor(const Vector2u size) const {
+        if (m_Id == 0 || !m_HasColor || size.x == 0 || size.y == 0) {
+            return std::nullopt;
+        }
+
+        const usize     row = static_cast<usize>(size.x) * 4;
+        std::vector<u8> pixels(row * size.y);
+
+        StateCache::BindFramebuffer(GL_READ_FRAMEBUFFER, m_Id);
+        FLK_GL_CALL(glPixelStorei(GL_PACK_ALIGNMENT, 1));
+        FLK_GL_CALL(glReadPixels(0, 0, size.x, size.y, GL_RGBA, GL_UNSIGNED_BYTE, pixels.data()));
+
+        Unbind();
+
+        // GL returns the bottom row first.
+        std::vector<u8> flipped(pixels.size());
+        for (usize y = 0; y < size.y; y++) {
+            std::memcpy(flipped.data() + y * row, pixels.data() + (size.y - 1 - y) * row, row);
+        }
+
+        return Image{.data = flipped, .size = size, .format = ImageFormat::Rgba};
+    }
+
+    bool Framebuffer::Validate(const Attachment attachment) {
+        // Draw and read buffers are framebuffer state, so setting them once per attachment is enough.
+        if (attachment == Attachment::Color) {
+            m_HasColor = true;
+        }
+
+        if (m_HasColor) {
+            FLK_GL_CALL(glDrawBuffer(GL_COLOR_ATTACHMENT0));
+            FLK_GL_CALL(glReadBuffer(GL_COLOR_ATTACHMENT0));
+        } else {
+            FLK_GL_CALL(glDrawBuffer(GL_NONE));
+            FLK_GL_CALL(glReadBuffer(GL_NONE));
+        }
+
+        return glCheckFramebufferStatus(GL_FRAMEBUFFER) == GL_FRAMEBUFFER_COMPLETE;
+    }
 }
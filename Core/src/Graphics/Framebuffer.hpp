@@ -4,6 +4,7 @@
 #include <optional>
 
 #include "Common.hpp"
+#include "Image.hpp"
 #include "Texture.hpp"
 #include "TextureArray.hpp"
 #include "glad/glad.h"
@@ -33,7 +34,8 @@ namespace Flock::Graphics {
     }
 
     class FLK_API Framebuffer {
-        u32 m_Id = 0;
+        u32  m_Id       = 0;
+        bool m_HasColor = false;
 
     public:
         static std::optional<Framebuffer> Create();
@@ -52,8 +54,37 @@ namespace Flock::Graphics {
         bool        Bind() const;
         static void Unbind();
 
-        bool Attach(Attachment attachment, const Texture &texture) const;
-        bool Attach(Attachment attachment, const TextureArray &textureArray, u32 index) const;
+        bool Attach(Attachment attachment, const Texture &texture);
+        bool Attach(Attachment attachment, const TextureArray &textureArray, u32 index);
+
+        /**
+         * @brief Removes the texture at an attachment, if any.
+         */
+        void Detach(Attachment attachment);
+
+        /**
+         * @return The GL ID of the texture at an attachment; 0 if there is none.
+         */
+        [[nodiscard]] u32 AttachedTexture(Attachment attachment) const;
+
+        /**
+         * @brief Copies an attachment of this framebuffer into another framebuffer.
+         * @param target The framebuffer to copy into.
+         * @param size The size of the copied region, starting at the origin.
+         * @param attachment The attachment to copy.
+         * @return true if successful; false otherwise.
+         */
+        bool Blit(const Framebuffer &target, Vector2u size, Attachment attachment) const;
+
+        /**
+         * @brief Reads back the color attachment, e.g. for screenshots and image comparisons.
+         * @param size The size of the read region, starting at the origin.
+         * @return The RGBA pixels with the top row first if successful; std::nullopt otherwise.
+         */
+        [[nodiscard]] std::optional<Image> ReadColor(Vector2u size) const;
+
+    private:
+        bool Validate(Attachment attachment);
     };
 }
 
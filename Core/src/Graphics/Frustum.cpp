@@ -0,0 +1,36 @@
+#include "Frustum.hpp"
+
+namespace Flock::Graphics {
+    Frustum Frustum::FromMatrix(const Matrix4f &viewProj) {
+        // Row vectors, so clip space coordinates are dot products with the columns.
+        const auto column = [&](const u32 col) {
+            return Vector4f{viewProj.At(0, col), viewProj.At(1, col), viewProj.At(2, col), viewProj.At(3, col)};
+        };
+
+        const Vector4f x = column(0);
+        const Vector4f y = column(1);
+        const Vector4f z = column(2);
+        const Vector4f w = column(3);
+
+        Frustum frustum = {.planes = {w + x, w - x, w + y, w - y, w + z, w - z}};
+        for (auto &plane: frustum.planes) {
+            const f32 length = static_cast<f32>(Vector3f{plane.x, plane.y, plane.z}.Magnitude());
+            if (length > 0.0F) {
+                plane = plane / length;
+            }
+        }
+
+        return frustum;
+    }
+
+    bool Frustum::Intersects(const BoundingSphere &sphere) const {
+        for (const auto &plane: planes) {
+            const f32 distance = plane.x * sphere.center.x + plane.y * sphere.center.y + plane.z * sphere.center.z + plane.w;
+            if (distance < -sphere.radius) {
+                return false;
+            }
+        }
+
+        return true;
+    }
+}
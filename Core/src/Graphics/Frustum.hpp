@@ -0,0 +1,32 @@
+#ifndef FLK_FRUSTUM_HPP
+#define FLK_FRUSTUM_HPP
+
+#include <array>
+
+#include "Common.hpp"
+#include "MeshLod.hpp"
+#include "Math/Matrix.hpp"
+#include "Math/Vector.hpp"
+
+namespace Flock::Graphics {
+    /**
+     * @struct Frustum
+     * @brief The six planes bounding what a camera sees, normals point inwards.
+     */
+    struct FLK_API Frustum {
+        std::array<Vector4f, 6> planes = {};
+
+        /**
+         * @brief Extracts the planes from a combined view and projection matrix.
+         * @param viewProj The view matrix times the projection matrix.
+         */
+        static Frustum FromMatrix(const Matrix4f &viewProj);
+
+        /**
+         * @brief Whether a sphere is at least partly inside or not, spheres near corners can pass without being inside.
+         */
+        [[nodiscard]] bool Intersects(const BoundingSphere &sphere) const;
+    };
+}
+
+#endif //FLK_FRUSTUM_HPP
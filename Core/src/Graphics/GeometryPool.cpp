@@ -0,0 +1,350 @@
+#include "GeometryPool.hpp"
+
+#include <algorithm>
+#include <numeric>
+
+#include "Debug/Log.hpp"
+
+namespace Flock::Graphics {
+    namespace {
+        // Index ranges are padded to this, so 16 and 32-bit indices can share a buffer and stay aligned.
+        constexpr usize s_IndexAlignment = sizeof(u32);
+    }
+
+    GeometryAllocation::GeometryAllocation(GeometryPool *pool, const u32 id)
+        : m_Pool(pool), m_Id(id) {
+    }
+
+    GeometryAllocation::~GeometryAllocation() {
+        Release();
+    }
+
+    GeometryAllocation::GeometryAllocation(GeometryAllocation &&other) noexcept
+        : m_Pool(other.m_Pool), m_Id(other.m_Id) {
+        other.m_Pool = nullptr;
+    }
+
+    GeometryAllocation &GeometryAllocation::operator=(GeometryAllocation &&other) noexcept {
+        if (this == &other) {
+            return *this;
+        }
+
+        Release();
+
+        m_Pool       = other.m_Pool;
+        m_Id         = other.m_Id;
+        other.m_Pool = nullptr;
+
+        return *this;
+    }
+
+    void GeometryAllocation::Release() {
+        if (m_Pool == nullptr) {
+            return;
+        }
+
+        m_Pool->Free(m_Id);
+        m_Pool = nullptr;
+    }
+
+    bool GeometryAllocation::Bind() const {
+        if (m_Pool == nullptr) {
+            return false;
+        }
+
+        const auto &arena = m_Pool->m_Arenas[static_cast<usize>(m_Pool->m_Ranges[m_Id].format)];
+        return arena && arena->vertexArray.Bind();
+    }
+
+    bool GeometryAllocation::BindDepth() const {
+        if (m_Pool == nullptr) {
+            return false;
+        }
+
+        const auto &arena = m_Pool->m_Arenas[static_cast<usize>(m_Pool->m_Ranges[m_Id].format)];
+        return arena && arena->depthVertexArray.Bind();
+    }
+
+    usize GeometryAllocation::IndexOffset() const {
+        return m_Pool ? m_Pool->m_Ranges[m_Id].indexOffset : 0;
+    }
+
+    i32 GeometryAllocation::BaseVertex() const {
+        return m_Pool ? static_cast<i32>(m_Pool->m_Ranges[m_Id].firstVertex) : 0;
+    }
+
+    GeometryAllocation::operator bool() const {
+        return m_Pool != nullptr;
+    }
+
+    GeometryPool::GeometryPool(const GeometryPoolConfig &config)
+        : m_Config(config) {
+    }
+
+    std::optional<GeometryAllocation> GeometryPool::Allocate(
+        const VertexFormat    format,
+        const PackedVertices &vertices,
+        const PackedVertices &positions,
+        const usize           vertexCount,
+        const Memory::Buffer &indices
+    ) {
+        if (vertexCount == 0 || indices.Size() == 0) {
+            return std::nullopt;
+        }
+
+        Arena *arena = GetArena(format, vertices, positions);
+        if (arena == nullptr) {
+            return std::nullopt;
+        }
+
+        std::optional<usize> firstVertex = arena->vertices.Allocate(vertexCount);
+        if (!firstVertex) {
+            const usize capacity = arena->vertices.Capacity();
+            if (!GrowArena(*arena, std::max(capacity * 2, capacity + vertexCount))) {
+                return std::nullopt;
+            }
+
+            firstVertex = arena->vertices.Allocate(vertexCount);
+        }
+
+        const usize          indexSize   = (indices.Size() + s_IndexAlignment - 1) / s_IndexAlignment * s_IndexAlignment;
+        std::optional<usize> indexOffset = m_Indices.Allocate(indexSize, s_IndexAlignment);
+        if (!indexOffset) {
+            const usize capacity = m_Indices.Capacity();
+            const usize required = capacity + indexSize;
+            if (!GrowIndices(capacity == 0 ? std::max(m_Config.initialIndices, required) : std::max(capacity * 2, required))) {
+                arena->vertices.Free(*firstVertex, vertexCount);
+                return std::nullopt;
+            }
+
+            indexOffset = m_Indices.Allocate(indexSize, s_IndexAlignment);
+        }
+
+        if (!firstVertex || !indexOffset) {
+            Debug::LogErr("GeometryPool::Allocate: Out of space after growing!");
+            return std::nullopt;
+        }
+
+        arena->vertexBuffer.SetSubData(vertices.data.Get(), *firstVertex * arena->layout.Stride(), vertices.data.Size());
+        arena->positionBuffer.SetSubData(
+            positions.data.Get(),
+            *firstVertex * arena->positionLayout.Stride(),
+            positions.data.Size()
+        );
+        m_IndexBuffer.SetSubData(indices.Get(), *indexOffset, indices.Size());
+
+        u32 id = m_Ranges.size();
+        if (!m_FreeIds.empty()) {
+            id = m_FreeIds.back();
+            m_FreeIds.pop_back();
+        } else {
+            m_Ranges.emplace_back();
+        }
+
+        m_Ranges[id] = {
+            .format      = format,
+            .firstVertex = *firstVertex,
+            .vertexCount = vertexCount,
+            .indexOffset = *indexOffset,
+            .indexSize   = indexSize,
+            .live        = true
+        };
+
+        return GeometryAllocation{this, id};
+    }
+
+    bool GeometryPool::Defragment() {
+        std::vector<u32> order(m_Ranges.size());
+        std::iota(order.begin(), order.end(), 0);
+        std::erase_if(order, [&](const u32 id) { return !m_Ranges[id].live; });
+
+        for (usize f = 0; f < m_Arenas.size(); f++) {
+            Arena *arena = m_Arenas[f].get();
+            if (arena == nullptr) {
+                continue;
+            }
+
+            const usize stride         = arena->layout.Stride();
+            const usize positionStride = arena->positionLayout.Stride();
+            const usize capacity       = arena->vertices.Capacity();
+
+            Buffer vertexBuffer   = Buffer::Allocate(capacity * stride, BufferType::Vertex);
+            Buffer positionBuffer = Buffer::Allocate(capacity * positionStride, BufferType::Vertex);
+
+            std::ranges::sort(order, {}, [&](const u32 id) { return m_Ranges[id].firstVertex; });
+
+            usize cursor = 0;
+            for (const u32 id: order) {
+                Range &range = m_Ranges[id];
+                if (static_cast<usize>(range.format) != f) {
+                    continue;
+                }
+
+                Buffer::Copy(arena->vertexBuffer, vertexBuffer, range.firstVertex * stride, cursor * stride,
+                             range.vertexCount * stride);
+                Buffer::Copy(arena->positionBuffer, positionBuffer, range.firstVertex * positionStride,
+                             cursor * positionStride, range.vertexCount * positionStride);
+
+                range.firstVertex  = cursor;
+                cursor            += range.vertexCount;
+            }
+
+            arena->vertexBuffer   = std::move(vertexBuffer);
+            arena->positionBuffer = std::move(positionBuffer);
+            arena->vertices.Reset(cursor);
+
+            if (!arena->vertexArray.SetVertexBuffer(arena->vertexBuffer, arena->layout) ||
+                !arena->depthVertexArray.SetVertexBuffer(arena->positionBuffer, arena->positionLayout)) {
+                Debug::LogErr("GeometryPool::Defragment: Failed to set vertex buffers!");
+                return false;
+            }
+        }
+
+        if (m_Indices.Capacity() == 0) {
+            return true;
+        }
+
+        Buffer indexBuffer = Buffer::Allocate(m_Indices.Capacity(), BufferType::Index);
+
+        std::ranges::sort(order, {}, [&](const u32 id) { return m_Ranges[id].indexOffset; });
+
+        usize cursor = 0;
+        for (const u32 id: order) {
+            Range &range = m_Ranges[id];
+
+            Buffer::Copy(m_IndexBuffer, indexBuffer, range.indexOffset, cursor, range.indexSize);
+
+            range.indexOffset  = cursor;
+            cursor            += range.indexSize;
+        }
+
+        m_IndexBuffer = std::move(indexBuffer);
+        m_Indices.Reset(cursor);
+
+        return AttachIndexBuffer();
+    }
+
+    f32 GeometryPool::Fragmentation() const {
+        f32 fragmentation = m_Indices.Fragmentation();
+        for (const auto &arena: m_Arenas) {
+            if (arena) {
+                fragmentation = std::max(fragmentation, arena->vertices.Fragmentation());
+            }
+        }
+
+        return fragmentation;
+    }
+
+    usize GeometryPool::AllocationCount() const {
+        return m_Ranges.size() - m_FreeIds.size();
+    }
+
+    void GeometryPool::SetConfig(const GeometryPoolConfig &config) {
+        m_Config = config;
+    }
+
+    const GeometryPoolConfig &GeometryPool::Config() const {
+        return m_Config;
+    }
+
+    void GeometryPool::Free(const u32 id) {
+        Range &range = m_Ranges[id];
+        if (!range.live) {
+            return;
+        }
+
+        if (const auto &arena = m_Arenas[static_cast<usize>(range.format)]) {
+            arena->vertices.Free(range.firstVertex, range.vertexCount);
+        }
+
+        m_Indices.Free(range.indexOffset, range.indexSize);
+
+        range.live = false;
+        m_FreeIds.push_back(id);
+    }
+
+    GeometryPool::Arena *GeometryPool::GetArena(
+        const VertexFormat    format,
+        const PackedVertices &vertices,
+        const PackedVertices &positions
+    ) {
+        auto &arena = m_Arenas[static_cast<usize>(format)];
+        if (arena) {
+            return arena.get();
+        }
+
+        arena                   = std::make_unique<Arena>();
+        arena->layout           = vertices.layout;
+        arena->positionLayout   = positions.layout;
+        arena->vertexArray      = VertexArray::Create();
+        arena->depthVertexArray = VertexArray::Create();
+
+        if (!GrowArena(*arena, m_Config.initialVertices)) {
+            arena.reset();
+            return nullptr;
+        }
+
+        if (m_IndexBuffer.GlId() != 0 && !AttachIndexBuffer()) {
+            arena.reset();
+            return nullptr;
+        }
+
+        return arena.get();
+    }
+
+    bool GeometryPool::GrowArena(Arena &arena, const usize capacity) {
+        const usize previous       = arena.vertices.Capacity();
+        const usize stride         = arena.layout.Stride();
+        const usize positionStride = arena.positionLayout.Stride();
+
+        Buffer vertexBuffer   = Buffer::Allocate(capacity * stride, BufferType::Vertex);
+        Buffer positionBuffer = Buffer::Allocate(capacity * positionStride, BufferType::Vertex);
+
+        if (previous > 0) {
+            Buffer::Copy(arena.vertexBuffer, vertexBuffer, 0, 0, previous * stride);
+            Buffer::Copy(arena.positionBuffer, positionBuffer, 0, 0, previous * positionStride);
+        }
+
+        arena.vertexBuffer   = std::move(vertexBuffer);
+        arena.positionBuffer = std::move(positionBuffer);
+        arena.vertices.Grow(capacity);
+
+        // Attribute pointers capture the buffer bound when they are set, so they have to be set again.
+        if (!arena.vertexArray.SetVertexBuffer(arena.vertexBuffer, arena.layout) ||
+            !arena.depthVertexArray.SetVertexBuffer(arena.positionBuffer, arena.positionLayout)) {
+            Debug::LogErr("GeometryPool::GrowArena: Failed to set vertex buffers!");
+            return false;
+        }
+
+        return true;
+    }
+
+    bool GeometryPool::GrowIndices(const usize capacity) {
+        const usize previous = m_Indices.Capacity();
+
+        Buffer indexBuffer = Buffer::Allocate(capacity, BufferType::Index);
+        if (previous > 0) {
+            Buffer::Copy(m_IndexBuffer, indexBuffer, 0, 0, previous);
+        }
+
+        m_IndexBuffer = std::move(indexBuffer);
+        m_Indices.Grow(capacity);
+
+        return AttachIndexBuffer();
+    }
+
+    bool GeometryPool::AttachIndexBuffer() const {
+        for (const auto &arena: m_Arenas) {
+            if (!arena) {
+                continue;
+            }
+
+            if (!arena->vertexArray.SetIndexBuffer(m_IndexBuffer) || !arena->depthVertexArray.SetIndexBuffer(m_IndexBuffer)) {
+                Debug::LogErr("GeometryPool::AttachIndexBuffer: Failed to set index buffer!");
+                return false;
+            }
+        }
+
+        return true;
+    }
+}
@@ -0,0 +1,171 @@
+#ifndef FLK_GEOMETRYPOOL_HPP
+#define FLK_GEOMETRYPOOL_HPP
+
+#include <array>
+#include <memory>
+#include <optional>
+#include <vector>
+
+#include "Common.hpp"
+#include "Buffer.hpp"
+#include "Vertex.hpp"
+#include "VertexArray.hpp"
+#include "VertexLayout.hpp"
+#include "Memory/Buffer.hpp"
+#include "Memory/FreeList.hpp"
+
+namespace Flock::Graphics {
+    struct GeometryPoolConfig {
+        bool  enabled         = true;
+        usize initialVertices = 1 << 16; // Per vertex format, doubled whenever it runs out.
+        usize initialIndices  = 1 << 20; // In bytes, shared by all formats.
+        f32   defragThreshold = 0.5F;    // Fragmentation past which unloading a model compacts the pool.
+    };
+
+    class GeometryPool;
+
+    /**
+     * @class GeometryAllocation
+     * @brief A mesh's share of a GeometryPool, released back to it on destruction.
+     *
+     * The offsets can change when the pool grows or is defragmented, query them at draw time.
+     */
+    class FLK_API GeometryAllocation {
+        GeometryPool *m_Pool = nullptr;
+        u32           m_Id   = 0;
+
+    public:
+        GeometryAllocation() = default;
+        GeometryAllocation(GeometryPool *pool, u32 id);
+        ~GeometryAllocation();
+
+        GeometryAllocation(const GeometryAllocation &) = delete;
+        GeometryAllocation(GeometryAllocation &&other) noexcept;
+
+        GeometryAllocation &operator=(const GeometryAllocation &) = delete;
+        GeometryAllocation &operator=(GeometryAllocation &&other) noexcept;
+
+        /**
+         * @brief Returns the ranges to the pool.
+         */
+        void Release();
+
+        /**
+         * @brief Binds the vertex array shared by every mesh of the same format.
+         * @return true if successful; false otherwise.
+         */
+        [[nodiscard]] bool Bind() const;
+
+        /**
+         * @brief Binds the position-only vertex array shared by every mesh of the same format.
+         * @return true if successful; false otherwise.
+         */
+        [[nodiscard]] bool BindDepth() const;
+
+        /**
+         * @return The offset of the first index in bytes.
+         */
+        [[nodiscard]] usize IndexOffset() const;
+
+        /**
+         * @return The value added to every index, the mesh's first vertex in the pool.
+         */
+        [[nodiscard]] i32 BaseVertex() const;
+
+        explicit operator bool() const;
+    };
+
+    /**
+     * @class GeometryPool
+     * @brief Suballocates vertices and indices of many meshes from a few large buffers.
+     *
+     * Each vertex format gets one vertex buffer, one position buffer and a vertex array for each, all formats
+     * share one index buffer. Meshes are drawn with a base vertex and an index offset, so consecutive draws of
+     * different meshes don't switch vertex arrays.
+     *
+     * The pool must outlive its allocations and can't be moved.
+     */
+    class FLK_API GeometryPool {
+        struct Arena {
+            VertexLayout     layout;
+            VertexLayout     positionLayout;
+            Buffer           vertexBuffer;
+            Buffer           positionBuffer;
+            VertexArray      vertexArray;
+            VertexArray      depthVertexArray;
+            Memory::FreeList vertices;
+        };
+
+        struct Range {
+            VertexFormat format      = VertexFormat::Standard;
+            usize        firstVertex = 0;
+            usize        vertexCount = 0;
+            usize        indexOffset = 0;
+            usize        indexSize   = 0;
+            bool         live        = false;
+        };
+
+        GeometryPoolConfig                    m_Config;
+        std::array<std::unique_ptr<Arena>, 3> m_Arenas;
+        Buffer                                m_IndexBuffer;
+        Memory::FreeList                      m_Indices;
+        std::vector<Range>                    m_Ranges;
+        std::vector<u32>                      m_FreeIds;
+
+    public:
+        explicit GeometryPool(const GeometryPoolConfig &config = {});
+        ~GeometryPool() = default;
+
+        GeometryPool(const GeometryPool &) = delete;
+        GeometryPool(GeometryPool &&)      = delete;
+
+        GeometryPool &operator=(const GeometryPool &) = delete;
+        GeometryPool &operator=(GeometryPool &&)      = delete;
+
+        /**
+         * @brief Uploads a mesh into the pool, growing it if needed.
+         * @param format The vertex format, selects the arena.
+         * @param vertices The vertices, from PackVertices().
+         * @param positions The positions, from PackPositions().
+         * @param vertexCount The number of vertices.
+         * @param indices The indices, relative to the mesh's first vertex.
+         * @return The allocation if successful; std::nullopt otherwise.
+         */
+        std::optional<GeometryAllocation> Allocate(
+            VertexFormat          format,
+            const PackedVertices &vertices,
+            const PackedVertices &positions,
+            usize                 vertexCount,
+            const Memory::Buffer &indices
+        );
+
+        /**
+         * @brief Moves all live ranges to the start of their buffers, merging the free space.
+         * @return true if successful; false otherwise.
+         */
+        bool Defragment();
+
+        /**
+         * @return The highest fragmentation among the buffers, see Memory::FreeList::Fragmentation().
+         */
+        [[nodiscard]] f32 Fragmentation() const;
+
+        [[nodiscard]] usize AllocationCount() const;
+
+        void                                    SetConfig(const GeometryPoolConfig &config);
+        [[nodiscard]] const GeometryPoolConfig &Config() const;
+
+    private:
+        friend class GeometryAllocation;
+
+        void Free(u32 id);
+
+        Arena *GetArena(VertexFormat format, const PackedVertices &vertices, const PackedVertices &positions);
+
+        bool GrowArena(Arena &arena, usize capacity);
+        bool GrowIndices(usize capacity);
+        bool AttachIndexBuffer() const;
+    };
+}
+
+#endif //FLK_GEOMETRYPOOL_HPP
@@ -1,5 +1,7 @@
 #include "Gl.hpp"
 
+#include <cstring>
+
 #include "glad/glad.h"
 
 namespace Flock::Graphics {
@@ -19,4 +21,25 @@ namespace Flock::Graphics {
                 return "UNKNOWN_ERROR";
         }
     }
+
+    bool HasExtension(const char *name) {
+        i32 count = 0;
+        glGetIntegerv(GL_NUM_EXTENSIONS, &count);
+
+        for (i32 i = 0; i < count; i++) {
+            const auto *extension = reinterpret_cast<const char *>(glGetStringi(GL_EXTENSIONS, i));
+            if (extension && std::strcmp(extension, name) == 0) {
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    i32 GetInteger(const GLenum name) {
+        i32 value = 0;
+        FLK_GL_CALL(glGetIntegerv(name, &value));
+
+        return value;
+    }
 }
@@ -4,10 +4,23 @@
 #include <glad/glad.h>
 #include <GLFW/glfw3.h>
 
+#include "Common.hpp"
 #include "Debug/Log.hpp"
 
 namespace Flock::Graphics {
     const char *GlErrorString(GLenum err);
+
+    /**
+     * @return true if the current context exposes the extension; false otherwise.
+     */
+    bool HasExtension(const char *name);
+
+    /**
+     * @brief Queries a single integer of context state, e.g. a binding.
+     * @param name The state to query.
+     * @return The value.
+     */
+    FLK_API i32 GetInteger(GLenum name);
 }
 
 #ifndef NDEBUG
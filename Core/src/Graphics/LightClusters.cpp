@@ -0,0 +1,305 @@
+#include "LightClusters.hpp"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cmath>
+
+#include "Graphics/Pipeline.hpp"
+#include "Jobs/JobSystem.hpp"
+#include "Math/Matrix.hpp"
+#include "Math/Utils.hpp"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define FLK_CLUSTERS_SSE
+#include <emmintrin.h>
+#elif defined(__ARM_NEON)
+#define FLK_CLUSTERS_NEON
+#include <arm_neon.h>
+#endif
+
+namespace Flock::Graphics {
+    namespace {
+        /**
+         * @brief Tests four spheres against an axis-aligned box.
+         * @return A 4-bit mask with bit i set if sphere i overlaps the box.
+         */
+        u32 SphereBoxMask4(
+            const f32 *    x,
+            const f32 *    y,
+            const f32 *    z,
+            const f32 *    radiusSq,
+            const Vector3f min,
+            const Vector3f max
+        ) {
+#if defined(FLK_CLUSTERS_SSE)
+            const __m128 zero = _mm_setzero_ps();
+
+            const __m128 cx = _mm_loadu_ps(x);
+            const __m128 cy = _mm_loadu_ps(y);
+            const __m128 cz = _mm_loadu_ps(z);
+
+            const __m128 dx = _mm_max_ps(zero, _mm_max_ps(_mm_sub_ps(_mm_set1_ps(min.x), cx), _mm_sub_ps(cx, _mm_set1_ps(max.x))));
+            const __m128 dy = _mm_max_ps(zero, _mm_max_ps(_mm_sub_ps(_mm_set1_ps(min.y), cy), _mm_sub_ps(cy, _mm_set1_ps(max.y))));
+            const __m128 dz = _mm_max_ps(zero, _mm_max_ps(_mm_sub_ps(_mm_set1_ps(min.z), cz), _mm_sub_ps(cz, _mm_set1_ps(max.z))));
+
+            const __m128 distSq = _mm_add_ps(_mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy)), _mm_mul_ps(dz, dz));
+
+            return static_cast<u32>(_mm_movemask_ps(_mm_cmple_ps(distSq, _mm_loadu_ps(radiusSq))));
+#elif defined(FLK_CLUSTERS_NEON)
+            const float32x4_t zero = vdupq_n_f32(0.0F);
+
+            const float32x4_t cx = vld1q_f32(x);
+            const float32x4_t cy = vld1q_f32(y);
+            const float32x4_t cz = vld1q_f32(z);
+
+            const float32x4_t dx = vmaxq_f32(zero, vmaxq_f32(vsubq_f32(vdupq_n_f32(min.x), cx), vsubq_f32(cx, vdupq_n_f32(max.x))));
+            const float32x4_t dy = vmaxq_f32(zero, vmaxq_f32(vsubq_f32(vdupq_n_f32(min.y), cy), vsubq_f32(cy, vdupq_n_f32(max.y))));
+            const float32x4_t dz = vmaxq_f32(zero, vmaxq_f32(vsubq_f32(vdupq_n_f32(min.z), cz), vsubq_f32(cz, vdupq_n_f32(max.z))));
+
+            const float32x4_t distSq = vaddq_f32(vaddq_f32(vmulq_f32(dx, dx), vmulq_f32(dy, dy)), vmulq_f32(dz, dz));
+            const uint32x4_t  hit    = vcleq_f32(distSq, vld1q_f32(radiusSq));
+
+            return (vgetq_lane_u32(hit, 0) & 1) | (vgetq_lane_u32(hit, 1) & 2) |
+                   (vgetq_lane_u32(hit, 2) & 4) | (vgetq_lane_u32(hit, 3) & 8);
+#else
+            u32 mask = 0;
+            for (u32 i = 0; i < 4; i++) {
+                const f32 dx = std::max({0.0F, min.x - x[i], x[i] - max.x});
+                const f32 dy = std::max({0.0F, min.y - y[i], y[i] - max.y});
+                const f32 dz = std::max({0.0F, min.z - z[i], z[i] - max.z});
+
+                if (dx * dx + dy * dy + dz * dz <= radiusSq[i]) {
+                    mask |= 1U << i;
+                }
+            }
+
+            return mask;
+#endif
+        }
+
+        Vector3f TransformPoint(const Matrix4f &mat, const Vector3f point) {
+            return {
+                point.x * mat.At(0, 0) + point.y * mat.At(1, 0) + point.z * mat.At(2, 0) + mat.At(3, 0),
+                point.x * mat.At(0, 1) + point.y * mat.At(1, 1) + point.z * mat.At(2, 1) + mat.At(3, 1),
+                point.x * mat.At(0, 2) + point.y * mat.At(1, 2) + point.z * mat.At(2, 2) + mat.At(3, 2),
+            };
+        }
+    }
+
+    LightClusters::LightClusters(const ClusterConfig config) : m_Config(config) {
+    }
+
+    bool LightClusters::Build(const std::vector<Light> &lights, const Camera &camera, const Rect2u viewport) {
+        Cull(lights, camera, viewport);
+
+        if (m_LightBuffer.GlId() == 0) {
+            m_LightBuffer = TextureBuffer::Create(TextureBufferFormat::RGBA32F);
+            m_GridBuffer  = TextureBuffer::Create(TextureBufferFormat::RG32U);
+            m_IndexBuffer = TextureBuffer::Create(TextureBufferFormat::R32U);
+        }
+
+        // Empty buffers still get a texel so every fetch stays in bounds.
+        static constexpr std::array<u32, 4> s_Empty = {};
+
+        const bool lightsSet = m_LightData.empty()
+                                   ? m_LightBuffer.SetData(s_Empty.data(), sizeof(s_Empty))
+                                   : m_LightBuffer.SetData(m_LightData.data(), m_LightData.size() * sizeof(f32));
+
+        const bool indicesSet = m_Indices.empty()
+                                    ? m_IndexBuffer.SetData(s_Empty.data(), sizeof(s_Empty))
+                                    : m_IndexBuffer.SetData(m_Indices.data(), m_Indices.size() * sizeof(u32));
+
+        const bool gridSet = m_GridBuffer.SetData(m_Grid.data(), m_Grid.size() * sizeof(u32));
+
+        return lightsSet && indicesSet && gridSet;
+    }
+
+    void LightClusters::Cull(const std::vector<Light> &lights, const Camera &camera, const Rect2u viewport) {
+        const auto [dimX, dimY, dimZ] = m_Config.dimensions;
+        const f32 aspectRatio = static_cast<f32>(viewport.aspect.x) / static_cast<f32>(std::max(viewport.aspect.y, 1U));
+
+        ComputeBounds(camera, aspectRatio);
+
+        m_Viewport = {
+            static_cast<f32>(viewport.origin.x),
+            static_cast<f32>(viewport.origin.y),
+            static_cast<f32>(viewport.aspect.x),
+            static_cast<f32>(viewport.aspect.y)
+        };
+
+        const f32 depthLog = std::log(camera.farZ / camera.nearZ);
+        m_Depth            = {
+            static_cast<f32>(dimZ) / depthLog,
+            -static_cast<f32>(dimZ) * std::log(camera.nearZ) / depthLog
+        };
+
+        const Matrix4f view = camera.ViewMatrix();
+
+        m_LightData.clear();
+        m_Slices.resize(dimZ);
+        for (auto &slice: m_Slices) {
+            slice.x.clear();
+            slice.y.clear();
+            slice.z.clear();
+            slice.radiusSq.clear();
+            slice.lights.clear();
+        }
+
+        // Lights are binned into the slices they span first, so each cluster only tests local lights.
+        for (const auto &light: lights) {
+            if (light.radius <= 0.0F) {
+                continue;
+            }
+
+            const u32      index   = m_LightData.size() / 8;
+            const Vector3f viewPos = TransformPoint(view, light.position);
+            const Vector3f color   = light.color.ToVector() * light.intensity;
+
+            m_LightData.insert(m_LightData.end(), {
+                light.position.x, light.position.y, light.position.z, light.radius,
+                color.x, color.y, color.z, 0.0F
+            });
+
+            for (u32 k = 0; k < dimZ; k++) {
+                const Aabb &bounds = m_Bounds[k * dimX * dimY];
+                if (viewPos.z + light.radius < bounds.min.z || viewPos.z - light.radius > bounds.max.z) {
+                    continue;
+                }
+
+                Slice &slice = m_Slices[k];
+                slice.x.push_back(viewPos.x);
+                slice.y.push_back(viewPos.y);
+                slice.z.push_back(viewPos.z);
+                slice.radiusSq.push_back(light.radius * light.radius);
+                slice.lights.push_back(index);
+            }
+        }
+
+        m_Grid.assign(static_cast<usize>(dimX) * dimY * dimZ * 2, 0);
+
+        Jobs::ParallelFor(dimZ, 1, [&](const usize begin, const usize end) {
+            for (usize k = begin; k < end; k++) {
+                CullSlice(k);
+            }
+        });
+
+        m_Indices.clear();
+        for (u32 k = 0; k < dimZ; k++) {
+            const u32 base = m_Indices.size();
+            for (usize c = static_cast<usize>(k) * dimX * dimY; c < static_cast<usize>(k + 1) * dimX * dimY; c++) {
+                m_Grid[c * 2] += base;
+            }
+
+            m_Indices.insert(m_Indices.end(), m_Slices[k].indices.begin(), m_Slices[k].indices.end());
+        }
+    }
+
+    void LightClusters::Bind(Pipeline &pipeline) const {
+        if (!pipeline.SetUniform("uLightData", m_LightBuffer)) {
+            return;
+        }
+
+        pipeline.SetUniform("uLightGrid", m_GridBuffer);
+        pipeline.SetUniform("uLightIndices", m_IndexBuffer);
+        pipeline.SetUniform("uClusterDimensions", Vector3f(m_Config.dimensions));
+        pipeline.SetUniform("uClusterDepth", m_Depth);
+        pipeline.SetUniform("uClusterViewport", m_Viewport);
+    }
+
+    ClusterConfig LightClusters::Config() const {
+        return m_Config;
+    }
+
+    usize LightClusters::ClusterCount() const {
+        return static_cast<usize>(m_Config.dimensions.x) * m_Config.dimensions.y * m_Config.dimensions.z;
+    }
+
+    std::vector<u32> LightClusters::ClusterLights(const usize cluster) const {
+        if (cluster * 2 + 1 >= m_Grid.size()) {
+            return {};
+        }
+
+        const auto begin = m_Indices.begin() + m_Grid[cluster * 2];
+        return {begin, begin + m_Grid[cluster * 2 + 1]};
+    }
+
+    void LightClusters::ComputeBounds(const Camera &camera, const f32 aspectRatio) {
+        const auto [dimX, dimY, dimZ] = m_Config.dimensions;
+        const bool perspective = camera.projection == Projection::Perspective;
+
+        // Half extents of the view volume, per unit of depth for perspective cameras.
+        const f32 halfY = perspective ? std::tan(DegreesToRadians(camera.fovY) / 2.0F) : camera.size;
+        const f32 halfX = halfY * aspectRatio;
+
+        m_Bounds.resize(static_cast<usize>(dimX) * dimY * dimZ);
+
+        for (u32 k = 0; k < dimZ; k++) {
+            const f32 nearZ = camera.nearZ * std::pow(camera.farZ / camera.nearZ, static_cast<f32>(k) / dimZ);
+            const f32 farZ  = camera.nearZ * std::pow(camera.farZ / camera.nearZ, static_cast<f32>(k + 1) / dimZ);
+
+            for (u32 j = 0; j < dimY; j++) {
+                const f32 y0 = (-1.0F + 2.0F * j / dimY) * halfY;
+                const f32 y1 = (-1.0F + 2.0F * (j + 1) / dimY) * halfY;
+
+                for (u32 i = 0; i < dimX; i++) {
+                    const f32 x0 = (-1.0F + 2.0F * i / dimX) * halfX;
+                    const f32 x1 = (-1.0F + 2.0F * (i + 1) / dimX) * halfX;
+
+                    Aabb &bounds = m_Bounds[(k * dimY + j) * dimX + i];
+                    if (perspective) {
+                        bounds.min = {std::min({x0 * nearZ, x0 * farZ}), std::min({y0 * nearZ, y0 * farZ}), nearZ};
+                        bounds.max = {std::max({x1 * nearZ, x1 * farZ}), std::max({y1 * nearZ, y1 * farZ}), farZ};
+                    } else {
+                        bounds.min = {x0, y0, nearZ};
+                        bounds.max = {x1, y1, farZ};
+                    }
+                }
+            }
+        }
+    }
+
+    void LightClusters::CullSlice(const u32 slice) {
+        const auto [dimX, dimY, dimZ] = m_Config.dimensions;
+
+        Slice &data = m_Slices[slice];
+        data.indices.clear();
+
+        // Pad to a multiple of four with spheres that can never overlap.
+        const usize count = data.lights.size();
+        for (usize i = count; i % 4 != 0; i++) {
+            data.x.push_back(0.0F);
+            data.y.push_back(0.0F);
+            data.z.push_back(0.0F);
+            data.radiusSq.push_back(-1.0F);
+        }
+
+        for (u32 j = 0; j < dimY; j++) {
+            for (u32 i = 0; i < dimX; i++) {
+                const usize cluster = (static_cast<usize>(slice) * dimY + j) * dimX + i;
+                const Aabb &bounds  = m_Bounds[cluster];
+                const u32   offset  = data.indices.size();
+
+                for (usize l = 0; l < count; l += 4) {
+                    u32 mask = SphereBoxMask4(
+                        &data.x[l],
+                        &data.y[l],
+                        &data.z[l],
+                        &data.radiusSq[l],
+                        bounds.min,
+                        bounds.max
+                    );
+
+                    while (mask != 0) {
+                        const u32 bit = std::countr_zero(mask);
+                        data.indices.push_back(data.lights[l + bit]);
+                        mask &= mask - 1;
+                    }
+                }
+
+                m_Grid[cluster * 2]     = offset;
+                m_Grid[cluster * 2 + 1] = data.indices.size() - offset;
+            }
+        }
+    }
+}
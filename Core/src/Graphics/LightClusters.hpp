@@ -0,0 +1,96 @@
+#ifndef FLK_LIGHTCLUSTERS_HPP
+#define FLK_LIGHTCLUSTERS_HPP
+
+#include <vector>
+
+#include "Common.hpp"
+#include "Camera.hpp"
+#include "Light.hpp"
+#include "TextureBuffer.hpp"
+#include "Math/Rect.hpp"
+#include "Math/Vector.hpp"
+
+namespace Flock::Graphics {
+    class Pipeline;
+
+    struct ClusterConfig {
+        Vector3u dimensions = {16, 9, 24}; // Screen tiles along x and y, exponential depth slices along z.
+    };
+
+    /**
+     * @class LightClusters
+     * @brief Bins point lights into a view frustum grid (froxels) so each fragment only shades nearby lights.
+     *
+     * Shaders read the result through three texture buffers:
+     * - uLightData (samplerBuffer): two texels per light, (position, radius) and (color * intensity, 0).
+     * - uLightGrid (usamplerBuffer): (offset, count) into uLightIndices per cluster.
+     * - uLightIndices (usamplerBuffer): light indices, grouped by cluster.
+     */
+    class FLK_API LightClusters {
+        struct Slice {
+            std::vector<f32> x, y, z, radiusSq;
+            std::vector<u32> lights;
+            std::vector<u32> indices;
+        };
+
+        struct Aabb {
+            Vector3f min;
+            Vector3f max;
+        };
+
+        ClusterConfig      m_Config;
+        std::vector<Slice> m_Slices;
+        std::vector<Aabb>  m_Bounds;
+        std::vector<f32>   m_LightData;
+        std::vector<u32>   m_Grid;
+        std::vector<u32>   m_Indices;
+        Vector2f           m_Depth    = {};
+        Vector4f           m_Viewport = {};
+
+        TextureBuffer m_LightBuffer;
+        TextureBuffer m_GridBuffer;
+        TextureBuffer m_IndexBuffer;
+
+    public:
+        explicit LightClusters(ClusterConfig config = {});
+
+        /**
+         * @brief Bins the lights on the CPU and uploads the result.
+         * @param lights The point lights, lights with a radius of 0 are skipped.
+         * @param camera The camera to build the grid for.
+         * @param viewport The viewport the grid covers.
+         * @return true if successful; false otherwise.
+         */
+        bool Build(const std::vector<Light> &lights, const Camera &camera, Rect2u viewport);
+
+        /**
+         * @brief Bins the lights on the CPU without touching the GPU.
+         * @param lights The point lights, lights with a radius of 0 are skipped.
+         * @param camera The camera to build the grid for.
+         * @param viewport The viewport the grid covers.
+         */
+        void Cull(const std::vector<Light> &lights, const Camera &camera, Rect2u viewport);
+
+        /**
+         * @brief Binds the light lists and grid uniforms to a pipeline.
+         * @param pipeline The pipeline, pipelines without clustered lighting are left untouched.
+         */
+        void Bind(Pipeline &pipeline) const;
+
+        [[nodiscard]] ClusterConfig Config() const;
+        [[nodiscard]] usize         ClusterCount() const;
+
+        /**
+         * @brief Gets the light indices of a cluster after Cull().
+         * @param cluster The cluster index, (z * dimensions.y + y) * dimensions.x + x.
+         * @return The light indices.
+         */
+        [[nodiscard]] std::vector<u32> ClusterLights(usize cluster) const;
+
+    private:
+        void ComputeBounds(const Camera &camera, f32 aspectRatio);
+        void CullSlice(u32 slice);
+    };
+}
+
+#endif //FLK_LIGHTCLUSTERS_HPP
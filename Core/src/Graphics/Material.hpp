@@ -1,12 +1,26 @@
 #ifndef FLK_MATERIAL_HPP
 #define FLK_MATERIAL_HPP
 
+#include <string>
+#include <vector>
+
 #include "Pipeline.hpp"
 #include "Asset/AssetHandle.hpp"
 #include "Math/Math.hpp"
 #include "Serial/Archive.hpp"
 
 namespace Flock::Graphics {
+    /**
+     * @enum RenderQueue
+     * @brief The bucket a draw is rendered in, buckets are drawn in declaration order.
+     */
+    enum class RenderQueue : u8 {
+        Opaque,      // Sorted front to back, no blending.
+        AlphaTested, // Sorted front to back, no blending, fragments below the alpha cutoff are discarded.
+        Transparent, // Sorted back to front, blended, no depth writes.
+        Overlay,     // Drawn last in submission order, blended, no depth test.
+    };
+
     struct FLK_API Material {
         Asset::AssetHandle<Pipeline> pipeline = Asset::AssetHandle<Pipeline>::FromPath("@PBR");
 
@@ -14,12 +28,19 @@ namespace Flock::Graphics {
         f32      metallic  = 0.25F;
         f32      roughness = 0.75F;
 
+        RenderQueue queue       = RenderQueue::Opaque;
+        f32         alphaCutoff = 0.5F;
+
         Asset::AssetHandle<Texture> colorMap     = Asset::AssetHandle<Texture>::FromPath("");
         Asset::AssetHandle<Texture> metallicMap  = Asset::AssetHandle<Texture>::FromPath("");
         Asset::AssetHandle<Texture> roughnessMap = Asset::AssetHandle<Texture>::FromPath("");
+
+        // Defined when the pipeline's file is compiled, picks a variant of it. See PipelineVariants.
+        std::vector<std::string> keywords = {};
     };
 
-    FLK_ARCHIVE(Material, pipeline, color, metallic, roughness, colorMap, metallicMap, roughnessMap)
+    FLK_ARCHIVE(Material, pipeline, color, metallic, roughness, queue, alphaCutoff, colorMap, metallicMap, roughnessMap,
+                keywords)
 }
 
 #endif //FLK_MATERIAL_HPP
@@ -0,0 +1,132 @@
+#include "MaterialTextures.hpp"
+
+#include <algorithm>
+#include <map>
+#include <optional>
+#include <ranges>
+#include <tuple>
+
+#include "Debug/Log.hpp"
+#include "Graphics/Framebuffer.hpp"
+#include "Graphics/Gl.hpp"
+#include "Graphics/StateCache.hpp"
+#include "Graphics/Texture.hpp"
+#include "glad/glad.h"
+
+namespace Flock::Graphics {
+    namespace {
+        // Textures that sample differently can't share an array, its config applies to every layer.
+        using GroupKey = std::tuple<u32, u32, FilterMode, FilterMode, WrapMode, bool>;
+
+        GroupKey KeyOf(const Texture &texture) {
+            const TextureConfig config = texture.Config();
+            const Vector2u      size   = texture.Size();
+
+            return {size.x, size.y, config.filterMode, config.mipmapFilterMode, config.wrapMode, config.generateMipmaps};
+        }
+    }
+
+    bool MaterialTextures::Pack(const std::span<const Texture *const> textures) {
+        Clear();
+
+        std::map<GroupKey, std::vector<const Texture *> > groups;
+        for (const Texture *texture: textures) {
+            if (!texture || texture->GlId() == 0 || m_Layers.contains(texture->GlId())) {
+                continue;
+            }
+
+            // Depth textures can't be copied into a color array.
+            const TextureConfig config = texture->Config();
+            if (config.format && config.format.value() == TextureFormat::Depth) {
+                continue;
+            }
+
+            m_Layers[texture->GlId()] = {};
+            groups[KeyOf(*texture)].push_back(texture);
+        }
+
+        if (groups.empty()) {
+            return true;
+        }
+
+        i32 maxLayers = 0;
+        FLK_GL_CALL(glGetIntegerv(GL_MAX_ARRAY_TEXTURE_LAYERS, &maxLayers));
+        const usize arrayLayers = std::max(maxLayers, 1);
+
+        // Reserved up front, layers point at their array.
+        usize arrayCount = 0;
+        for (const auto &group: groups | std::views::values) {
+            arrayCount += (group.size() + arrayLayers - 1) / arrayLayers;
+        }
+
+        m_Arrays.reserve(arrayCount);
+
+        std::optional<Framebuffer> framebuffer = Framebuffer::Create();
+        if (!framebuffer) {
+            Debug::LogErr("MaterialTextures::Pack: Failed to create framebuffer!");
+            Clear();
+            return false;
+        }
+
+        bool success = true;
+        for (const auto &group: groups | std::views::values) {
+            for (usize first = 0; first < group.size(); first += arrayLayers) {
+                const usize    count  = std::min(arrayLayers, group.size() - first);
+                const Vector2u size   = group[first]->Size();
+                TextureConfig  config = group[first]->Config();
+                config.format         = TextureFormat::Rgba;
+
+                TextureArray &array = m_Arrays.emplace_back(TextureArray::Create(count, size, config));
+
+                for (usize i = 0; i < count; i++) {
+                    const Texture &texture = *group[first + i];
+                    if (!framebuffer->Attach(Attachment::Color, texture) || !framebuffer->Bind()) {
+                        Debug::LogErr("MaterialTextures::Pack: Failed to read texture {}!", texture.GlId());
+                        m_Layers.erase(texture.GlId());
+                        success = false;
+                        continue;
+                    }
+
+                    // A GPU side copy, the image data doesn't have to be kept around after loading.
+                    StateCache::BindTexture(0, GL_TEXTURE_2D_ARRAY, array.GlId());
+                    FLK_GL_CALL(glCopyTexSubImage3D(GL_TEXTURE_2D_ARRAY, 0, 0, 0, i, 0, 0, size.x, size.y));
+
+                    m_Layers[texture.GlId()] = {.array = &array, .layer = static_cast<i32>(i)};
+                }
+
+                if (config.generateMipmaps) {
+                    StateCache::BindTexture(0, GL_TEXTURE_2D_ARRAY, array.GlId());
+                    FLK_GL_CALL(glGenerateMipmap(GL_TEXTURE_2D_ARRAY));
+                }
+            }
+        }
+
+        Framebuffer::Unbind();
+
+        return success;
+    }
+
+    TextureLayer MaterialTextures::Find(const Texture *texture) const {
+        if (!texture) {
+            return {};
+        }
+
+        const auto it = m_Layers.find(texture->GlId());
+        return it != m_Layers.end() ? it->second : TextureLayer{};
+    }
+
+    void MaterialTextures::Clear() {
+        m_Layers.clear();
+        m_Arrays.clear();
+    }
+
+    usize MaterialTextures::ArrayCount() const {
+        return m_Arrays.size();
+    }
+
+    usize MaterialTextures::LayerCount() const {
+        return std::ranges::count_if(m_Layers | std::views::values, [](const TextureLayer &layer) {
+            return layer.array != nullptr;
+        });
+    }
+}
@@ -0,0 +1,54 @@
+#ifndef FLK_MATERIALTEXTURES_HPP
+#define FLK_MATERIALTEXTURES_HPP
+
+#include <span>
+#include <unordered_map>
+#include <vector>
+
+#include "Common.hpp"
+#include "TextureArray.hpp"
+
+namespace Flock::Graphics {
+    class Texture;
+
+    /**
+     * @struct TextureLayer
+     * @brief Where a material texture was packed.
+     */
+    struct TextureLayer {
+        const TextureArray *array = nullptr;
+        i32                 layer = -1; // Negative if the texture isn't packed.
+    };
+
+    /**
+     * @class MaterialTextures
+     * @brief Copies of material textures packed into texture arrays, one array per size and sampling config.
+     *
+     * Draws whose maps all live in the same arrays can be instanced, picking their layers from instance data
+     * instead of binding textures in between.
+     */
+    class FLK_API MaterialTextures {
+        std::vector<TextureArray>             m_Arrays;
+        std::unordered_map<u32, TextureLayer> m_Layers; // By the GL ID of the source texture.
+
+    public:
+        /**
+         * @brief Replaces the arrays with copies of the textures, textures sharing a size and config share an array.
+         * @param textures The textures to pack, null and duplicate entries are skipped.
+         * @return true if successful; false otherwise.
+         */
+        bool Pack(std::span<const Texture *const> textures);
+
+        /**
+         * @return The layer of a packed texture; an empty layer if it wasn't packed.
+         */
+        [[nodiscard]] TextureLayer Find(const Texture *texture) const;
+
+        void Clear();
+
+        [[nodiscard]] usize ArrayCount() const;
+        [[nodiscard]] usize LayerCount() const;
+    };
+}
+
+#endif //FLK_MATERIALTEXTURES_HPP
@@ -4,19 +4,51 @@
 
 #include "Graphics/Vertex.hpp"
 #include "Graphics/VertexArray.hpp"
+#include "glad/glad.h"
 #include "Memory/Buffer.hpp"
 
 namespace Flock::Graphics {
-    std::optional<Mesh> Mesh::Create(const MeshData &data) {
+    u32 ToGlType(const IndexType type) {
+        switch (type) {
+            case IndexType::U16:
+                return GL_UNSIGNED_SHORT;
+            case IndexType::U32:
+                return GL_UNSIGNED_INT;
+            default:
+                return 0;
+        }
+    }
+
+    namespace {
+        Memory::Buffer PackIndices(const std::vector<u32> &indices, const IndexType type) {
+            if (type == IndexType::U16) {
+                return std::vector<u16>(indices.begin(), indices.end());
+            }
+
+            return indices;
+        }
+
+        IndexType ChooseIndexType(const MeshData &data) {
+            return data.vertices.size() <= 0x10000 ? IndexType::U16 : IndexType::U32;
+        }
+    }
+
+    std::optional<Mesh> Mesh::Create(const MeshData &data, const VertexFormat format, const bool positionStream) {
         Mesh mesh{};
 
         mesh.m_Data = data;
 
+        const PackedVertices packed = PackVertices(data.vertices, format);
+        mesh.m_Format               = format;
+        mesh.m_Dequantize           = packed.dequantize;
+
         mesh.m_VertexArray  = VertexArray::Create();
-        mesh.m_VertexBuffer = Buffer::Create(data.vertices, BufferType::Vertex);
-        mesh.m_IndexBuffer  = Buffer::Create(data.indices, BufferType::Index);
+        mesh.m_VertexBuffer = Buffer::Create(packed.data, BufferType::Vertex);
 
-        if (!mesh.m_VertexArray.SetVertexBuffer(mesh.m_VertexBuffer, Vertex::Layout())) {
+        mesh.m_IndexType   = ChooseIndexType(data);
+        mesh.m_IndexBuffer = Buffer::Create(PackIndices(data.indices, mesh.m_IndexType), BufferType::Index);
+
+        if (!mesh.m_VertexArray.SetVertexBuffer(mesh.m_VertexBuffer, packed.layout)) {
             return std::nullopt;
         }
 
@@ -24,12 +56,61 @@ namespace Flock::Graphics {
             return std::nullopt;
         }
 
+        if (positionStream) {
+            const PackedVertices positions = PackPositions(data.vertices, format);
+
+            // Shares the index buffer, the element array binding is per vertex array.
+            mesh.m_DepthVertexArray = VertexArray::Create();
+            mesh.m_PositionBuffer   = Buffer::Create(positions.data, BufferType::Vertex);
+
+            if (!mesh.m_DepthVertexArray.SetVertexBuffer(mesh.m_PositionBuffer, positions.layout)) {
+                return std::nullopt;
+            }
+
+            if (!mesh.m_DepthVertexArray.SetIndexBuffer(mesh.m_IndexBuffer)) {
+                return std::nullopt;
+            }
+
+            mesh.m_PositionStream = true;
+        }
+
         mesh.m_IndexCount  = data.indices.size();
         mesh.m_Initialized = true;
 
         return mesh;
     }
 
+    std::optional<Mesh> Mesh::Create(const MeshData &data, GeometryPool &pool, const VertexFormat format) {
+        Mesh mesh{};
+
+        mesh.m_Data = data;
+
+        const PackedVertices packed    = PackVertices(data.vertices, format);
+        const PackedVertices positions = PackPositions(data.vertices, format);
+        mesh.m_Format                  = format;
+        mesh.m_Dequantize              = packed.dequantize;
+        mesh.m_IndexType               = ChooseIndexType(data);
+
+        std::optional<GeometryAllocation> allocation = pool.Allocate(
+            format,
+            packed,
+            positions,
+            data.vertices.size(),
+            PackIndices(data.indices, mesh.m_IndexType)
+        );
+
+        if (!allocation) {
+            return std::nullopt;
+        }
+
+        mesh.m_Allocation     = std::move(*allocation);
+        mesh.m_IndexCount     = data.indices.size();
+        mesh.m_PositionStream = true;
+        mesh.m_Initialized    = true;
+
+        return mesh;
+    }
+
     Mesh Mesh::Square(const Vector2f halfExtents) {
         const Vector2f h = halfExtents;
 
@@ -101,19 +182,45 @@ namespace Flock::Graphics {
         return Create({.vertices = vertices, .indices = indices}).value();
     }
 
+    const Mesh &Mesh::Builtin(const Primitive primitive) {
+        switch (primitive) {
+            case Primitive::Box: {
+                static const Mesh box = Box();
+                return box;
+            }
+            case Primitive::Square:
+            default: {
+                static const Mesh square = Square();
+                return square;
+            }
+        }
+    }
+
     Mesh::~Mesh() {
         Clear();
     }
 
     void Mesh::Clear() {
         m_VertexArray.Clear();
+        m_DepthVertexArray.Clear();
         m_VertexBuffer.Clear();
+        m_PositionBuffer.Clear();
         m_IndexBuffer.Clear();
-        m_IndexCount = 0;
+        m_Allocation.Release();
+        m_IndexCount     = 0;
+        m_PositionStream = false;
     }
 
     bool Mesh::Bind() const {
-        return m_VertexArray.Bind();
+        return m_Allocation ? m_Allocation.Bind() : m_VertexArray.Bind();
+    }
+
+    bool Mesh::BindDepth() const {
+        if (m_Allocation) {
+            return m_Allocation.BindDepth();
+        }
+
+        return m_PositionStream ? m_DepthVertexArray.Bind() : m_VertexArray.Bind();
     }
 
     void Mesh::Unbind() {
@@ -124,6 +231,34 @@ namespace Flock::Graphics {
         return m_IndexCount;
     }
 
+    IndexType Mesh::GetIndexType() const {
+        return m_IndexType;
+    }
+
+    usize Mesh::IndexOffset() const {
+        return m_Allocation.IndexOffset();
+    }
+
+    i32 Mesh::BaseVertex() const {
+        return m_Allocation.BaseVertex();
+    }
+
+    bool Mesh::IsPooled() const {
+        return static_cast<bool>(m_Allocation);
+    }
+
+    VertexFormat Mesh::Format() const {
+        return m_Format;
+    }
+
+    bool Mesh::HasPositionStream() const {
+        return m_PositionStream;
+    }
+
+    const Matrix4f &Mesh::Dequantize() const {
+        return m_Dequantize;
+    }
+
     const MeshData &Mesh::Data() const {
         return m_Data;
     }
@@ -5,9 +5,11 @@
 #include <vector>
 
 #include "Common.hpp"
+#include "GeometryPool.hpp"
 #include "Vertex.hpp"
 #include "VertexArray.hpp"
 #include "Graphics/Buffer.hpp"
+#include "Math/Matrix.hpp"
 #include "Math/Vector.hpp"
 
 namespace Flock::Graphics {
@@ -20,16 +22,45 @@ namespace Flock::Graphics {
         std::vector<u32>    indices;
     };
 
+    /**
+     * @enum IndexType
+     * @brief The size of the indices in a mesh's index buffer.
+     */
+    enum class IndexType : u8 {
+        U16,
+        U32,
+    };
+
+    u32 ToGlType(IndexType type);
+
+    /**
+     * @enum Primitive
+     * @brief A built-in mesh, see Mesh::Builtin().
+     */
+    enum class Primitive : u8 {
+        Square, // Mesh::Square() with the default half extents.
+        Box,    // Mesh::Box() with the default half extents.
+    };
+
     /**
      * @class Mesh
      * @brief If you don't know what a mesh is then you shouldn't be here.
      */
     class FLK_API Mesh {
         VertexArray m_VertexArray;
+        VertexArray m_DepthVertexArray;
         Buffer      m_VertexBuffer;
+        Buffer      m_PositionBuffer;
         Buffer      m_IndexBuffer;
-        usize       m_IndexCount  = 0;
-        bool        m_Initialized = false;
+        usize       m_IndexCount     = 0;
+        IndexType   m_IndexType      = IndexType::U32;
+        bool        m_Initialized    = false;
+        bool        m_PositionStream = false;
+
+        GeometryAllocation m_Allocation;
+
+        VertexFormat m_Format     = VertexFormat::Standard;
+        Matrix4f     m_Dequantize = {};
 
         MeshData m_Data;
 
@@ -37,9 +68,29 @@ namespace Flock::Graphics {
         /**
          * @brief Static factory method.
          * @param data The mesh data.
+         * @param format The format to store the vertices in on the GPU, the mesh data is kept as is.
+         * Meshes with fewer than 65536 vertices get 16-bit indices.
+         * @param positionStream Whether to also upload a position-only vertex buffer for depth-only passes.
+         * @return The mesh if successful; std::nullopt otherwise.
+         */
+        static std::optional<Mesh> Create(
+            const MeshData &data,
+            VertexFormat    format         = VertexFormat::Standard,
+            bool            positionStream = true
+        );
+
+        /**
+         * @brief Static factory method, suballocates the mesh from a pool instead of creating its own buffers.
+         * @param data The mesh data.
+         * @param pool The pool, which must outlive the mesh.
+         * @param format The format to store the vertices in on the GPU, the mesh data is kept as is.
          * @return The mesh if successful; std::nullopt otherwise.
          */
-        static std::optional<Mesh> Create(const MeshData &data);
+        static std::optional<Mesh> Create(
+            const MeshData &data,
+            GeometryPool &  pool,
+            VertexFormat    format = VertexFormat::Standard
+        );
 
         /**
          * @brief Static factory method.
@@ -55,6 +106,13 @@ namespace Flock::Graphics {
          */
         static Mesh Box(Vector3f halfExtents = Vector3f::One() * 0.5F);
 
+        /**
+         * @brief Gets a shared built-in mesh, created on first use with the context current.
+         * @param primitive The primitive.
+         * @return The mesh, valid until the program exits.
+         */
+        static const Mesh &Builtin(Primitive primitive);
+
         Mesh() = default;
         ~Mesh();
 
@@ -75,6 +133,13 @@ namespace Flock::Graphics {
          */
         bool Bind() const;
 
+        /**
+         * @brief Binds the position-only vertex array, or the full one if the mesh has no position stream.
+         * Only attribute 0 is guaranteed to be set, so this is meant for depth-only pipelines.
+         * @return true if successful; false otherwise.
+         */
+        bool BindDepth() const;
+
         /**
          * @brief Unbinds the currently bound mesh.
          */
@@ -83,7 +148,27 @@ namespace Flock::Graphics {
         /**
          * @return The index count of the mesh.
          */
-        [[nodiscard]] usize IndexCount() const;
+        [[nodiscard]] usize     IndexCount() const;
+        [[nodiscard]] IndexType GetIndexType() const;
+
+        /**
+         * @return The offset of the first index in bytes, 0 unless the mesh is pooled.
+         */
+        [[nodiscard]] usize IndexOffset() const;
+
+        /**
+         * @return The value added to every index when drawing, 0 unless the mesh is pooled.
+         */
+        [[nodiscard]] i32  BaseVertex() const;
+        [[nodiscard]] bool IsPooled() const;
+
+        [[nodiscard]] VertexFormat Format() const;
+        [[nodiscard]] bool         HasPositionStream() const;
+
+        /**
+         * @return The matrix mapping stored positions back to model space, identity unless the format is Quantized.
+         */
+        [[nodiscard]] const Matrix4f &Dequantize() const;
 
         [[nodiscard]] const MeshData &Data() const;
     };
@@ -0,0 +1,502 @@
+#include "MeshLod.hpp"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cmath>
+#include <queue>
+#include <unordered_map>
+
+#include "Math/Math.hpp"
+
+namespace Flock::Graphics {
+    namespace {
+        // Symmetric 4x4 plane quadric, a b c d for ax + by + cz + d = 0.
+        struct Quadric {
+            std::array<f64, 10> q = {};
+
+            static Quadric FromPlane(const f64 a, const f64 b, const f64 c, const f64 d, const f64 weight) {
+                Quadric quadric;
+                quadric.q = {a * a, a * b, a * c, a * d, b * b, b * c, b * d, c * c, c * d, d * d};
+                for (auto &value: quadric.q) {
+                    value *= weight;
+                }
+
+                return quadric;
+            }
+
+            Quadric &operator+=(const Quadric &other) {
+                for (usize i = 0; i < q.size(); i++) {
+                    q[i] += other.q[i];
+                }
+
+                return *this;
+            }
+
+            [[nodiscard]] f64 Error(const Vector3f &p) const {
+                const f64 x = p.x, y = p.y, z = p.z;
+                return q[0] * x * x + 2 * q[1] * x * y + 2 * q[2] * x * z + 2 * q[3] * x
+                       + q[4] * y * y + 2 * q[5] * y * z + 2 * q[6] * y
+                       + q[7] * z * z + 2 * q[8] * z
+                       + q[9];
+            }
+        };
+
+        struct Collapse {
+            f64 error;
+            u32 from;
+            u32 to;
+            u32 fromVersion;
+            u32 toVersion;
+
+            bool operator>(const Collapse &other) const {
+                return error > other.error;
+            }
+        };
+
+        struct PositionHash {
+            usize operator()(const std::array<u32, 3> &key) const {
+                return (key[0] * 73856093U) ^ (key[1] * 19349663U) ^ (key[2] * 83492791U);
+            }
+        };
+
+        u64 EdgeKey(const u32 a, const u32 b) {
+            return a < b ? (static_cast<u64>(a) << 32) | b : (static_cast<u64>(b) << 32) | a;
+        }
+
+        f32 AttributeDistance(const Vertex &lhs, const Vertex &rhs) {
+            const Vector2f uv = lhs.texCoords - rhs.texCoords;
+            return 1.0F - lhs.normal.Dot(rhs.normal) + uv.x * uv.x + uv.y * uv.y;
+        }
+
+        class Simplifier {
+            const MeshData &m_Data;
+
+            std::vector<u32>     m_Remap;     // Vertex -> canonical vertex sharing its position.
+            std::vector<u32>     m_WedgeOffsets;
+            std::vector<u32>     m_Wedges;    // Vertices of each canonical vertex, grouped.
+            std::vector<Quadric> m_Quadrics;
+            std::vector<u32>     m_Versions;
+            std::vector<bool>    m_Locked;
+            std::vector<bool>    m_Alive;
+
+            std::vector<u32>              m_Indices;
+            std::vector<bool>             m_Removed;
+            std::vector<std::vector<u32>> m_Triangles; // Canonical vertex -> triangles using it.
+            usize                         m_LiveTriangles = 0;
+
+            std::priority_queue<Collapse, std::vector<Collapse>, std::greater<>> m_Queue;
+
+        public:
+            explicit Simplifier(const MeshData &data) : m_Data(data), m_Indices(data.indices) {
+                Weld();
+                BuildAdjacency();
+                BuildQuadrics();
+
+                for (u32 t = 0; t < m_Removed.size(); t++) {
+                    for (u32 c = 0; c < 3; c++) {
+                        const u32 a = Corner(t, c);
+                        const u32 b = Corner(t, (c + 1) % 3);
+
+                        if (a < b) {
+                            Push(a, b);
+                        }
+                    }
+                }
+            }
+
+            MeshData Run(const usize targetTriangles) {
+                while (m_LiveTriangles > targetTriangles && !m_Queue.empty()) {
+                    const Collapse collapse = m_Queue.top();
+                    m_Queue.pop();
+
+                    const bool stale = !m_Alive[collapse.from] || !m_Alive[collapse.to] ||
+                                       m_Versions[collapse.from] != collapse.fromVersion ||
+                                       m_Versions[collapse.to] != collapse.toVersion;
+
+                    if (stale || !CanCollapse(collapse.from, collapse.to)) {
+                        continue;
+                    }
+
+                    Apply(collapse.from, collapse.to);
+                }
+
+                return Compact();
+            }
+
+        private:
+            [[nodiscard]] u32 Corner(const u32 triangle, const u32 corner) const {
+                return m_Remap[m_Indices[triangle * 3 + corner]];
+            }
+
+            [[nodiscard]] const Vector3f &Position(const u32 vertex) const {
+                return m_Data.vertices[vertex].position;
+            }
+
+            void Weld() {
+                const usize vertexCount = m_Data.vertices.size();
+
+                std::unordered_map<std::array<u32, 3>, u32, PositionHash> positions;
+                positions.reserve(vertexCount);
+
+                m_Remap.resize(vertexCount);
+                std::vector<u32> wedgeCounts(vertexCount + 1, 0);
+                for (u32 v = 0; v < vertexCount; v++) {
+                    const Vector3f &p   = Position(v);
+                    const auto      key = std::array{std::bit_cast<u32>(p.x), std::bit_cast<u32>(p.y), std::bit_cast<u32>(p.z)};
+
+                    m_Remap[v] = positions.try_emplace(key, v).first->second;
+                    wedgeCounts[m_Remap[v] + 1]++;
+                }
+
+                m_WedgeOffsets.resize(vertexCount + 1, 0);
+                for (usize v = 0; v < vertexCount; v++) {
+                    m_WedgeOffsets[v + 1] = m_WedgeOffsets[v] + wedgeCounts[v + 1];
+                }
+
+                std::vector<u32> cursor(m_WedgeOffsets.begin(), m_WedgeOffsets.end() - 1);
+                m_Wedges.resize(vertexCount);
+                for (u32 v = 0; v < vertexCount; v++) {
+                    m_Wedges[cursor[m_Remap[v]]++] = v;
+                }
+
+                m_Versions.assign(vertexCount, 0);
+                m_Alive.assign(vertexCount, true);
+                m_Locked.assign(vertexCount, false);
+            }
+
+            void BuildAdjacency() {
+                const usize triangleCount = m_Indices.size() / 3;
+                m_Removed.assign(triangleCount, false);
+                m_Triangles.resize(m_Data.vertices.size());
+                m_LiveTriangles = triangleCount;
+
+                std::unordered_map<u64, u32> edgeUses;
+                edgeUses.reserve(triangleCount * 3);
+
+                for (u32 t = 0; t < triangleCount; t++) {
+                    for (u32 c = 0; c < 3; c++) {
+                        m_Triangles[Corner(t, c)].push_back(t);
+                        edgeUses[EdgeKey(Corner(t, c), Corner(t, (c + 1) % 3))]++;
+                    }
+                }
+
+                // Moving a vertex on an open border would tear a hole, so those stay put.
+                for (const auto &[edge, uses]: edgeUses) {
+                    if (uses == 1) {
+                        m_Locked[edge >> 32]        = true;
+                        m_Locked[edge & 0xFFFFFFFF] = true;
+                    }
+                }
+            }
+
+            void BuildQuadrics() {
+                m_Quadrics.assign(m_Data.vertices.size(), {});
+
+                for (u32 t = 0; t < m_Removed.size(); t++) {
+                    const Vector3f &p0 = Position(Corner(t, 0));
+                    const Vector3f &p1 = Position(Corner(t, 1));
+                    const Vector3f &p2 = Position(Corner(t, 2));
+
+                    const Vector3f normal = (p1 - p0).Cross(p2 - p0);
+                    const f64      area   = normal.Magnitude();
+                    if (area == 0.0) {
+                        continue;
+                    }
+
+                    const Vector3f n = normal / static_cast<f32>(area);
+                    const Quadric  q = Quadric::FromPlane(n.x, n.y, n.z, -n.Dot(p0), area * 0.5);
+
+                    for (u32 c = 0; c < 3; c++) {
+                        m_Quadrics[Corner(t, c)] += q;
+                    }
+                }
+            }
+
+            void Push(const u32 a, const u32 b) {
+                Quadric q = m_Quadrics[a];
+                q         += m_Quadrics[b];
+
+                // Only the cheaper direction is queued, a vertex always collapses onto the position of another.
+                const f64 errorAb = m_Locked[a] ? INFINITY : q.Error(Position(b));
+                const f64 errorBa = m_Locked[b] ? INFINITY : q.Error(Position(a));
+
+                if (std::isinf(errorAb) && std::isinf(errorBa)) {
+                    return;
+                }
+
+                const u32 from = errorAb <= errorBa ? a : b;
+                const u32 to   = from == a ? b : a;
+
+                m_Queue.push({std::min(errorAb, errorBa), from, to, m_Versions[from], m_Versions[to]});
+            }
+
+            [[nodiscard]] bool Contains(const u32 triangle, const u32 vertex) const {
+                return Corner(triangle, 0) == vertex || Corner(triangle, 1) == vertex || Corner(triangle, 2) == vertex;
+            }
+
+            void Neighbors(const u32 vertex, std::vector<u32> &out) const {
+                out.clear();
+                for (const u32 t: m_Triangles[vertex]) {
+                    if (m_Removed[t]) {
+                        continue;
+                    }
+
+                    for (u32 c = 0; c < 3; c++) {
+                        if (Corner(t, c) != vertex) {
+                            out.push_back(Corner(t, c));
+                        }
+                    }
+                }
+
+                std::sort(out.begin(), out.end());
+                out.erase(std::unique(out.begin(), out.end()), out.end());
+            }
+
+            [[nodiscard]] bool CanCollapse(const u32 from, const u32 to) {
+                static thread_local std::vector<u32> fromNeighbors;
+                static thread_local std::vector<u32> toNeighbors;
+
+                Neighbors(from, fromNeighbors);
+                Neighbors(to, toNeighbors);
+
+                usize shared = 0;
+                for (const u32 t: m_Triangles[from]) {
+                    if (!m_Removed[t] && Contains(t, to)) {
+                        shared++;
+                    }
+                }
+
+                if (shared == 0) {
+                    return false;
+                }
+
+                // Link condition: every common neighbor must come from a triangle on the edge, or the result is non-manifold.
+                usize common = 0;
+                for (usize i = 0, j = 0; i < fromNeighbors.size() && j < toNeighbors.size();) {
+                    if (fromNeighbors[i] == toNeighbors[j]) {
+                        common++;
+                        i++;
+                        j++;
+                    } else if (fromNeighbors[i] < toNeighbors[j]) {
+                        i++;
+                    } else {
+                        j++;
+                    }
+                }
+
+                if (common != shared) {
+                    return false;
+                }
+
+                // Reject collapses that flip or squash the triangles around the moved vertex.
+                for (const u32 t: m_Triangles[from]) {
+                    if (m_Removed[t] || Contains(t, to)) {
+                        continue;
+                    }
+
+                    std::array<Vector3f, 3> before;
+                    std::array<Vector3f, 3> after;
+                    for (u32 c = 0; c < 3; c++) {
+                        before[c] = Position(Corner(t, c));
+                        after[c]  = Corner(t, c) == from ? Position(to) : before[c];
+                    }
+
+                    const Vector3f oldNormal = (before[1] - before[0]).Cross(before[2] - before[0]);
+                    const Vector3f newNormal = (after[1] - after[0]).Cross(after[2] - after[0]);
+
+                    if (oldNormal.Dot(newNormal) <= 0.2 * oldNormal.Magnitude() * newNormal.Magnitude()) {
+                        return false;
+                    }
+                }
+
+                return true;
+            }
+
+            [[nodiscard]] u32 ClosestWedge(const u32 vertex, const u32 canonical) const {
+                u32 closest  = m_Wedges[m_WedgeOffsets[canonical]];
+                f32 distance = INFINITY;
+
+                for (u32 w = m_WedgeOffsets[canonical]; w < m_WedgeOffsets[canonical + 1]; w++) {
+                    const f32 d = AttributeDistance(m_Data.vertices[vertex], m_Data.vertices[m_Wedges[w]]);
+                    if (d < distance) {
+                        distance = d;
+                        closest  = m_Wedges[w];
+                    }
+                }
+
+                return closest;
+            }
+
+            void Apply(const u32 from, const u32 to) {
+                for (const u32 t: m_Triangles[from]) {
+                    if (m_Removed[t]) {
+                        continue;
+                    }
+
+                    if (Contains(t, to)) {
+                        m_Removed[t] = true;
+                        m_LiveTriangles--;
+                        continue;
+                    }
+
+                    for (u32 c = 0; c < 3; c++) {
+                        u32 &index = m_Indices[t * 3 + c];
+                        if (m_Remap[index] == from) {
+                            index = ClosestWedge(index, to);
+                        }
+                    }
+
+                    m_Triangles[to].push_back(t);
+                }
+
+                m_Alive[from] = false;
+                m_Triangles[from].clear();
+                m_Triangles[from].shrink_to_fit();
+                m_Quadrics[to] += m_Quadrics[from];
+                m_Versions[to]++;
+
+                std::erase_if(m_Triangles[to], [&](const u32 t) { return m_Removed[t]; });
+
+                static thread_local std::vector<u32> neighbors;
+                Neighbors(to, neighbors);
+                for (const u32 neighbor: neighbors) {
+                    Push(to, neighbor);
+                }
+            }
+
+            MeshData Compact() const {
+                MeshData         result;
+                std::vector<u32> newIndex(m_Data.vertices.size(), UINT32_MAX);
+
+                for (u32 t = 0; t < m_Removed.size(); t++) {
+                    if (m_Removed[t]) {
+                        continue;
+                    }
+
+                    const u32 a = Corner(t, 0), b = Corner(t, 1), c = Corner(t, 2);
+                    if (a == b || b == c || a == c) {
+                        continue;
+                    }
+
+                    for (u32 corner = 0; corner < 3; corner++) {
+                        const u32 vertex = m_Indices[t * 3 + corner];
+                        if (newIndex[vertex] == UINT32_MAX) {
+                            newIndex[vertex] = result.vertices.size();
+                            result.vertices.push_back(m_Data.vertices[vertex]);
+                        }
+
+                        result.indices.push_back(newIndex[vertex]);
+                    }
+                }
+
+                return result;
+            }
+        };
+    }
+
+    BoundingSphere BoundingSphere::FromMesh(const MeshData &data) {
+        if (data.vertices.empty()) {
+            return {};
+        }
+
+        Vector3f min = data.vertices[0].position;
+        Vector3f max = data.vertices[0].position;
+        for (const auto &vertex: data.vertices) {
+            min = {std::min(min.x, vertex.position.x), std::min(min.y, vertex.position.y), std::min(min.z, vertex.position.z)};
+            max = {std::max(max.x, vertex.position.x), std::max(max.y, vertex.position.y), std::max(max.z, vertex.position.z)};
+        }
+
+        BoundingSphere sphere = {.center = (min + max) * 0.5F};
+        for (const auto &vertex: data.vertices) {
+            sphere.radius = std::max(sphere.radius, static_cast<f32>((vertex.position - sphere.center).Magnitude()));
+        }
+
+        return sphere;
+    }
+
+    BoundingSphere BoundingSphere::Transformed(const Transform &transform) const {
+        const Matrix4f m = transform.Matrix();
+
+        Vector3f worldCenter;
+        worldCenter.x = center.x * m.At(0, 0) + center.y * m.At(1, 0) + center.z * m.At(2, 0) + m.At(3, 0);
+        worldCenter.y = center.x * m.At(0, 1) + center.y * m.At(1, 1) + center.z * m.At(2, 1) + m.At(3, 1);
+        worldCenter.z = center.x * m.At(0, 2) + center.y * m.At(1, 2) + center.z * m.At(2, 2) + m.At(3, 2);
+
+        const f32 scale = std::max({std::abs(transform.scale.x), std::abs(transform.scale.y), std::abs(transform.scale.z)});
+
+        return {.center = worldCenter, .radius = radius * scale};
+    }
+
+    MeshData SimplifyMesh(const MeshData &data, const usize targetTriangles) {
+        if (data.indices.size() / 3 <= targetTriangles) {
+            return data;
+        }
+
+        return Simplifier(data).Run(targetTriangles);
+    }
+
+    std::vector<MeshData> GenerateLods(const MeshData &data, const LodConfig &config) {
+        const usize triangleCount = data.indices.size() / 3;
+        if (triangleCount < config.minTriangles) {
+            return {};
+        }
+
+        std::vector<MeshData> lods;
+        const MeshData *      previous = &data;
+
+        for (const f32 ratio: config.ratios) {
+            const usize target = static_cast<usize>(static_cast<f32>(triangleCount) * ratio);
+            MeshData    lod    = SimplifyMesh(*previous, target);
+
+            // A level that barely shrinks costs memory without saving any work.
+            if (lod.indices.empty() || lod.indices.size() > previous->indices.size() * 9 / 10) {
+                break;
+            }
+
+            lods.push_back(std::move(lod));
+            previous = &lods.back();
+        }
+
+        return lods;
+    }
+
+    f32 ScreenCoverage(const BoundingSphere &sphere, const Camera &camera) {
+        if (camera.projection == Projection::Orthographic) {
+            return std::min(sphere.radius / camera.size, 1.0F);
+        }
+
+        const f32 distance = (sphere.center - camera.transform.position).Magnitude();
+        if (distance <= sphere.radius) {
+            return 1.0F;
+        }
+
+        const f32 halfHeight = distance * std::tan(DegreesToRadians(camera.fovY) * 0.5F);
+        return std::min(sphere.radius / halfHeight, 1.0F);
+    }
+
+    u32 SelectLod(const f32 coverage, u32 current, const usize levelCount, const LodConfig &config) {
+        const usize levels = std::min(levelCount, config.coverages.size() + 1);
+        if (levels <= 1) {
+            return 0;
+        }
+
+        current = std::min<u32>(current, levels - 1);
+
+        u32 target = 0;
+        while (target + 1 < levels && coverage < config.coverages[target]) {
+            target++;
+        }
+
+        // Switching only once the coverage is clear of the threshold keeps objects near it from popping every frame.
+        while (current < target && coverage < config.coverages[current] * (1.0F - config.hysteresis)) {
+            current++;
+        }
+
+        while (current > target && coverage > config.coverages[current - 1] * (1.0F + config.hysteresis)) {
+            current--;
+        }
+
+        return current;
+    }
+}
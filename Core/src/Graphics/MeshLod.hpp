@@ -0,0 +1,73 @@
+#ifndef FLK_MESHLOD_HPP
+#define FLK_MESHLOD_HPP
+
+#include <vector>
+
+#include "Common.hpp"
+#include "Camera.hpp"
+#include "Mesh.hpp"
+#include "Math/Transform.hpp"
+#include "Math/Vector.hpp"
+
+namespace Flock::Graphics {
+    struct LodConfig {
+        std::vector<f32> ratios       = {0.5F, 0.25F, 0.1F}; // Triangle ratio of each level past LOD 0, relative to LOD 0.
+        std::vector<f32> coverages    = {0.4F, 0.2F, 0.08F}; // Level i + 1 is used below coverages[i] of the half screen height.
+        f32              hysteresis   = 0.1F;                // Relative band around each threshold that doesn't switch levels.
+        u32              shadowBias   = 1;                   // Shadow passes use a level this much coarser.
+        usize            minTriangles = 512;                 // Meshes with fewer triangles get no LODs.
+    };
+
+    struct BoundingSphere {
+        Vector3f center = {};
+        f32      radius = 0.0F;
+
+        /**
+         * @brief Computes a sphere enclosing all vertices, centered on their bounding box.
+         */
+        static BoundingSphere FromMesh(const MeshData &data);
+
+        /**
+         * @brief Transforms the sphere, the radius grows with the largest scale axis.
+         */
+        [[nodiscard]] BoundingSphere Transformed(const Transform &transform) const;
+    };
+
+    /**
+     * @brief Simplifies a mesh with quadric error metric edge collapses.
+     *
+     * Vertices are collapsed onto neighbors, so no new vertices are created. Vertices sharing a position are
+     * treated as one, each corner keeps the attributes closest to the one it had. Open borders never move.
+     *
+     * @param data The mesh to simplify.
+     * @param targetTriangles The triangle count to stop at.
+     * @return The simplified mesh, which can have more triangles than requested if no valid collapse remains.
+     */
+    FLK_API MeshData SimplifyMesh(const MeshData &data, usize targetTriangles);
+
+    /**
+     * @brief Generates the coarser levels of a mesh, each simplified from the previous one.
+     * @param data The full resolution mesh.
+     * @param config The LOD config.
+     * @return The levels past LOD 0, levels that fail to reduce the triangle count are dropped.
+     */
+    FLK_API std::vector<MeshData> GenerateLods(const MeshData &data, const LodConfig &config);
+
+    /**
+     * @brief Computes the projected radius of a sphere as a fraction of the half screen height.
+     * @return The coverage, clamped to 1 when the camera is inside the sphere.
+     */
+    FLK_API f32 ScreenCoverage(const BoundingSphere &sphere, const Camera &camera);
+
+    /**
+     * @brief Selects a LOD level from the screen coverage.
+     * @param coverage The screen coverage from ScreenCoverage().
+     * @param current The level selected last frame, levels only change once the coverage leaves the hysteresis band.
+     * @param levelCount The number of levels including LOD 0.
+     * @param config The LOD config.
+     * @return The level to draw.
+     */
+    FLK_API u32 SelectLod(f32 coverage, u32 current, usize levelCount, const LodConfig &config);
+}
+
+#endif //FLK_MESHLOD_HPP
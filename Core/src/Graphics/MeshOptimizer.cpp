@@ -0,0 +1,298 @@
+#include "MeshOptimizer.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <string_view>
+#include <unordered_map>
+
+namespace Flock::Graphics {
+    namespace {
+        constexpr u32 s_CacheSize = 32;
+
+        // Forsyth's scoring: the last triangle's vertices get a flat score so they aren't favored for being used
+        // again immediately, older entries decay, and vertices with few triangles left are boosted to finish them.
+        f32 VertexScore(const i32 cachePosition, const u32 remaining) {
+            if (remaining == 0) {
+                return -1.0F;
+            }
+
+            f32 score = 0.0F;
+            if (cachePosition >= 0) {
+                if (cachePosition < 3) {
+                    score = 0.75F;
+                } else {
+                    const f32 scaler = 1.0F / static_cast<f32>(s_CacheSize - 3);
+                    score            = std::pow(1.0F - static_cast<f32>(cachePosition - 3) * scaler, 1.5F);
+                }
+            }
+
+            return score + 2.0F / std::sqrt(static_cast<f32>(remaining));
+        }
+    }
+
+    VertexCacheStats AnalyzeVertexCache(const std::vector<u32> &indices, const usize vertexCount, const u32 cacheSize) {
+        if (indices.empty() || vertexCount == 0) {
+            return {};
+        }
+
+        std::vector<u32>  timestamps(vertexCount, 0);
+        std::vector<bool> used(vertexCount, false);
+
+        u32   time   = cacheSize + 1;
+        usize misses = 0;
+        usize unique = 0;
+
+        // A vertex is in a FIFO cache while fewer than cacheSize misses happened since it was inserted.
+        for (const u32 index: indices) {
+            if (time - timestamps[index] > cacheSize) {
+                timestamps[index] = time++;
+                misses++;
+            }
+
+            if (!used[index]) {
+                used[index] = true;
+                unique++;
+            }
+        }
+
+        return {
+            .acmr = static_cast<f32>(misses) / static_cast<f32>(indices.size() / 3),
+            .atvr = static_cast<f32>(misses) / static_cast<f32>(unique),
+        };
+    }
+
+    void DeduplicateVertices(MeshData &data) {
+        const auto key = [&](const u32 v) {
+            return std::string_view(reinterpret_cast<const char *>(&data.vertices[v]), sizeof(Vertex));
+        };
+
+        std::unordered_map<std::string_view, u32> unique;
+        unique.reserve(data.vertices.size());
+
+        std::vector<u32> remap(data.vertices.size());
+        for (u32 v = 0; v < data.vertices.size(); v++) {
+            remap[v] = unique.try_emplace(key(v), v).first->second;
+        }
+
+        for (u32 &index: data.indices) {
+            index = remap[index];
+        }
+
+        OptimizeVertexFetch(data);
+    }
+
+    void OptimizeVertexCache(std::vector<u32> &indices, const usize vertexCount) {
+        const usize triangleCount = indices.size() / 3;
+        if (triangleCount == 0) {
+            return;
+        }
+
+        // Triangles of each vertex, packed with offsets. Emitted triangles are swapped past the remaining count.
+        std::vector<u32> remaining(vertexCount, 0);
+        for (const u32 index: indices) {
+            remaining[index]++;
+        }
+
+        std::vector<u32> offsets(vertexCount + 1, 0);
+        for (usize v = 0; v < vertexCount; v++) {
+            offsets[v + 1] = offsets[v] + remaining[v];
+        }
+
+        std::vector<u32> vertexTriangles(indices.size());
+        {
+            std::vector<u32> cursor(offsets.begin(), offsets.end() - 1);
+            for (u32 t = 0; t < triangleCount; t++) {
+                for (u32 c = 0; c < 3; c++) {
+                    vertexTriangles[cursor[indices[t * 3 + c]]++] = t;
+                }
+            }
+        }
+
+        std::vector<i32> cachePositions(vertexCount, -1);
+        std::vector<f32> vertexScores(vertexCount);
+        for (usize v = 0; v < vertexCount; v++) {
+            vertexScores[v] = VertexScore(-1, remaining[v]);
+        }
+
+        std::vector<f32>  triangleScores(triangleCount);
+        std::vector<bool> emitted(triangleCount, false);
+        for (u32 t = 0; t < triangleCount; t++) {
+            triangleScores[t] = vertexScores[indices[t * 3]] + vertexScores[indices[t * 3 + 1]] + vertexScores[indices[t * 3 + 2]];
+        }
+
+        std::vector<u32> cache;
+        std::vector<u32> newCache;
+        cache.reserve(s_CacheSize + 3);
+        newCache.reserve(s_CacheSize + 3);
+
+        std::vector<u32> result;
+        result.reserve(indices.size());
+
+        u32 cursor = 0;
+        i64 best   = -1;
+
+        while (result.size() < indices.size()) {
+            if (best < 0) {
+                // Nothing in the cache has triangles left, restart from the next unemitted triangle.
+                while (emitted[cursor]) {
+                    cursor++;
+                }
+
+                best = cursor;
+            }
+
+            const u32 triangle = static_cast<u32>(best);
+            emitted[triangle]  = true;
+
+            newCache.clear();
+            for (u32 c = 0; c < 3; c++) {
+                const u32 v = indices[triangle * 3 + c];
+                result.push_back(v);
+                newCache.push_back(v);
+
+                const auto begin = vertexTriangles.begin() + offsets[v];
+                const auto end   = begin + remaining[v];
+                std::iter_swap(std::find(begin, end, triangle), end - 1);
+                remaining[v]--;
+            }
+
+            for (const u32 v: cache) {
+                if (std::find(newCache.begin(), newCache.begin() + 3, v) == newCache.begin() + 3) {
+                    newCache.push_back(v);
+                }
+            }
+
+            for (usize i = 0; i < newCache.size(); i++) {
+                const u32 v       = newCache[i];
+                cachePositions[v] = i < s_CacheSize ? static_cast<i32>(i) : -1;
+                vertexScores[v]   = VertexScore(cachePositions[v], remaining[v]);
+            }
+
+            best          = -1;
+            f32 bestScore = -1.0F;
+            for (const u32 v: newCache) {
+                for (u32 i = offsets[v]; i < offsets[v] + remaining[v]; i++) {
+                    const u32 t = vertexTriangles[i];
+
+                    triangleScores[t] = vertexScores[indices[t * 3]] + vertexScores[indices[t * 3 + 1]] +
+                                        vertexScores[indices[t * 3 + 2]];
+
+                    if (triangleScores[t] > bestScore) {
+                        bestScore = triangleScores[t];
+                        best      = t;
+                    }
+                }
+            }
+
+            cache.assign(newCache.begin(), newCache.begin() + std::min<usize>(newCache.size(), s_CacheSize));
+        }
+
+        indices = std::move(result);
+    }
+
+    void OptimizeOverdraw(std::vector<u32> &indices, const std::vector<Vertex> &vertices) {
+        const usize triangleCount = indices.size() / 3;
+        if (triangleCount == 0) {
+            return;
+        }
+
+        // Hard boundaries: triangles whose vertices all miss the cache, reordering there costs nothing.
+        std::vector<u32> clusters;
+        {
+            constexpr u32    cacheSize = 16;
+            std::vector<u32> timestamps(vertices.size(), 0);
+            u32              time = cacheSize + 1;
+
+            for (u32 t = 0; t < triangleCount; t++) {
+                u32 misses = 0;
+                for (u32 c = 0; c < 3; c++) {
+                    const u32 v = indices[t * 3 + c];
+                    if (time - timestamps[v] > cacheSize) {
+                        timestamps[v] = time++;
+                        misses++;
+                    }
+                }
+
+                if (t == 0 || misses == 3) {
+                    clusters.push_back(t);
+                }
+            }
+        }
+
+        const usize clusterCount = clusters.size();
+        clusters.push_back(triangleCount);
+
+        Vector3f meshCenter = {};
+        for (const auto &vertex: vertices) {
+            meshCenter += vertex.position;
+        }
+        meshCenter /= static_cast<f32>(std::max<usize>(vertices.size(), 1));
+
+        // Clusters facing away from the mesh center are drawn first, they are the most likely to occlude the rest.
+        std::vector<f32> sortKeys(clusterCount);
+        for (usize i = 0; i < clusterCount; i++) {
+            Vector3f center = {};
+            Vector3f normal = {};
+            f32      area = 0.0F;
+
+            for (u32 t = clusters[i]; t < clusters[i + 1]; t++) {
+                const Vector3f &p0 = vertices[indices[t * 3]].position;
+                const Vector3f &p1 = vertices[indices[t * 3 + 1]].position;
+                const Vector3f &p2 = vertices[indices[t * 3 + 2]].position;
+
+                const Vector3f n = (p1 - p0).Cross(p2 - p0);
+                const f32      a = static_cast<f32>(n.Magnitude());
+
+                center += (p0 + p1 + p2) * (a / 3.0F);
+                normal += n;
+                area   += a;
+            }
+
+            if (area == 0.0F) {
+                sortKeys[i] = 0.0F;
+                continue;
+            }
+
+            sortKeys[i] = (center / area - meshCenter).Dot(normal.Normalized());
+        }
+
+        std::vector<usize> order(clusterCount);
+        std::iota(order.begin(), order.end(), 0);
+        std::stable_sort(order.begin(), order.end(), [&](const usize lhs, const usize rhs) {
+            return sortKeys[lhs] > sortKeys[rhs];
+        });
+
+        std::vector<u32> result;
+        result.reserve(indices.size());
+        for (const usize cluster: order) {
+            result.insert(result.end(), indices.begin() + clusters[cluster] * 3, indices.begin() + clusters[cluster + 1] * 3);
+        }
+
+        indices = std::move(result);
+    }
+
+    void OptimizeVertexFetch(MeshData &data) {
+        std::vector<u32>    remap(data.vertices.size(), UINT32_MAX);
+        std::vector<Vertex> vertices;
+        vertices.reserve(data.vertices.size());
+
+        for (u32 &index: data.indices) {
+            if (remap[index] == UINT32_MAX) {
+                remap[index] = vertices.size();
+                vertices.push_back(data.vertices[index]);
+            }
+
+            index = remap[index];
+        }
+
+        data.vertices = std::move(vertices);
+    }
+
+    void OptimizeMesh(MeshData &data) {
+        DeduplicateVertices(data);
+        OptimizeVertexCache(data.indices, data.vertices.size());
+        OptimizeOverdraw(data.indices, data.vertices);
+        OptimizeVertexFetch(data);
+    }
+}
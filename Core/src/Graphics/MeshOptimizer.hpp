@@ -0,0 +1,58 @@
+#ifndef FLK_MESHOPTIMIZER_HPP
+#define FLK_MESHOPTIMIZER_HPP
+
+#include <vector>
+
+#include "Common.hpp"
+#include "Mesh.hpp"
+#include "Vertex.hpp"
+
+namespace Flock::Graphics {
+    /**
+     * @struct VertexCacheStats
+     * @brief Post-transform vertex cache efficiency of an index buffer.
+     */
+    struct VertexCacheStats {
+        f32 acmr = 0.0F; // Average cache miss ratio, vertex shader runs per triangle. 0.5 is ideal, 3 is the worst.
+        f32 atvr = 0.0F; // Average transform to vertex ratio, vertex shader runs per vertex. 1 is ideal.
+    };
+
+    /**
+     * @brief Simulates a FIFO post-transform cache over an index buffer.
+     * @param indices The triangle list.
+     * @param vertexCount The number of vertices the indices point into.
+     * @param cacheSize The cache size in vertices.
+     * @return The cache statistics.
+     */
+    FLK_API VertexCacheStats AnalyzeVertexCache(const std::vector<u32> &indices, usize vertexCount, u32 cacheSize = 16);
+
+    /**
+     * @brief Merges bitwise identical vertices and drops unused ones.
+     */
+    FLK_API void DeduplicateVertices(MeshData &data);
+
+    /**
+     * @brief Reorders triangles for the post-transform vertex cache (Forsyth's linear-speed optimizer).
+     */
+    FLK_API void OptimizeVertexCache(std::vector<u32> &indices, usize vertexCount);
+
+    /**
+     * @brief Reorders clusters of triangles so outward facing ones are drawn first, cutting overdraw.
+     *
+     * Clusters are split where the vertex cache restarts, so the cache order inside them is kept. Run after
+     * OptimizeVertexCache().
+     */
+    FLK_API void OptimizeOverdraw(std::vector<u32> &indices, const std::vector<Vertex> &vertices);
+
+    /**
+     * @brief Reorders vertices in the order the indices first use them, for vertex fetch locality.
+     */
+    FLK_API void OptimizeVertexFetch(MeshData &data);
+
+    /**
+     * @brief Runs every stage above in order.
+     */
+    FLK_API void OptimizeMesh(MeshData &data);
+}
+
+#endif //FLK_MESHOPTIMIZER_HPP
@@ -1,20 +1,42 @@
 #ifndef FLK_MODEL_HPP
 #define FLK_MODEL_HPP
 
+#include <algorithm>
+#include <vector>
+
 #include "Material.hpp"
 #include "Mesh.hpp"
+#include "MeshLod.hpp"
 
 namespace Flock::Graphics {
     struct RenderObject {
-        Mesh     mesh;
-        Material material;
+        Mesh              mesh;
+        Material          material;
+        std::vector<Mesh> lods   = {}; // Progressively coarser levels, lods[i] is LOD i + 1.
+        BoundingSphere    bounds = {};
+
+        [[nodiscard]] usize LodCount() const {
+            return lods.size() + 1;
+        }
+
+        /**
+         * @brief Gets a LOD level, levels past the coarsest one return the coarsest one.
+         */
+        [[nodiscard]] Mesh &Lod(const u32 level) {
+            if (level == 0 || lods.empty()) {
+                return mesh;
+            }
+
+            return lods[std::min<usize>(level, lods.size()) - 1];
+        }
     };
 
     struct Model {
         std::vector<RenderObject> objects;
 
         Model &Add(Mesh &&mesh, const Material &material) {
-            objects.push_back(RenderObject{.mesh = std::move(mesh), .material = material});
+            const BoundingSphere bounds = BoundingSphere::FromMesh(mesh.Data());
+            objects.push_back(RenderObject{.mesh = std::move(mesh), .material = material, .bounds = bounds});
             return *this;
         }
     };
@@ -9,9 +9,10 @@ namespace Flock::Graphics {
 
     struct FLK_API ModelRenderer {
         Asset::AssetHandle<Model> model;
+        bool                      isStatic = false; // Static renderers are cached in the far shadow cascades.
     };
 
-    FLK_ARCHIVE(ModelRenderer, model)
+    FLK_ARCHIVE(ModelRenderer, model, isStatic)
 }
 
 #endif //FLK_MODELRENDERER_HPP
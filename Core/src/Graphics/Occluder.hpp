@@ -0,0 +1,27 @@
+#ifndef FLK_OCCLUDER_HPP
+#define FLK_OCCLUDER_HPP
+
+#include "Common.hpp"
+#include "Asset/AssetHandle.hpp"
+#include "Serial/Archive.hpp"
+
+namespace Flock::Graphics {
+    struct Model;
+
+    /**
+     * @struct Occluder
+     * @brief Marks an entity with a ModelRenderer as hiding what is behind it, see OcclusionConfig.
+     *
+     * Best suited to large, solid models like walls, floors and terrain. Occluders are rasterized on the CPU,
+     * so their meshes should be a few hundred triangles and never larger than what is rendered. Without a
+     * stand-in the rendered model is rasterized at full detail, give detailed models a simpler stand-in that
+     * stays inside them.
+     */
+    struct FLK_API Occluder {
+        Asset::AssetHandle<Model> model = {}; // A simplified stand-in, the rendered model at full detail if empty.
+    };
+
+    FLK_ARCHIVE(Occluder, model)
+}
+
+#endif //FLK_OCCLUDER_HPP
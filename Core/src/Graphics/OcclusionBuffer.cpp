@@ -0,0 +1,345 @@
+#include "OcclusionBuffer.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+
+#include "Jobs/JobSystem.hpp"
+#include "Math/Simd.hpp"
+
+namespace Flock::Graphics {
+    namespace {
+        using Ops = Simd::WideOps;
+
+        constexpr usize s_OccluderGrain = 16; // Occluders per setup job.
+        constexpr u32   s_BandTiles     = 2;  // Tile rows per rasterization job.
+        constexpr f32   s_MinArea       = 1e-6F;
+
+        // Pixel centers relative to the first pixel of a run, wide enough for any backend.
+        constexpr std::array<f32, 8> s_LaneCenters = {0.5F, 1.5F, 2.5F, 3.5F, 4.5F, 5.5F, 6.5F, 7.5F};
+
+        static_assert(OcclusionBuffer::s_TileWidth % Ops::Width == 0, "Runs must not straddle tiles");
+
+        // Row vectors, like the rest of the renderer.
+        Vector4f ToClip(const Vector3f &point, const Matrix4f &matrix) {
+            Vector4f clip;
+            clip.x = point.x * matrix.At(0, 0) + point.y * matrix.At(1, 0) + point.z * matrix.At(2, 0) + matrix.At(3, 0);
+            clip.y = point.x * matrix.At(0, 1) + point.y * matrix.At(1, 1) + point.z * matrix.At(2, 1) + matrix.At(3, 1);
+            clip.z = point.x * matrix.At(0, 2) + point.y * matrix.At(1, 2) + point.z * matrix.At(2, 2) + matrix.At(3, 2);
+            clip.w = point.x * matrix.At(0, 3) + point.y * matrix.At(1, 3) + point.z * matrix.At(2, 3) + matrix.At(3, 3);
+            return clip;
+        }
+
+        // Behind or crossing the near plane, where the projection flips.
+        bool BehindNear(const Vector4f &clip) {
+            return clip.w <= 0.0F || clip.z < -clip.w;
+        }
+    }
+
+    void OcclusionBuffer::Resize(const Vector2u resolution) {
+        const Vector2u tiles = {
+            std::max<u32>((resolution.x + s_TileWidth - 1) / s_TileWidth, 1),
+            std::max<u32>((resolution.y + s_TileHeight - 1) / s_TileHeight, 1),
+        };
+
+        if (tiles == m_Tiles && !m_Depth.empty()) {
+            return;
+        }
+
+        m_Tiles = tiles;
+        m_Size  = {tiles.x * s_TileWidth, tiles.y * s_TileHeight};
+        m_Depth.assign(static_cast<usize>(m_Size.x) * m_Size.y, 1.0F);
+        m_TileDepth.assign(static_cast<usize>(m_Tiles.x) * m_Tiles.y, 1.0F);
+    }
+
+    void OcclusionBuffer::Render(const std::span<const OccluderMesh> occluders, const Matrix4f &viewProj) {
+        if (m_Depth.empty()) {
+            Resize({320, 192});
+        }
+
+        m_ViewProj = viewProj;
+        m_Stats    = {.occluders = occluders.size()};
+
+        m_ChunkTriangles.resize(std::max<usize>((occluders.size() + s_OccluderGrain - 1) / s_OccluderGrain, 1));
+        for (auto &triangles: m_ChunkTriangles) {
+            triangles.clear();
+        }
+
+        Jobs::ParallelFor(occluders.size(), s_OccluderGrain, [&](const usize begin, const usize end) {
+            auto &triangles = m_ChunkTriangles[begin / s_OccluderGrain];
+            for (usize i = begin; i < end; i++) {
+                SetupTriangles(occluders[i], triangles);
+            }
+        });
+
+        for (const auto &triangles: m_ChunkTriangles) {
+            m_Stats.triangles += triangles.size();
+        }
+
+        // Bands own disjoint rows of pixels and tiles, they clear and fill them without synchronization.
+        const u32 bands = (m_Tiles.y + s_BandTiles - 1) / s_BandTiles;
+        Jobs::ParallelFor(bands, 1, [&](const usize begin, const usize end) {
+            for (usize band = begin; band < end; band++) {
+                const u32 firstTile = static_cast<u32>(band) * s_BandTiles;
+                const u32 lastTile  = std::min(firstTile + s_BandTiles, m_Tiles.y);
+                RasterizeBand(firstTile * s_TileHeight, lastTile * s_TileHeight);
+            }
+        });
+    }
+
+    bool OcclusionBuffer::IsVisible(const BoundingSphere &sphere) const {
+        if (m_Depth.empty() || sphere.radius < 0.0F) {
+            return true;
+        }
+
+        // The corners of the sphere's bounding box, their screen rect and nearest depth enclose the sphere's.
+        f32 minX = std::numeric_limits<f32>::max();
+        f32 minY = std::numeric_limits<f32>::max();
+        f32 maxX = std::numeric_limits<f32>::lowest();
+        f32 maxY = std::numeric_limits<f32>::lowest();
+        f32 minZ = std::numeric_limits<f32>::max();
+
+        for (u32 corner = 0; corner < 8; corner++) {
+            const Vector3f offset = {
+                corner & 1 ? sphere.radius : -sphere.radius,
+                corner & 2 ? sphere.radius : -sphere.radius,
+                corner & 4 ? sphere.radius : -sphere.radius,
+            };
+
+            const Vector4f clip = ToClip(sphere.center + offset, m_ViewProj);
+            if (BehindNear(clip)) {
+                return true;
+            }
+
+            const f32 x = (clip.x / clip.w * 0.5F + 0.5F) * static_cast<f32>(m_Size.x);
+            const f32 y = (clip.y / clip.w * 0.5F + 0.5F) * static_cast<f32>(m_Size.y);
+            minX        = std::min(minX, x);
+            maxX        = std::max(maxX, x);
+            minY        = std::min(minY, y);
+            maxY        = std::max(maxY, y);
+            minZ        = std::min(minZ, clip.z / clip.w * 0.5F + 0.5F);
+        }
+
+        // Off screen, which is for frustum culling to decide.
+        if (maxX < 0.0F || maxY < 0.0F || minX >= static_cast<f32>(m_Size.x) || minY >= static_cast<f32>(m_Size.y)) {
+            return true;
+        }
+
+        const auto tileOf = [](const f32 pixel, const u32 tileSize, const u32 tiles) {
+            const i32 tile = static_cast<i32>(std::floor(pixel / static_cast<f32>(tileSize)));
+            return static_cast<u32>(std::clamp(tile, 0, static_cast<i32>(tiles) - 1));
+        };
+
+        const u32 firstX = tileOf(minX, s_TileWidth, m_Tiles.x);
+        const u32 lastX  = tileOf(maxX, s_TileWidth, m_Tiles.x);
+        const u32 firstY = tileOf(minY, s_TileHeight, m_Tiles.y);
+        const u32 lastY  = tileOf(maxY, s_TileHeight, m_Tiles.y);
+
+        for (u32 ty = firstY; ty <= lastY; ty++) {
+            for (u32 tx = firstX; tx <= lastX; tx++) {
+                if (m_TileDepth[ty * m_Tiles.x + tx] >= minZ) {
+                    return true;
+                }
+            }
+        }
+
+        return false;
+    }
+
+    Image OcclusionBuffer::DebugImage() const {
+        // Perspective depth bunches up near the far plane, so covered depths are stretched over the full range.
+        f32 nearest  = 1.0F;
+        f32 farthest = 0.0F;
+        for (const f32 depth: m_Depth) {
+            if (depth < 1.0F) {
+                nearest  = std::min(nearest, depth);
+                farthest = std::max(farthest, depth);
+            }
+        }
+
+        const f32 range = std::max(farthest - nearest, 1e-6F);
+
+        std::vector<u8> pixels(m_Depth.size() * 4);
+        for (usize y = 0; y < m_Size.y; y++) {
+            const usize source = (m_Size.y - 1 - y) * m_Size.x;
+
+            for (usize x = 0; x < m_Size.x; x++) {
+                const f32 depth = m_Depth[source + x];
+                const u8  value = depth < 1.0F ? static_cast<u8>(255.0F - 223.0F * (depth - nearest) / range) : 0;
+
+                u8 *pixel = &pixels[(y * m_Size.x + x) * 4];
+                pixel[0]  = value;
+                pixel[1]  = value;
+                pixel[2]  = value;
+                pixel[3]  = 255;
+            }
+        }
+
+        return Image{.data = pixels, .size = m_Size, .format = ImageFormat::Rgba};
+    }
+
+    Vector2u OcclusionBuffer::Size() const {
+        return m_Size;
+    }
+
+    OcclusionStats OcclusionBuffer::Stats() const {
+        return m_Stats;
+    }
+
+    void OcclusionBuffer::SetupTriangles(const OccluderMesh &occluder, std::vector<Triangle> &triangles) const {
+        if (!occluder.data) {
+            return;
+        }
+
+        const MeshData &data = *occluder.data;
+        const Matrix4f  mvp  = occluder.model * m_ViewProj;
+
+        thread_local std::vector<Vector4f> clip;
+        clip.resize(data.vertices.size());
+        for (usize i = 0; i < data.vertices.size(); i++) {
+            clip[i] = ToClip(data.vertices[i].position, mvp);
+        }
+
+        const f32 width  = static_cast<f32>(m_Size.x);
+        const f32 height = static_cast<f32>(m_Size.y);
+
+        for (usize i = 0; i + 2 < data.indices.size(); i += 3) {
+            const u32 i0 = data.indices[i];
+            const u32 i1 = data.indices[i + 1];
+            const u32 i2 = data.indices[i + 2];
+            if (i0 >= clip.size() || i1 >= clip.size() || i2 >= clip.size()) {
+                continue;
+            }
+
+            const Vector4f &a = clip[i0];
+            const Vector4f &b = clip[i1];
+            const Vector4f &c = clip[i2];
+
+            // Clipping against the near plane isn't worth it, skipping those triangles only loses occlusion.
+            if (BehindNear(a) || BehindNear(b) || BehindNear(c)) {
+                continue;
+            }
+
+            if ((a.x > a.w && b.x > b.w && c.x > c.w) || (a.x < -a.w && b.x < -b.w && c.x < -c.w) ||
+                (a.y > a.w && b.y > b.w && c.y > c.w) || (a.y < -a.w && b.y < -b.w && c.y < -c.w)) {
+                continue;
+            }
+
+            f32 x[3] = {(a.x / a.w * 0.5F + 0.5F) * width, (b.x / b.w * 0.5F + 0.5F) * width, (c.x / c.w * 0.5F + 0.5F) * width};
+            f32 y[3] = {(a.y / a.w * 0.5F + 0.5F) * height, (b.y / b.w * 0.5F + 0.5F) * height, (c.y / c.w * 0.5F + 0.5F) * height};
+            f32 z[3] = {a.z / a.w * 0.5F + 0.5F, b.z / b.w * 0.5F + 0.5F, c.z / c.w * 0.5F + 0.5F};
+
+            f32 area = (x[1] - x[0]) * (y[2] - y[0]) - (x[2] - x[0]) * (y[1] - y[0]);
+            if (std::abs(area) < s_MinArea) {
+                continue;
+            }
+
+            // Both windings occlude, the hidden side of a closed mesh is behind the visible one anyway.
+            if (area < 0.0F) {
+                std::swap(x[1], x[2]);
+                std::swap(y[1], y[2]);
+                std::swap(z[1], z[2]);
+                area = -area;
+            }
+
+            Triangle triangle;
+            for (u32 e = 0; e < 3; e++) {
+                const u32 next    = (e + 1) % 3;
+                triangle.edgeX[e] = y[e] - y[next];
+                triangle.edgeY[e] = x[next] - x[e];
+                triangle.edge0[e] = x[e] * y[next] - x[next] * y[e];
+            }
+
+            triangle.depthX = ((z[1] - z[0]) * (y[2] - y[0]) - (z[2] - z[0]) * (y[1] - y[0])) / area;
+            triangle.depthY = ((z[2] - z[0]) * (x[1] - x[0]) - (z[1] - z[0]) * (x[2] - x[0])) / area;
+            triangle.depth0 = z[0] - triangle.depthX * x[0] - triangle.depthY * y[0];
+            triangle.minX   = std::min({x[0], x[1], x[2]});
+            triangle.maxX   = std::max({x[0], x[1], x[2]});
+            triangle.minY   = std::min({y[0], y[1], y[2]});
+            triangle.maxY   = std::max({y[0], y[1], y[2]});
+
+            triangles.push_back(triangle);
+        }
+    }
+
+    void OcclusionBuffer::RasterizeBand(const u32 firstRow, const u32 lastRow) {
+        std::fill(m_Depth.begin() + firstRow * m_Size.x, m_Depth.begin() + lastRow * m_Size.x, 1.0F);
+
+        for (const auto &triangles: m_ChunkTriangles) {
+            for (const Triangle &triangle: triangles) {
+                if (triangle.maxY >= static_cast<f32>(firstRow) && triangle.minY <= static_cast<f32>(lastRow)) {
+                    RasterizeTriangle(triangle, firstRow, lastRow);
+                }
+            }
+        }
+
+        // The farthest depth of each tile, what IsVisible() compares against.
+        for (u32 ty = firstRow / s_TileHeight; ty < lastRow / s_TileHeight; ty++) {
+            for (u32 tx = 0; tx < m_Tiles.x; tx++) {
+                auto farthest = Ops::Splat(0.0F);
+
+                for (u32 row = 0; row < s_TileHeight; row++) {
+                    const f32 *pixels = &m_Depth[(ty * s_TileHeight + row) * m_Size.x + tx * s_TileWidth];
+                    for (u32 x = 0; x < s_TileWidth; x += Ops::Width) {
+                        farthest = Ops::Max(farthest, Ops::Load(pixels + x));
+                    }
+                }
+
+                std::array<f32, Ops::Width> lanes;
+                Ops::Store(lanes.data(), farthest);
+                m_TileDepth[ty * m_Tiles.x + tx] = *std::ranges::max_element(lanes);
+            }
+        }
+    }
+
+    void OcclusionBuffer::RasterizeTriangle(const Triangle &triangle, const u32 firstRow, const u32 lastRow) {
+        // Pixels whose centers fall inside the bounds, runs start on a multiple of the SIMD width.
+        const i32 top    = std::max(static_cast<i32>(std::ceil(triangle.minY - 0.5F)), static_cast<i32>(firstRow));
+        const i32 bottom = std::min(static_cast<i32>(std::floor(triangle.maxY - 0.5F)), static_cast<i32>(lastRow) - 1);
+        const i32 left   = std::max(static_cast<i32>(std::ceil(triangle.minX - 0.5F)), 0);
+        const i32 right  = std::min(static_cast<i32>(std::floor(triangle.maxX - 0.5F)), static_cast<i32>(m_Size.x) - 1);
+        if (top > bottom || left > right) {
+            return;
+        }
+
+        const i32 start = left / static_cast<i32>(Ops::Width) * static_cast<i32>(Ops::Width);
+
+        const auto centers = Ops::Load(s_LaneCenters.data());
+        const auto zero    = Ops::Splat(0.0F);
+        const auto edgeX0  = Ops::Splat(triangle.edgeX[0]);
+        const auto edgeX1  = Ops::Splat(triangle.edgeX[1]);
+        const auto edgeX2  = Ops::Splat(triangle.edgeX[2]);
+        const auto depthX  = Ops::Splat(triangle.depthX);
+
+        for (i32 y = top; y <= bottom; y++) {
+            const f32 centerY = static_cast<f32>(y) + 0.5F;
+            const auto row0   = Ops::Splat(triangle.edgeY[0] * centerY + triangle.edge0[0]);
+            const auto row1   = Ops::Splat(triangle.edgeY[1] * centerY + triangle.edge0[1]);
+            const auto row2   = Ops::Splat(triangle.edgeY[2] * centerY + triangle.edge0[2]);
+            const auto rowZ   = Ops::Splat(triangle.depthY * centerY + triangle.depth0);
+
+            f32 *pixels = &m_Depth[static_cast<usize>(y) * m_Size.x];
+
+            for (i32 x = start; x <= right; x += static_cast<i32>(Ops::Width)) {
+                const auto px = Ops::Add(Ops::Splat(static_cast<f32>(x)), centers);
+
+                const auto inside = Ops::And(
+                    Ops::And(
+                        Ops::GreaterEqual(Ops::Add(Ops::Mul(edgeX0, px), row0), zero),
+                        Ops::GreaterEqual(Ops::Add(Ops::Mul(edgeX1, px), row1), zero)
+                    ),
+                    Ops::GreaterEqual(Ops::Add(Ops::Mul(edgeX2, px), row2), zero)
+                );
+
+                if (!Ops::Any(inside)) {
+                    continue;
+                }
+
+                const auto depth   = Ops::Add(Ops::Mul(depthX, px), rowZ);
+                const auto current = Ops::Load(pixels + x);
+                Ops::Store(pixels + x, Ops::Select(inside, Ops::Min(current, depth), current));
+            }
+        }
+    }
+}
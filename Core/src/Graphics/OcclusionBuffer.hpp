@@ -0,0 +1,115 @@
+#ifndef FLK_OCCLUSIONBUFFER_HPP
+#define FLK_OCCLUSIONBUFFER_HPP
+
+#include <span>
+#include <vector>
+
+#include "Common.hpp"
+#include "Image.hpp"
+#include "Mesh.hpp"
+#include "MeshLod.hpp"
+#include "Math/Matrix.hpp"
+#include "Math/Vector.hpp"
+#include "Serial/Archive.hpp"
+
+namespace Flock::Graphics {
+    /**
+     * @struct OcclusionConfig
+     * @brief A resource configuring software occlusion culling, see OcclusionBuffer.
+     */
+    struct FLK_API OcclusionConfig {
+        bool     enabled    = false;
+        Vector2u resolution = {320, 192}; // Of the depth buffer, rounded up to whole tiles.
+        bool     debugView  = false;      // Shows the depth buffer in the corner of the screen.
+    };
+
+    FLK_ARCHIVE(OcclusionConfig, enabled, resolution, debugView)
+
+    /**
+     * @struct OccluderMesh
+     * @brief A mesh drawn into the occlusion buffer.
+     */
+    struct OccluderMesh {
+        const MeshData *data  = nullptr;
+        Matrix4f        model = {};
+    };
+
+    struct OcclusionStats {
+        usize occluders = 0;
+        usize triangles = 0; // Rasterized, after rejecting the ones off screen or crossing the near plane.
+    };
+
+    /**
+     * @class OcclusionBuffer
+     * @brief A low resolution depth buffer rasterized on the CPU from occluders, to cull what they hide.
+     *
+     * The screen is split into bands of tiles rasterized on the worker threads, each pixel row of a tile is
+     * filled a SIMD register of pixels at a time with edge functions. Every tile keeps the farthest depth of its
+     * pixels, which is what the occlusion tests read: a box is hidden if each tile it covers is nearer than
+     * the box's nearest point. Only whole pixel centers count as covered, so the test errs on the visible side.
+     */
+    class FLK_API OcclusionBuffer {
+    public:
+        static constexpr u32 s_TileWidth  = 8;
+        static constexpr u32 s_TileHeight = 4;
+
+    private:
+        // Edge functions and depth plane in pixel coordinates, positive edges inside.
+        struct Triangle {
+            f32 edgeX[3] = {};
+            f32 edgeY[3] = {};
+            f32 edge0[3] = {};
+            f32 depthX   = 0.0F;
+            f32 depthY   = 0.0F;
+            f32 depth0   = 0.0F;
+            f32 minX     = 0.0F;
+            f32 maxX     = 0.0F;
+            f32 minY     = 0.0F;
+            f32 maxY     = 0.0F;
+        };
+
+        Vector2u                            m_Size;  // In pixels, whole tiles.
+        Vector2u                            m_Tiles; // Tile columns and rows.
+        std::vector<f32>                    m_Depth; // Bottom row first, like GL.
+        std::vector<f32>                    m_TileDepth;
+        std::vector<std::vector<Triangle> > m_ChunkTriangles; // Per occluder chunk, so setup needs no lock.
+        Matrix4f                            m_ViewProj;
+        OcclusionStats                      m_Stats;
+
+    public:
+        /**
+         * @brief Resizes the buffer, rounding up to whole tiles. Cleared to the far plane.
+         * @param resolution The resolution in pixels.
+         */
+        void Resize(Vector2u resolution);
+
+        /**
+         * @brief Clears the buffer and rasterizes the occluders as seen through a camera.
+         * @param occluders The occluders, ideally a few hundred triangles each.
+         * @param viewProj The view matrix times the projection matrix of the camera.
+         */
+        void Render(std::span<const OccluderMesh> occluders, const Matrix4f &viewProj);
+
+        /**
+         * @brief Tests a bounding sphere against the last Render(), safe to call from several threads at once.
+         * @return false if the occluders hide the sphere completely; true if it may be visible.
+         */
+        [[nodiscard]] bool IsVisible(const BoundingSphere &sphere) const;
+
+        /**
+         * @brief Visualizes the depth buffer, near occluders bright and uncovered pixels black.
+         * @return The image, top row first.
+         */
+        [[nodiscard]] Image DebugImage() const;
+
+        [[nodiscard]] Vector2u       Size() const;
+        [[nodiscard]] OcclusionStats Stats() const;
+
+    private:
+        void SetupTriangles(const OccluderMesh &occluder, std::vector<Triangle> &triangles) const;
+        void RasterizeBand(u32 firstRow, u32 lastRow);
+        void RasterizeTriangle(const Triangle &triangle, u32 firstRow, u32 lastRow);
+    };
+}
+
+#endif //FLK_OCCLUSIONBUFFER_HPP
@@ -5,20 +5,40 @@
 #include "Gl.hpp"
 #include "Debug/Log.hpp"
 #include "Graphics/CubeMap.hpp"
+#include "Graphics/ProgramCache.hpp"
+#include "Graphics/RenderStats.hpp"
 #include "Graphics/Shader.hpp"
+#include "Graphics/StateCache.hpp"
 #include "Graphics/Texture.hpp"
 #include "Graphics/TextureArray.hpp"
+#include "Graphics/TextureBuffer.hpp"
 #include "glad/glad.h"
 
+// GL_KHR_parallel_shader_compile, the loader may have been generated without it.
+#ifndef GL_COMPLETION_STATUS_KHR
+#define GL_COMPLETION_STATUS_KHR 0x91B1
+#endif
+
 namespace Flock::Graphics {
+    namespace {
+        bool s_ParallelCompile = false; // Set by PipelineBuild::EnableParallelCompile().
+    }
+
     std::optional<Pipeline> Pipeline::Create(const Shader &vertex, const Shader &fragment) {
-        Pipeline pipeline{};
+        return FromProgram(LinkShaders(vertex, fragment));
+    }
+
+    std::optional<Pipeline> Pipeline::FromSource(const std::string &vertex, const std::string &fragment) {
+        return PipelineBuild::Start(vertex, fragment).Finish();
+    }
 
-        pipeline.m_Id = LinkShaders(vertex, fragment);
-        if (pipeline.m_Id == 0) {
+    std::optional<Pipeline> Pipeline::FromProgram(const u32 program) {
+        if (program == 0) {
             return std::nullopt;
         }
 
+        Pipeline pipeline{};
+        pipeline.m_Id             = program;
         pipeline.m_DefaultTexture = Texture::Default();
         pipeline.SetSamplerUnits();
 
@@ -54,6 +74,7 @@ namespace Flock::Graphics {
     }
 
     void Pipeline::Clear() const {
+        StateCache::ForgetProgram(m_Id);
         FLK_GL_CALL(glDeleteProgram(m_Id));
     }
 
@@ -62,7 +83,7 @@ namespace Flock::Graphics {
             return false;
         }
 
-        FLK_GL_CALL(glUseProgram(m_Id));
+        StateCache::UseProgram(m_Id);
         SetDefaultTextures();
 
         for (const auto &[name, uniform]: m_Uniforms) {
@@ -75,7 +96,7 @@ namespace Flock::Graphics {
     }
 
     void Pipeline::Unbind() {
-        FLK_GL_CALL(glUseProgram(0));
+        StateCache::UseProgram(0);
     }
 
     void Pipeline::SetUniform(const std::string &name, const u8 value) {
@@ -118,6 +139,16 @@ namespace Flock::Graphics {
         m_Uniforms[name] = {.type = UniformType::Mat4, .data = value};
     }
 
+    void Pipeline::SetUniform(const std::string &name, const Uniform &uniform) {
+        m_Uniforms[name] = uniform;
+    }
+
+    void Pipeline::SetUniforms(const UniformList &uniforms) {
+        for (const auto &[name, uniform]: uniforms) {
+            m_Uniforms[name] = uniform;
+        }
+    }
+
     bool Pipeline::SetUniform(const std::string &name, const Texture &value) const {
         if (m_Id == 0 || !m_Samplers.contains(name)) {
             return false;
@@ -160,6 +191,25 @@ namespace Flock::Graphics {
         return value.Bind();
     }
 
+    bool Pipeline::SetUniform(const std::string &name, const TextureBuffer &value) const {
+        if (m_Id == 0 || !m_Samplers.contains(name)) {
+            return false;
+        }
+
+        if (m_Samplers.at(name).glType != GL_SAMPLER_BUFFER &&
+            m_Samplers.at(name).glType != GL_INT_SAMPLER_BUFFER &&
+            m_Samplers.at(name).glType != GL_UNSIGNED_INT_SAMPLER_BUFFER) {
+            return false;
+        }
+
+        Texture::SetActiveUnit(m_Samplers.at(name).unit);
+        return value.Bind();
+    }
+
+    bool Pipeline::HasSampler(const std::string &name) const {
+        return m_Samplers.contains(name);
+    }
+
     void Pipeline::ResetUniforms() {
         m_Uniforms.clear();
         SetDefaultTextures(true);
@@ -171,6 +221,7 @@ namespace Flock::Graphics {
         FLK_GL_CALL(program = glCreateProgram());
         FLK_GL_CALL(glAttachShader(program, vertex.GlId()));
         FLK_GL_CALL(glAttachShader(program, fragment.GlId()));
+        ProgramCache::MarkRetrievable(program);
         FLK_GL_CALL(glLinkProgram(program));
 
         int success = 0;
@@ -195,10 +246,8 @@ namespace Flock::Graphics {
             return false;
         }
 
-        i32 boundPipeline = 0;
-        FLK_GL_CALL(glGetIntegerv(GL_CURRENT_PROGRAM, &boundPipeline));
-
-        FLK_GL_CALL(glUseProgram(m_Id));
+        const u32 boundPipeline = StateCache::Program();
+        StateCache::UseProgram(m_Id);
 
         i32 uniformCount;
         FLK_GL_CALL(glGetProgramiv(m_Id, GL_ACTIVE_UNIFORMS, &uniformCount));
@@ -212,7 +261,8 @@ namespace Flock::Graphics {
             FLK_GL_CALL(glGetActiveUniform(m_Id, i, sizeof(name), &length, &size, &type, name));
 
             if (type == GL_SAMPLER_2D || type == GL_SAMPLER_2D_SHADOW || type == GL_SAMPLER_2D_ARRAY || type ==
-                GL_SAMPLER_2D_ARRAY_SHADOW || type == GL_SAMPLER_CUBE || type == GL_SAMPLER_CUBE_SHADOW) {
+                GL_SAMPLER_2D_ARRAY_SHADOW || type == GL_SAMPLER_CUBE || type == GL_SAMPLER_CUBE_SHADOW ||
+                type == GL_SAMPLER_BUFFER || type == GL_INT_SAMPLER_BUFFER || type == GL_UNSIGNED_INT_SAMPLER_BUFFER) {
                 std::string uniformName = name;
 
                 if (uniformName.ends_with("[0]")) {
@@ -233,7 +283,7 @@ namespace Flock::Graphics {
             }
         }
 
-        FLK_GL_CALL(glUseProgram(boundPipeline));
+        StateCache::UseProgram(boundPipeline == StateCache::s_Unknown ? 0 : boundPipeline);
 
         return true;
     }
@@ -290,29 +340,180 @@ namespace Flock::Graphics {
                 return false;
         }
 
+        FrameCounters::UniformUpload();
         return true;
     }
 
     void Pipeline::SetDefaultTextures(const bool overwrite) const {
-        i32 activeUnit;
-        FLK_GL_CALL(glGetIntegerv(GL_ACTIVE_TEXTURE, &activeUnit));
-
         for (const auto &[name, info]: m_Samplers) {
             if (info.glType != GL_SAMPLER_2D) {
                 continue;
             }
 
-            i32 id = 0;
-            FLK_GL_CALL(glActiveTexture(GL_TEXTURE0 + info.unit));
-            FLK_GL_CALL(glGetIntegerv(GL_TEXTURE_BINDING_2D, &id));
-
-            if (id != 0 && !overwrite) {
+            // Units the cache has lost track of get the default texture as well.
+            const u32 id = StateCache::Texture(info.unit, GL_TEXTURE_2D);
+            if (id != 0 && id != StateCache::s_Unknown && !overwrite) {
                 continue;
             }
 
             SetUniform(name, m_DefaultTexture);
         }
+    }
+
+    PipelineBuild PipelineBuild::Start(const std::string &vertex, const std::string &fragment) {
+        PipelineBuild build;
+        build.m_VertexSource   = vertex;
+        build.m_FragmentSource = fragment;
+
+        build.m_Program = ProgramCache::Load(vertex, fragment);
+        if (build.m_Program != 0) {
+            build.m_Cached = true;
+            return build;
+        }
+
+        // Nothing here queries a status, so the driver is free to keep working after this returns.
+        const auto compile = [](const GLenum type, const std::string &source) {
+            const u32   shader = glCreateShader(type);
+            const char *text   = source.c_str();
+
+            FLK_GL_CALL(glShaderSource(shader, 1, &text, nullptr));
+            FLK_GL_CALL(glCompileShader(shader));
+
+            return shader;
+        };
 
-        FLK_GL_CALL(glActiveTexture(activeUnit));
+        build.m_Vertex   = compile(GL_VERTEX_SHADER, vertex);
+        build.m_Fragment = compile(GL_FRAGMENT_SHADER, fragment);
+
+        FLK_GL_CALL(build.m_Program = glCreateProgram());
+        FLK_GL_CALL(glAttachShader(build.m_Program, build.m_Vertex));
+        FLK_GL_CALL(glAttachShader(build.m_Program, build.m_Fragment));
+        ProgramCache::MarkRetrievable(build.m_Program);
+        FLK_GL_CALL(glLinkProgram(build.m_Program));
+
+        return build;
+    }
+
+    bool PipelineBuild::EnableParallelCompile() {
+        using MaxThreadsFn = void (APIENTRYP)(GLuint);
+
+        auto maxThreads = reinterpret_cast<MaxThreadsFn>(glfwGetProcAddress("glMaxShaderCompilerThreadsKHR"));
+        if (!maxThreads || !HasExtension("GL_KHR_parallel_shader_compile")) {
+            maxThreads = reinterpret_cast<MaxThreadsFn>(glfwGetProcAddress("glMaxShaderCompilerThreadsARB"));
+            if (!maxThreads || !HasExtension("GL_ARB_parallel_shader_compile")) {
+                s_ParallelCompile = false;
+                return false;
+            }
+        }
+
+        // As many threads as the driver likes.
+        maxThreads(0xFFFFFFFF);
+        s_ParallelCompile = true;
+        return true;
+    }
+
+    bool PipelineBuild::ParallelCompile() {
+        return s_ParallelCompile;
+    }
+
+    PipelineBuild::~PipelineBuild() {
+        Clear();
+    }
+
+    PipelineBuild::PipelineBuild(PipelineBuild &&other) noexcept
+        : m_Program(std::exchange(other.m_Program, 0)),
+          m_Vertex(std::exchange(other.m_Vertex, 0)),
+          m_Fragment(std::exchange(other.m_Fragment, 0)),
+          m_Cached(other.m_Cached),
+          m_VertexSource(std::move(other.m_VertexSource)),
+          m_FragmentSource(std::move(other.m_FragmentSource)) {}
+
+    PipelineBuild &PipelineBuild::operator=(PipelineBuild &&other) noexcept {
+        if (this == &other) {
+            return *this;
+        }
+
+        Clear();
+
+        m_Program        = std::exchange(other.m_Program, 0);
+        m_Vertex         = std::exchange(other.m_Vertex, 0);
+        m_Fragment       = std::exchange(other.m_Fragment, 0);
+        m_Cached         = other.m_Cached;
+        m_VertexSource   = std::move(other.m_VertexSource);
+        m_FragmentSource = std::move(other.m_FragmentSource);
+
+        return *this;
+    }
+
+    bool PipelineBuild::Ready() const {
+        if (m_Program == 0 || m_Cached || !ParallelCompile()) {
+            return true;
+        }
+
+        i32 done = 0;
+        FLK_GL_CALL(glGetProgramiv(m_Program, GL_COMPLETION_STATUS_KHR, &done));
+        return done == GL_TRUE;
+    }
+
+    std::optional<Pipeline> PipelineBuild::Finish() {
+        if (m_Program == 0) {
+            return std::nullopt;
+        }
+
+        if (!m_Cached) {
+            i32 linked = 0;
+            FLK_GL_CALL(glGetProgramiv(m_Program, GL_LINK_STATUS, &linked));
+
+            if (linked != GL_TRUE) {
+                constexpr u32 msgLength = 1024;
+
+                GLsizei length = 0;
+                char    message[msgLength];
+
+                // The link log rarely says more than that a stage failed, the stage logs say why.
+                for (const auto &[shader, stage]: {std::pair{m_Vertex, "vertex"}, std::pair{m_Fragment, "fragment"}}) {
+                    i32 compiled = 0;
+                    FLK_GL_CALL(glGetShaderiv(shader, GL_COMPILE_STATUS, &compiled));
+                    if (compiled != GL_TRUE) {
+                        FLK_GL_CALL(glGetShaderInfoLog(shader, msgLength, &length, message));
+                        Debug::LogErr("Failed to compile {} shader: {}", stage, message);
+                    }
+                }
+
+                FLK_GL_CALL(glGetProgramInfoLog(m_Program, msgLength, &length, message));
+                Debug::LogErr("Failed to link shaders: {}", message);
+
+                Clear();
+                return std::nullopt;
+            }
+
+            ProgramCache::Store(m_Program, m_VertexSource, m_FragmentSource);
+        }
+
+        const u32 program = std::exchange(m_Program, 0);
+        Clear();
+
+        return Pipeline::FromProgram(program);
+    }
+
+    void PipelineBuild::Clear() {
+        // Shaders only live as long as the program needs them, the linked program keeps its own copy.
+        for (u32 *shader: {&m_Vertex, &m_Fragment}) {
+            if (*shader == 0) {
+                continue;
+            }
+
+            if (m_Program != 0) {
+                FLK_GL_CALL(glDetachShader(m_Program, *shader));
+            }
+
+            FLK_GL_CALL(glDeleteShader(*shader));
+            *shader = 0;
+        }
+
+        if (m_Program != 0) {
+            FLK_GL_CALL(glDeleteProgram(m_Program));
+            m_Program = 0;
+        }
     }
 }
@@ -5,18 +5,22 @@
 #include <optional>
 #include <string>
 #include <unordered_map>
+#include <utility>
+#include <vector>
 
 #include "Common.hpp"
 #include "CubeMap.hpp"
 #include "Shader.hpp"
 #include "Texture.hpp"
 #include "TextureArray.hpp"
+#include "TextureBuffer.hpp"
 #include "Math/Math.hpp"
 
 namespace Flock::Graphics {
     class CubeMap;
     class Shader;
     class TextureArray;
+    class TextureBuffer;
 }
 
 namespace Flock::Graphics {
@@ -56,8 +60,17 @@ namespace Flock::Graphics {
     struct FLK_API Uniform {
         UniformType type;
         UniformData data;
+
+        /**
+         * @brief Creates a uniform whose type follows the value, UniformType lists the types in UniformData's order.
+         */
+        static Uniform From(const UniformData &data) {
+            return {.type = static_cast<UniformType>(data.index()), .data = data};
+        }
     };
 
+    using UniformList = std::vector<std::pair<std::string, Uniform> >;
+
     struct SamplerInfo {
         i32 unit;
         u32 glType;
@@ -68,6 +81,8 @@ namespace Flock::Graphics {
      * @brief A shader pipeline.
      */
     class FLK_API Pipeline {
+        friend class PipelineBuild;
+
         u32                                          m_Id = 0;
         std::unordered_map<std::string, Uniform>     m_Uniforms;
         std::unordered_map<std::string, SamplerInfo> m_Samplers;
@@ -82,6 +97,14 @@ namespace Flock::Graphics {
          */
         static std::optional<Pipeline> Create(const Shader &vertex, const Shader &fragment);
 
+        /**
+         * @brief Static factory method, loads the program from the ProgramCache or compiles and caches it.
+         * @param vertex The vertex shader source.
+         * @param fragment The fragment shader source.
+         * @return The pipeline if successful; std::nullopt otherwise.
+         */
+        static std::optional<Pipeline> FromSource(const std::string &vertex, const std::string &fragment);
+
         Pipeline() = default;
         ~Pipeline();
 
@@ -177,6 +200,19 @@ namespace Flock::Graphics {
          */
         void SetUniform(const std::string &name, Matrix4f value);
 
+        /**
+         * @brief Sets a value uniform of any type.
+         * @param name The uniform name.
+         * @param uniform The uniform to set.
+         */
+        void SetUniform(const std::string &name, const Uniform &uniform);
+
+        /**
+         * @brief Sets a list of value uniforms.
+         * @param uniforms The uniforms to set.
+         */
+        void SetUniforms(const UniformList &uniforms);
+
         /**
          * @brief Sets a 2D texture (sampler2D) uniform.
          * @param name The uniform name.
@@ -201,19 +237,92 @@ namespace Flock::Graphics {
          */
         bool SetUniform(const std::string &name, const TextureArray &value) const;
 
+        /**
+         * @brief Sets a texture buffer (samplerBuffer) uniform.
+         * @param name The uniform name.
+         * @param value The uniform value to set.
+         * @return true if successful; false otherwise.
+         */
+        bool SetUniform(const std::string &name, const TextureBuffer &value) const;
+
+        /**
+         * @return true if the pipeline has an active sampler uniform with this name; false otherwise.
+         */
+        [[nodiscard]] bool HasSampler(const std::string &name) const;
+
         /**
          * @brief Resets all uniforms;
          */
         void ResetUniforms();
 
     private:
-        static u32 LinkShaders(const Shader &vertex, const Shader &fragment);
+        static std::optional<Pipeline> FromProgram(u32 program);
+        static u32                     LinkShaders(const Shader &vertex, const Shader &fragment);
 
         bool SetSamplerUnits();
         bool BindUniform(const std::string &name, const Uniform &uniform) const;
 
         void SetDefaultTextures(bool overwrite = false) const;
     };
+
+    /**
+     * @class PipelineBuild
+     * @brief A pipeline whose shaders are being compiled and linked.
+     *
+     * With GL_KHR_parallel_shader_compile the driver builds it on its own threads, Ready() tells when Finish()
+     * won't block. Without it Ready() is always true and Finish() waits for the driver.
+     */
+    class FLK_API PipelineBuild {
+        u32         m_Program  = 0;
+        u32         m_Vertex   = 0;
+        u32         m_Fragment = 0;
+        bool        m_Cached   = false; // Loaded from the ProgramCache, already linked.
+        std::string m_VertexSource;
+        std::string m_FragmentSource;
+
+    public:
+        /**
+         * @brief Loads the program from the ProgramCache, or starts compiling and linking it.
+         * @param vertex The vertex shader source.
+         * @param fragment The fragment shader source.
+         * @return The build in progress.
+         */
+        static PipelineBuild Start(const std::string &vertex, const std::string &fragment);
+
+        /**
+         * @brief Lets the driver compile shaders on its own threads, if it supports it. Call once per context.
+         * @return true if the context now compiles shaders in parallel; false otherwise.
+         */
+        static bool EnableParallelCompile();
+
+        /**
+         * @return true if EnableParallelCompile() succeeded; false otherwise.
+         */
+        [[nodiscard]] static bool ParallelCompile();
+
+        PipelineBuild() = default;
+        ~PipelineBuild();
+
+        PipelineBuild(const PipelineBuild &other) = delete;
+        PipelineBuild(PipelineBuild &&other) noexcept;
+
+        PipelineBuild &operator=(const PipelineBuild &other) = delete;
+        PipelineBuild &operator=(PipelineBuild &&other) noexcept;
+
+        /**
+         * @return true if Finish() won't wait for the driver; false otherwise.
+         */
+        [[nodiscard]] bool Ready() const;
+
+        /**
+         * @brief Waits for the build, logs its errors and stores the program in the ProgramCache.
+         * @return The pipeline if successful; std::nullopt otherwise.
+         */
+        std::optional<Pipeline> Finish();
+
+    private:
+        void Clear();
+    };
 }
 
 #endif //FLK_PIPELINE_HPP
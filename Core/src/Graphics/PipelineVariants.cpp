@@ -0,0 +1,125 @@
+#include "PipelineVariants.hpp"
+
+#include <algorithm>
+
+#include "Debug/Log.hpp"
+#include "FileIo/Pipeline.hpp"
+
+namespace Flock::Graphics {
+    u64 VariantKey(const ShaderKeywords &keywords) {
+        ShaderKeywords sorted = keywords;
+        std::ranges::sort(sorted);
+        sorted.erase(std::ranges::unique(sorted).begin(), sorted.end());
+
+        u64 hash = 14695981039346656037ULL;
+        for (const std::string &keyword: sorted) {
+            for (const char c: keyword) {
+                hash ^= static_cast<u8>(c);
+                hash *= 1099511628211ULL;
+            }
+
+            // Separates the keywords, so "AB" and "A", "B" differ.
+            hash ^= 0xFF;
+            hash *= 1099511628211ULL;
+        }
+
+        return hash;
+    }
+
+    std::optional<u32> PipelineVariants::Request(const std::filesystem::path &filePath, const ShaderKeywords &keywords) {
+        const std::string key = filePath.string() + '#' + std::to_string(VariantKey(keywords));
+        if (const auto it = m_Indices.find(key); it != m_Indices.end()) {
+            return m_Variants[it->second].failed ? std::nullopt : std::optional{it->second};
+        }
+
+        const u32 index = m_Variants.size();
+        m_Indices[key]  = index;
+        Variant &variant = m_Variants.emplace_back();
+
+        // A failed file is remembered too, so it isn't read again for every proxy using it.
+        const std::optional<FileIo::PipelineSource> source = FileIo::PreprocessPipeline(filePath, keywords);
+        if (!source) {
+            Debug::LogErr("PipelineVariants::Request: Failed to preprocess '{}'!", filePath.string());
+            variant.failed = true;
+            return std::nullopt;
+        }
+
+        variant.vertex   = source->vertex;
+        variant.fragment = source->fragment;
+        m_Pending.push_back(index);
+
+        return index;
+    }
+
+    usize PipelineVariants::Update() {
+        if (m_Pending.empty()) {
+            return 0;
+        }
+
+        const bool parallel = PipelineBuild::ParallelCompile();
+
+        // Everything is handed to the driver at once, it compiles in parallel while the frame goes on.
+        if (parallel) {
+            for (const u32 index: m_Pending) {
+                Variant &variant = m_Variants[index];
+                if (!variant.build) {
+                    variant.build = PipelineBuild::Start(variant.vertex, variant.fragment);
+                }
+            }
+        }
+
+        usize finished = 0;
+        bool  waited   = false;
+        std::erase_if(m_Pending, [&](const u32 index) {
+            Variant &variant = m_Variants[index];
+
+            // Without parallel compilation the first variant blocks, so the rest waits for the next call.
+            if (!parallel) {
+                if (waited) {
+                    return false;
+                }
+
+                waited        = true;
+                variant.build = PipelineBuild::Start(variant.vertex, variant.fragment);
+            }
+
+            if (!variant.build->Ready()) {
+                return false;
+            }
+
+            variant.pipeline = variant.build->Finish();
+            variant.build.reset();
+            variant.failed = !variant.pipeline;
+
+            // The sources are only needed to build and cache the program.
+            variant.vertex.clear();
+            variant.fragment.clear();
+
+            if (variant.pipeline) {
+                finished++;
+            }
+
+            return true;
+        });
+
+        return finished;
+    }
+
+    Pipeline *PipelineVariants::Get(const u32 index) {
+        if (index >= m_Variants.size() || !m_Variants[index].pipeline) {
+            return nullptr;
+        }
+
+        return &m_Variants[index].pipeline.value();
+    }
+
+    usize PipelineVariants::PendingCount() const {
+        return m_Pending.size();
+    }
+
+    void PipelineVariants::Clear() {
+        m_Pending.clear();
+        m_Indices.clear();
+        m_Variants.clear();
+    }
+}
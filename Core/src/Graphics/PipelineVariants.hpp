@@ -0,0 +1,73 @@
+#ifndef FLK_PIPELINEVARIANTS_HPP
+#define FLK_PIPELINEVARIANTS_HPP
+
+#include <deque>
+#include <filesystem>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "Common.hpp"
+#include "Pipeline.hpp"
+
+namespace Flock::Graphics {
+    using ShaderKeywords = std::vector<std::string>;
+
+    /**
+     * @return A hash of the keywords, independent of their order and duplicates.
+     */
+    FLK_API u64 VariantKey(const ShaderKeywords &keywords);
+
+    /**
+     * @class PipelineVariants
+     * @brief Pipelines built from one file with different keywords defined, compiled in the background.
+     *
+     * Requesting a variant only preprocesses it. Update() starts the builds and picks up the finished ones, with
+     * GL_KHR_parallel_shader_compile the driver compiles them on its own threads, without it Update() finishes
+     * one variant per call so a new material costs a hitch per variant instead of one long stall. Until then,
+     * draws use the pipeline without keywords.
+     */
+    class FLK_API PipelineVariants {
+        struct Variant {
+            std::string                  vertex;
+            std::string                  fragment;
+            std::optional<PipelineBuild> build;
+            std::optional<Pipeline>      pipeline;
+            bool                         failed = false;
+        };
+
+        std::deque<Variant>                  m_Variants; // A deque, so pipelines keep their address.
+        std::unordered_map<std::string, u32> m_Indices;  // By file path and variant key.
+        std::vector<u32>                     m_Pending;  // Requested or building, oldest first.
+
+    public:
+        /**
+         * @brief Preprocesses a variant unless it was requested before, doesn't touch the GL context.
+         * @param filePath The pipeline file.
+         * @param keywords The keywords to define.
+         * @return The index of the variant if the file was preprocessed; std::nullopt otherwise.
+         */
+        std::optional<u32> Request(const std::filesystem::path &filePath, const ShaderKeywords &keywords);
+
+        /**
+         * @brief Starts building the requested variants and finishes the ready ones, needs the GL context.
+         * @return The number of variants that became available.
+         */
+        usize Update();
+
+        /**
+         * @return The pipeline of a variant if it's built; nullptr otherwise.
+         */
+        [[nodiscard]] Pipeline *Get(u32 index);
+
+        /**
+         * @return The number of variants not built yet.
+         */
+        [[nodiscard]] usize PendingCount() const;
+
+        void Clear();
+    };
+}
+
+#endif //FLK_PIPELINEVARIANTS_HPP
@@ -0,0 +1,244 @@
+#include "ProgramCache.hpp"
+
+#include <cstring>
+#include <mutex>
+#include <vector>
+
+#include "Debug/Log.hpp"
+#include "FileIo/File.hpp"
+#include "Graphics/Gl.hpp"
+#include "glad/glad.h"
+
+// Core in OpenGL 4.1, the loader may have been generated for an older version.
+#ifndef GL_PROGRAM_BINARY_RETRIEVABLE_HINT
+#define GL_PROGRAM_BINARY_RETRIEVABLE_HINT 0x8257
+#endif
+#ifndef GL_PROGRAM_BINARY_LENGTH
+#define GL_PROGRAM_BINARY_LENGTH 0x8741
+#endif
+#ifndef GL_NUM_PROGRAM_BINARY_FORMATS
+#define GL_NUM_PROGRAM_BINARY_FORMATS 0x87FE
+#endif
+
+namespace Flock::Graphics {
+    namespace {
+        typedef void (APIENTRYP GetProgramBinaryFn)(GLuint, GLsizei, GLsizei *, GLenum *, void *);
+        typedef void (APIENTRYP ProgramBinaryFn)(GLuint, GLenum, const void *, GLsizei);
+        typedef void (APIENTRYP ProgramParameteriFn)(GLuint, GLenum, GLint);
+
+        constexpr u32 s_Magic = 0x504B4C46; // "FLKP"
+
+        struct Header {
+            u32 magic  = s_Magic;
+            u32 format = 0;
+            u64 key    = 0;
+            u64 size   = 0;
+        };
+
+        struct State {
+            std::mutex            mutex;
+            std::filesystem::path directory;
+            bool                  resolved  = false;
+            bool                  supported = false;
+            std::string           driver; // Vendor, renderer and version, part of every key.
+
+            GetProgramBinaryFn  getProgramBinary  = nullptr;
+            ProgramBinaryFn     programBinary     = nullptr;
+            ProgramParameteriFn programParameteri = nullptr;
+        };
+
+        State s_State;
+
+        std::string GlString(const GLenum name) {
+            const auto *string = reinterpret_cast<const char *>(glGetString(name));
+            return string ? string : "";
+        }
+
+        // Looked up once a context is current, binary retrieval is optional for a 3.3 context.
+        bool Resolve() {
+            if (s_State.resolved) {
+                return s_State.supported;
+            }
+
+            s_State.resolved = true;
+
+            i32 major = 0;
+            i32 minor = 0;
+            glGetIntegerv(GL_MAJOR_VERSION, &major);
+            glGetIntegerv(GL_MINOR_VERSION, &minor);
+
+            if (major * 10 + minor < 41 && !HasExtension("GL_ARB_get_program_binary")) {
+                return false;
+            }
+
+            // Some drivers expose the entry points but no binary format to go with them.
+            i32 formats = 0;
+            glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formats);
+            while (glGetError() != GL_NO_ERROR) {}
+
+            s_State.getProgramBinary  = reinterpret_cast<GetProgramBinaryFn>(glfwGetProcAddress("glGetProgramBinary"));
+            s_State.programBinary     = reinterpret_cast<ProgramBinaryFn>(glfwGetProcAddress("glProgramBinary"));
+            s_State.programParameteri = reinterpret_cast<ProgramParameteriFn>(glfwGetProcAddress("glProgramParameteri"));
+
+            s_State.supported = formats > 0 && s_State.getProgramBinary && s_State.programBinary &&
+                                s_State.programParameteri;
+            s_State.driver = GlString(GL_VENDOR) + '\n' + GlString(GL_RENDERER) + '\n' + GlString(GL_VERSION);
+
+            return s_State.supported;
+        }
+
+        bool EnabledLocked() {
+            return !s_State.directory.empty() && Resolve();
+        }
+
+        u64 Key(const std::string &vertex, const std::string &fragment) {
+            u64 hash = 14695981039346656037ULL;
+
+            const auto mix = [&](const std::string &text) {
+                for (const char c: text) {
+                    hash ^= static_cast<u8>(c);
+                    hash *= 1099511628211ULL;
+                }
+
+                // Separates the strings, so moving text from one to the next changes the key.
+                hash ^= 0xFF;
+                hash *= 1099511628211ULL;
+            };
+
+            mix(vertex);
+            mix(fragment);
+            mix(s_State.driver);
+
+            return hash;
+        }
+
+        std::filesystem::path EntryPath(const u64 key) {
+            constexpr auto digits = "0123456789abcdef";
+
+            std::string name(16, '0');
+            for (usize i = 0; i < name.size(); i++) {
+                name[name.size() - 1 - i] = digits[(key >> (i * 4)) & 0xF];
+            }
+
+            return s_State.directory / (name + ".bin");
+        }
+    }
+
+    void ProgramCache::SetDirectory(const std::filesystem::path &directory) {
+        std::lock_guard lock(s_State.mutex);
+        s_State.directory = directory;
+    }
+
+    std::filesystem::path ProgramCache::Directory() {
+        std::lock_guard lock(s_State.mutex);
+        return s_State.directory;
+    }
+
+    bool ProgramCache::Enabled() {
+        std::lock_guard lock(s_State.mutex);
+        return EnabledLocked();
+    }
+
+    u32 ProgramCache::Load(const std::string &vertex, const std::string &fragment) {
+        std::lock_guard lock(s_State.mutex);
+        if (!EnabledLocked()) {
+            return 0;
+        }
+
+        const std::filesystem::path path = EntryPath(Key(vertex, fragment));
+
+        std::error_code error;
+        if (!std::filesystem::exists(path, error)) {
+            return 0;
+        }
+
+        const std::optional<std::vector<u8> > bytes = FileIo::ReadBytes(path);
+        if (!bytes || bytes->size() < sizeof(Header)) {
+            return 0;
+        }
+
+        Header header;
+        std::memcpy(&header, bytes->data(), sizeof(Header));
+
+        if (header.magic != s_Magic || header.key != Key(vertex, fragment) ||
+            header.size != bytes->size() - sizeof(Header)) {
+            return 0;
+        }
+
+        const u32 program = glCreateProgram();
+        s_State.programBinary(
+            program,
+            header.format,
+            bytes->data() + sizeof(Header),
+            static_cast<GLsizei>(header.size)
+        );
+
+        // A rejected binary is an ordinary miss, the error it raised doesn't need reporting.
+        i32 linked = 0;
+        glGetProgramiv(program, GL_LINK_STATUS, &linked);
+        while (glGetError() != GL_NO_ERROR) {}
+
+        if (linked != GL_TRUE) {
+            glDeleteProgram(program);
+            std::filesystem::remove(path, error);
+            return 0;
+        }
+
+        return program;
+    }
+
+    bool ProgramCache::Store(const u32 program, const std::string &vertex, const std::string &fragment) {
+        std::lock_guard lock(s_State.mutex);
+        if (program == 0 || !EnabledLocked()) {
+            return false;
+        }
+
+        i32 length = 0;
+        FLK_GL_CALL(glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &length));
+        if (length <= 0) {
+            return false;
+        }
+
+        std::vector<u8> bytes(sizeof(Header) + length);
+
+        Header  header;
+        GLsizei written = 0;
+        GLenum  format  = 0;
+        FLK_GL_CALL(s_State.getProgramBinary(program, length, &written, &format, bytes.data() + sizeof(Header)));
+
+        header.format = format;
+        header.key    = Key(vertex, fragment);
+        header.size   = written;
+
+        std::memcpy(bytes.data(), &header, sizeof(Header));
+        bytes.resize(sizeof(Header) + written);
+
+        std::error_code error;
+        std::filesystem::create_directories(s_State.directory, error);
+        if (error) {
+            Debug::LogErr("ProgramCache::Store: Failed to create '{}'!", s_State.directory.string());
+            return false;
+        }
+
+        // Written next to the entry and moved in place, so a crash never leaves a torn binary behind.
+        const std::filesystem::path path      = EntryPath(header.key);
+        std::filesystem::path       temporary = path;
+        temporary += ".tmp";
+
+        if (!FileIo::WriteBytes(temporary, bytes)) {
+            return false;
+        }
+
+        std::filesystem::rename(temporary, path, error);
+        return !error;
+    }
+
+    void ProgramCache::MarkRetrievable(const u32 program) {
+        std::lock_guard lock(s_State.mutex);
+        if (!EnabledLocked()) {
+            return;
+        }
+
+        FLK_GL_CALL(s_State.programParameteri(program, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE));
+    }
+}
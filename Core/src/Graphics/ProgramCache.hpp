@@ -0,0 +1,57 @@
+#ifndef FLK_PROGRAMCACHE_HPP
+#define FLK_PROGRAMCACHE_HPP
+
+#include <filesystem>
+#include <string>
+
+#include "Common.hpp"
+
+namespace Flock::Graphics {
+    /**
+     * @class ProgramCache
+     * @brief Keeps linked shader programs on disk as driver binaries, so later runs skip compiling and linking.
+     *
+     * Entries are keyed by a hash of the preprocessed sources and the driver's vendor, renderer and version
+     * strings, a driver update misses instead of loading a stale binary. Needs OpenGL 4.1 or
+     * GL_ARB_get_program_binary, without either every call is a miss and programs are compiled as usual.
+     */
+    class FLK_API ProgramCache {
+    public:
+        /**
+         * @brief Sets where binaries are kept, created on the first store.
+         * @param directory The cache directory, empty disables the cache.
+         */
+        static void                                SetDirectory(const std::filesystem::path &directory);
+        [[nodiscard]] static std::filesystem::path Directory();
+
+        /**
+         * @return true if the cache has a directory and the context can retrieve program binaries; false otherwise.
+         */
+        [[nodiscard]] static bool Enabled();
+
+        /**
+         * @brief Creates a program from a cached binary.
+         * @param vertex The preprocessed vertex shader source.
+         * @param fragment The preprocessed fragment shader source.
+         * @return The linked program if the cache had a binary the driver accepted; 0 otherwise.
+         */
+        static u32 Load(const std::string &vertex, const std::string &fragment);
+
+        /**
+         * @brief Writes the binary of a linked program to the cache.
+         * @param program The program, linked after MarkRetrievable().
+         * @param vertex The preprocessed vertex shader source.
+         * @param fragment The preprocessed fragment shader source.
+         * @return true if successful; false otherwise.
+         */
+        static bool Store(u32 program, const std::string &vertex, const std::string &fragment);
+
+        /**
+         * @brief Asks the driver to keep the binary of a program around, must be called before linking.
+         * @param program The program.
+         */
+        static void MarkRetrievable(u32 program);
+    };
+}
+
+#endif //FLK_PROGRAMCACHE_HPP
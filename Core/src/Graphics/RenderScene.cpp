@@ -0,0 +1,406 @@
+#include "RenderScene.hpp"
+
+#include <algorithm>
+#include <functional>
+#include <span>
+
+#include "Asset/AssetLoader.hpp"
+#include "Debug/Log.hpp"
+#include "Graphics/Occluder.hpp"
+#include "Jobs/JobSystem.hpp"
+#include "Math/TransformBatch.hpp"
+
+namespace Flock::Graphics {
+    namespace {
+        constexpr usize s_CollectGrain = 512;  // Proxies per collection job.
+        constexpr usize s_UpdateGrain  = 1024; // Moved instances per update job.
+    }
+
+    bool RenderScene::Set(
+        const u32                        key,
+        const Asset::AssetHandle<Model> &model,
+        const Transform &                transform,
+        const bool                       isStatic,
+        Asset::AssetLoader &             loader
+    ) {
+        if (key >= m_Instances.size()) {
+            m_Instances.resize(key + 1);
+        }
+
+        Instance &instance = m_Instances[key];
+        instance.model     = model;
+        instance.transform = transform;
+        instance.isStatic  = isStatic;
+        instance.live      = true;
+
+        loader.Resolve(instance.model);
+
+        return BuildProxies(key, loader);
+    }
+
+    void RenderScene::SetTransform(const u32 key, const Transform &transform) {
+        if (!Contains(key)) {
+            return;
+        }
+
+        Instance &instance = m_Instances[key];
+        instance.transform = transform;
+
+        if (!instance.dirty) {
+            instance.dirty = true;
+            m_Dirty.push_back(key);
+        }
+    }
+
+    bool RenderScene::Remove(const u32 key) {
+        if (!Contains(key)) {
+            return false;
+        }
+
+        Instance &instance = m_Instances[key];
+        RemoveProxies(instance);
+        if (instance.occluder) {
+            std::erase(m_Occluders, key);
+        }
+
+        instance = {};
+
+        return true;
+    }
+
+    bool RenderScene::Contains(const u32 key) const {
+        return key < m_Instances.size() && m_Instances[key].live;
+    }
+
+    bool RenderScene::SetOccluder(const u32 key, const Occluder *occluder, Asset::AssetLoader &loader) {
+        if (!Contains(key)) {
+            return false;
+        }
+
+        Instance &instance = m_Instances[key];
+        if (!occluder) {
+            if (instance.occluder) {
+                std::erase(m_Occluders, key);
+            }
+
+            instance.occluder      = false;
+            instance.occluderModel = {};
+            instance.occluderMeshes.clear();
+            return true;
+        }
+
+        if (!instance.occluder) {
+            m_Occluders.push_back(key);
+        }
+
+        instance.occluder      = true;
+        instance.occluderModel = occluder->model;
+
+        if (!instance.occluderModel.filePath.empty() || instance.occluderModel.IsValid()) {
+            loader.Resolve(instance.occluderModel);
+        }
+
+        return BuildOccluder(instance, loader);
+    }
+
+    void RenderScene::CollectOccluders(std::vector<OccluderMesh> &occluders) const {
+        for (const u32 key: m_Occluders) {
+            const Instance &instance = m_Instances[key];
+            const Matrix4f  model    = instance.transform.Matrix();
+
+            for (const MeshData *data: instance.occluderMeshes) {
+                occluders.push_back({.data = data, .model = model});
+            }
+        }
+    }
+
+    void RenderScene::Refresh(Asset::AssetLoader &loader) {
+        if (m_Generation == loader.Generation()) {
+            return;
+        }
+
+        for (u32 key = 0; key < m_Instances.size(); key++) {
+            if (m_Instances[key].live) {
+                BuildProxies(key, loader);
+            }
+        }
+
+        // Removed textures free their GL IDs for new ones, the packed layers can't be trusted anymore.
+        m_PackDirty  = m_MaterialBatching;
+        m_Generation = loader.Generation();
+    }
+
+    void RenderScene::Clear() {
+        m_Instances.clear();
+        m_Proxies.clear();
+        m_Dirty.clear();
+        m_Occluders.clear();
+        m_MaterialTextures.Clear();
+        m_Variants.Clear();
+        m_PackDirty = false;
+    }
+
+    void RenderScene::Collect(const Camera &camera, RenderList &commands) {
+        UpdateDirty();
+
+        if (m_PackDirty) {
+            PackMaterials();
+        }
+
+        // Collect() runs with the GL context, proxies switch from the fallback as their variants finish.
+        if (m_Variants.Update() > 0) {
+            for (RenderProxy &proxy: m_Proxies) {
+                if (proxy.variant == FLK_INVALID) {
+                    continue;
+                }
+
+                if (Pipeline *pipeline = m_Variants.Get(proxy.variant)) {
+                    proxy.pipeline = pipeline;
+                }
+            }
+        }
+
+        // Every proxy writes its own slot, so the jobs need no synchronization and the order stays fixed.
+        const usize first = commands.size();
+        commands.resize(first + m_Proxies.size(), {.mesh = nullptr, .pipeline = nullptr});
+
+        Jobs::ParallelFor(m_Proxies.size(), s_CollectGrain, [&](const usize begin, const usize end) {
+            for (usize i = begin; i < end; i++) {
+                RenderProxy &   proxy    = m_Proxies[i];
+                const Instance &instance = m_Instances[proxy.owner];
+                RenderObject &  object   = *proxy.object;
+
+                const f32 coverage = ScreenCoverage(proxy.bounds, camera);
+                proxy.lod          = SelectLod(coverage, proxy.lod, object.LodCount(), m_LodConfig);
+
+                // Static casters keep one shadow level, so the camera moving doesn't invalidate the cached cascades.
+                const u32 shadowLod = (instance.isStatic ? 0 : proxy.lod) + m_LodConfig.shadowBias;
+
+                commands[first + i] = {
+                    .mesh               = &object.Lod(proxy.lod),
+                    .pipeline           = proxy.pipeline,
+                    .materialProperties = proxy.material,
+                    .transform          = instance.transform,
+                    .isStatic           = instance.isStatic,
+                    .queue              = proxy.queue,
+                    .shadowMesh         = &object.Lod(shadowLod),
+                    .model              = proxy.model,
+                    .bounds             = proxy.bounds,
+                };
+            }
+        });
+    }
+
+    usize RenderScene::InstanceCount() const {
+        return std::ranges::count_if(m_Instances, [](const Instance &instance) { return instance.live; });
+    }
+
+    usize RenderScene::ProxyCount() const {
+        return m_Proxies.size();
+    }
+
+    void RenderScene::SetLodConfig(const LodConfig &config) {
+        m_LodConfig = config;
+    }
+
+    const LodConfig &RenderScene::GetLodConfig() const {
+        return m_LodConfig;
+    }
+
+    void RenderScene::SetMaterialBatching(const bool enabled) {
+        if (m_MaterialBatching == enabled) {
+            return;
+        }
+
+        m_MaterialBatching = enabled;
+        m_PackDirty        = enabled;
+
+        if (!enabled) {
+            m_MaterialTextures.Clear();
+            for (RenderProxy &proxy: m_Proxies) {
+                AssignLayers(proxy.material);
+            }
+        }
+    }
+
+    bool RenderScene::MaterialBatching() const {
+        return m_MaterialBatching;
+    }
+
+    const MaterialTextures &RenderScene::GetMaterialTextures() const {
+        return m_MaterialTextures;
+    }
+
+    PipelineVariants &RenderScene::Variants() {
+        return m_Variants;
+    }
+
+    bool RenderScene::BuildProxies(const u32 key, Asset::AssetLoader &loader) {
+        Instance &instance = m_Instances[key];
+        RemoveProxies(instance);
+
+        Model *model = loader.Get(instance.model);
+        if (model == nullptr) {
+            Debug::LogErr("RenderScene::BuildProxies: Invalid model");
+            return false;
+        }
+
+        const Matrix4f matrix = instance.transform.Matrix();
+
+        for (auto &object: model->objects) {
+            Material &mat = object.material;
+
+            // Resolved in the model itself, so later lookups skip the path map.
+            loader.Resolve(mat.pipeline);
+            loader.Resolve(mat.colorMap);
+            loader.Resolve(mat.metallicMap);
+            loader.Resolve(mat.roughnessMap);
+
+            instance.proxies.push_back(m_Proxies.size());
+            RenderProxy &proxy = m_Proxies.emplace_back(RenderProxy{
+                .object   = &object,
+                .pipeline = loader.Get(mat.pipeline),
+                .material = {
+                    .color        = mat.color,
+                    .metallic     = mat.metallic,
+                    .roughness    = mat.roughness,
+                    .colorMap     = loader.Get(mat.colorMap),
+                    .metallicMap  = loader.Get(mat.metallicMap),
+                    .roughnessMap = loader.Get(mat.roughnessMap),
+                    .alphaCutoff  = mat.alphaCutoff,
+                },
+                .queue    = mat.queue,
+                .model    = matrix,
+                .bounds   = object.bounds.Transformed(instance.transform),
+                .owner    = key,
+            });
+
+            // Variants are built from the pipeline's file, the pipeline itself draws until the variant is ready.
+            const std::string &pipelinePath = mat.pipeline.filePath;
+            if (!mat.keywords.empty() && !pipelinePath.empty() && pipelinePath[0] != '@') {
+                if (const std::optional<u32> variant = m_Variants.Request(pipelinePath, mat.keywords)) {
+                    proxy.variant = variant.value();
+                    if (Pipeline *pipeline = m_Variants.Get(proxy.variant)) {
+                        proxy.pipeline = pipeline;
+                    }
+                }
+            }
+
+            // Maps that aren't packed yet are packed on the next Collect(), the proxy draws unbatched until then.
+            if (!AssignLayers(proxy.material) && m_MaterialBatching) {
+                m_PackDirty = true;
+            }
+        }
+
+        // The meshes are pointers into the asset pools too.
+        if (instance.occluder) {
+            BuildOccluder(instance, loader);
+        }
+
+        return true;
+    }
+
+    void RenderScene::RemoveProxies(Instance &instance) {
+        // Highest index first, so swapping the last proxy in never moves one that is still to be removed.
+        std::ranges::sort(instance.proxies, std::greater{});
+
+        for (const u32 index: instance.proxies) {
+            const u32 last = m_Proxies.size() - 1;
+            if (index != last) {
+                m_Proxies[index] = m_Proxies[last];
+
+                auto &moved = m_Instances[m_Proxies[index].owner].proxies;
+                std::ranges::replace(moved, last, index);
+            }
+
+            m_Proxies.pop_back();
+        }
+
+        instance.proxies.clear();
+    }
+
+    bool RenderScene::BuildOccluder(Instance &instance, Asset::AssetLoader &loader) const {
+        instance.occluderMeshes.clear();
+
+        const bool standIn = !instance.occluderModel.filePath.empty() || instance.occluderModel.IsValid();
+        Model *    model   = loader.Get(standIn ? instance.occluderModel : instance.model);
+        if (model == nullptr) {
+            Debug::LogErr("RenderScene::BuildOccluder: Invalid occluder model");
+            return false;
+        }
+
+        // Not the coarser LODs, simplification can move their surface past the real one and hide visible objects.
+        for (RenderObject &object: model->objects) {
+            instance.occluderMeshes.push_back(&object.mesh.Data());
+        }
+
+        return true;
+    }
+
+    void RenderScene::UpdateDirty() {
+        if (m_Dirty.empty()) {
+            return;
+        }
+
+        m_Transforms.clear();
+        for (const u32 key: m_Dirty) {
+            m_Transforms.push_back(m_Instances[key].transform);
+        }
+
+        m_Models.resize(m_Transforms.size());
+
+        // Instances own disjoint proxies, so each job can write its instances' proxies directly.
+        Jobs::ParallelFor(m_Dirty.size(), s_UpdateGrain, [&](const usize begin, const usize end) {
+            ComputeMatrices(
+                std::span<const Transform>(m_Transforms).subspan(begin, end - begin),
+                std::span<Matrix4f>(m_Models).subspan(begin, end - begin)
+            );
+
+            for (usize i = begin; i < end; i++) {
+                Instance &instance = m_Instances[m_Dirty[i]];
+                instance.dirty     = false;
+
+                for (const u32 index: instance.proxies) {
+                    RenderProxy &proxy = m_Proxies[index];
+                    proxy.model        = m_Models[i];
+                    proxy.bounds       = proxy.object->bounds.Transformed(instance.transform);
+                }
+            }
+        });
+
+        m_Dirty.clear();
+    }
+
+    void RenderScene::PackMaterials() {
+        m_PackDirty = false;
+
+        std::vector<const Texture *> textures;
+        for (const RenderProxy &proxy: m_Proxies) {
+            textures.push_back(proxy.material.colorMap);
+            textures.push_back(proxy.material.metallicMap);
+            textures.push_back(proxy.material.roughnessMap);
+        }
+
+        if (!m_MaterialTextures.Pack(textures)) {
+            Debug::LogErr("RenderScene::PackMaterials: Failed to pack material textures!");
+        }
+
+        for (RenderProxy &proxy: m_Proxies) {
+            AssignLayers(proxy.material);
+        }
+    }
+
+    bool RenderScene::AssignLayers(MaterialProperties &material) const {
+        material.colorLayer     = m_MaterialTextures.Find(material.colorMap);
+        material.metallicLayer  = m_MaterialTextures.Find(material.metallicMap);
+        material.roughnessLayer = m_MaterialTextures.Find(material.roughnessMap);
+
+        // A missing map reads the default texture in both paths, only present maps have to be packed.
+        material.batched = m_MaterialBatching &&
+                           (!material.colorMap || material.colorLayer.array) &&
+                           (!material.metallicMap || material.metallicLayer.array) &&
+                           (!material.roughnessMap || material.roughnessLayer.array);
+
+        return material.batched;
+    }
+}
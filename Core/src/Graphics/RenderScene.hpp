@@ -0,0 +1,209 @@
+#ifndef FLK_RENDERSCENE_HPP
+#define FLK_RENDERSCENE_HPP
+
+#include <vector>
+
+#include "Camera.hpp"
+#include "Material.hpp"
+#include "MaterialTextures.hpp"
+#include "MeshLod.hpp"
+#include "Model.hpp"
+#include "OcclusionBuffer.hpp"
+#include "PipelineVariants.hpp"
+#include "Common.hpp"
+#include "Asset/AssetHandle.hpp"
+#include "Math/Color.hpp"
+#include "Math/Matrix.hpp"
+#include "Math/Transform.hpp"
+
+namespace Flock::Asset {
+    class AssetLoader;
+}
+
+namespace Flock::Graphics {
+    struct Occluder;
+    class Mesh;
+    class Pipeline;
+    class Texture;
+
+    struct MaterialProperties {
+        Color4u8 color        = Color4u8::White();
+        f32      metallic     = 0.25F;
+        f32      roughness    = 0.75F;
+        Texture *colorMap     = nullptr;
+        Texture *metallicMap  = nullptr;
+        Texture *roughnessMap = nullptr;
+        f32      alphaCutoff  = 0.5F; // Only used by RenderQueue::AlphaTested.
+
+        // Set by RenderScene with material batching, the maps' layers in MaterialTextures.
+        bool         batched        = false; // Every map is packed, so the draw can be instanced.
+        TextureLayer colorLayer     = {};
+        TextureLayer metallicLayer  = {};
+        TextureLayer roughnessLayer = {};
+    };
+
+    struct RenderCommand {
+        const Mesh *       mesh;
+        Pipeline *         pipeline;
+        MaterialProperties materialProperties = {};
+        Transform          transform          = {};
+        bool               isStatic           = false;
+        RenderQueue        queue              = RenderQueue::Opaque;
+        const Mesh *       shadowMesh         = nullptr;           // For shadow passes, mesh if null. Fixed for static commands.
+        Matrix4f           model              = {};                // Computed from transform by Render(), for all passes.
+        BoundingSphere     bounds             = {.radius = -1.0F}; // In world space, never culled if the radius is negative.
+    };
+
+    using RenderList = std::vector<RenderCommand>;
+
+    /**
+     * @struct RenderProxy
+     * @brief The render state of one model object, kept across frames.
+     */
+    struct RenderProxy {
+        RenderObject *     object   = nullptr;
+        Pipeline *         pipeline = nullptr;
+        MaterialProperties material = {};
+        RenderQueue        queue    = RenderQueue::Opaque;
+        Matrix4f           model    = {};
+        BoundingSphere     bounds   = {}; // In world space.
+        u32                lod      = 0;  // The LOD selected last frame.
+        u32                owner    = FLK_INVALID;
+        u32                variant  = FLK_INVALID; // The material's pipeline variant, if it has keywords.
+    };
+
+    /**
+     * @class RenderScene
+     * @brief Retained render proxies of the models in a world, updated only where something changed.
+     *
+     * Each instance is a model with a transform under a caller chosen key, usually an entity ID, and gets one
+     * proxy per model object. Materials are resolved when an instance is set and again only after the asset
+     * loader adds or removes assets, matrices and bounds only when the transform is set.
+     */
+    class FLK_API RenderScene {
+        struct Instance {
+            Asset::AssetHandle<Model> model     = {};
+            Transform                 transform = {};
+            bool                      isStatic  = false;
+            bool                      live      = false;
+            bool                      dirty     = false; // The transform changed since the last Collect().
+            std::vector<u32>          proxies   = {};
+
+            bool                          occluder       = false;
+            Asset::AssetHandle<Model>     occluderModel  = {}; // Empty for the full detail meshes of model.
+            std::vector<const MeshData *> occluderMeshes = {};
+        };
+
+        std::vector<Instance>    m_Instances;
+        std::vector<RenderProxy> m_Proxies;
+        std::vector<u32>         m_Dirty;
+        std::vector<u32>         m_Occluders; // Keys of the instances marked as occluders.
+        std::vector<Transform>   m_Transforms;
+        std::vector<Matrix4f>    m_Models;
+        LodConfig                m_LodConfig;
+        u64                      m_Generation = 0;
+        MaterialTextures         m_MaterialTextures;
+        bool                     m_MaterialBatching = false;
+        bool                     m_PackDirty        = false; // A proxy has a map that isn't packed yet.
+        PipelineVariants         m_Variants;
+
+    public:
+        /**
+         * @brief Creates or replaces an instance and resolves its materials.
+         *
+         * Resolving can load assets, which moves the ones loaded before, so call Refresh() before the next Collect().
+         *
+         * @param key The instance key.
+         * @param model The model.
+         * @param transform The instance transform.
+         * @param isStatic Whether it's cached in the far shadow cascades.
+         * @param loader The asset loader to resolve the model and materials with.
+         * @return true if successful; false otherwise.
+         */
+        bool Set(u32 key, const Asset::AssetHandle<Model> &model, const Transform &transform, bool isStatic,
+                 Asset::AssetLoader &loader);
+
+        /**
+         * @brief Moves an instance, its matrices are recomputed on the next Collect().
+         * @param key The instance key.
+         * @param transform The new transform.
+         */
+        void SetTransform(u32 key, const Transform &transform);
+
+        /**
+         * @brief Removes an instance and its proxies.
+         * @param key The instance key.
+         * @return true if the instance existed; false otherwise.
+         */
+        bool Remove(u32 key);
+
+        [[nodiscard]] bool Contains(u32 key) const;
+
+        /**
+         * @brief Marks an instance as an occluder, or unmarks it.
+         * @param key The instance key.
+         * @param occluder The occluder, or null to unmark the instance.
+         * @param loader The asset loader to resolve the occluder model with.
+         * @return true if successful; false otherwise.
+         */
+        bool SetOccluder(u32 key, const Occluder *occluder, Asset::AssetLoader &loader);
+
+        /**
+         * @brief Appends the meshes of every occluder with its instance's current transform.
+         * @param occluders The list to append to.
+         */
+        void CollectOccluders(std::vector<OccluderMesh> &occluders) const;
+
+        /**
+         * @brief Resolves all proxies again if the asset loader added or removed assets since the last call.
+         *
+         * Proxies point into the asset pools, which move when assets are added or removed.
+         *
+         * @param loader The asset loader.
+         */
+        void Refresh(Asset::AssetLoader &loader);
+
+        void Clear();
+
+        /**
+         * @brief Updates the moved instances, selects LODs and appends a command per proxy.
+         * @param camera The camera to select LODs for.
+         * @param commands The list to append to.
+         */
+        void Collect(const Camera &camera, RenderList &commands);
+
+        [[nodiscard]] usize InstanceCount() const;
+        [[nodiscard]] usize ProxyCount() const;
+
+        void                           SetLodConfig(const LodConfig &config);
+        [[nodiscard]] const LodConfig &GetLodConfig() const;
+
+        /**
+         * @brief Packs the material textures into texture arrays, so the renderer can instance draws across materials.
+         *
+         * Textures are packed on the next Collect() after they are first used or the asset loader changed, the
+         * pipelines have to read their maps from instance data, see Renderer.
+         *
+         * @param enabled Whether materials are batched.
+         */
+        void               SetMaterialBatching(bool enabled);
+        [[nodiscard]] bool MaterialBatching() const;
+
+        [[nodiscard]] const MaterialTextures &GetMaterialTextures() const;
+
+        /**
+         * @brief The pipeline variants of materials with keywords, built during Collect().
+         */
+        [[nodiscard]] PipelineVariants &Variants();
+
+    private:
+        bool BuildProxies(u32 key, Asset::AssetLoader &loader);
+        void RemoveProxies(Instance &instance);
+        bool BuildOccluder(Instance &instance, Asset::AssetLoader &loader) const;
+        void UpdateDirty();
+        void PackMaterials();
+        bool AssignLayers(MaterialProperties &material) const;
+    };
+}
+
+#endif //FLK_RENDERSCENE_HPP
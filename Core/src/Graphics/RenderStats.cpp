@@ -0,0 +1,172 @@
+#include "RenderStats.hpp"
+
+#include <numeric>
+#include <utility>
+
+#include "Graphics/Gl.hpp"
+#include "Graphics/StateCache.hpp"
+#include "glad/glad.h"
+
+namespace Flock::Graphics {
+    namespace {
+        RenderStats s_Counts;
+    }
+
+    f32 RenderStats::GpuTime(const GpuPass pass) const {
+        return pass < GpuPass::Count ? gpuMilliseconds[static_cast<usize>(pass)] : 0.0F;
+    }
+
+    f32 RenderStats::GpuTotal() const {
+        return std::accumulate(gpuMilliseconds.begin(), gpuMilliseconds.end(), 0.0F);
+    }
+
+    void FrameCounters::Draw(const u64 indices, const u32 instances) {
+        s_Counts.drawCalls++;
+        s_Counts.triangles += indices / 3 * instances;
+    }
+
+    void FrameCounters::UniformUpload() {
+        s_Counts.uniformUploads++;
+    }
+
+    void FrameCounters::BufferUpload(const usize bytes) {
+        s_Counts.bufferBytes += bytes;
+    }
+
+    RenderStats FrameCounters::Counts() {
+        const StateCacheStats binds = StateCache::Stats();
+
+        RenderStats stats      = s_Counts;
+        stats.programBinds     = binds.programBinds;
+        stats.vertexArrayBinds = binds.vertexArrayBinds;
+        stats.textureBinds     = binds.textureBinds;
+
+        return stats;
+    }
+
+    void FrameCounters::Reset() {
+        s_Counts = {};
+        StateCache::ResetStats();
+    }
+
+    GpuTimers::~GpuTimers() {
+        Clear();
+    }
+
+    GpuTimers::GpuTimers(GpuTimers &&other) noexcept
+        : m_Frames(std::exchange(other.m_Frames, {})),
+          m_Current(other.m_Current),
+          m_Active(std::exchange(other.m_Active, false)),
+          m_Milliseconds(other.m_Milliseconds) {}
+
+    GpuTimers &GpuTimers::operator=(GpuTimers &&other) noexcept {
+        if (this == &other) {
+            return *this;
+        }
+
+        Clear();
+
+        m_Frames       = std::exchange(other.m_Frames, {});
+        m_Current      = other.m_Current;
+        m_Active       = std::exchange(other.m_Active, false);
+        m_Milliseconds = other.m_Milliseconds;
+
+        return *this;
+    }
+
+    void GpuTimers::BeginFrame() {
+        if (m_Active) {
+            End();
+        }
+
+        m_Current    = (m_Current + 1) % s_Latency;
+        Frame &frame = m_Frames[m_Current];
+
+        if (frame.used > 0) {
+            // Rarely still pending this late, then the old times stay up rather than stalling on the new ones.
+            bool available = true;
+            for (usize i = 0; i < frame.used && available; i++) {
+                i32 ready = 0;
+                FLK_GL_CALL(glGetQueryObjectiv(frame.queries[i], GL_QUERY_RESULT_AVAILABLE, &ready));
+                available = ready == GL_TRUE;
+            }
+
+            if (available) {
+                m_Milliseconds.fill(0.0F);
+                for (usize i = 0; i < frame.used; i++) {
+                    GLuint64 nanoseconds = 0;
+                    FLK_GL_CALL(glGetQueryObjectui64v(frame.queries[i], GL_QUERY_RESULT, &nanoseconds));
+                    m_Milliseconds[static_cast<usize>(frame.passes[i])] += static_cast<f32>(nanoseconds) / 1e6F;
+                }
+            }
+        }
+
+        frame.used = 0;
+    }
+
+    bool GpuTimers::Begin(const GpuPass pass) {
+        Frame &frame = m_Frames[m_Current];
+
+        // Bounded, in case BeginFrame() is never called.
+        if (m_Active || pass >= GpuPass::Count || frame.used >= s_MaxQueries) {
+            return false;
+        }
+
+        if (frame.used == frame.queries.size()) {
+            u32 query = 0;
+            FLK_GL_CALL(glGenQueries(1, &query));
+            frame.queries.push_back(query);
+            frame.passes.push_back(pass);
+        }
+
+        frame.passes[frame.used] = pass;
+        FLK_GL_CALL(glBeginQuery(GL_TIME_ELAPSED, frame.queries[frame.used]));
+        frame.used++;
+
+        m_Active = true;
+        return true;
+    }
+
+    void GpuTimers::End() {
+        if (!m_Active) {
+            return;
+        }
+
+        FLK_GL_CALL(glEndQuery(GL_TIME_ELAPSED));
+        m_Active = false;
+    }
+
+    f32 GpuTimers::Milliseconds(const GpuPass pass) const {
+        return pass < GpuPass::Count ? m_Milliseconds[static_cast<usize>(pass)] : 0.0F;
+    }
+
+    const std::array<f32, s_GpuPassCount> &GpuTimers::AllMilliseconds() const {
+        return m_Milliseconds;
+    }
+
+    GpuTimers::Scope::Scope(GpuTimers &timers, const GpuPass pass) {
+        if (timers.Begin(pass)) {
+            m_Timers = &timers;
+        }
+    }
+
+    GpuTimers::Scope::~Scope() {
+        if (m_Timers) {
+            m_Timers->End();
+        }
+    }
+
+    void GpuTimers::Clear() {
+        if (m_Active) {
+            End();
+        }
+
+        for (Frame &frame: m_Frames) {
+            if (!frame.queries.empty()) {
+                FLK_GL_CALL(glDeleteQueries(static_cast<i32>(frame.queries.size()), frame.queries.data()));
+            }
+
+            frame = {};
+        }
+    }
+}
@@ -0,0 +1,140 @@
+#ifndef FLK_RENDERSTATS_HPP
+#define FLK_RENDERSTATS_HPP
+
+#include <array>
+#include <vector>
+
+#include "Common.hpp"
+
+namespace Flock::Graphics {
+    /**
+     * @enum GpuPass
+     * @brief The passes timed on the GPU.
+     */
+    enum class GpuPass : u8 {
+        Shadows,
+        Skybox,
+        Scene,
+        Gui,
+        Count,
+    };
+
+    static constexpr usize s_GpuPassCount = static_cast<usize>(GpuPass::Count);
+
+    /**
+     * @struct RenderStats
+     * @brief What the last frame cost, a resource of the world updated at every sync point.
+     */
+    struct FLK_API RenderStats {
+        u64 drawCalls        = 0;
+        u64 triangles        = 0;
+        u64 programBinds     = 0;
+        u64 vertexArrayBinds = 0;
+        u64 textureBinds     = 0;
+        u64 uniformUploads   = 0;
+        u64 bufferBytes      = 0; // Uploaded to buffer objects.
+
+        // GPU time per GpuPass in milliseconds, from GpuTimers::s_Latency frames earlier.
+        std::array<f32, s_GpuPassCount> gpuMilliseconds = {};
+
+        [[nodiscard]] f32 GpuTime(GpuPass pass) const;
+        [[nodiscard]] f32 GpuTotal() const;
+    };
+
+    /**
+     * @class FrameCounters
+     * @brief Counts draws and uploads as they are issued, binds are counted by the StateCache.
+     *
+     * Only touched by the thread that owns the GL context.
+     */
+    class FLK_API FrameCounters {
+    public:
+        static void Draw(u64 indices, u32 instances = 1);
+        static void UniformUpload();
+        static void BufferUpload(usize bytes);
+
+        /**
+         * @return The counts since the last Reset(), without GPU times.
+         */
+        [[nodiscard]] static RenderStats Counts();
+
+        /**
+         * @brief Starts counting a new frame, also resets the StateCache stats.
+         */
+        static void Reset();
+    };
+
+    /**
+     * @class GpuTimers
+     * @brief GL_TIME_ELAPSED queries around the passes of a frame, read back s_Latency frames later.
+     *
+     * By then the GPU is done with them, so reading the results never waits. A pass can be timed more than once
+     * per frame, its times add up. Queries can't overlap, a pass started inside another isn't timed.
+     */
+    class FLK_API GpuTimers {
+    public:
+        static constexpr usize s_Latency    = 3;
+        static constexpr usize s_MaxQueries = 64; // Per frame.
+
+    private:
+        struct Frame {
+            std::vector<u32>     queries; // Pooled, the first used ones belong to this frame.
+            std::vector<GpuPass> passes;
+            usize                used = 0;
+        };
+
+        std::array<Frame, s_Latency>    m_Frames;
+        usize                           m_Current = 0;
+        bool                            m_Active  = false;
+        std::array<f32, s_GpuPassCount> m_Milliseconds = {};
+
+    public:
+        GpuTimers() = default;
+        ~GpuTimers();
+
+        GpuTimers(const GpuTimers &other) = delete;
+        GpuTimers(GpuTimers &&other) noexcept;
+
+        GpuTimers &operator=(const GpuTimers &other) = delete;
+        GpuTimers &operator=(GpuTimers &&other) noexcept;
+
+        /**
+         * @brief Collects the frame from s_Latency frames ago and reuses its queries for a new one.
+         */
+        void BeginFrame();
+
+        /**
+         * @brief Starts timing a pass.
+         * @return true if the query started; false if another pass is being timed.
+         */
+        bool Begin(GpuPass pass);
+        void End();
+
+        /**
+         * @return The last collected time of a pass in milliseconds.
+         */
+        [[nodiscard]] f32 Milliseconds(GpuPass pass) const;
+
+        [[nodiscard]] const std::array<f32, s_GpuPassCount> &AllMilliseconds() const;
+
+        /**
+         * @class Scope
+         * @brief Times a pass until the end of the scope.
+         */
+        class FLK_API Scope {
+            GpuTimers *m_Timers = nullptr;
+
+        public:
+            Scope(GpuTimers &timers, GpuPass pass);
+            ~Scope();
+
+            Scope(const Scope &other) = delete;
+            Scope &operator=(const Scope &other) = delete;
+        };
+
+    private:
+        void Clear();
+    };
+}
+
+#endif //FLK_RENDERSTATS_HPP
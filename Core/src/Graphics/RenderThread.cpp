@@ -0,0 +1,173 @@
+#include "RenderThread.hpp"
+
+#include <condition_variable>
+#include <mutex>
+#include <utility>
+
+#include "Debug/Profiler.hpp"
+#include "Glfw/Window.hpp"
+
+namespace Flock::Graphics {
+    struct RenderThread::State {
+        std::mutex              mutex;
+        std::condition_variable wake;
+        std::condition_variable idle;
+        std::function<void()>   frame;
+        bool                    pending = false; // A frame or a release is queued or running.
+        bool                    release = false; // Unbind the context once done.
+        bool                    stop    = false;
+    };
+
+    RenderThread::RenderThread()
+        : m_State(std::make_unique<State>()) {
+    }
+
+    RenderThread::~RenderThread() {
+        Stop();
+    }
+
+    // Only moved before Start(), the thread refers to this object.
+    RenderThread::RenderThread(RenderThread &&other) noexcept            = default;
+    RenderThread &RenderThread::operator=(RenderThread &&other) noexcept = default;
+
+    bool RenderThread::Start(Glfw::Window &window) {
+        if (IsRunning()) {
+            return false;
+        }
+
+        m_Window        = &window;
+        m_CallerContext = false;
+        m_State->stop   = false;
+
+        Glfw::Window::UnbindContext();
+        m_Thread = std::thread([this] { Loop(); });
+
+        return true;
+    }
+
+    void RenderThread::Stop() {
+        if (!IsRunning()) {
+            return;
+        }
+
+        Wait();
+
+        {
+            std::lock_guard lock(m_State->mutex);
+            m_State->stop = true;
+        }
+
+        m_State->wake.notify_one();
+        m_Thread.join();
+
+        m_Window->BindContext();
+        m_CallerContext = true;
+    }
+
+    bool RenderThread::IsRunning() const {
+        return m_Thread.joinable();
+    }
+
+    void RenderThread::Submit(std::function<void()> frame) {
+        if (!IsRunning()) {
+            frame();
+            return;
+        }
+
+        Wait();
+
+        if (m_CallerContext) {
+            Glfw::Window::UnbindContext();
+            m_CallerContext = false;
+        }
+
+        {
+            std::lock_guard lock(m_State->mutex);
+            m_State->frame   = std::move(frame);
+            m_State->pending = true;
+        }
+
+        m_State->wake.notify_one();
+    }
+
+    void RenderThread::Wait() {
+        // A frame waiting on itself would never wake, anything it calls back into is already in order.
+        if (!IsRunning() || std::this_thread::get_id() == m_Thread.get_id()) {
+            return;
+        }
+
+        std::unique_lock lock(m_State->mutex);
+        m_State->idle.wait(lock, [&] { return !m_State->pending; });
+    }
+
+    void RenderThread::Acquire() {
+        if (!IsRunning() || m_CallerContext || std::this_thread::get_id() == m_Thread.get_id()) {
+            return;
+        }
+
+        Wait();
+
+        {
+            std::lock_guard lock(m_State->mutex);
+            m_State->release = true;
+            m_State->pending = true;
+        }
+
+        m_State->wake.notify_one();
+        Wait();
+
+        m_Window->BindContext();
+        m_CallerContext = true;
+    }
+
+    void RenderThread::Loop() {
+        Debug::Profiler::SetThreadName("Render");
+
+        State &state   = *m_State;
+        bool   current = false;
+
+        while (true) {
+            std::function<void()> frame;
+            bool                  release = false;
+
+            {
+                std::unique_lock lock(state.mutex);
+                state.wake.wait(lock, [&] { return state.pending || state.stop; });
+
+                if (!state.pending) {
+                    break;
+                }
+
+                frame   = std::move(state.frame);
+                release = state.release;
+            }
+
+            if (frame) {
+                if (!current) {
+                    m_Window->BindContext();
+                    current = true;
+                }
+
+                frame();
+            }
+
+            if (release && current) {
+                Glfw::Window::UnbindContext();
+                current = false;
+            }
+
+            {
+                std::lock_guard lock(state.mutex);
+                state.frame   = {};
+                state.pending = false;
+                state.release = false;
+            }
+
+            state.idle.notify_all();
+        }
+
+        if (current) {
+            Glfw::Window::UnbindContext();
+        }
+    }
+}
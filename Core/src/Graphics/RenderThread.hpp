@@ -0,0 +1,76 @@
+#ifndef FLK_RENDERTHREAD_HPP
+#define FLK_RENDERTHREAD_HPP
+
+#include <functional>
+#include <memory>
+#include <thread>
+
+#include "Common.hpp"
+
+namespace Flock::Glfw {
+    class Window;
+}
+
+namespace Flock::Graphics {
+    /**
+     * @class RenderThread
+     * @brief Runs frames on a thread of their own, so the caller can simulate the next frame meanwhile.
+     *
+     * At most one frame is in flight. The GL context follows the work: the thread binds it to run a frame and
+     * keeps it until Acquire() hands it back to the caller, Submit() hands it to the thread again.
+     * Without Start() frames run on the calling thread.
+     */
+    class FLK_API RenderThread {
+        struct State;
+
+        std::unique_ptr<State> m_State;
+        std::thread            m_Thread;
+        Glfw::Window *         m_Window        = nullptr;
+        bool                   m_CallerContext = true; // Whether the context is current on the calling thread.
+
+    public:
+        RenderThread();
+        ~RenderThread();
+
+        RenderThread(const RenderThread &other)     = delete;
+        RenderThread(RenderThread &&other) noexcept;
+
+        RenderThread &operator=(const RenderThread &other)     = delete;
+        RenderThread &operator=(RenderThread &&other) noexcept;
+
+        /**
+         * @brief Starts the thread, the window's context is detached from the caller.
+         * @param window The window whose context frames render with; must outlive the thread.
+         * @return true if successful; false if already running.
+         */
+        bool Start(Glfw::Window &window);
+
+        /**
+         * @brief Finishes the frame in flight and stops the thread, the context is current on the caller again.
+         */
+        void Stop();
+
+        [[nodiscard]] bool IsRunning() const;
+
+        /**
+         * @brief Waits for the previous frame, then runs the frame on the thread.
+         * @param frame The frame to run; only touches state the caller leaves alone until the next Wait().
+         */
+        void Submit(std::function<void()> frame);
+
+        /**
+         * @brief The sync point, waits until the frame in flight has finished.
+         */
+        void Wait();
+
+        /**
+         * @brief Waits for the frame in flight and makes the context current on the caller, for GL work between frames.
+         */
+        void Acquire();
+
+    private:
+        void Loop();
+    };
+}
+
+#endif //FLK_RENDERTHREAD_HPP
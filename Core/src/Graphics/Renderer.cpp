@@ -1,19 +1,28 @@
 #include "Renderer.hpp"
 
 #include <algorithm>
+#include <array>
+#include <cmath>
+#include <span>
 #include <string>
+#include <tuple>
 
 #include "Debug/Log.hpp"
+#include "Debug/Profiler.hpp"
 #include "Graphics/Camera.hpp"
 #include "Graphics/Framebuffer.hpp"
+#include "Graphics/Frustum.hpp"
 #include "Graphics/Gl.hpp"
 #include "Graphics/Light.hpp"
 #include "Graphics/Mesh.hpp"
 #include "Graphics/Pipeline.hpp"
-#include "Graphics/Shader.hpp"
+#include "Graphics/RenderStats.hpp"
+#include "Graphics/StateCache.hpp"
 #include "Graphics/Texture.hpp"
+#include "Jobs/JobSystem.hpp"
 #include "Math/Quaternion.hpp"
 #include "Math/RigidTransform.hpp"
+#include "Math/TransformBatch.hpp"
 #include "glad/glad.h"
 
 namespace Flock {
@@ -23,7 +32,10 @@ namespace Flock {
 }     // namespace Flock
 
 namespace Flock::Graphics {
-    static constexpr usize s_MaxLightsPerObject = 16;
+    static constexpr usize s_MaxDirectionalLights = 16;
+    static constexpr usize s_DrawGrain            = 512;  // Commands per draw preparation job.
+    static constexpr usize s_MatrixGrain          = 1024; // Transforms per matrix job.
+    static constexpr usize s_InstanceTexels       = 7;    // RGBA32F texels per batched instance.
 
     static constexpr auto s_ShadowVertShader = R"(
 #version 330 core
@@ -32,12 +44,16 @@ layout(location = 0) in vec3 aPosition;
 layout(location = 1) in vec3 aNormal;
 layout(location = 2) in vec2 aTexCoords;
 
+uniform mat4 uDequantize;
 uniform mat4 uModel;
 uniform mat4 uView;
 uniform mat4 uProj;
 
+// The depth pre-pass relies on matching the depth of the shading pass exactly.
+invariant gl_Position;
+
 void main() {
-    gl_Position = vec4(aPosition, 1.0) * uModel * uView * uProj;
+    gl_Position = vec4(aPosition, 1.0) * uDequantize * uModel * uView * uProj;
 }
 )";
 
@@ -115,88 +131,530 @@ void main() {
         }
     }
 
-    Renderer &Renderer::Render(const RenderList &commands, const SceneData &scene, RenderConfig config, const ShadowConfig &shadowConfig) {
-        const auto     lights       = NearestLights(scene.lights, scene.camera.transform.position, s_MaxLightsPerObject);
-        const Vector3f shadowCenter = scene.camera.transform.position;
-
-        RenderList sortedCmds = commands;
-        std::sort(sortedCmds.begin(), sortedCmds.end(), [&](RenderCommand &lhs, RenderCommand &rhs) {
-            const f32 lhsZ = ((lhs.transform.position - scene.camera.transform.position) * scene.camera.transform.rotation.Inverse()).z;
-            const f32 rhsZ = ((rhs.transform.position - scene.camera.transform.position) * scene.camera.transform.rotation.Inverse()).z;
+    Renderer &Renderer::Render(const RenderList &submitted, const SceneData &scene, RenderConfig config, const ShadowConfig &shadowConfig) {
+        // Model matrices are computed once in a batch, the shadow passes and every bucket reuse them.
+        m_Transforms.clear();
+        for (const auto &cmd: submitted) {
+            m_Transforms.push_back(cmd.transform);
+        }
 
-            return lhsZ > rhsZ;
+        m_Models.resize(m_Transforms.size());
+        Jobs::ParallelFor(m_Transforms.size(), s_MatrixGrain, [&](const usize begin, const usize end) {
+            ComputeMatrices(
+                std::span<const Transform>(m_Transforms).subspan(begin, end - begin),
+                std::span<Matrix4f>(m_Models).subspan(begin, end - begin)
+            );
         });
 
-        ShadowData shadowData;
-        if (shadowConfig.enabled) {
-            shadowData = GenerateShadowMaps(sortedCmds, lights, shadowConfig, shadowCenter);
+        m_Occluders.clear();
+        m_Commands.assign(submitted.begin(), submitted.end());
+        for (usize i = 0; i < m_Commands.size(); i++) {
+            m_Commands[i].model = m_Models[i];
+        }
+
+        return RenderCommands(scene, config, shadowConfig);
+    }
+
+    Renderer &Renderer::Render(const SceneData &scene, const RenderConfig &config, const ShadowConfig &shadowConfig) {
+        // Proxies already hold their model matrices, only the moved ones are recomputed.
+        m_Commands.clear();
+        {
+            FLK_PROFILE_SCOPE("RenderScene::Collect");
+            m_Scene.Collect(scene.camera, m_Commands);
+        }
+
+        m_Occluders.clear();
+        if (m_OcclusionConfig.enabled) {
+            m_Scene.CollectOccluders(m_Occluders);
+        }
+
+        return RenderCommands(scene, config, shadowConfig);
+    }
+
+    RenderScene &Renderer::Scene() {
+        return m_Scene;
+    }
+
+    GpuTimers &Renderer::Timers() {
+        return m_Timers;
+    }
+
+    void Renderer::SetOcclusionConfig(const OcclusionConfig &config) {
+        m_OcclusionConfig = config;
+    }
+
+    const OcclusionConfig &Renderer::GetOcclusionConfig() const {
+        return m_OcclusionConfig;
+    }
+
+    const OcclusionBuffer &Renderer::Occlusion() const {
+        return m_Occlusion;
+    }
+
+    const Texture &Renderer::OcclusionView() const {
+        return m_OcclusionView;
+    }
+
+    Renderer &Renderer::RenderCommands(const SceneData &scene, RenderConfig config, const ShadowConfig &shadowConfig) {
+        FLK_PROFILE_SCOPE("Renderer::Render");
+
+        const RenderList &commands = m_Commands;
+
+        // Directional lights reach everything and go through uniforms, point lights are clustered.
+        std::vector<Light> directionalLights;
+        std::vector<Light> pointLights;
+        for (const auto &light: scene.lights) {
+            (light.radius > 0.0F ? pointLights : directionalLights).push_back(light);
+        }
+
+        const auto lights = NearestLights(directionalLights, scene.camera.transform.position, s_MaxDirectionalLights);
+        if (!m_LightClusters.Build(pointLights, scene.camera, config.viewport)) {
+            Debug::LogErr("Renderer::Render: Failed to upload light clusters!");
         }
 
+        const Vector3f           shadowCenter = scene.camera.transform.position;
+        const std::vector<Light> shadowLights = shadowConfig.enabled ? ShadowLights(lights) : std::vector<Light>{};
+        const usize              shadowLayers = shadowLights.size() * shadowConfig.cascadeRanges.size();
+
+        m_ShadowData.spaceMatrices.resize(shadowLayers);
+        m_ShadowData.shadowMaps = nullptr;
+
         auto      [origin, aspect] = config.viewport;
         const f32 aspectRatio      = static_cast<f32>(aspect.x - origin.x) / static_cast<f32>(aspect.y - origin.y);
 
-        SetFramebuffer(config.framebuffer);
-        ConfigureFramebuffer(config);
+        const bool occlusion = RenderOccluders(scene.camera, aspectRatio);
 
-        if (scene.skybox) {
-            RenderSkybox(
-                *scene.skybox,
-                scene.camera.transform.rotation.Inverse().ToMatrix(),
-                scene.camera.ProjMatrix(aspectRatio)
+        {
+            FLK_PROFILE_SCOPE("Renderer::PrepareDraws");
+            PrepareDraws(commands, scene.camera, aspectRatio, occlusion ? &m_Occlusion : nullptr);
+        }
+
+        // The passes are declared every frame, the graph orders them and takes their targets from m_Targets.
+        m_Graph.Reset();
+        const FrameResource output     = m_Graph.Import("Output");
+        FrameResource       shadowMaps = FLK_INVALID;
+
+        if (shadowLayers > 0) {
+            m_Graph.AddPass(
+                "Shadows",
+                [&](PassBuilder &builder) {
+                    shadowMaps = builder.Write(builder.Create("ShadowMaps", {
+                        .size   = shadowConfig.resolution,
+                        .format = TextureFormat::Depth,
+                        .layers = static_cast<u32>(shadowLayers)
+                    }));
+                },
+                [&](const PassContext &context) {
+                    const TextureArray *maps = context.GetTextureArray(shadowMaps);
+                    if (!maps) {
+                        m_ShadowData.spaceMatrices.clear();
+                        return;
+                    }
+
+                    FLK_PROFILE_SCOPE("Shadows pass");
+                    GpuTimers::Scope timer(m_Timers, GpuPass::Shadows);
+
+                    // Shadows get the submission order, so the static caster hash doesn't change as the camera moves.
+                    GenerateShadowMaps(commands, shadowLights, shadowConfig, shadowCenter, *maps);
+                    m_ShadowData.shadowMaps = maps;
+                }
             );
         }
 
+        m_Graph.AddPass(
+            "Background",
+            [&](PassBuilder &builder) { builder.Write(output); },
+            [&](const PassContext &) {
+                FLK_PROFILE_SCOPE("Background pass");
+                SetFramebuffer(config.framebuffer);
+                ConfigureFramebuffer(config);
+
+                if (scene.skybox) {
+                    GpuTimers::Scope timer(m_Timers, GpuPass::Skybox);
+                    RenderSkybox(
+                        *scene.skybox,
+                        scene.camera.transform.rotation.Inverse().ToMatrix(),
+                        scene.camera.ProjMatrix(aspectRatio)
+                    );
+                }
+            }
+        );
+
+        bool success = true;
+        m_Graph.AddPass(
+            "Scene",
+            [&](PassBuilder &builder) {
+                builder.Read(shadowMaps);
+                builder.Write(output);
+            },
+            [&](const PassContext &) {
+                FLK_PROFILE_SCOPE("Scene pass");
+                GpuTimers::Scope timer(m_Timers, GpuPass::Scene);
+                PackFrameUniforms(scene, lights, shadowConfig, aspectRatio);
+
+                SetFramebuffer(config.framebuffer);
+                success = RenderBuckets(scene, config, aspectRatio);
+            }
+        );
+
+        if (!m_Graph.Compile() || !m_Graph.Execute(m_Targets)) {
+            Debug::LogErr("Renderer::Render: Failed to execute the frame graph!");
+        }
+
+        m_Targets.EndFrame();
+
+        if (!success) {
+            Debug::LogErr("Renderer::Render: Failed to render all buckets!");
+        }
+
+        // Depth writes also gate depth clears and blits.
+        StateCache::DepthMask(true);
+
+        Framebuffer::Unbind();
+        Mesh::Unbind();
+        Pipeline::Unbind();
+
+        return *this;
+    }
+
+    bool Renderer::RenderBuckets(const SceneData &scene, RenderConfig config, const f32 aspectRatio) {
+        const DrawList &opaque      = m_Draws[static_cast<usize>(RenderQueue::Opaque)];
+        const DrawList &alphaTested = m_Draws[static_cast<usize>(RenderQueue::AlphaTested)];
+        const DrawList &transparent = m_Draws[static_cast<usize>(RenderQueue::Transparent)];
+        const DrawList &overlay     = m_Draws[static_cast<usize>(RenderQueue::Overlay)];
+
+        // The skybox doesn't occlude anything, its depth is cleared along with the first bucket.
         config.clear.clearColor = false;
-        ConfigureFramebuffer(config);
 
-        for (auto &cmd: sortedCmds) {
-            auto &[mesh, pipeline, mat, trans] = cmd;
+        RenderConfig opaqueConfig  = config;
+        opaqueConfig.blend.enabled = false;
 
-            if (!mesh || !pipeline) {
-                continue;
-            }
+        ConfigureFramebuffer(opaqueConfig);
+        config.clear.clearDepth       = false;
+        opaqueConfig.clear.clearDepth = false;
 
-            pipeline->ResetUniforms();
+        if (config.depthPrePass && config.depth.enabled && !opaque.empty()) {
+            StateCache::ColorMask(false);
+            RenderDepth(opaque, scene.camera, aspectRatio);
+            StateCache::ColorMask(true);
 
-            SetMatrices(*pipeline, trans, scene.camera, aspectRatio);
+            // Depth is final, only the visible fragment of each pixel passes.
+            opaqueConfig.depth.func  = DepthFunc::Equal;
+            opaqueConfig.depth.write = false;
+        }
 
-            pipeline->SetUniform("uCameraPosition", scene.camera.transform.position);
-            pipeline->SetUniform("uAmbientColor", scene.ambientLight.color);
-            pipeline->SetUniform("uAmbientIntensity", scene.ambientLight.intensity);
+        ConfigureFramebuffer(opaqueConfig);
+        bool success = RenderBucket(opaque, scene);
 
-            SetMaterialUniforms(*pipeline, mat);
-            SetLightUniforms(*pipeline, lights, shadowConfig);
+        RenderConfig alphaTestedConfig  = config;
+        alphaTestedConfig.blend.enabled = false;
+
+        ConfigureFramebuffer(alphaTestedConfig);
+        success = success && RenderBucket(alphaTested, scene);
+
+        RenderConfig transparentConfig = config;
+        transparentConfig.depth.write  = false;
+
+        ConfigureFramebuffer(transparentConfig);
+        success = success && RenderBucket(transparent, scene);
+
+        RenderConfig overlayConfig  = config;
+        overlayConfig.depth.enabled = false;
+
+        ConfigureFramebuffer(overlayConfig);
+        return success && RenderBucket(overlay, scene);
+    }
+
+    bool Renderer::RenderOccluders(const Camera &camera, const f32 aspectRatio) {
+        if (!m_OcclusionConfig.enabled || m_Occluders.empty()) {
+            return false;
+        }
+
+        {
+            FLK_PROFILE_SCOPE("Renderer::RenderOccluders");
+            m_Occlusion.Resize(m_OcclusionConfig.resolution);
+            m_Occlusion.Render(m_Occluders, camera.ViewMatrix() * camera.ProjMatrix(aspectRatio));
+        }
 
-            if (shadowData.shadowMaps.LayerCount() > 0) {
-                if (!pipeline->SetUniform("uShadowMaps", shadowData.shadowMaps)) {
-                    Debug::LogErr("Render: Failed to upload shadow maps!");
-                    return *this;
+        if (m_OcclusionConfig.debugView) {
+            const Image image = m_Occlusion.DebugImage();
+            if (m_OcclusionView.Size() != image.size) {
+                m_OcclusionView = Texture::FromImage(image, {.generateMipmaps = false});
+            } else {
+                m_OcclusionView.SetSubImage(image, {0, 0});
+            }
+        }
+
+        return true;
+    }
+
+    void Renderer::PrepareDraws(
+        const RenderList &     commands,
+        const Camera &         camera,
+        const f32              aspectRatio,
+        const OcclusionBuffer *occlusion
+    ) {
+        const Frustum    frustum         = Frustum::FromMatrix(camera.ViewMatrix() * camera.ProjMatrix(aspectRatio));
+        const Quaternion inverseRotation = camera.transform.rotation.Inverse();
+        const Vector3f   cameraPosition  = camera.transform.position;
+
+        m_ChunkDraws.resize(std::max<usize>((commands.size() + s_DrawGrain - 1) / s_DrawGrain, 1));
+        for (auto &chunk: m_ChunkDraws) {
+            for (auto &draws: chunk) {
+                draws.clear();
+            }
+        }
+
+        // Every chunk fills its own lists, they are merged in chunk order so the result doesn't depend on scheduling.
+        Jobs::ParallelFor(commands.size(), s_DrawGrain, [&](const usize begin, const usize end) {
+            auto &chunk = m_ChunkDraws[begin / s_DrawGrain];
+
+            for (usize i = begin; i < end; i++) {
+                const RenderCommand &cmd = commands[i];
+                if (!cmd.mesh || !cmd.pipeline) {
+                    continue;
                 }
 
-                for (usize i = 0; i < shadowData.spaceMatrices.size(); i++) {
-                    std::string idx = "[" + std::to_string(i) + "]";
-                    pipeline->SetUniform("uLightSpaceMatrices" + idx, shadowData.spaceMatrices[i]);
+                if (cmd.bounds.radius >= 0.0F && !frustum.Intersects(cmd.bounds)) {
+                    continue;
                 }
 
-                pipeline->SetUniform("uShadowCascadeCount", static_cast<i32>(shadowConfig.cascadeRanges.size()));
-                for (usize i = 0; i < shadowConfig.cascadeRanges.size(); i++) {
-                    std::string idx = "[" + std::to_string(i) + "]";
-                    pipeline->SetUniform("uShadowCascadeRanges" + idx, shadowConfig.cascadeRanges[i]);
+                // Overlays are drawn on top of everything, occluders included.
+                if (occlusion && cmd.bounds.radius >= 0.0F && cmd.queue != RenderQueue::Overlay &&
+                    !occlusion->IsVisible(cmd.bounds)) {
+                    continue;
                 }
+
+                const f32 depth = ((cmd.transform.position - cameraPosition) * inverseRotation).z;
+                chunk[static_cast<usize>(cmd.queue)].push_back({.command = &cmd, .depth = depth});
+            }
+        });
+
+        for (usize q = 0; q < m_Draws.size(); q++) {
+            m_Draws[q].clear();
+            for (const auto &chunk: m_ChunkDraws) {
+                m_Draws[q].insert(m_Draws[q].end(), chunk[q].begin(), chunk[q].end());
+            }
+        }
+
+        // Opaques front to back for early depth rejection, transparents back to front for blending, overlays as submitted.
+        Jobs::ParallelFor(3, 1, [&](const usize begin, const usize end) {
+            for (usize q = begin; q < end; q++) {
+                const bool frontToBack = static_cast<RenderQueue>(q) != RenderQueue::Transparent;
+                std::ranges::stable_sort(m_Draws[q], [&](const DrawItem &lhs, const DrawItem &rhs) {
+                    return frontToBack ? lhs.depth < rhs.depth : lhs.depth > rhs.depth;
+                });
+            }
+        });
+    }
+
+    void Renderer::PackFrameUniforms(
+        const SceneData &         scene,
+        const std::vector<Light> &lights,
+        const ShadowConfig &      shadowConfig,
+        const f32                 aspectRatio
+    ) {
+        UniformList &uniforms = m_FrameUniforms;
+        uniforms.clear();
+
+        uniforms.emplace_back("uView", Uniform::From(scene.camera.ViewMatrix()));
+        uniforms.emplace_back("uProj", Uniform::From(scene.camera.ProjMatrix(aspectRatio)));
+        uniforms.emplace_back("uCameraPosition", Uniform::From(scene.camera.transform.position));
+        uniforms.emplace_back("uAmbientColor", Uniform::From(scene.ambientLight.color));
+        uniforms.emplace_back("uAmbientIntensity", Uniform::From(scene.ambientLight.intensity));
+
+        PackLightUniforms(uniforms, lights, shadowConfig);
+
+        const ShadowData &shadowData = m_ShadowData;
+        if (shadowData.spaceMatrices.empty()) {
+            return;
+        }
+
+        for (usize i = 0; i < shadowData.spaceMatrices.size(); i++) {
+            std::string idx = "[" + std::to_string(i) + "]";
+            uniforms.emplace_back("uLightSpaceMatrices" + idx, Uniform::From(shadowData.spaceMatrices[i]));
+        }
+
+        uniforms.emplace_back("uShadowCascadeCount", Uniform::From(static_cast<i32>(shadowConfig.cascadeRanges.size())));
+        for (usize i = 0; i < shadowConfig.cascadeRanges.size(); i++) {
+            std::string idx = "[" + std::to_string(i) + "]";
+            uniforms.emplace_back("uShadowCascadeRanges" + idx, Uniform::From(shadowConfig.cascadeRanges[i]));
+        }
+    }
+
+    bool Renderer::RenderBucket(const DrawList &draws, const SceneData &scene) {
+        m_Batched.clear();
+
+        for (const auto &[cmd, depth]: draws) {
+            if (Batchable(*cmd)) {
+                m_Batched.push_back(cmd);
+                continue;
             }
 
-            if (scene.skybox) {
-                pipeline->SetUniform("uSkybox", *scene.skybox);
+            auto &[mesh, pipeline, mat, trans, isStatic, queue, shadowMesh, model, bounds] = *cmd;
+
+            pipeline->ResetUniforms();
+            if (!BindSceneUniforms(*pipeline, scene)) {
+                return false;
             }
 
+            // Uniform values stay in the program, a batched draw before this one may have set it.
+            pipeline->SetUniform("uInstanced", 0);
+            pipeline->SetUniform("uModel", model);
+
+            SetMaterialUniforms(*pipeline, mat);
+            pipeline->SetUniform("uAlphaCutoff", queue == RenderQueue::AlphaTested ? mat.alphaCutoff : 0.0F);
+
+            SetMeshUniforms(*pipeline, *mesh);
             RenderMesh(*mesh, *pipeline);
         }
 
-        Framebuffer::Unbind();
-        Mesh::Unbind();
-        Pipeline::Unbind();
+        return RenderBatched(scene);
+    }
 
-        return *this;
+    bool Renderer::RenderBatched(const SceneData &scene) {
+        if (m_Batched.empty()) {
+            return true;
+        }
+
+        const auto batchKey = [](const RenderCommand *cmd) {
+            const MaterialProperties &mat = cmd->materialProperties;
+            return std::tuple{
+                cmd->pipeline, cmd->mesh, mat.colorLayer.array, mat.metallicLayer.array, mat.roughnessLayer.array
+            };
+        };
+
+        // Opaque draws don't depend on their order, only on the depth test. Stable, so every batch stays front to back.
+        std::ranges::stable_sort(m_Batched, std::less{}, batchKey);
+
+        m_InstanceData.resize(m_Batched.size() * s_InstanceTexels * 4);
+        for (usize i = 0; i < m_Batched.size(); i++) {
+            const RenderCommand &     cmd    = *m_Batched[i];
+            const MaterialProperties &mat    = cmd.materialProperties;
+            const Vector4f            color  = mat.color.ToVector();
+            f32 *                     texels = &m_InstanceData[i * s_InstanceTexels * 4];
+
+            std::copy_n(cmd.model.Data(), 16, texels);
+
+            texels[16] = color.x;
+            texels[17] = color.y;
+            texels[18] = color.z;
+            texels[19] = color.w;
+
+            texels[20] = mat.metallic;
+            texels[21] = mat.roughness;
+            texels[22] = cmd.queue == RenderQueue::AlphaTested ? mat.alphaCutoff : 0.0F;
+            texels[23] = 0.0F;
+
+            texels[24] = static_cast<f32>(mat.colorLayer.layer);
+            texels[25] = static_cast<f32>(mat.metallicLayer.layer);
+            texels[26] = static_cast<f32>(mat.roughnessLayer.layer);
+            texels[27] = 0.0F;
+        }
+
+        if (m_InstanceBuffer.GlId() == 0) {
+            m_InstanceBuffer = TextureBuffer::Create(TextureBufferFormat::RGBA32F);
+        }
+
+        if (!m_InstanceBuffer.SetData(m_InstanceData.data(), m_InstanceData.size() * sizeof(f32))) {
+            Debug::LogErr("Renderer::RenderBatched: Failed to upload instance data!");
+            return false;
+        }
+
+        for (usize first = 0; first < m_Batched.size();) {
+            usize last = first + 1;
+            while (last < m_Batched.size() && batchKey(m_Batched[last]) == batchKey(m_Batched[first])) {
+                last++;
+            }
+
+            const RenderCommand &     cmd      = *m_Batched[first];
+            const MaterialProperties &mat      = cmd.materialProperties;
+            Pipeline &                pipeline = *cmd.pipeline;
+
+            pipeline.ResetUniforms();
+            if (!BindSceneUniforms(pipeline, scene)) {
+                return false;
+            }
+
+            pipeline.SetUniform("uInstanced", 1);
+            pipeline.SetUniform("uInstanceBase", static_cast<i32>(first));
+            pipeline.SetUniform("uInstanceData", m_InstanceBuffer);
+
+            if (mat.colorLayer.array) {
+                pipeline.SetUniform("uColorMaps", *mat.colorLayer.array);
+            }
+            if (mat.metallicLayer.array) {
+                pipeline.SetUniform("uMetallicMaps", *mat.metallicLayer.array);
+            }
+            if (mat.roughnessLayer.array) {
+                pipeline.SetUniform("uRoughnessMaps", *mat.roughnessLayer.array);
+            }
+
+            SetMeshUniforms(pipeline, *cmd.mesh);
+            RenderMesh(*cmd.mesh, pipeline, false, static_cast<u32>(last - first));
+
+            first = last;
+        }
+
+        return true;
+    }
+
+    bool Renderer::BindSceneUniforms(Pipeline &pipeline, const SceneData &scene) const {
+        pipeline.SetUniforms(m_FrameUniforms);
+        m_LightClusters.Bind(pipeline);
+
+        if (m_ShadowData.shadowMaps && !pipeline.SetUniform("uShadowMaps", *m_ShadowData.shadowMaps)) {
+            Debug::LogErr("Render: Failed to upload shadow maps!");
+            return false;
+        }
+
+        if (scene.skybox) {
+            pipeline.SetUniform("uSkybox", *scene.skybox);
+        }
+
+        return true;
+    }
+
+    bool Renderer::Batchable(const RenderCommand &command) {
+        // Sorted buckets would lose their order, so only the depth tested ones are batched.
+        return command.materialProperties.batched &&
+               (command.queue == RenderQueue::Opaque || command.queue == RenderQueue::AlphaTested) &&
+               command.pipeline->HasSampler("uInstanceData");
+    }
+
+    void Renderer::RenderDepth(const DrawList &draws, const Camera &camera, const f32 aspectRatio) {
+        Pipeline &pipeline = DepthPipeline();
+
+        const Matrix4f view = camera.ViewMatrix();
+        const Matrix4f proj = camera.ProjMatrix(aspectRatio);
+
+        for (const auto &[cmd, depth]: draws) {
+            pipeline.SetUniform("uModel", cmd->model);
+            pipeline.SetUniform("uView", view);
+            pipeline.SetUniform("uProj", proj);
+
+            SetMeshUniforms(pipeline, *cmd->mesh);
+            RenderMesh(*cmd->mesh, pipeline, true);
+        }
+    }
+
+    Pipeline &Renderer::DepthPipeline() {
+        static Pipeline pipeline = Pipeline::FromSource(s_ShadowVertShader, s_ShadowFragShader).value();
+
+        return pipeline;
+    }
+
+    Pipeline &Renderer::SkyboxPipeline() {
+        static Pipeline pipeline = Pipeline::FromSource(s_SkyboxVertShader, s_SkyboxFragShader).value();
+
+        return pipeline;
+    }
+
+    void Renderer::WarmUp() {
+        DepthPipeline();
+        SkyboxPipeline();
+        Mesh::Builtin(Primitive::Box);
+        Mesh::Builtin(Primitive::Square);
     }
 
     bool Renderer::SetFramebuffer(const Framebuffer *framebuffer) {
@@ -215,28 +673,22 @@ void main() {
     void Renderer::ConfigureFramebuffer(RenderConfig config) {
         auto [origin, aspect] = config.viewport;
 
-        FLK_GL_CALL(glFrontFace(GL_CCW));
-        FLK_GL_CALL(glViewport(origin.x, origin.y, aspect.x, aspect.y));
+        StateCache::FrontFace(GL_CCW);
+        StateCache::Viewport(origin.x, origin.y, aspect.x, aspect.y);
 
+        StateCache::SetEnabled(GL_BLEND, config.blend.enabled);
         if (config.blend.enabled) {
-            FLK_GL_CALL(glEnable(GL_BLEND));
-            FLK_GL_CALL(glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA));
-        } else {
-            FLK_GL_CALL(glDisable(GL_BLEND));
+            StateCache::BlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
         }
 
+        StateCache::SetEnabled(GL_CULL_FACE, config.raster.cullMode != CullMode::None);
         if (config.raster.cullMode != CullMode::None) {
-            FLK_GL_CALL(glEnable(GL_CULL_FACE));
-            FLK_GL_CALL(glCullFace(ToGlType(config.raster.cullMode)));
-        } else {
-            FLK_GL_CALL(glDisable(GL_CULL_FACE));
+            StateCache::CullFace(ToGlType(config.raster.cullMode));
         }
 
+        StateCache::SetEnabled(GL_DEPTH_TEST, config.depth.enabled);
         if (config.depth.enabled) {
-            FLK_GL_CALL(glEnable(GL_DEPTH_TEST));
-            FLK_GL_CALL(glDepthFunc(ToGlType(config.depth.func)));
-        } else {
-            FLK_GL_CALL(glDisable(GL_DEPTH_TEST));
+            StateCache::DepthFunc(ToGlType(config.depth.func));
         }
 
         if (config.clear.clearColor) {
@@ -246,27 +698,14 @@ void main() {
         }
 
         if (config.clear.clearDepth) {
+            StateCache::DepthMask(true);
             FLK_GL_CALL(glClearDepth(config.clear.depth));
             FLK_GL_CALL(glClear(GL_DEPTH_BUFFER_BIT));
-        } else {
-            FLK_GL_CALL(glDisable(GL_DEPTH_TEST));
         }
 
-        if (config.raster.fill) {
-            FLK_GL_CALL(glPolygonMode(GL_FRONT_AND_BACK, GL_FILL));
-        } else {
-            FLK_GL_CALL(glPolygonMode(GL_FRONT_AND_BACK, GL_LINE));
-        }
-    }
-
-    void Renderer::SetMatrices(Pipeline &pipeline, const Transform &transform, const Camera &camera, const f32 aspectRatio) {
-        const Matrix4f model = transform.Matrix();
-        const Matrix4f view  = camera.ViewMatrix();
-        const Matrix4f proj  = camera.ProjMatrix(aspectRatio);
+        StateCache::DepthMask(config.depth.write);
 
-        pipeline.SetUniform("uModel", model);
-        pipeline.SetUniform("uView", view);
-        pipeline.SetUniform("uProj", proj);
+        StateCache::PolygonMode(config.raster.fill ? GL_FILL : GL_LINE);
     }
 
     void Renderer::SetMaterialUniforms(Pipeline &pipeline, const MaterialProperties &material) {
@@ -285,23 +724,28 @@ void main() {
         }
     }
 
-    void Renderer::SetLightUniforms(Pipeline &pipeline, std::vector<Light> lights, ShadowConfig shadowConfig) {
-        pipeline.SetUniform("uNumLights", static_cast<i32>(lights.size()));
+    void Renderer::SetMeshUniforms(Pipeline &pipeline, const Mesh &mesh) {
+        pipeline.SetUniform("uPackedVertices", static_cast<i32>(mesh.Format() != VertexFormat::Standard));
+        pipeline.SetUniform("uDequantize", mesh.Dequantize());
+    }
+
+    void Renderer::PackLightUniforms(UniformList &uniforms, const std::vector<Light> &lights, const ShadowConfig &shadowConfig) {
+        uniforms.emplace_back("uNumLights", Uniform::From(static_cast<i32>(lights.size())));
         i32 shadowIdx = 0;
         for (usize i = 0; i < lights.size(); i++) {
             const auto &[lightPosition, color, intensity, radius, hasShadows] = lights[i];
 
             std::string idx = "[" + std::to_string(i) + "]";
-            pipeline.SetUniform("uLightPositions" + idx, lightPosition);
-            pipeline.SetUniform("uLightColors" + idx, color);
-            pipeline.SetUniform("uLightIntensities" + idx, intensity);
-            pipeline.SetUniform("uLightRadii" + idx, radius);
+            uniforms.emplace_back("uLightPositions" + idx, Uniform::From(lightPosition));
+            uniforms.emplace_back("uLightColors" + idx, Uniform::From(color));
+            uniforms.emplace_back("uLightIntensities" + idx, Uniform::From(intensity));
+            uniforms.emplace_back("uLightRadii" + idx, Uniform::From(radius));
 
             if (hasShadows && shadowConfig.enabled) {
-                pipeline.SetUniform("uLightShadowMapIndices" + idx, shadowIdx);
+                uniforms.emplace_back("uLightShadowMapIndices" + idx, Uniform::From(shadowIdx));
                 shadowIdx++;
             } else {
-                pipeline.SetUniform("uLightShadowMapIndices" + idx, -1);
+                uniforms.emplace_back("uLightShadowMapIndices" + idx, Uniform::From(-1));
             }
         }
     }
@@ -318,12 +762,7 @@ void main() {
         return lights;
     }
 
-    ShadowData Renderer::GenerateShadowMaps(
-        const RenderList &        commands,
-        const std::vector<Light> &lights,
-        const ShadowConfig        shadowConfig,
-        const Vector3f            shadowCenter
-    ) {
+    std::vector<Light> Renderer::ShadowLights(const std::vector<Light> &lights) {
         std::vector<Light> shadowLights;
         for (const auto &light: lights) {
             if (light.hasShadows && light.radius == 0.0F) {
@@ -331,40 +770,131 @@ void main() {
             }
         }
 
-        ShadowData data;
+        return shadowLights;
+    }
 
-        data.shadowMaps = TextureArray::Create(
-            shadowLights.size() * shadowConfig.cascadeRanges.size(),
-            shadowConfig.resolution,
-            {.format = TextureFormat::Depth}
-        );
+    void Renderer::GenerateShadowMaps(
+        const RenderList &        commands,
+        const std::vector<Light> &shadowLights,
+        const ShadowConfig &      shadowConfig,
+        const Vector3f            shadowCenter,
+        const TextureArray &      shadowMaps
+    ) {
+        const usize cascadeCount = shadowConfig.cascadeRanges.size();
+        const bool  cacheStatic  = shadowConfig.cacheStaticCasters && shadowConfig.dynamicCascades < cascadeCount;
+        const u64   staticHash   = cacheStatic ? HashStaticCasters(commands) : 0;
 
-        data.spaceMatrices.resize(shadowLights.size() * shadowConfig.cascadeRanges.size());
+        // Only the cascades past dynamicCascades have a cached layer.
+        const usize cachedCascades = cacheStatic ? cascadeCount - shadowConfig.dynamicCascades : 0;
+        ReserveShadowMaps(shadowLights.size() * cachedCascades, shadowConfig);
 
         const f32 aspectRatio = static_cast<f32>(shadowConfig.resolution.x) / static_cast<f32>(shadowConfig.resolution.y);
         for (usize i = 0; i < shadowLights.size(); i++) {
-            for (usize r = 0; r < shadowConfig.cascadeRanges.size(); r++) {
+            for (usize r = 0; r < cascadeCount; r++) {
                 const f32 range = shadowConfig.cascadeRanges[r];
-                const i32 idx   = i * shadowConfig.cascadeRanges.size() + r;
+                const u32 idx   = i * cascadeCount + r;
+
+                if (!cacheStatic || r < shadowConfig.dynamicCascades) {
+                    GenerateShadowMap(
+                        commands,
+                        *m_ShadowFramebuffer,
+                        shadowMaps,
+                        idx,
+                        shadowLights[i],
+                        shadowCenter,
+                        range
+                    );
+
+                    m_ShadowData.spaceMatrices[idx] = shadowLights[i].LightSpaceMatrix(range, aspectRatio, shadowCenter);
+                    continue;
+                }
 
-                GenerateShadowMap(commands, data.shadowMaps, idx, shadowLights[i], shadowCenter, range);
-                data.spaceMatrices[idx] = shadowLights[i].LightSpaceMatrix(range, aspectRatio, shadowCenter);
+                const Vector3f direction = -shadowLights[i].position.Normalized();
+                const Vector3f center    = SnapShadowCenter(
+                    shadowLights[i],
+                    shadowCenter,
+                    range,
+                    shadowConfig.resolution,
+                    shadowConfig.cacheSnapTexels
+                );
+
+                const u32    cached = i * cachedCascades + (r - shadowConfig.dynamicCascades);
+                ShadowCache &cache  = m_ShadowCache[cached];
+                if (!cache.valid || cache.casterHash != staticHash || cache.direction != direction || cache.center != center) {
+                    GenerateShadowMap(
+                        commands,
+                        *m_StaticShadowFramebuffer,
+                        m_StaticShadowMaps,
+                        cached,
+                        shadowLights[i],
+                        center,
+                        range,
+                        ShadowCasters::Static
+                    );
+
+                    cache = {.direction = direction, .center = center, .casterHash = staticHash, .valid = true};
+                }
+
+                if (!m_StaticShadowFramebuffer->Attach(Attachment::Depth, m_StaticShadowMaps, cached) ||
+                    !m_ShadowFramebuffer->Attach(Attachment::Depth, shadowMaps, idx) ||
+                    !m_StaticShadowFramebuffer->Blit(*m_ShadowFramebuffer, shadowConfig.resolution, Attachment::Depth)) {
+                    Debug::LogErr("Renderer::GenerateShadowMaps: Failed to copy cached shadow map!");
+                    cache.valid = false;
+                    continue;
+                }
+
+                GenerateShadowMap(
+                    commands,
+                    *m_ShadowFramebuffer,
+                    shadowMaps,
+                    idx,
+                    shadowLights[i],
+                    center,
+                    range,
+                    ShadowCasters::Dynamic,
+                    false
+                );
+
+                m_ShadowData.spaceMatrices[idx] = shadowLights[i].LightSpaceMatrix(range, aspectRatio, center);
             }
         }
+    }
 
-        return data;
+    void Renderer::ReserveShadowMaps(const usize cachedLayers, const ShadowConfig &shadowConfig) {
+        if (!m_ShadowFramebuffer) {
+            m_ShadowFramebuffer       = Framebuffer::Create();
+            m_StaticShadowFramebuffer = Framebuffer::Create();
+        }
+
+        // The maps drawn every frame come from the frame graph, only the static caster cache is kept here.
+        if (m_ShadowCache.size() != cachedLayers) {
+            m_ShadowCache.assign(cachedLayers, {});
+        }
+
+        if (cachedLayers == 0) {
+            m_StaticShadowMaps = {};
+        } else if (m_StaticShadowMaps.LayerCount() < cachedLayers || m_StaticShadowMaps.Size() != shadowConfig.resolution) {
+            m_StaticShadowMaps = TextureArray::Create(cachedLayers, shadowConfig.resolution, {.format = TextureFormat::Depth});
+            m_ShadowCache.assign(cachedLayers, {});
+        }
+
+        if (m_CascadeRanges != shadowConfig.cascadeRanges) {
+            m_CascadeRanges = shadowConfig.cascadeRanges;
+            m_ShadowCache.assign(m_ShadowCache.size(), {});
+        }
     }
 
     bool Renderer::GenerateShadowMap(
         const RenderList &  commands,
+        Framebuffer &       framebuffer,
         const TextureArray &textureArray,
         const u32           index,
         const Light &       light,
         const Vector3f      shadowCenter,
-        const f32           range
+        const f32           range,
+        const ShadowCasters casters,
+        const bool          clear
     ) {
-        static Framebuffer framebuffer = Framebuffer::Create().value();
-
         if (!framebuffer.Attach(Attachment::Depth, textureArray, index)) {
             Debug::LogErr("Renderer::GenerateShadowMap: Failed to attach depth texture!");
             return false;
@@ -378,7 +908,8 @@ void main() {
         const RenderConfig config = {
             .viewport = {{0, 0}, {textureArray.Size().x, textureArray.Size().y}},
             .clear    = {
-                .clearColor = false
+                .clearColor = false,
+                .clearDepth = clear
             }
         };
 
@@ -387,22 +918,24 @@ void main() {
         const f32      aspectRatio = static_cast<f32>(textureArray.Size().x) / static_cast<f32>(textureArray.Size().y);
         const Matrix4f spaceMat    = light.LightSpaceMatrix(range, aspectRatio, shadowCenter);
 
-        static const Shader vert     = Shader::Create(VertexShader, s_ShadowVertShader).value();
-        static const Shader frag     = Shader::Create(FragmentShader, s_ShadowFragShader).value();
-        static Pipeline     pipeline = Pipeline::Create(vert, frag).value();
+        Pipeline &pipeline = DepthPipeline();
 
         for (auto &cmd: commands) {
-            if (!cmd.mesh) {
+            if (!cmd.mesh || cmd.queue == RenderQueue::Overlay) {
                 continue;
             }
 
-            const Matrix4f model = cmd.transform.Matrix();
+            if ((casters == ShadowCasters::Static && !cmd.isStatic) || (casters == ShadowCasters::Dynamic && cmd.isStatic)) {
+                continue;
+            }
 
-            pipeline.SetUniform("uModel", model);
+            pipeline.SetUniform("uModel", cmd.model);
             pipeline.SetUniform("uView", Matrix4f{});
             pipeline.SetUniform("uProj", spaceMat);
 
-            RenderMesh(*cmd.mesh, pipeline);
+            const Mesh &mesh = cmd.shadowMesh ? *cmd.shadowMesh : *cmd.mesh;
+            SetMeshUniforms(pipeline, mesh);
+            RenderMesh(mesh, pipeline, true);
         }
 
         Mesh::Unbind();
@@ -412,32 +945,101 @@ void main() {
         return true;
     }
 
-    bool Renderer::RenderMesh(const Mesh &mesh, const Pipeline &pipeline) {
+    Vector3f Renderer::SnapShadowCenter(
+        const Light &  light,
+        const Vector3f center,
+        const f32      range,
+        const Vector2u resolution,
+        const u32      texels
+    ) {
+        if (texels == 0) {
+            return center;
+        }
+
+        // Same basis as the light's LookAt, so the snapped offset is a whole number of texels on screen.
+        const Vector3f lightDir = -light.position.Normalized();
+        const Vector3f up       = std::abs(lightDir.Dot(Vector3f::Up())) < 0.99F ? Vector3f::Up() : Vector3f::Forward();
+        const Vector3f x        = up.Cross(lightDir).Normalized();
+        const Vector3f y        = lightDir.Cross(x);
+
+        const f32 aspectRatio = static_cast<f32>(resolution.x) / static_cast<f32>(resolution.y);
+        const f32 stepX       = 2.0F * aspectRatio * range / static_cast<f32>(resolution.x) * static_cast<f32>(texels);
+        const f32 stepY       = 2.0F * range / static_cast<f32>(resolution.y) * static_cast<f32>(texels);
+
+        const f32 cx = x.Dot(center);
+        const f32 cy = y.Dot(center);
+
+        return center - x * (cx - std::round(cx / stepX) * stepX) - y * (cy - std::round(cy / stepY) * stepY);
+    }
+
+    u64 Renderer::HashStaticCasters(const RenderList &commands) {
+        u64 hash = 14695981039346656037ULL;
+
+        const auto mix = [&](const void *data, const usize size) {
+            const auto *bytes = static_cast<const u8 *>(data);
+            for (usize i = 0; i < size; i++) {
+                hash ^= bytes[i];
+                hash *= 1099511628211ULL;
+            }
+        };
+
+        for (const auto &cmd: commands) {
+            if (!cmd.isStatic || !cmd.mesh) {
+                continue;
+            }
+
+            // The shadow mesh of a static command is fixed, unlike mesh which follows the camera's LOD selection.
+            const Mesh *mesh = cmd.shadowMesh ? cmd.shadowMesh : cmd.mesh;
+            mix(&mesh, sizeof(mesh));
+            mix(&cmd.transform, sizeof(cmd.transform));
+        }
+
+        return hash;
+    }
+
+    bool Renderer::RenderMesh(const Mesh &mesh, const Pipeline &pipeline, const bool depthOnly, const u32 instances) {
         if (!pipeline.Bind()) {
             Debug::LogErr("Render command failed: Unable to bind pipeline!");
             return false;
         }
 
-        if (!mesh.Bind()) {
+        if (!(depthOnly ? mesh.BindDepth() : mesh.Bind())) {
             Debug::LogErr("Render command failed: Unable to bind mesh!");
             return false;
         }
 
-        FLK_GL_CALL(glDrawElements(GL_TRIANGLES, mesh.IndexCount(), GL_UNSIGNED_INT, nullptr));
+        FrameCounters::Draw(mesh.IndexCount(), instances);
+
+        if (instances != 1) {
+            FLK_GL_CALL(glDrawElementsInstancedBaseVertex(
+                GL_TRIANGLES,
+                mesh.IndexCount(),
+                ToGlType(mesh.GetIndexType()),
+                reinterpret_cast<const void *>(mesh.IndexOffset()),
+                static_cast<i32>(instances),
+                mesh.BaseVertex()
+            ));
+            return true;
+        }
+
+        FLK_GL_CALL(glDrawElementsBaseVertex(
+            GL_TRIANGLES,
+            mesh.IndexCount(),
+            ToGlType(mesh.GetIndexType()),
+            reinterpret_cast<const void *>(mesh.IndexOffset()),
+            mesh.BaseVertex()
+        ));
         return true;
     }
 
     bool Renderer::RenderSkybox(const CubeMap &cubeMap, const Matrix4f &view, const Matrix4f &proj) {
-        const Mesh cube = Mesh::Box(Vector3f::One());
-
-        static const Shader vert     = Shader::Create(VertexShader, s_SkyboxVertShader).value();
-        static const Shader frag     = Shader::Create(FragmentShader, s_SkyboxFragShader).value();
-        static Pipeline     pipeline = Pipeline::Create(vert, frag).value();
+        Pipeline &pipeline = SkyboxPipeline();
 
         pipeline.SetUniform("uSkybox", cubeMap);
         pipeline.SetUniform("uView", view);
         pipeline.SetUniform("uProj", proj);
 
-        return RenderMesh(cube, pipeline);
+        // Only the direction to each vertex reaches the cube map, the box size doesn't matter.
+        return RenderMesh(Mesh::Builtin(Primitive::Box), pipeline);
     }
 }
@@ -1,6 +1,7 @@
 #ifndef FLK_RENDERER_HPP
 #define FLK_RENDERER_HPP
 
+#include <array>
 #include <functional>
 #include <optional>
 #include <vector>
@@ -11,7 +12,16 @@
 #include "Math/Rect.hpp"
 #include "Math/Transform.hpp"
 #include "Camera.hpp"
+#include "FrameGraph.hpp"
 #include "Light.hpp"
+#include "LightClusters.hpp"
+#include "Material.hpp"
+#include "OcclusionBuffer.hpp"
+#include "Pipeline.hpp"
+#include "RenderScene.hpp"
+#include "RenderStats.hpp"
+#include "Texture.hpp"
+#include "TextureBuffer.hpp"
 #include "Common.hpp"
 #include "Graphics/TextureArray.hpp"
 #include "Math/Color.hpp"
@@ -61,6 +71,7 @@ namespace Flock::Graphics {
 
     struct DepthState {
         bool      enabled = true;
+        bool      write   = true;
         DepthFunc func    = DepthFunc::LEqual;
     };
 
@@ -84,10 +95,14 @@ namespace Flock::Graphics {
         bool             enabled       = true;
         Vector2u         resolution    = {2048, 2048};
         std::vector<f32> cascadeRanges = {20.0F, 100.0F, 500.0F};
+
+        bool cacheStaticCasters = true; // Cascades past dynamicCascades keep static casters in a cached layer.
+        u32  dynamicCascades    = 1;    // Number of near cascades that are fully redrawn every frame.
+        u32  cacheSnapTexels    = 16;   // Cached cascades only move when the camera crosses this many texels.
     };
 
     struct ShadowData {
-        TextureArray          shadowMaps;
+        const TextureArray *  shadowMaps = nullptr; // Valid while the frame renders.
         std::vector<Matrix4f> spaceMatrices;
     };
 
@@ -98,57 +113,187 @@ namespace Flock::Graphics {
         BlendState   blend       = {};
         RasterState  raster      = {};
         Framebuffer *framebuffer = nullptr;
-    };
 
-    struct MaterialProperties {
-        Color4u8 color        = Color4u8::White();
-        f32      metallic     = 0.25F;
-        f32      roughness    = 0.75F;
-        Texture *colorMap     = nullptr;
-        Texture *metallicMap  = nullptr;
-        Texture *roughnessMap = nullptr;
+        bool depthPrePass = false; // Lays down opaque depth first so opaques are only shaded once per pixel.
     };
 
-    struct RenderCommand {
-        Mesh *             mesh;
-        Pipeline *         pipeline;
-        MaterialProperties materialProperties = {};
-        Transform          transform          = {};
+    enum class ShadowCasters {
+        All,
+        Static,
+        Dynamic
     };
 
-    using RenderList = std::vector<RenderCommand>;
-
     class FLK_API Renderer {
+        struct DrawItem {
+            const RenderCommand *command = nullptr;
+            f32                  depth   = 0.0F; // View space depth, the sort key.
+        };
+
+        using DrawList = std::vector<DrawItem>;
+
+        struct ShadowCache {
+            Vector3f direction  = {};
+            Vector3f center     = {};
+            u64      casterHash = 0;
+            bool     valid      = false;
+        };
+
+        ShadowData                 m_ShadowData;
+        TextureArray               m_StaticShadowMaps;
+        std::vector<ShadowCache>   m_ShadowCache;
+        std::vector<f32>           m_CascadeRanges;
+        std::optional<Framebuffer> m_ShadowFramebuffer;
+        std::optional<Framebuffer> m_StaticShadowFramebuffer;
+        LightClusters              m_LightClusters;
+        RenderScene                m_Scene;
+        RenderList                 m_Commands;
+        std::vector<Transform>     m_Transforms;
+        std::vector<Matrix4f>      m_Models;
+
+        std::array<DrawList, 4>              m_Draws;      // Visible commands per RenderQueue, sorted.
+        std::vector<std::array<DrawList, 4>> m_ChunkDraws; // Per job lists, merged into m_Draws.
+        UniformList                          m_FrameUniforms;
+
+        FrameGraph       m_Graph;
+        RenderTargetPool m_Targets; // Transient targets of m_Graph, kept across frames.
+
+        std::vector<const RenderCommand *> m_Batched;      // Draws of the current bucket that are instanced.
+        std::vector<f32>                   m_InstanceData; // Texels of m_InstanceBuffer, see RenderBatched().
+        TextureBuffer                      m_InstanceBuffer;
+
+        GpuTimers m_Timers;
+
+        OcclusionBuffer           m_Occlusion;
+        OcclusionConfig           m_OcclusionConfig;
+        std::vector<OccluderMesh> m_Occluders;
+        Texture                   m_OcclusionView; // The debug view of m_Occlusion.
+
     public:
         Renderer &Render(const RenderList &  commands, const SceneData &scene, RenderConfig config = {},
                          const ShadowConfig &shadowConfig                                          = {});
 
+        /**
+         * @brief Renders the retained scene, see Scene().
+         */
+        Renderer &Render(const SceneData &scene, const RenderConfig &config = {}, const ShadowConfig &shadowConfig = {});
+
+        /**
+         * @return The retained scene, kept across frames and rendered by Render(const SceneData &, ...).
+         */
+        [[nodiscard]] RenderScene &Scene();
+
+        /**
+         * @return The GPU timers of the shadow, skybox and scene passes, callers can time their own passes too.
+         */
+        [[nodiscard]] GpuTimers &Timers();
+
+        /**
+         * @brief Configures occlusion culling of the retained scene, commands rendered from a list are never occluded.
+         */
+        void                                 SetOcclusionConfig(const OcclusionConfig &config);
+        [[nodiscard]] const OcclusionConfig &GetOcclusionConfig() const;
+
+        [[nodiscard]] const OcclusionBuffer &Occlusion() const;
+
+        /**
+         * @return The depth buffer of the occluders, updated while OcclusionConfig::debugView is set.
+         */
+        [[nodiscard]] const Texture &OcclusionView() const;
+
+        /**
+         * @brief Builds the built-in pipelines and meshes, which are otherwise created on first use.
+         *
+         * Needs a current context. Their programs go through the ProgramCache like any other pipeline.
+         */
+        static void WarmUp();
+
     private:
+        Renderer &RenderCommands(const SceneData &scene, RenderConfig config, const ShadowConfig &shadowConfig);
+
+        /**
+         * @brief Rasterizes m_Occluders into m_Occlusion, refreshing the debug view if it's enabled.
+         * @return true if the occlusion buffer is ready for culling; false otherwise.
+         */
+        bool RenderOccluders(const Camera &camera, f32 aspectRatio);
+
+        /**
+         * @brief Culls, buckets and sorts the commands on the job system, filling m_Draws.
+         * @param occlusion Also culls what the occluders hide if not null.
+         */
+        void PrepareDraws(const RenderList &commands, const Camera &camera, f32 aspectRatio,
+                          const OcclusionBuffer *occlusion = nullptr);
+
+        /**
+         * @brief Renders every RenderQueue of m_Draws in order, on top of the skybox.
+         */
+        bool RenderBuckets(const SceneData &scene, RenderConfig config, f32 aspectRatio);
+
+        /**
+         * @brief Packs the uniforms shared by every draw of the frame, filling m_FrameUniforms.
+         */
+        void PackFrameUniforms(
+            const SceneData &         scene,
+            const std::vector<Light> &lights,
+            const ShadowConfig &      shadowConfig,
+            f32                       aspectRatio
+        );
+
+        bool RenderBucket(const DrawList &draws, const SceneData &scene);
+
+        /**
+         * @brief Draws the batched commands of a bucket, one instanced draw per pipeline, mesh and texture arrays.
+         *
+         * Pipelines opt in with a uInstanceData samplerBuffer, seven texels per instance: the model matrix rows,
+         * the color, (metallic, roughness, alpha cutoff, 0) and the (color, metallic, roughness, 0) map layers,
+         * -1 where the material has no map. Instance i of a draw is at uInstanceBase + gl_InstanceID, uInstanced
+         * is 1 for these draws and 0 otherwise. The maps are bound as uColorMaps, uMetallicMaps and uRoughnessMaps.
+         */
+        bool RenderBatched(const SceneData &scene);
+
+        bool BindSceneUniforms(Pipeline &pipeline, const SceneData &scene) const;
+
+        static bool Batchable(const RenderCommand &command);
+
+        static void RenderDepth(const DrawList &draws, const Camera &camera, f32 aspectRatio);
+        static Pipeline &DepthPipeline();
+        static Pipeline &SkyboxPipeline();
+
         static bool SetFramebuffer(const Framebuffer *framebuffer = nullptr);
         static void ConfigureFramebuffer(RenderConfig config);
-        static void SetMatrices(Pipeline &pipeline, const Transform &transform, const Camera &camera, f32 aspectRatio);
         static void SetMaterialUniforms(Pipeline &pipeline, const MaterialProperties &material);
-        static void SetLightUniforms(Pipeline &pipeline, std::vector<Light> lights, ShadowConfig shadowConfig);
+        static void SetMeshUniforms(Pipeline &pipeline, const Mesh &mesh);
+        static void PackLightUniforms(UniformList &uniforms, const std::vector<Light> &lights, const ShadowConfig &shadowConfig);
 
         static std::vector<Light> NearestLights(std::vector<Light> lights, Vector3f center, usize count);
 
-        static ShadowData GenerateShadowMaps(
+        static std::vector<Light> ShadowLights(const std::vector<Light> &lights);
+
+        void GenerateShadowMaps(
             const RenderList &        commands,
-            const std::vector<Light> &lights,
-            ShadowConfig              shadowConfig,
-            Vector3f                  shadowCenter
+            const std::vector<Light> &shadowLights,
+            const ShadowConfig &      shadowConfig,
+            Vector3f                  shadowCenter,
+            const TextureArray &      shadowMaps
         );
 
+        void ReserveShadowMaps(usize cachedLayers, const ShadowConfig &shadowConfig);
+
         static bool GenerateShadowMap(
             const RenderList &  commands,
+            Framebuffer &       framebuffer,
             const TextureArray &textureArray,
             u32                 index,
             const Light &       light,
             Vector3f            shadowCenter,
-            f32                 range
+            f32                 range,
+            ShadowCasters       casters = ShadowCasters::All,
+            bool                clear   = true
         );
 
-        static bool RenderMesh(const Mesh &mesh, const Pipeline &pipeline);
+        static Vector3f SnapShadowCenter(const Light &light, Vector3f center, f32 range, Vector2u resolution, u32 texels);
+        static u64      HashStaticCasters(const RenderList &commands);
+
+        static bool RenderMesh(const Mesh &mesh, const Pipeline &pipeline, bool depthOnly = false, u32 instances = 1);
         static bool RenderSkybox(const CubeMap &cubeMap, const Matrix4f &view, const Matrix4f &proj);
     };
 }
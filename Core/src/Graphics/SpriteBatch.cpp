@@ -0,0 +1,265 @@
+#include "SpriteBatch.hpp"
+
+#include <algorithm>
+#include <functional>
+#include <string>
+
+#include "Debug/Log.hpp"
+#include "Graphics/Gl.hpp"
+#include "Graphics/RenderStats.hpp"
+#include "Graphics/StateCache.hpp"
+#include "Graphics/Texture.hpp"
+#include "Jobs/JobSystem.hpp"
+#include "Math/Quaternion.hpp"
+#include "glad/glad.h"
+
+namespace Flock::Graphics {
+    namespace {
+        constexpr usize s_VertexGrain        = 2048;        // Sprites per vertex job.
+        constexpr usize s_InitialSegmentSize = 1024 * 1024; // Bytes of vertices per frame, grown as needed.
+    }
+
+    static constexpr auto s_SpriteVertShader = R"(
+#version 330 core
+
+layout(location = 0) in vec3 aPosition;
+layout(location = 1) in vec2 aTexCoords;
+layout(location = 2) in vec4 aColor;
+layout(location = 3) in float aSlot;
+
+out vec2 vTexCoords;
+out vec4 vColor;
+flat out int vSlot;
+
+uniform mat4 uViewProj;
+
+void main() {
+    vTexCoords = aTexCoords;
+    vColor = aColor;
+    vSlot = int(aSlot + 0.5);
+
+    gl_Position = vec4(aPosition, 1.0) * uViewProj;
+}
+)";
+
+    static constexpr auto s_SpriteFragShader = R"(
+#version 330 core
+
+in vec2 vTexCoords;
+in vec4 vColor;
+flat in int vSlot;
+
+out vec4 FragColor;
+
+uniform sampler2D uTextures[8];
+
+// Sampler arrays can only be indexed with constants before GLSL 4.00.
+vec4 sampleSlot(int slot, vec2 uv) {
+    switch (slot) {
+        case 0: return texture(uTextures[0], uv);
+        case 1: return texture(uTextures[1], uv);
+        case 2: return texture(uTextures[2], uv);
+        case 3: return texture(uTextures[3], uv);
+        case 4: return texture(uTextures[4], uv);
+        case 5: return texture(uTextures[5], uv);
+        case 6: return texture(uTextures[6], uv);
+        default: return texture(uTextures[7], uv);
+    }
+}
+
+void main() {
+    FragColor = sampleSlot(vSlot, vTexCoords) * vColor;
+}
+)";
+
+    VertexLayout SpriteVertex::Layout() {
+        return VertexLayout{}
+                .Add(3, AttribType::F32)
+                .Add(2, AttribType::F32)
+                .Add(4, AttribType::U8, true)
+                .Add(1, AttribType::F32);
+    }
+
+    std::optional<SpriteBatch> SpriteBatch::Create() {
+        SpriteBatch batch;
+        batch.m_Pipeline = Pipeline::FromSource(s_SpriteVertShader, s_SpriteFragShader);
+        if (!batch.m_Pipeline) {
+            Debug::LogErr("SpriteBatch::Create: Failed to build sprite pipeline!");
+            return std::nullopt;
+        }
+
+        // Every quad has the same topology, one index buffer serves all batches through the base vertex.
+        std::vector<u16> indices(s_MaxSprites * 6);
+        for (usize i = 0; i < s_MaxSprites; i++) {
+            const u16 v = static_cast<u16>(i * 4);
+
+            indices[i * 6 + 0] = v + 0;
+            indices[i * 6 + 1] = v + 1;
+            indices[i * 6 + 2] = v + 2;
+            indices[i * 6 + 3] = v + 2;
+            indices[i * 6 + 4] = v + 3;
+            indices[i * 6 + 5] = v + 0;
+        }
+
+        batch.m_IndexBuffer  = Buffer::Create(Memory::Buffer(indices), BufferType::Index);
+        batch.m_VertexBuffer = StreamBuffer::Create(s_InitialSegmentSize, BufferType::Vertex);
+        batch.m_White        = Texture::Default();
+
+        return batch;
+    }
+
+    bool SpriteBatch::Render(const SpriteList &sprites, const Matrix4f &viewProj) {
+        m_Stats = {.sprites = sprites.size()};
+        if (sprites.empty()) {
+            return true;
+        }
+
+        m_VertexBuffer.BeginFrame();
+
+        BuildBatches(sprites);
+        WriteVertices(sprites);
+
+        const usize stride = sizeof(SpriteVertex);
+        const usize bytes  = m_Vertices.size() * stride;
+
+        m_VertexBuffer.Reserve(bytes + stride);
+        const std::optional<usize> offset = m_VertexBuffer.Write(m_Vertices.data(), bytes, stride);
+        if (!offset) {
+            Debug::LogErr("SpriteBatch::Render: Failed to upload sprite vertices!");
+            return false;
+        }
+
+        // A grown stream buffer is a new GL buffer, the vertex array has to point at it.
+        const Buffer &buffer = m_VertexBuffer.GetBuffer();
+        if (m_VertexArrayBuffer != buffer.GlId()) {
+            m_VertexArray = VertexArray::Create();
+            if (!m_VertexArray.SetVertexBuffer(buffer, SpriteVertex::Layout()) ||
+                !m_VertexArray.SetIndexBuffer(m_IndexBuffer)) {
+                Debug::LogErr("SpriteBatch::Render: Failed to set up vertex array!");
+                return false;
+            }
+
+            m_VertexArrayBuffer = buffer.GlId();
+        }
+
+        m_Pipeline->SetUniform("uViewProj", viewProj);
+        if (!m_Pipeline->Bind() || !m_VertexArray.Bind()) {
+            return false;
+        }
+
+        StateCache::SetEnabled(GL_DEPTH_TEST, false);
+        StateCache::SetEnabled(GL_CULL_FACE, false);
+        StateCache::SetEnabled(GL_BLEND, true);
+
+        const i32 baseVertex = static_cast<i32>(*offset / stride);
+        for (const Batch &batch: m_Batches) {
+            if (batch.blend == SpriteBlend::Additive) {
+                StateCache::BlendFunc(GL_SRC_ALPHA, GL_ONE);
+            } else {
+                StateCache::BlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+            }
+
+            for (usize s = 0; s < batch.slots; s++) {
+                const Texture &texture = batch.textures[s] ? *batch.textures[s] : m_White;
+                m_Pipeline->SetUniform("uTextures[" + std::to_string(s) + "]", texture);
+            }
+
+            FrameCounters::Draw(batch.count * 6);
+            FLK_GL_CALL(glDrawElementsBaseVertex(
+                GL_TRIANGLES,
+                static_cast<i32>(batch.count * 6),
+                GL_UNSIGNED_SHORT,
+                nullptr,
+                baseVertex + static_cast<i32>(batch.first * 4)
+            ));
+        }
+
+        m_VertexBuffer.EndFrame();
+        m_Stats.batches = m_Batches.size();
+
+        StateCache::BlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+        VertexArray::Unbind();
+
+        return true;
+    }
+
+    SpriteBatchStats SpriteBatch::Stats() const {
+        return m_Stats;
+    }
+
+    void SpriteBatch::BuildBatches(const SpriteList &sprites) {
+        m_Order.resize(sprites.size());
+        for (u32 i = 0; i < m_Order.size(); i++) {
+            m_Order[i] = i;
+        }
+
+        // Stable, so sprites sharing a layer and a texture keep their submission order.
+        std::ranges::stable_sort(m_Order, [&](const u32 lhs, const u32 rhs) {
+            const Sprite &a = sprites[lhs];
+            const Sprite &b = sprites[rhs];
+
+            if (a.layer != b.layer) {
+                return a.layer < b.layer;
+            }
+
+            if (a.blend != b.blend) {
+                return a.blend < b.blend;
+            }
+
+            return std::less<const Texture *>{}(a.texture, b.texture);
+        });
+
+        m_Batches.clear();
+        m_Slots.resize(sprites.size());
+
+        for (usize i = 0; i < m_Order.size(); i++) {
+            const Sprite &sprite = sprites[m_Order[i]];
+
+            Batch *batch = m_Batches.empty() ? nullptr : &m_Batches.back();
+            if (!batch || batch->blend != sprite.blend || batch->count == s_MaxSprites) {
+                batch = &m_Batches.emplace_back(Batch{.first = i, .blend = sprite.blend});
+            }
+
+            const auto begin = batch->textures.begin();
+            const auto end   = begin + static_cast<std::ptrdiff_t>(batch->slots);
+            auto       slot  = std::find(begin, end, sprite.texture);
+
+            if (slot == end && batch->slots == s_TextureSlots) {
+                batch = &m_Batches.emplace_back(Batch{.first = i, .blend = sprite.blend});
+                slot  = batch->textures.begin();
+            }
+
+            if (slot == batch->textures.begin() + static_cast<std::ptrdiff_t>(batch->slots)) {
+                *slot = sprite.texture;
+                batch->slots++;
+            }
+
+            m_Slots[i] = static_cast<u8>(slot - batch->textures.begin());
+            batch->count++;
+        }
+    }
+
+    void SpriteBatch::WriteVertices(const SpriteList &sprites) {
+        m_Vertices.resize(sprites.size() * 4);
+
+        Jobs::ParallelFor(m_Order.size(), s_VertexGrain, [&](const usize begin, const usize end) {
+            for (usize i = begin; i < end; i++) {
+                const Sprite &sprite = sprites[m_Order[i]];
+                const auto &[position, rotation, scale, euler] = sprite.transform;
+
+                const Vector3f right = rotation * Vector3f{scale.x * 0.5F, 0.0F, 0.0F};
+                const Vector3f up    = rotation * Vector3f{0.0F, scale.y * 0.5F, 0.0F};
+
+                const Vector2f uvMin = sprite.uv.origin;
+                const Vector2f uvMax = sprite.uv.origin + sprite.uv.aspect;
+                const f32      slot  = m_Slots[i];
+
+                SpriteVertex *quad = &m_Vertices[i * 4];
+                quad[0]            = {position - right - up, {uvMin.x, uvMin.y}, sprite.color, slot};
+                quad[1]            = {position + right - up, {uvMax.x, uvMin.y}, sprite.color, slot};
+                quad[2]            = {position + right + up, {uvMax.x, uvMax.y}, sprite.color, slot};
+                quad[3]            = {position - right + up, {uvMin.x, uvMax.y}, sprite.color, slot};
+            }
+        });
+    }
+}
@@ -0,0 +1,121 @@
+#ifndef FLK_SPRITEBATCH_HPP
+#define FLK_SPRITEBATCH_HPP
+
+#include <array>
+#include <optional>
+#include <vector>
+
+#include "Common.hpp"
+#include "Buffer.hpp"
+#include "Pipeline.hpp"
+#include "StreamBuffer.hpp"
+#include "Texture.hpp"
+#include "VertexArray.hpp"
+#include "VertexLayout.hpp"
+#include "Math/Color.hpp"
+#include "Math/Matrix.hpp"
+#include "Math/Rect.hpp"
+#include "Math/Transform.hpp"
+#include "Math/Vector.hpp"
+
+namespace Flock::Graphics {
+    /**
+     * @enum SpriteBlend
+     * @brief How a sprite is blended with what is behind it.
+     */
+    enum class SpriteBlend : u8 {
+        Alpha,
+        Additive,
+    };
+
+    /**
+     * @struct Sprite
+     * @brief A textured quad of unit size, centered on its transform.
+     */
+    struct FLK_API Sprite {
+        const Texture *texture   = nullptr; // White if null.
+        Transform      transform = {};
+        Color4u8       color     = Color4u8::White();
+        Rect2f         uv        = {{0.0F, 0.0F}, {1.0F, 1.0F}}; // Origin and size in texture coordinates.
+        i32            layer     = 0;                            // Higher layers are drawn on top.
+        SpriteBlend    blend     = SpriteBlend::Alpha;
+    };
+
+    using SpriteList = std::vector<Sprite>;
+
+    struct SpriteVertex {
+        Vector3f position;
+        Vector2f texCoords;
+        Color4u8 color;
+        f32      slot; // The texture slot of the batch.
+
+        static VertexLayout Layout();
+    };
+
+    struct SpriteBatchStats {
+        usize sprites = 0;
+        usize batches = 0;
+    };
+
+    /**
+     * @class SpriteBatch
+     * @brief Draws sprites in as few draw calls as possible.
+     *
+     * Sprites are sorted by layer, blend mode and texture, then written as quads into a stream buffer. A batch
+     * binds up to s_TextureSlots textures and only breaks when it runs out of slots or the blend mode changes.
+     */
+    class FLK_API SpriteBatch {
+    public:
+        static constexpr usize s_TextureSlots = 8;
+        static constexpr usize s_MaxSprites   = 16384; // Per draw call, so that 16-bit indices reach every vertex.
+
+    private:
+        struct Batch {
+            usize                                       first    = 0;
+            usize                                       count    = 0;
+            SpriteBlend                                 blend    = SpriteBlend::Alpha;
+            std::array<const Texture *, s_TextureSlots> textures = {};
+            usize                                       slots    = 0;
+        };
+
+        StreamBuffer m_VertexBuffer;
+        Buffer       m_IndexBuffer;
+        VertexArray  m_VertexArray;
+        u32          m_VertexArrayBuffer = 0; // The stream buffer m_VertexArray was set up with.
+
+        std::optional<Pipeline> m_Pipeline;
+        Texture                 m_White; // Bound in the slot of untextured sprites.
+
+        std::vector<u32>          m_Order;
+        std::vector<u8>           m_Slots; // Per sorted sprite.
+        std::vector<SpriteVertex> m_Vertices;
+        std::vector<Batch>        m_Batches;
+        SpriteBatchStats          m_Stats;
+
+    public:
+        /**
+         * @brief Static factory method.
+         * @return A newly created sprite batch if successful; std::nullopt otherwise.
+         */
+        static std::optional<SpriteBatch> Create();
+
+        /**
+         * @brief Draws the sprites into the bound framebuffer, without depth testing.
+         * @param sprites The sprites to draw.
+         * @param viewProj The view projection matrix of the camera.
+         * @return true if successful; false otherwise.
+         */
+        bool Render(const SpriteList &sprites, const Matrix4f &viewProj);
+
+        /**
+         * @return The sprites and draw calls of the last Render().
+         */
+        [[nodiscard]] SpriteBatchStats Stats() const;
+
+    private:
+        void BuildBatches(const SpriteList &sprites);
+        void WriteVertices(const SpriteList &sprites);
+    };
+}
+
+#endif //FLK_SPRITEBATCH_HPP
@@ -2,15 +2,21 @@
 #define FLK_SPRITERENDERER_HPP
 
 #include "Common.hpp"
+#include "SpriteBatch.hpp"
+#include "TextureAtlas.hpp"
 #include "Serial/Archive.hpp"
 
 namespace Flock::Graphics {
     struct FLK_API SpriteRenderer {
-        Asset::AssetHandle<Texture> sprite;
-        Color4u8                    color = Color4u8::White();
+        Asset::AssetHandle<Texture>      sprite;
+        Asset::AssetHandle<TextureAtlas> atlas;      // Used instead of sprite if set.
+        u32                              region = 0; // The region of the atlas.
+        Color4u8                         color  = Color4u8::White();
+        i32                              layer  = 0; // Higher layers are drawn on top, regardless of depth.
+        SpriteBlend                      blend  = SpriteBlend::Alpha;
     };
 
-    FLK_ARCHIVE(SpriteRenderer, sprite, color)
+    FLK_ARCHIVE(SpriteRenderer, sprite, atlas, region, color, layer, blend)
 }
 
 #endif //FLK_SPRITERENDERER_HPP
@@ -0,0 +1,296 @@
+#include "StateCache.hpp"
+
+#include "Graphics/Gl.hpp"
+#include "glad/glad.h"
+
+namespace Flock::Graphics {
+    namespace {
+        constexpr u32 s_Unknown = StateCache::s_Unknown;
+
+        struct State {
+            using UnitTextures = std::array<u32, 4>;
+
+            u32                                                  program      = s_Unknown;
+            u32                                                  vertexArray  = s_Unknown;
+            u32                                                  readFbo      = s_Unknown;
+            u32                                                  drawFbo      = s_Unknown;
+            u32                                                  activeUnit   = s_Unknown;
+            std::array<UnitTextures, StateCache::s_TextureUnits> textures     = {};
+            std::array<u32, 5>                                   capabilities = {};
+            u32                                                  blendSrc     = s_Unknown;
+            u32                                                  blendDst     = s_Unknown;
+            u32                                                  depthFunc    = s_Unknown;
+            u32                                                  depthMask    = s_Unknown;
+            u32                                                  colorMask    = s_Unknown;
+            u32                                                  cullFace     = s_Unknown;
+            u32                                                  frontFace    = s_Unknown;
+            u32                                                  polygonMode  = s_Unknown;
+            std::array<u32, 4>                                   viewport     = {};
+
+            State() {
+                for (auto &unit: textures) {
+                    unit.fill(s_Unknown);
+                }
+
+                capabilities.fill(s_Unknown);
+                viewport.fill(s_Unknown);
+            }
+        };
+
+        State           s_State;
+        StateCacheStats s_Stats;
+
+        i32 TargetIndex(const u32 target) {
+            switch (target) {
+                case GL_TEXTURE_2D: return 0;
+                case GL_TEXTURE_2D_ARRAY: return 1;
+                case GL_TEXTURE_CUBE_MAP: return 2;
+                case GL_TEXTURE_BUFFER: return 3;
+                default: return -1;
+            }
+        }
+
+        i32 CapabilityIndex(const u32 capability) {
+            switch (capability) {
+                case GL_BLEND: return 0;
+                case GL_DEPTH_TEST: return 1;
+                case GL_CULL_FACE: return 2;
+                case GL_STENCIL_TEST: return 3;
+                case GL_SCISSOR_TEST: return 4;
+                default: return -1;
+            }
+        }
+    }
+
+    void StateCache::Invalidate() {
+        s_State = State{};
+    }
+
+    void StateCache::UseProgram(const u32 program) {
+        if (Update(s_State.program, program)) {
+            s_Stats.programBinds++;
+            FLK_GL_CALL(glUseProgram(program));
+        }
+    }
+
+    void StateCache::BindVertexArray(const u32 vertexArray) {
+        if (Update(s_State.vertexArray, vertexArray)) {
+            s_Stats.vertexArrayBinds++;
+            FLK_GL_CALL(glBindVertexArray(vertexArray));
+        }
+    }
+
+    void StateCache::BindFramebuffer(const u32 target, const u32 framebuffer) {
+        switch (target) {
+            case GL_READ_FRAMEBUFFER:
+                if (Update(s_State.readFbo, framebuffer)) {
+                    FLK_GL_CALL(glBindFramebuffer(GL_READ_FRAMEBUFFER, framebuffer));
+                }
+                break;
+            case GL_DRAW_FRAMEBUFFER:
+                if (Update(s_State.drawFbo, framebuffer)) {
+                    FLK_GL_CALL(glBindFramebuffer(GL_DRAW_FRAMEBUFFER, framebuffer));
+                }
+                break;
+            default:
+                if (s_State.readFbo == framebuffer && s_State.drawFbo == framebuffer) {
+                    s_Stats.skipped++;
+                    break;
+                }
+
+                s_Stats.issued++;
+                s_State.readFbo = framebuffer;
+                s_State.drawFbo = framebuffer;
+                FLK_GL_CALL(glBindFramebuffer(GL_FRAMEBUFFER, framebuffer));
+                break;
+        }
+    }
+
+    void StateCache::ActiveTexture(const u32 unit) {
+        if (Update(s_State.activeUnit, unit)) {
+            FLK_GL_CALL(glActiveTexture(GL_TEXTURE0 + unit));
+        }
+    }
+
+    void StateCache::BindTexture(const u32 target, const u32 texture) {
+        const i32 targetIdx = TargetIndex(target);
+        if (targetIdx < 0 || s_State.activeUnit >= s_TextureUnits) {
+            s_Stats.issued++;
+            s_Stats.textureBinds++;
+            FLK_GL_CALL(glBindTexture(target, texture));
+            return;
+        }
+
+        if (Update(s_State.textures[s_State.activeUnit][targetIdx], texture)) {
+            s_Stats.textureBinds++;
+            FLK_GL_CALL(glBindTexture(target, texture));
+        }
+    }
+
+    void StateCache::BindTexture(const u32 unit, const u32 target, const u32 texture) {
+        // The unit is activated even if the texture is already bound there, callers edit it through the active unit.
+        ActiveTexture(unit);
+        BindTexture(target, texture);
+    }
+
+    void StateCache::SetEnabled(const u32 capability, const bool enabled) {
+        const i32 capIdx = CapabilityIndex(capability);
+        if (capIdx >= 0 && !Update(s_State.capabilities[capIdx], enabled)) {
+            return;
+        }
+
+        if (capIdx < 0) {
+            s_Stats.issued++;
+        }
+
+        if (enabled) {
+            FLK_GL_CALL(glEnable(capability));
+        } else {
+            FLK_GL_CALL(glDisable(capability));
+        }
+    }
+
+    void StateCache::BlendFunc(const u32 src, const u32 dst) {
+        if (s_State.blendSrc == src && s_State.blendDst == dst) {
+            s_Stats.skipped++;
+            return;
+        }
+
+        s_Stats.issued++;
+        s_State.blendSrc = src;
+        s_State.blendDst = dst;
+        FLK_GL_CALL(glBlendFunc(src, dst));
+    }
+
+    void StateCache::DepthFunc(const u32 func) {
+        if (Update(s_State.depthFunc, func)) {
+            FLK_GL_CALL(glDepthFunc(func));
+        }
+    }
+
+    void StateCache::DepthMask(const bool write) {
+        if (Update(s_State.depthMask, write)) {
+            FLK_GL_CALL(glDepthMask(write ? GL_TRUE : GL_FALSE));
+        }
+    }
+
+    void StateCache::ColorMask(const bool write) {
+        if (Update(s_State.colorMask, write)) {
+            const GLboolean mask = write ? GL_TRUE : GL_FALSE;
+            FLK_GL_CALL(glColorMask(mask, mask, mask, mask));
+        }
+    }
+
+    void StateCache::CullFace(const u32 face) {
+        if (Update(s_State.cullFace, face)) {
+            FLK_GL_CALL(glCullFace(face));
+        }
+    }
+
+    void StateCache::FrontFace(const u32 face) {
+        if (Update(s_State.frontFace, face)) {
+            FLK_GL_CALL(glFrontFace(face));
+        }
+    }
+
+    void StateCache::PolygonMode(const u32 mode) {
+        if (Update(s_State.polygonMode, mode)) {
+            FLK_GL_CALL(glPolygonMode(GL_FRONT_AND_BACK, mode));
+        }
+    }
+
+    void StateCache::Viewport(const i32 x, const i32 y, const i32 width, const i32 height) {
+        const std::array<u32, 4> viewport = {
+            static_cast<u32>(x),
+            static_cast<u32>(y),
+            static_cast<u32>(width),
+            static_cast<u32>(height)
+        };
+
+        if (s_State.viewport == viewport) {
+            s_Stats.skipped++;
+            return;
+        }
+
+        s_Stats.issued++;
+        s_State.viewport = viewport;
+        FLK_GL_CALL(glViewport(x, y, width, height));
+    }
+
+    u32 StateCache::Program() {
+        return s_State.program;
+    }
+
+    u32 StateCache::VertexArray() {
+        return s_State.vertexArray;
+    }
+
+    u32 StateCache::Framebuffer(const u32 target) {
+        return target == GL_READ_FRAMEBUFFER ? s_State.readFbo : s_State.drawFbo;
+    }
+
+    u32 StateCache::ActiveUnit() {
+        return s_State.activeUnit;
+    }
+
+    u32 StateCache::Texture(const u32 unit, const u32 target) {
+        const i32 targetIdx = TargetIndex(target);
+        if (targetIdx < 0 || unit >= s_TextureUnits) {
+            return s_Unknown;
+        }
+
+        return s_State.textures[unit][targetIdx];
+    }
+
+    void StateCache::ForgetProgram(const u32 program) {
+        // A deleted program stays in use until another one is bound, so only its name is forgotten.
+        if (s_State.program == program) {
+            s_State.program = s_Unknown;
+        }
+    }
+
+    void StateCache::ForgetVertexArray(const u32 vertexArray) {
+        if (s_State.vertexArray == vertexArray) {
+            s_State.vertexArray = 0;
+        }
+    }
+
+    void StateCache::ForgetFramebuffer(const u32 framebuffer) {
+        if (s_State.readFbo == framebuffer) {
+            s_State.readFbo = 0;
+        }
+
+        if (s_State.drawFbo == framebuffer) {
+            s_State.drawFbo = 0;
+        }
+    }
+
+    void StateCache::ForgetTexture(const u32 texture) {
+        for (auto &unit: s_State.textures) {
+            for (auto &bound: unit) {
+                if (bound == texture) {
+                    bound = 0;
+                }
+            }
+        }
+    }
+
+    StateCacheStats StateCache::Stats() {
+        return s_Stats;
+    }
+
+    void StateCache::ResetStats() {
+        s_Stats = {};
+    }
+
+    bool StateCache::Update(u32 &cached, const u32 value) {
+        if (cached == value) {
+            s_Stats.skipped++;
+            return false;
+        }
+
+        s_Stats.issued++;
+        cached = value;
+        return true;
+    }
+}
@@ -0,0 +1,99 @@
+#ifndef FLK_STATECACHE_HPP
+#define FLK_STATECACHE_HPP
+
+#include <array>
+
+#include "Common.hpp"
+
+namespace Flock::Graphics {
+    /**
+     * @struct StateCacheStats
+     * @brief Number of GL state calls issued to the driver and skipped as redundant.
+     */
+    struct StateCacheStats {
+        u64 issued  = 0;
+        u64 skipped = 0;
+
+        // Issued binds by kind, part of issued.
+        u64 programBinds     = 0;
+        u64 vertexArrayBinds = 0;
+        u64 textureBinds     = 0;
+    };
+
+    /**
+     * @class StateCache
+     * @brief Shadows the GL context state so redundant binds and state changes never reach the driver.
+     *
+     * Every bind in the engine goes through this cache. Code that touches GL state behind its back
+     * (e.g. nanovg) must call Invalidate() afterward.
+     */
+    class FLK_API StateCache {
+    public:
+        static constexpr u32 s_Unknown      = 0xFFFFFFFF;
+        static constexpr u32 s_TextureUnits = 32;
+
+        /**
+         * @brief Forgets all shadowed state, forcing the next call of each kind to be issued.
+         */
+        static void Invalidate();
+
+        static void UseProgram(u32 program);
+        static void BindVertexArray(u32 vertexArray);
+        static void BindFramebuffer(u32 target, u32 framebuffer);
+
+        /**
+         * @brief Sets the active texture unit.
+         * @param unit The unit index, starting at 0.
+         */
+        static void ActiveTexture(u32 unit);
+
+        /**
+         * @brief Binds a texture to the active texture unit.
+         * @param target The GL texture target (GL_TEXTURE_2D, GL_TEXTURE_2D_ARRAY, GL_TEXTURE_CUBE_MAP or GL_TEXTURE_BUFFER).
+         * @param texture The GL texture name.
+         */
+        static void BindTexture(u32 target, u32 texture);
+
+        /**
+         * @brief Binds a texture to a given texture unit and leaves that unit active.
+         * @param unit The unit index, starting at 0.
+         * @param target The GL texture target.
+         * @param texture The GL texture name.
+         */
+        static void BindTexture(u32 unit, u32 target, u32 texture);
+
+        static void SetEnabled(u32 capability, bool enabled);
+        static void BlendFunc(u32 src, u32 dst);
+        static void DepthFunc(u32 func);
+        static void DepthMask(bool write);
+        static void ColorMask(bool write);
+        static void CullFace(u32 face);
+        static void FrontFace(u32 face);
+        static void PolygonMode(u32 mode);
+        static void Viewport(i32 x, i32 y, i32 width, i32 height);
+
+        [[nodiscard]] static u32 Program();
+        [[nodiscard]] static u32 VertexArray();
+        [[nodiscard]] static u32 Framebuffer(u32 target);
+        [[nodiscard]] static u32 ActiveUnit();
+
+        /**
+         * @brief Gets the texture bound to a unit, or s_Unknown if it is not being tracked.
+         */
+        [[nodiscard]] static u32 Texture(u32 unit, u32 target);
+
+        // Deleting a GL object implicitly unbinds it, these keep the cache in sync.
+        static void ForgetProgram(u32 program);
+        static void ForgetVertexArray(u32 vertexArray);
+        static void ForgetFramebuffer(u32 framebuffer);
+        static void ForgetTexture(u32 texture);
+
+        [[nodiscard]] static StateCacheStats Stats();
+        static void                          ResetStats();
+
+    private:
+        static bool Update(u32 &cached, u32 value);
+    };
+}
+
+#endif //FLK_STATECACHE_HPP
@@ -0,0 +1,174 @@
+#include "StreamBuffer.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <utility>
+
+#include "Gl.hpp"
+#include "RenderStats.hpp"
+
+namespace Flock::Graphics {
+    namespace {
+        // Waiting on a fence of a segment that is this old means the GPU is frames behind, a second is plenty.
+        constexpr u64 s_FenceTimeout = 1'000'000'000;
+    }
+
+    StreamBuffer StreamBuffer::Create(const usize segmentSize, const BufferType type) {
+        StreamBuffer buffer;
+        buffer.m_Type        = type;
+        buffer.m_SegmentSize = segmentSize;
+        buffer.m_Buffer      = Buffer::Allocate(segmentSize * s_Segments, type, BufferUsage::DynamicDraw);
+
+        return buffer;
+    }
+
+    StreamBuffer::~StreamBuffer() {
+        ClearFences();
+    }
+
+    StreamBuffer::StreamBuffer(StreamBuffer &&other) noexcept
+        : m_Buffer(std::move(other.m_Buffer)),
+          m_Type(other.m_Type),
+          m_SegmentSize(other.m_SegmentSize),
+          m_Segment(other.m_Segment),
+          m_Head(other.m_Head),
+          m_Demand(other.m_Demand),
+          m_Fences(other.m_Fences) {
+        other.m_Fences = {};
+    }
+
+    StreamBuffer &StreamBuffer::operator=(StreamBuffer &&other) noexcept {
+        if (this == &other) {
+            return *this;
+        }
+
+        ClearFences();
+
+        m_Buffer       = std::move(other.m_Buffer);
+        m_Type         = other.m_Type;
+        m_SegmentSize  = other.m_SegmentSize;
+        m_Segment      = other.m_Segment;
+        m_Head         = other.m_Head;
+        m_Demand       = other.m_Demand;
+        m_Fences       = other.m_Fences;
+        other.m_Fences = {};
+
+        return *this;
+    }
+
+    void StreamBuffer::BeginFrame() {
+        if (m_Buffer.GlId() == 0) {
+            return;
+        }
+
+        Reserve(m_Demand);
+
+        m_Segment = (m_Segment + 1) % s_Segments;
+        m_Head    = 0;
+        m_Demand  = 0;
+
+        GLsync &fence = m_Fences[m_Segment];
+        if (fence) {
+            const GLenum result = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, s_FenceTimeout);
+            if (result == GL_TIMEOUT_EXPIRED || result == GL_WAIT_FAILED) {
+                Debug::LogErr("StreamBuffer::BeginFrame: Timed out waiting for the GPU!");
+            }
+
+            FLK_GL_CALL(glDeleteSync(fence));
+            fence = nullptr;
+        }
+    }
+
+    void StreamBuffer::EndFrame() {
+        if (m_Buffer.GlId() == 0 || m_Head == 0) {
+            return;
+        }
+
+        GLsync &fence = m_Fences[m_Segment];
+        if (fence) {
+            FLK_GL_CALL(glDeleteSync(fence));
+        }
+
+        fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    }
+
+    std::optional<usize> StreamBuffer::Write(const void *data, const usize size, const usize alignment) {
+        if (m_Buffer.GlId() == 0 || size == 0) {
+            return std::nullopt;
+        }
+
+        // The demand keeps counting past a failed write, so the next segment fits the whole frame.
+        const usize base  = m_Segment * m_SegmentSize;
+        const usize start = (base + m_Head + alignment - 1) / alignment * alignment;
+        m_Demand += size + alignment - 1;
+
+        if (start + size > base + m_SegmentSize) {
+            return std::nullopt;
+        }
+
+        // The fence already keeps the GPU off this range, the driver doesn't need to synchronize.
+        FLK_GL_CALL(glBindBuffer(GL_COPY_WRITE_BUFFER, m_Buffer.GlId()));
+        void *dst = glMapBufferRange(
+            GL_COPY_WRITE_BUFFER,
+            static_cast<GLintptr>(start),
+            static_cast<GLsizeiptr>(size),
+            GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_RANGE_BIT | GL_MAP_UNSYNCHRONIZED_BIT
+        );
+
+        if (!dst) {
+            FLK_GL_CALL(glBindBuffer(GL_COPY_WRITE_BUFFER, 0));
+            Debug::LogErr("StreamBuffer::Write: Failed to map buffer!");
+            return std::nullopt;
+        }
+
+        std::memcpy(dst, data, size);
+        FrameCounters::BufferUpload(size);
+        FLK_GL_CALL(glUnmapBuffer(GL_COPY_WRITE_BUFFER));
+        FLK_GL_CALL(glBindBuffer(GL_COPY_WRITE_BUFFER, 0));
+
+        m_Head = start + size - base;
+        return start;
+    }
+
+    bool StreamBuffer::Reserve(const usize segmentSize) {
+        if (m_Buffer.GlId() == 0 || segmentSize <= m_SegmentSize) {
+            return false;
+        }
+
+        // The old store stays alive until the GPU is done with it, nothing has to wait.
+        ClearFences();
+
+        m_SegmentSize = std::max(m_SegmentSize * 2, segmentSize);
+        m_Buffer      = Buffer::Allocate(m_SegmentSize * s_Segments, m_Type, BufferUsage::DynamicDraw);
+        m_Segment     = 0;
+        m_Head        = 0;
+
+        return true;
+    }
+
+    void StreamBuffer::Clear() {
+        ClearFences();
+
+        m_Buffer      = {};
+        m_SegmentSize = 0;
+        m_Head        = 0;
+        m_Demand      = 0;
+    }
+
+    const Buffer &StreamBuffer::GetBuffer() const {
+        return m_Buffer;
+    }
+
+    usize StreamBuffer::SegmentSize() const {
+        return m_SegmentSize;
+    }
+
+    void StreamBuffer::ClearFences() {
+        for (GLsync &fence: m_Fences) {
+            if (fence) {
+                FLK_GL_CALL(glDeleteSync(fence));
+                fence = nullptr;
+            }
+        }
+    }
+}
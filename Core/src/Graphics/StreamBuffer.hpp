@@ -0,0 +1,91 @@
+#ifndef FLK_STREAMBUFFER_HPP
+#define FLK_STREAMBUFFER_HPP
+
+#include <array>
+#include <optional>
+
+#include "Common.hpp"
+#include "Buffer.hpp"
+#include "glad/glad.h"
+
+namespace Flock::Graphics {
+    /**
+     * @class StreamBuffer
+     * @brief A persistent ring buffer for geometry rewritten every frame.
+     *
+     * The buffer is split into one segment per frame in flight. Each frame writes into its own segment through
+     * unsynchronized maps, a fence placed by EndFrame() keeps the segment from being rewritten while the GPU may
+     * still read it. A frame that runs out of space fails its writes and the buffer grows at the next BeginFrame(),
+     * Reserve() grows it up front.
+     * Growing replaces the GL buffer, vertex arrays referring to it need to be set up again.
+     */
+    class FLK_API StreamBuffer {
+        static constexpr usize s_Segments = 3;
+
+        Buffer                         m_Buffer;
+        BufferType                     m_Type        = BufferType::None;
+        usize                          m_SegmentSize = 0;
+        usize                          m_Segment     = 0;
+        usize                          m_Head        = 0; // The next free byte of the current segment.
+        usize                          m_Demand      = 0; // Where the head would be if no write had failed.
+        std::array<GLsync, s_Segments> m_Fences      = {};
+
+    public:
+        /**
+         * @brief Static factory method.
+         * @param segmentSize The bytes available to each frame.
+         * @param type The type of the buffer.
+         * @return A newly created stream buffer.
+         */
+        static StreamBuffer Create(usize segmentSize, BufferType type);
+
+        StreamBuffer() = default;
+        ~StreamBuffer();
+
+        StreamBuffer(const StreamBuffer &other) = delete;
+        StreamBuffer(StreamBuffer &&other) noexcept;
+
+        StreamBuffer &operator=(const StreamBuffer &other) = delete;
+        StreamBuffer &operator=(StreamBuffer &&other) noexcept;
+
+        /**
+         * @brief Moves on to the next segment, waiting for the GPU if it still reads it.
+         */
+        void BeginFrame();
+
+        /**
+         * @brief Fences the current segment, call once the frame's draws are submitted.
+         */
+        void EndFrame();
+
+        /**
+         * @brief Copies data into the current segment.
+         * @param data The data to copy from.
+         * @param size The size in bytes.
+         * @param alignment The alignment of the returned offset, the vertex stride to draw with a base vertex.
+         * @return The offset of the data in the buffer if successful; std::nullopt if the segment is full.
+         */
+        std::optional<usize> Write(const void *data, usize size, usize alignment = 4);
+
+        /**
+         * @brief Grows the buffer right away if a segment is smaller than requested, draws already issued from the
+         * old buffer are unaffected.
+         * @param segmentSize The bytes needed by a frame.
+         * @return true if the buffer was replaced; false otherwise.
+         */
+        bool Reserve(usize segmentSize);
+
+        /**
+         * @brief Frees the buffer and its fences.
+         */
+        void Clear();
+
+        [[nodiscard]] const Buffer &GetBuffer() const;
+        [[nodiscard]] usize         SegmentSize() const;
+
+    private:
+        void ClearFences();
+    };
+}
+
+#endif //FLK_STREAMBUFFER_HPP
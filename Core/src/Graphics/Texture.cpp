@@ -2,6 +2,7 @@
 
 #include "Gl.hpp"
 #include "Graphics/Image.hpp"
+#include "Graphics/StateCache.hpp"
 #include "Memory/Buffer.hpp"
 
 namespace Flock::Graphics {
@@ -83,15 +84,8 @@ namespace Flock::Graphics {
         texture.m_Config = config;
         texture.m_Size   = image.size;
 
-        i32 activeUnit;
-        i32 boundTexture;
-
-        FLK_GL_CALL(glGetIntegerv(GL_ACTIVE_TEXTURE, &activeUnit));
-        FLK_GL_CALL(glGetIntegerv(GL_TEXTURE_BINDING_2D, &boundTexture));
-
         FLK_GL_CALL(glGenTextures(1, &texture.m_Id));
-        FLK_GL_CALL(glActiveTexture(GL_TEXTURE0));
-        FLK_GL_CALL(glBindTexture(GL_TEXTURE_2D, texture.m_Id));
+        StateCache::BindTexture(0, GL_TEXTURE_2D, texture.m_Id);
 
         u32 format = ToGlType(image.format);
         if (config.format) {
@@ -115,10 +109,6 @@ namespace Flock::Graphics {
 
         ConfigureTexture(GL_TEXTURE_2D, config);
 
-        FLK_GL_CALL(glBindTexture(GL_TEXTURE_2D, 0));
-        FLK_GL_CALL(glActiveTexture(activeUnit));
-        FLK_GL_CALL(glBindTexture(GL_TEXTURE_2D, boundTexture));
-
         return texture;
     }
 
@@ -127,15 +117,8 @@ namespace Flock::Graphics {
         texture.m_Config = config;
         texture.m_Size   = size;
 
-        i32 activeUnit;
-        i32 boundTexture;
-
-        FLK_GL_CALL(glGetIntegerv(GL_ACTIVE_TEXTURE, &activeUnit));
-        FLK_GL_CALL(glGetIntegerv(GL_TEXTURE_BINDING_2D, &boundTexture));
-
         FLK_GL_CALL(glGenTextures(1, &texture.m_Id));
-        FLK_GL_CALL(glActiveTexture(GL_TEXTURE0));
-        FLK_GL_CALL(glBindTexture(GL_TEXTURE_2D, texture.m_Id));
+        StateCache::BindTexture(0, GL_TEXTURE_2D, texture.m_Id);
 
         u32 varType = GL_UNSIGNED_BYTE;
         u32 format  = GL_RGBA;
@@ -161,10 +144,6 @@ namespace Flock::Graphics {
 
         ConfigureTexture(GL_TEXTURE_2D, config);
 
-        FLK_GL_CALL(glBindTexture(GL_TEXTURE_2D, 0));
-        FLK_GL_CALL(glActiveTexture(activeUnit));
-        FLK_GL_CALL(glBindTexture(GL_TEXTURE_2D, boundTexture));
-
         return texture;
     }
 
@@ -179,6 +158,7 @@ namespace Flock::Graphics {
     Texture::Texture(Texture &&other) noexcept {
         m_Id       = other.m_Id;
         m_Config   = other.m_Config;
+        m_Size     = other.m_Size;
         other.m_Id = 0;
     }
 
@@ -191,6 +171,7 @@ namespace Flock::Graphics {
 
         m_Id       = other.m_Id;
         m_Config   = other.m_Config;
+        m_Size     = other.m_Size;
         other.m_Id = 0;
 
         return *this;
@@ -198,12 +179,13 @@ namespace Flock::Graphics {
 
     void Texture::Clear() const {
         if (m_Id != 0) {
+            StateCache::ForgetTexture(m_Id);
             FLK_GL_CALL(glDeleteTextures(1, &m_Id));
         }
     }
 
     void Texture::SetActiveUnit(const u8 unit) {
-        FLK_GL_CALL(glActiveTexture(GL_TEXTURE0 + unit));
+        StateCache::ActiveTexture(unit);
     }
 
     bool Texture::Bind() const {
@@ -211,31 +193,54 @@ namespace Flock::Graphics {
             return false;
         }
 
-        FLK_GL_CALL(glBindTexture(GL_TEXTURE_2D, m_Id));
+        StateCache::BindTexture(GL_TEXTURE_2D, m_Id);
 
         return true;
     }
 
     void Texture::Unbind() {
-        FLK_GL_CALL(glBindTexture(GL_TEXTURE_2D, 0));
+        StateCache::BindTexture(GL_TEXTURE_2D, 0);
     }
 
-    void Texture::Configure(const TextureConfig config) {
-        m_Config = config;
+    bool Texture::SetSubImage(const Image &image, const Vector2u offset) const {
+        if (m_Id == 0 || offset.x + image.size.x > m_Size.x || offset.y + image.size.y > m_Size.y) {
+            return false;
+        }
+
+        StateCache::BindTexture(0, GL_TEXTURE_2D, m_Id);
+
+        const Image flipped = image.FlipY();
+
+        // Rows are stored bottom up, same as FromImage().
+        FLK_GL_CALL(glPixelStorei(GL_UNPACK_ALIGNMENT, 1));
+        FLK_GL_CALL(glTexSubImage2D(GL_TEXTURE_2D,
+                0,
+                offset.x,
+                m_Size.y - offset.y - image.size.y,
+                image.size.x,
+                image.size.y,
+                ToGlType(image.format),
+                GL_UNSIGNED_BYTE,
+                flipped.data.Get())
+        );
 
-        i32 activeUnit;
-        i32 boundTexture;
+        return true;
+    }
 
-        FLK_GL_CALL(glGetIntegerv(GL_ACTIVE_TEXTURE, &activeUnit));
-        FLK_GL_CALL(glGetIntegerv(GL_TEXTURE_BINDING_2D, &boundTexture));
+    void Texture::GenerateMipmaps() const {
+        if (m_Id == 0 || !m_Config.generateMipmaps || (m_Config.format && m_Config.format.value() == TextureFormat::Depth)) {
+            return;
+        }
 
-        FLK_GL_CALL(glActiveTexture(GL_TEXTURE0));
-        FLK_GL_CALL(glBindTexture(GL_TEXTURE_2D, m_Id));
+        StateCache::BindTexture(0, GL_TEXTURE_2D, m_Id);
+        FLK_GL_CALL(glGenerateMipmap(GL_TEXTURE_2D));
+    }
 
-        ConfigureTexture(GL_TEXTURE_2D, config);
+    void Texture::Configure(const TextureConfig config) {
+        m_Config = config;
 
-        FLK_GL_CALL(glActiveTexture(activeUnit));
-        FLK_GL_CALL(glBindTexture(GL_TEXTURE_2D, boundTexture));
+        StateCache::BindTexture(0, GL_TEXTURE_2D, m_Id);
+        ConfigureTexture(GL_TEXTURE_2D, config);
     }
 
     TextureConfig Texture::Config() const {
@@ -143,6 +143,19 @@ namespace Flock::Graphics {
          */
         static void Unbind();
 
+        /**
+         * @brief Overwrites part of the base level, mipmaps are left stale until GenerateMipmaps().
+         * @param image The image to copy from.
+         * @param offset Where the image goes, from the top-left corner like image data.
+         * @return true if successful; false if the image doesn't fit.
+         */
+        bool SetSubImage(const Image &image, Vector2u offset) const;
+
+        /**
+         * @brief Regenerates the mipmaps from the base level if the config has them, e.g. after SetSubImage().
+         */
+        void GenerateMipmaps() const;
+
         void Configure(TextureConfig config);
 
         [[nodiscard]] TextureConfig Config() const;
@@ -3,6 +3,7 @@
 #include <optional>
 
 #include "Graphics/Gl.hpp"
+#include "Graphics/StateCache.hpp"
 #include "Graphics/Texture.hpp"
 #include "glad/glad.h"
 
@@ -14,7 +15,7 @@ namespace Flock::Graphics {
         texArr.m_Size   = size;
 
         FLK_GL_CALL(glGenTextures(1, &texArr.m_Id));
-        FLK_GL_CALL(glBindTexture(GL_TEXTURE_2D_ARRAY, texArr.m_Id));
+        StateCache::BindTexture(0, GL_TEXTURE_2D_ARRAY, texArr.m_Id);
 
         u32 varType = GL_UNSIGNED_BYTE;
         u32 format  = GL_RGBA;
@@ -78,6 +79,7 @@ namespace Flock::Graphics {
             return;
         }
 
+        StateCache::ForgetTexture(m_Id);
         glDeleteTextures(1, &m_Id);
     }
 
@@ -90,13 +92,13 @@ namespace Flock::Graphics {
             return false;
         }
 
-        FLK_GL_CALL(glBindTexture(GL_TEXTURE_2D_ARRAY, m_Id));
+        StateCache::BindTexture(GL_TEXTURE_2D_ARRAY, m_Id);
 
         return true;
     }
 
     void TextureArray::Unbind() {
-        FLK_GL_CALL(glBindTexture(GL_TEXTURE_2D_ARRAY, 0));
+        StateCache::BindTexture(GL_TEXTURE_2D_ARRAY, 0);
     }
 
     Vector2u TextureArray::Size() const {
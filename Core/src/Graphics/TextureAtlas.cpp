@@ -1,54 +1,204 @@
 #include "TextureAtlas.hpp"
 
-#include <functional>
+#include <algorithm>
+#include <limits>
 #include <optional>
 #include <utility>
 
+#include "Debug/Log.hpp"
 #include "Graphics/Image.hpp"
 #include "Graphics/Texture.hpp"
 #include "Math/Rect.hpp"
 
 namespace Flock::Graphics {
+    namespace {
+        // Textures are uploaded flipped, so the top of the page is at v = 1.
+        Rect2f ToUv(const Rect2u pixels, const Vector2u pageSize) {
+            const f32 width  = static_cast<f32>(pageSize.x);
+            const f32 height = static_cast<f32>(pageSize.y);
+
+            return {
+                {
+                    static_cast<f32>(pixels.origin.x) / width,
+                    1.0F - static_cast<f32>(pixels.origin.y + pixels.aspect.y) / height
+                },
+                {static_cast<f32>(pixels.aspect.x) / width, static_cast<f32>(pixels.aspect.y) / height}
+            };
+        }
+    }
+
+    AtlasPacker::AtlasPacker(const Vector2u size)
+        : m_Size(size) {
+        Reset();
+    }
+
+    std::optional<Vector2u> AtlasPacker::Insert(const Vector2u size) {
+        if (size.x == 0 || size.y == 0 || size.x > m_Size.x || size.y > m_Size.y) {
+            return std::nullopt;
+        }
+
+        usize best    = m_Skyline.size();
+        u32   bestTop = std::numeric_limits<u32>::max();
+        u32   bestY   = 0;
+
+        for (usize i = 0; i < m_Skyline.size(); i++) {
+            if (m_Skyline[i].x + size.x > m_Size.x) {
+                break;
+            }
+
+            // The rectangle rests on the highest segment it spans.
+            u32 y         = 0;
+            u32 remaining = size.x;
+            for (usize j = i; remaining > 0; j++) {
+                y = std::max(y, m_Skyline[j].y);
+                remaining -= std::min(remaining, m_Skyline[j].width);
+            }
+
+            if (y + size.y <= m_Size.y && y + size.y < bestTop) {
+                best    = i;
+                bestTop = y + size.y;
+                bestY   = y;
+            }
+        }
+
+        if (best == m_Skyline.size()) {
+            return std::nullopt;
+        }
+
+        const u32 x   = m_Skyline[best].x;
+        const u32 end = x + size.x;
+
+        m_Skyline.insert(m_Skyline.begin() + static_cast<std::ptrdiff_t>(best), {.x = x, .y = bestTop, .width = size.x});
+
+        // Segments under the new one are cut off or removed.
+        for (usize i = best + 1; i < m_Skyline.size() && m_Skyline[i].x < end;) {
+            Segment  &segment    = m_Skyline[i];
+            const u32 segmentEnd = segment.x + segment.width;
+
+            if (segmentEnd <= end) {
+                m_Skyline.erase(m_Skyline.begin() + static_cast<std::ptrdiff_t>(i));
+                continue;
+            }
+
+            segment.width = segmentEnd - end;
+            segment.x     = end;
+            break;
+        }
+
+        for (usize i = 0; i + 1 < m_Skyline.size();) {
+            if (m_Skyline[i].y == m_Skyline[i + 1].y) {
+                m_Skyline[i].width += m_Skyline[i + 1].width;
+                m_Skyline.erase(m_Skyline.begin() + static_cast<std::ptrdiff_t>(i + 1));
+            } else {
+                i++;
+            }
+        }
+
+        m_UsedArea += static_cast<u64>(size.x) * size.y;
+        return Vector2u{x, bestY};
+    }
+
+    void AtlasPacker::Reset() {
+        m_Skyline  = {{.x = 0, .y = 0, .width = m_Size.x}};
+        m_UsedArea = 0;
+    }
+
+    Vector2u AtlasPacker::Size() const {
+        return m_Size;
+    }
+
+    f32 AtlasPacker::Occupancy() const {
+        const u64 area = static_cast<u64>(m_Size.x) * m_Size.y;
+        return area == 0 ? 0.0F : static_cast<f32>(m_UsedArea) / static_cast<f32>(area);
+    }
+
     TextureAtlas TextureAtlas::FromImage(const Image &image, const Vector2u subtextures, const TextureConfig config) {
         const Vector2u subTexSize = image.size / subtextures;
         TextureAtlas   atlas;
 
         atlas.m_Subtextures = subtextures;
-        atlas.m_Size        = image.size;
+        atlas.m_PageSize    = image.size;
         atlas.m_Config      = config;
+        atlas.m_Padding     = 0;
+
+        atlas.m_Pages.push_back(Texture::FromImage(image, config));
+        atlas.m_StaleMipmaps.push_back(false);
 
-        for (u32 i = 0; i < image.size.x; i += subTexSize.x) {
-            for (u32 j = 0; j < image.size.y; j += subTexSize.y) {
-                Image subImage = image.SubImage(Rect2u{{i, j}, subTexSize}).value();
-                atlas.Insert(Vector2u{i, j}, Texture::FromImage(subImage));
+        // The grid covers the whole page, nothing else can be packed into it.
+        AtlasPacker &packer = atlas.m_Packers.emplace_back(image.size);
+        packer.Insert(image.size);
+
+        for (u32 y = 0; y < subtextures.y; y++) {
+            for (u32 x = 0; x < subtextures.x; x++) {
+                const Rect2u pixels = {{x * subTexSize.x, y * subTexSize.y}, subTexSize};
+                atlas.m_Regions.push_back({.page = 0, .pixels = pixels, .uv = ToUv(pixels, image.size)});
             }
         }
 
         return atlas;
     }
 
-    TextureAtlas TextureAtlas::CreateEmpty(const Vector2u size, const Vector2u subtextures, const TextureConfig config) {
-        const Vector2u subTexSize = size / subtextures;
-        TextureAtlas   atlas;
+    TextureAtlas TextureAtlas::CreateEmpty(const Vector2u pageSize, const TextureConfig config, const u32 padding) {
+        TextureAtlas atlas;
 
-        atlas.m_Subtextures = subtextures;
-        atlas.m_Size        = size;
-        atlas.m_Config      = config;
+        atlas.m_PageSize = pageSize;
+        atlas.m_Config   = config;
+        atlas.m_Padding  = padding;
 
-        for (u32 i = 0; i < size.x; i += subTexSize.x) {
-            for (u32 j = 0; i < size.y; j += subTexSize.y) {
-                atlas.Insert(Vector2u{i, j}, Texture::CreateEmpty(subTexSize));
-            }
+        return atlas;
+    }
+
+    std::optional<u32> TextureAtlas::Insert(const Image &image) {
+        const Vector2u padded = image.size + Vector2u{m_Padding * 2, m_Padding * 2};
+        if (padded.x > m_PageSize.x || padded.y > m_PageSize.y) {
+            Debug::LogErr("TextureAtlas::Insert: Image doesn't fit in a page!");
+            return std::nullopt;
         }
 
-        return atlas;
+        std::optional<Vector2u> corner;
+
+        u32 page = 0;
+        for (; page < m_Packers.size() && !corner; page++) {
+            corner = m_Packers[page].Insert(padded);
+        }
+
+        if (corner) {
+            page--;
+        } else {
+            // Cleared up front, the padding has to stay transparent.
+            m_Pages.push_back(Texture::FromImage(Image::SingleColor(m_PageSize, Color4u8::Transparent()), m_Config));
+            m_StaleMipmaps.push_back(false);
+            corner = m_Packers.emplace_back(m_PageSize).Insert(padded);
+            page   = m_Pages.size() - 1;
+        }
+
+        const Rect2u pixels = {*corner + Vector2u{m_Padding, m_Padding}, image.size};
+        if (!m_Pages[page].SetSubImage(image, pixels.origin)) {
+            Debug::LogErr("TextureAtlas::Insert: Failed to upload image!");
+            return std::nullopt;
+        }
+
+        // Regenerating mipmaps per insert would redo the whole page every time, Flush() does it once.
+        m_StaleMipmaps[page] = true;
+
+        m_Regions.push_back({.page = page, .pixels = pixels, .uv = ToUv(pixels, m_PageSize)});
+        return m_Regions.size() - 1;
+    }
+
+    void TextureAtlas::Flush() {
+        for (usize page = 0; page < m_Pages.size(); page++) {
+            if (m_StaleMipmaps[page]) {
+                m_Pages[page].GenerateMipmaps();
+                m_StaleMipmaps[page] = false;
+            }
+        }
     }
 
     void TextureAtlas::Configure(const TextureConfig config) {
         m_Config = config;
 
-        for (auto &tex: m_Textures) {
-            tex.Configure(config);
+        for (auto &page: m_Pages) {
+            page.Configure(config);
         }
     }
 
@@ -57,7 +207,7 @@ namespace Flock::Graphics {
     }
 
     Vector2u TextureAtlas::Size() const {
-        return m_Size;
+        return m_PageSize;
     }
 
     u32 TextureAtlas::Width() const {
@@ -68,28 +218,27 @@ namespace Flock::Graphics {
         return Size().y;
     }
 
-    Texture &TextureAtlas::operator[](const Vector2u position) {
-        if (!At(position)) {
-            return Insert(position, Texture::Default());
-        }
-
-        return *At(position);
+    const AtlasRegion *TextureAtlas::Region(const u32 region) const {
+        return region < m_Regions.size() ? &m_Regions[region] : nullptr;
     }
 
-    Texture *TextureAtlas::At(const Vector2u position) {
-        if (position.y * m_Subtextures.x + position.x >= m_Textures.size()) {
+    const AtlasRegion *TextureAtlas::Region(const Vector2u cell) const {
+        if (cell.x >= m_Subtextures.x || cell.y >= m_Subtextures.y) {
             return nullptr;
         }
 
-        return &m_Textures.at(position.y * m_Subtextures.x + position.x);
+        return Region(cell.y * m_Subtextures.x + cell.x);
     }
 
-    Texture &TextureAtlas::Insert(const Vector2u position, Texture &&texture) {
-        while (!At(position)) {
-            m_Textures.push_back(Texture::Default());
-        }
+    usize TextureAtlas::RegionCount() const {
+        return m_Regions.size();
+    }
+
+    const Texture *TextureAtlas::Page(const u32 page) const {
+        return page < m_Pages.size() ? &m_Pages[page] : nullptr;
+    }
 
-        *At(position) = std::move(texture);
-        return *At(position);
+    usize TextureAtlas::PageCount() const {
+        return m_Pages.size();
     }
 }
@@ -1,10 +1,12 @@
 #ifndef TEXTUREATLAS_HPP
 #define TEXTUREATLAS_HPP
 
+#include <optional>
 #include <vector>
 
 #include "Texture.hpp"
 #include "Common.hpp"
+#include "Math/Rect.hpp"
 #include "Math/Vector.hpp"
 
 namespace Flock {
@@ -14,16 +16,79 @@ struct Image;
 }  // namespace Flock
 
 namespace Flock::Graphics {
+    /**
+     * @class AtlasPacker
+     * @brief Packs rectangles into a fixed size area with the skyline bottom-left heuristic.
+     *
+     * The skyline is the top edge of everything packed so far, rectangles go where they keep it lowest.
+     * Rectangles can't be removed one by one, only all at once with Reset().
+     */
+    class FLK_API AtlasPacker {
+        struct Segment {
+            u32 x     = 0;
+            u32 y     = 0;
+            u32 width = 0;
+        };
+
+        Vector2u             m_Size     = {};
+        std::vector<Segment> m_Skyline  = {};
+        u64                  m_UsedArea = 0;
+
+    public:
+        AtlasPacker() = default;
+        explicit AtlasPacker(Vector2u size);
+
+        /**
+         * @brief Finds room for a rectangle and marks it as used.
+         * @param size The size of the rectangle.
+         * @return The top-left corner of the rectangle if it fits; std::nullopt otherwise.
+         */
+        std::optional<Vector2u> Insert(Vector2u size);
+
+        /**
+         * @brief Frees the whole area.
+         */
+        void Reset();
+
+        [[nodiscard]] Vector2u Size() const;
+
+        /**
+         * @return The fraction of the area covered by rectangles.
+         */
+        [[nodiscard]] f32 Occupancy() const;
+    };
+
+    /**
+     * @struct AtlasRegion
+     * @brief An image packed into a TextureAtlas.
+     */
+    struct FLK_API AtlasRegion {
+        u32    page   = 0;
+        Rect2u pixels = {}; // Origin and size in the page, from the top-left corner.
+        Rect2f uv     = {}; // Origin and size in texture coordinates.
+    };
+
+    /**
+     * @class TextureAtlas
+     * @brief Images sharing a few textures, so that drawing them doesn't switch textures.
+     *
+     * Images are packed into pages of a fixed size at runtime, a new page is added whenever none has room left.
+     * An atlas loaded from a grid has a single page and one region per cell.
+     */
     class FLK_API TextureAtlas {
-        std::vector<Texture> m_Textures;
-        TextureConfig        m_Config;
-        Vector2u             m_Size        = {};
-        Vector2u             m_Subtextures = {};
+        std::vector<Texture>     m_Pages;
+        std::vector<AtlasPacker> m_Packers;
+        std::vector<AtlasRegion> m_Regions;
+        std::vector<bool>        m_StaleMipmaps; // Per page, inserted into since the last Flush().
+        TextureConfig            m_Config;
+        Vector2u                 m_PageSize    = {};
+        Vector2u                 m_Subtextures = {};
+        u32                      m_Padding     = 1;
 
     public:
         /**
          * @brief Static factory method.
-         * @param image The image to copy data from.
+         * @param image The image to copy data from, uploaded as a single page.
          * @param subtextures The number of subtextures (horizontal and vertical) the atlas has.
          * @param config The texture configuration.
          * @return A newly created texture atlas.
@@ -32,12 +97,12 @@ namespace Flock::Graphics {
 
         /**
          * @brief Static factory method.
-         * @param size The size of the texture.
-         * @param subtextures The number of subtextures (horizontal and vertical) the atlas has.
+         * @param pageSize The size of each page.
          * @param config The texture configuration.
-         * @return A newly created texture atlas.
+         * @param padding The transparent border kept around each inserted image, so filtering doesn't bleed.
+         * @return A newly created texture atlas without pages.
          */
-        static TextureAtlas CreateEmpty(Vector2u size, Vector2u subtextures, TextureConfig config = {});
+        static TextureAtlas CreateEmpty(Vector2u pageSize, TextureConfig config = {}, u32 padding = 1);
 
         TextureAtlas()  = default;
         ~TextureAtlas() = default;
@@ -48,18 +113,49 @@ namespace Flock::Graphics {
         TextureAtlas &operator=(const TextureAtlas &other)     = delete;
         TextureAtlas &operator=(TextureAtlas &&other) noexcept = default;
 
+        /**
+         * @brief Packs an image into the first page with room, adding a page if none has any.
+         * Mipmaps of the page are left stale until Flush(), so a batch of inserts regenerates them once.
+         * @param image The image to insert.
+         * @return The region index if successful; std::nullopt if the image is larger than a page.
+         */
+        std::optional<u32> Insert(const Image &image);
+
+        /**
+         * @brief Regenerates the mipmaps of the pages inserted into since the last call.
+         * Call it after a batch of Insert() calls, with the same context current.
+         */
+        void Flush();
+
         void Configure(TextureConfig config);
 
         [[nodiscard]] TextureConfig Config() const;
 
+        /**
+         * @return The size of a page.
+         */
         [[nodiscard]] Vector2u Size() const;
         [[nodiscard]] u32      Width() const;
         [[nodiscard]] u32      Height() const;
 
-        [[nodiscard]] Texture &            operator[](Vector2u position);
-        [[nodiscard]] Texture *At(Vector2u position);
+        /**
+         * @return The region if it exists; nullptr otherwise.
+         */
+        [[nodiscard]] const AtlasRegion *Region(u32 region) const;
+
+        /**
+         * @return The region of a grid cell if it exists; nullptr otherwise.
+         */
+        [[nodiscard]] const AtlasRegion *Region(Vector2u cell) const;
+
+        [[nodiscard]] usize RegionCount() const;
+
+        /**
+         * @return The page texture if it exists; nullptr otherwise.
+         */
+        [[nodiscard]] const Texture *Page(u32 page) const;
 
-        Texture &Insert(Vector2u position, Texture &&texture);
+        [[nodiscard]] usize PageCount() const;
     };
 }
 
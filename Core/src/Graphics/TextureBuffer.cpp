@@ -0,0 +1,99 @@
+#include "TextureBuffer.hpp"
+
+#include <utility>
+
+#include "Graphics/Gl.hpp"
+#include "Graphics/StateCache.hpp"
+#include "glad/glad.h"
+
+namespace Flock::Graphics {
+    u32 ToGlType(const TextureBufferFormat format) {
+        switch (format) {
+            case TextureBufferFormat::R32U:
+                return GL_R32UI;
+            case TextureBufferFormat::RG32U:
+                return GL_RG32UI;
+            case TextureBufferFormat::RGBA32F:
+                return GL_RGBA32F;
+            default:
+                return 0;
+        }
+    }
+
+    TextureBuffer TextureBuffer::Create(const TextureBufferFormat format) {
+        TextureBuffer texBuf;
+        texBuf.m_Format = format;
+        texBuf.m_Buffer = Buffer::Create({}, BufferType::Texture, BufferUsage::DynamicDraw);
+
+        FLK_GL_CALL(glGenTextures(1, &texBuf.m_Id));
+        StateCache::BindTexture(0, GL_TEXTURE_BUFFER, texBuf.m_Id);
+        FLK_GL_CALL(glTexBuffer(GL_TEXTURE_BUFFER, ToGlType(format), texBuf.m_Buffer.GlId()));
+
+        return texBuf;
+    }
+
+    TextureBuffer::~TextureBuffer() {
+        Clear();
+    }
+
+    TextureBuffer::TextureBuffer(TextureBuffer &&other) noexcept {
+        m_Id       = other.m_Id;
+        m_Buffer   = std::move(other.m_Buffer);
+        m_Format   = other.m_Format;
+        other.m_Id = 0;
+    }
+
+    TextureBuffer &TextureBuffer::operator=(TextureBuffer &&other) noexcept {
+        if (this == &other) {
+            return *this;
+        }
+
+        Clear();
+
+        m_Id       = other.m_Id;
+        m_Buffer   = std::move(other.m_Buffer);
+        m_Format   = other.m_Format;
+        other.m_Id = 0;
+
+        return *this;
+    }
+
+    void TextureBuffer::Clear() const {
+        if (m_Id == 0) {
+            return;
+        }
+
+        StateCache::ForgetTexture(m_Id);
+        FLK_GL_CALL(glDeleteTextures(1, &m_Id));
+    }
+
+    bool TextureBuffer::SetData(const void *data, const usize size) const {
+        if (m_Id == 0) {
+            return false;
+        }
+
+        // The texture keeps pointing at the buffer object, so orphaning the store needs no rebinding.
+        return m_Buffer.SetData(data, size);
+    }
+
+    bool TextureBuffer::Bind() const {
+        if (m_Id == 0) {
+            return false;
+        }
+
+        StateCache::BindTexture(GL_TEXTURE_BUFFER, m_Id);
+        return true;
+    }
+
+    void TextureBuffer::Unbind() {
+        StateCache::BindTexture(GL_TEXTURE_BUFFER, 0);
+    }
+
+    u32 TextureBuffer::GlId() const {
+        return m_Id;
+    }
+
+    TextureBufferFormat TextureBuffer::Format() const {
+        return m_Format;
+    }
+}
@@ -0,0 +1,75 @@
+#ifndef FLK_TEXTUREBUFFER_HPP
+#define FLK_TEXTUREBUFFER_HPP
+
+#include "Buffer.hpp"
+#include "Common.hpp"
+
+namespace Flock::Graphics {
+    /**
+     * @enum TextureBufferFormat
+     * @brief Texel format of a texture buffer.
+     */
+    enum class TextureBufferFormat : u8 {
+        R32U,
+        RG32U,
+        RGBA32F,
+    };
+
+    u32 ToGlType(TextureBufferFormat format);
+
+    /**
+     * @class TextureBuffer
+     * @brief A buffer object sampled from shaders as a samplerBuffer/usamplerBuffer.
+     */
+    class FLK_API TextureBuffer {
+        u32                 m_Id     = 0;
+        Buffer              m_Buffer;
+        TextureBufferFormat m_Format = TextureBufferFormat::RGBA32F;
+
+    public:
+        /**
+         * @brief Static factory method.
+         * @param format The texel format.
+         * @return A newly created, empty texture buffer.
+         */
+        static TextureBuffer Create(TextureBufferFormat format);
+
+        TextureBuffer() = default;
+        ~TextureBuffer();
+
+        TextureBuffer(const TextureBuffer &other) = delete;
+        TextureBuffer(TextureBuffer &&other) noexcept;
+
+        TextureBuffer &operator=(const TextureBuffer &other) = delete;
+        TextureBuffer &operator=(TextureBuffer &&other) noexcept;
+
+        /**
+         * @brief Clears the texture buffer.
+         */
+        void Clear() const;
+
+        /**
+         * @brief Replaces the buffer contents.
+         * @param data The texels to copy from.
+         * @param size The size in bytes.
+         * @return true if successful; false otherwise.
+         */
+        bool SetData(const void *data, usize size) const;
+
+        /**
+         * @brief Binds the texture buffer to the active texture unit.
+         * @return true if successful; false otherwise.
+         */
+        bool Bind() const;
+
+        /**
+         * @brief Unbinds a texture buffer from the active texture unit.
+         */
+        static void Unbind();
+
+        [[nodiscard]] u32                 GlId() const;
+        [[nodiscard]] TextureBufferFormat Format() const;
+    };
+}
+
+#endif //FLK_TEXTUREBUFFER_HPP
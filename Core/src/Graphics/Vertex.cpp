@@ -0,0 +1,259 @@
+#include "Vertex.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <cstddef>
+
+namespace Flock::Graphics {
+    namespace {
+        constexpr f32 s_SignStep = 1.0F / 32767.0F;
+
+        i16 ToSnorm16(const f32 value) {
+            return static_cast<i16>(std::round(std::clamp(value, -1.0F, 1.0F) * 32767.0F));
+        }
+
+        u16 ToUnorm16(const f32 value) {
+            return static_cast<u16>(std::round(std::clamp(value, 0.0F, 1.0F) * 65535.0F));
+        }
+
+        struct EncodedFrame {
+            std::array<i16, 2> normal;
+            std::array<i16, 2> tangent;
+            std::array<u16, 2> texCoords;
+        };
+
+        EncodedFrame EncodeFrame(const Vertex &vertex) {
+            const Vector2f normal  = OctEncode(vertex.normal);
+            const Vector2f tangent = OctEncode(vertex.tangent);
+            const f32      sign    = vertex.normal.Cross(vertex.tangent).Dot(vertex.bitangent) < 0.0F ? -1.0F : 1.0F;
+
+            // Never 0, so the sign survives the trip through snorm16.
+            const f32 signedY = sign * ((0.5F + 0.5F * tangent.y) * (1.0F - s_SignStep) + s_SignStep);
+
+            return {
+                .normal    = {ToSnorm16(normal.x), ToSnorm16(normal.y)},
+                .tangent   = {ToSnorm16(tangent.x), ToSnorm16(signedY)},
+                .texCoords = {ToHalf(vertex.texCoords.x), ToHalf(vertex.texCoords.y)},
+            };
+        }
+
+        struct Bounds {
+            Vector3f min;
+            Vector3f max;
+        };
+
+        Bounds ComputeBounds(const std::vector<Vertex> &vertices) {
+            Vector3f min = vertices.empty() ? Vector3f{} : vertices[0].position;
+            Vector3f max = min;
+            for (const auto &vertex: vertices) {
+                min = {std::min(min.x, vertex.position.x), std::min(min.y, vertex.position.y), std::min(min.z, vertex.position.z)};
+                max = {std::max(max.x, vertex.position.x), std::max(max.y, vertex.position.y), std::max(max.z, vertex.position.z)};
+            }
+
+            return {min, max};
+        }
+
+        struct Quantization {
+            Vector3f min;
+            Vector3f extent;
+        };
+
+        Quantization ComputeQuantization(const std::vector<Vertex> &vertices) {
+            const auto [min, max] = ComputeBounds(vertices);
+
+            // Flat axes keep a unit extent so the division stays finite.
+            Vector3f extent = max - min;
+            extent.x        = extent.x > 0.0F ? extent.x : 1.0F;
+            extent.y        = extent.y > 0.0F ? extent.y : 1.0F;
+            extent.z        = extent.z > 0.0F ? extent.z : 1.0F;
+
+            return {min, extent};
+        }
+
+        std::array<u16, 4> Quantize(const Vector3f &position, const Quantization &quantization) {
+            const Vector3f unit = (position - quantization.min) / quantization.extent;
+            return {ToUnorm16(unit.x), ToUnorm16(unit.y), ToUnorm16(unit.z), 0};
+        }
+    }
+
+    VertexLayout PackedVertex::Layout() {
+        return VertexLayout{}
+                .Add(3, AttribType::F32, 0, offsetof(PackedVertex, position))
+                .Add(2, AttribType::I16, 1, offsetof(PackedVertex, normal), true)
+                .Add(2, AttribType::F16, 2, offsetof(PackedVertex, texCoords))
+                .Add(2, AttribType::I16, 3, offsetof(PackedVertex, tangent), true);
+    }
+
+    VertexLayout QuantizedVertex::Layout() {
+        return VertexLayout{}
+                .Add(3, AttribType::U16, 0, offsetof(QuantizedVertex, position), true)
+                .Add(2, AttribType::I16, 1, offsetof(QuantizedVertex, normal), true)
+                .Add(2, AttribType::F16, 2, offsetof(QuantizedVertex, texCoords))
+                .Add(2, AttribType::I16, 3, offsetof(QuantizedVertex, tangent), true);
+    }
+
+    u16 ToHalf(const f32 value) {
+        const u32 bits     = std::bit_cast<u32>(value);
+        const u32 sign     = (bits >> 16) & 0x8000;
+        const i32 exponent = static_cast<i32>((bits >> 23) & 0xFF) - 127 + 15;
+        u32       mantissa = bits & 0x7FFFFF;
+
+        if (((bits >> 23) & 0xFF) == 0xFF) {
+            return sign | 0x7C00 | (mantissa ? 0x200 : 0);
+        }
+
+        if (exponent >= 31) {
+            return sign | 0x7C00;
+        }
+
+        if (exponent <= 0) {
+            if (exponent < -10) {
+                return sign;
+            }
+
+            // Subnormal, round to nearest even on the bits shifted out.
+            mantissa        |= 0x800000;
+            const u32 shift = 14 - exponent;
+            u32       half  = mantissa >> shift;
+            const u32 rest  = mantissa & ((1U << shift) - 1);
+            const u32 mid   = 1U << (shift - 1);
+            if (rest > mid || (rest == mid && (half & 1))) {
+                half++;
+            }
+
+            return sign | half;
+        }
+
+        u32 half = sign | (exponent << 10) | (mantissa >> 13);
+
+        // Rounding can carry into the exponent, which correctly rounds up to the next power of two or infinity.
+        const u32 rest = mantissa & 0x1FFF;
+        if (rest > 0x1000 || (rest == 0x1000 && (half & 1))) {
+            half++;
+        }
+
+        return half;
+    }
+
+    f32 FromHalf(const u16 value) {
+        const u32 sign     = (value & 0x8000) << 16;
+        const u32 exponent = (value >> 10) & 0x1F;
+        const u32 mantissa = value & 0x3FF;
+
+        if (exponent == 0) {
+            const f32 magnitude = std::ldexp(static_cast<f32>(mantissa), -24);
+            return sign ? -magnitude : magnitude;
+        }
+
+        if (exponent == 31) {
+            return std::bit_cast<f32>(sign | 0x7F800000 | (mantissa << 13));
+        }
+
+        return std::bit_cast<f32>(sign | ((exponent + 127 - 15) << 23) | (mantissa << 13));
+    }
+
+    Vector2f OctEncode(const Vector3f direction) {
+        const f32 sum = std::abs(direction.x) + std::abs(direction.y) + std::abs(direction.z);
+        if (sum == 0.0F) {
+            return {};
+        }
+
+        Vector2f encoded = {direction.x / sum, direction.y / sum};
+        if (direction.z < 0.0F) {
+            encoded = {
+                (1.0F - std::abs(encoded.y)) * (encoded.x >= 0.0F ? 1.0F : -1.0F),
+                (1.0F - std::abs(encoded.x)) * (encoded.y >= 0.0F ? 1.0F : -1.0F)
+            };
+        }
+
+        return encoded;
+    }
+
+    Vector3f OctDecode(const Vector2f encoded) {
+        Vector3f  direction = {encoded.x, encoded.y, 1.0F - std::abs(encoded.x) - std::abs(encoded.y)};
+        const f32 fold      = std::max(-direction.z, 0.0F);
+
+        direction.x += direction.x >= 0.0F ? -fold : fold;
+        direction.y += direction.y >= 0.0F ? -fold : fold;
+
+        return direction.Normalized();
+    }
+
+    VertexFormat ChooseVertexFormat(const std::vector<Vertex> &vertices, const PackingConfig &config) {
+        if (!config.enabled || vertices.empty()) {
+            return VertexFormat::Standard;
+        }
+
+        const auto [min, max] = ComputeBounds(vertices);
+
+        // Rounding is off by at most half a step per axis.
+        const Vector3f extent = max - min;
+        const f32      error  = static_cast<f32>(extent.Magnitude()) / 65535.0F * 0.5F;
+
+        return error <= config.maxPositionError ? VertexFormat::Quantized : VertexFormat::Packed;
+    }
+
+    PackedVertices PackVertices(const std::vector<Vertex> &vertices, const VertexFormat format) {
+        switch (format) {
+            case VertexFormat::Packed: {
+                std::vector<PackedVertex> packed;
+                packed.reserve(vertices.size());
+
+                for (const auto &vertex: vertices) {
+                    const auto [normal, tangent, texCoords] = EncodeFrame(vertex);
+                    packed.push_back({vertex.position, normal, tangent, texCoords});
+                }
+
+                return {.data = packed, .layout = PackedVertex::Layout()};
+            }
+            case VertexFormat::Quantized: {
+                const Quantization quantization = ComputeQuantization(vertices);
+
+                std::vector<QuantizedVertex> quantized;
+                quantized.reserve(vertices.size());
+
+                for (const auto &vertex: vertices) {
+                    const auto [normal, tangent, texCoords] = EncodeFrame(vertex);
+                    quantized.push_back({Quantize(vertex.position, quantization), normal, tangent, texCoords});
+                }
+
+                return {
+                    .data       = quantized,
+                    .layout     = QuantizedVertex::Layout(),
+                    .dequantize = Matrix4f::Scale(quantization.extent) * Matrix4f::Translate(quantization.min)
+                };
+            }
+            default:
+                return {.data = vertices, .layout = Vertex::Layout()};
+        }
+    }
+
+    PackedVertices PackPositions(const std::vector<Vertex> &vertices, const VertexFormat format) {
+        if (format == VertexFormat::Quantized) {
+            const Quantization quantization = ComputeQuantization(vertices);
+
+            std::vector<std::array<u16, 4>> positions;
+            positions.reserve(vertices.size());
+
+            for (const auto &vertex: vertices) {
+                positions.push_back(Quantize(vertex.position, quantization));
+            }
+
+            return {
+                .data       = positions,
+                .layout     = VertexLayout{}.Add(4, AttribType::U16, 0, 0, true), // The padding keeps the stride at 8 bytes.
+                .dequantize = Matrix4f::Scale(quantization.extent) * Matrix4f::Translate(quantization.min)
+            };
+        }
+
+        std::vector<Vector3f> positions;
+        positions.reserve(vertices.size());
+
+        for (const auto &vertex: vertices) {
+            positions.push_back(vertex.position);
+        }
+
+        return {.data = positions, .layout = VertexLayout{}.Add(3, AttribType::F32)};
+    }
+}
@@ -1,9 +1,14 @@
 #ifndef FLK_VERTEX_HPP
 #define FLK_VERTEX_HPP
 
+#include <array>
+#include <vector>
+
 #include "Common.hpp"
 #include "VertexLayout.hpp"
+#include "Math/Matrix.hpp"
 #include "Math/Vector.hpp"
+#include "Memory/Buffer.hpp"
 
 namespace Flock::Graphics {
     struct FLK_API Vertex {
@@ -24,6 +29,80 @@ namespace Flock::Graphics {
     };
 
     FLK_ARCHIVE(Vertex, position, normal, texCoords, tangent, bitangent)
+
+    /**
+     * @enum VertexFormat
+     * @brief How a mesh stores its vertices on the GPU.
+     *
+     * Packed formats store the normal and tangent octahedral-encoded in two snorm16 each, the shader rebuilds them
+     * with octDecode() when uPackedVertices is set. The bitangent is dropped, its sign is folded into the tangent's
+     * second component: sign * (0.5 + 0.5 * y) * (1 - 1 / 32767) + 1 / 32767.
+     */
+    enum class VertexFormat : u8 {
+        Standard,  // Vertex, 56 bytes.
+        Packed,    // PackedVertex, 24 bytes.
+        Quantized, // QuantizedVertex, 20 bytes. Positions are unorm16 in the mesh bounds, mapped back by uDequantize.
+    };
+
+    struct PackedVertex {
+        Vector3f           position;
+        std::array<i16, 2> normal;
+        std::array<i16, 2> tangent;
+        std::array<u16, 2> texCoords;
+
+        static VertexLayout Layout();
+    };
+
+    struct QuantizedVertex {
+        std::array<u16, 4> position; // The last component is padding.
+        std::array<i16, 2> normal;
+        std::array<i16, 2> tangent;
+        std::array<u16, 2> texCoords;
+
+        static VertexLayout Layout();
+    };
+
+    /**
+     * @struct PackingConfig
+     * @brief Opts loaded meshes into packed vertex formats, every pipeline drawing them has to decode them, see
+     * VertexFormat.
+     */
+    struct PackingConfig {
+        bool enabled          = false;
+        f32  maxPositionError = 0.0005F; // Meshes quantize their positions if it costs at most this much in model units.
+    };
+
+    /**
+     * @struct PackedVertices
+     * @brief Vertices encoded in a VertexFormat, ready for upload.
+     */
+    struct PackedVertices {
+        Memory::Buffer data;
+        VertexLayout   layout;
+        Matrix4f       dequantize = {}; // Maps stored positions back to model space, identity unless quantized.
+    };
+
+    FLK_API u16 ToHalf(f32 value);
+    FLK_API f32 FromHalf(u16 value);
+
+    FLK_API Vector2f OctEncode(Vector3f direction);
+    FLK_API Vector3f OctDecode(Vector2f encoded);
+
+    /**
+     * @brief Picks the smallest format that keeps positions within the configured error.
+     */
+    FLK_API VertexFormat ChooseVertexFormat(const std::vector<Vertex> &vertices, const PackingConfig &config);
+
+    /**
+     * @brief Encodes vertices into a format.
+     */
+    FLK_API PackedVertices PackVertices(const std::vector<Vertex> &vertices, VertexFormat format);
+
+    /**
+     * @brief Extracts the positions alone, for depth-only passes. Quantized meshes keep their quantized positions
+     * and share the dequantize matrix, other formats store them as three floats.
+     */
+    FLK_API PackedVertices PackPositions(const std::vector<Vertex> &vertices, VertexFormat format);
 }
 
 #endif //FLK_VERTEX_HPP
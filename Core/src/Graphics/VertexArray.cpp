@@ -2,6 +2,7 @@
 
 #include "Gl.hpp"
 #include "Graphics/Buffer.hpp"
+#include "Graphics/StateCache.hpp"
 #include "Graphics/VertexLayout.hpp"
 #include "glad/glad.h"
 
@@ -44,6 +45,7 @@ namespace Flock::Graphics {
             return;
         }
 
+        StateCache::ForgetVertexArray(m_Id);
         FLK_GL_CALL(glDeleteVertexArrays(1, &m_Id));
     }
 
@@ -52,12 +54,12 @@ namespace Flock::Graphics {
             return false;
         }
 
-        FLK_GL_CALL(glBindVertexArray(m_Id));
+        StateCache::BindVertexArray(m_Id);
         return true;
     }
 
     void VertexArray::Unbind() {
-        FLK_GL_CALL(glBindVertexArray(0));
+        StateCache::BindVertexArray(0);
     }
 
     bool VertexArray::SetVertexBuffer(const Buffer &buffer, const VertexLayout &layout) {
@@ -65,17 +67,18 @@ namespace Flock::Graphics {
             return false;
         }
 
-        i32 boundVertArr;
-        FLK_GL_CALL(glGetIntegerv(GL_VERTEX_ARRAY_BINDING, &boundVertArr));
+        const u32 bound    = StateCache::VertexArray();
+        const u32 previous = bound == StateCache::s_Unknown ? 0 : bound;
 
-        FLK_GL_CALL(glBindVertexArray(m_Id));
+        StateCache::BindVertexArray(m_Id);
         if (!buffer.Bind()) {
+            StateCache::BindVertexArray(previous);
             return false;
         }
 
         layout.Bind();
 
-        FLK_GL_CALL(glBindVertexArray(boundVertArr));
+        StateCache::BindVertexArray(previous);
         m_VertexSet = true;
         return true;
     }
@@ -85,15 +88,16 @@ namespace Flock::Graphics {
             return false;
         }
 
-        i32 boundVertArr;
-        FLK_GL_CALL(glGetIntegerv(GL_VERTEX_ARRAY_BINDING, &boundVertArr));
+        const u32 bound    = StateCache::VertexArray();
+        const u32 previous = bound == StateCache::s_Unknown ? 0 : bound;
 
-        FLK_GL_CALL(glBindVertexArray(m_Id));
+        StateCache::BindVertexArray(m_Id);
         if (!buffer.Bind()) {
+            StateCache::BindVertexArray(previous);
             return false;
         }
 
-        FLK_GL_CALL(glBindVertexArray(boundVertArr));
+        StateCache::BindVertexArray(previous);
         m_IndexSet = true;
         return true;
     }
@@ -16,12 +16,21 @@ namespace Flock::Graphics {
             case AttribType::I8:
                 size = sizeof(char);
                 break;
+            case AttribType::U16:
+                size = sizeof(u16);
+                break;
+            case AttribType::I16:
+                size = sizeof(i16);
+                break;
             case AttribType::U32:
                 size = sizeof(u32);
                 break;
             case AttribType::I32:
                 size = sizeof(i32);
                 break;
+            case AttribType::F16:
+                size = sizeof(u16);
+                break;
             case AttribType::F32:
                 size = sizeof(f32);
                 break;
@@ -42,12 +51,21 @@ namespace Flock::Graphics {
             case AttribType::I8:
                 glType = GL_BYTE;
                 break;
+            case AttribType::U16:
+                glType = GL_UNSIGNED_SHORT;
+                break;
+            case AttribType::I16:
+                glType = GL_SHORT;
+                break;
             case AttribType::U32:
                 glType = GL_UNSIGNED_INT;
                 break;
             case AttribType::I32:
                 glType = GL_INT;
                 break;
+            case AttribType::F16:
+                glType = GL_HALF_FLOAT;
+                break;
             case AttribType::F32:
                 glType = GL_FLOAT;
                 break;
@@ -83,6 +101,10 @@ namespace Flock::Graphics {
         return *this;
     }
 
+    usize VertexLayout::Stride() const {
+        return m_Stride;
+    }
+
     void VertexLayout::Bind() const {
         for (const auto &[offset, index, count, type, normalized]: m_Elements) {
             const void *offsetPtr = reinterpret_cast<void *>(offset);
@@ -13,8 +13,11 @@ namespace Flock::Graphics {
     enum class AttribType : u8 {
         U8,
         I8,
+        U16,
+        I16,
         U32,
         I32,
+        F16,
         F32
     };
 
@@ -58,6 +61,8 @@ namespace Flock::Graphics {
          */
         VertexLayout &Add(u32 count, AttribType type, u32 index, usize offset, bool normalized = false);
 
+        [[nodiscard]] usize Stride() const;
+
         /**
          * @brief Binds the vertex layout to the currently bound Vertex Array.
          */
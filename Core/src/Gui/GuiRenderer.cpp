@@ -1,8 +1,10 @@
 #include "GuiRenderer.hpp"
 
 #include <functional>
+#include <variant>
 
 #include "Nvg.hpp"
+#include "Graphics/StateCache.hpp"
 #include "Graphics/Texture.hpp"
 #include "Debug/Log.hpp"
 #include "Gui/Font.hpp"
@@ -16,6 +18,9 @@ namespace Flock::Gui {
         GuiRenderer renderer;
         renderer.m_Ctx = nvgCreateGL3(NVG_ANTIALIAS | NVG_STENCIL_STROKES);
 
+        // nanovg binds GL objects without going through the state cache.
+        Graphics::StateCache::Invalidate();
+
         return renderer;
     }
 
@@ -47,6 +52,7 @@ namespace Flock::Gui {
         }
 
         nvgDeleteGL3(m_Ctx);
+        Graphics::StateCache::Invalidate();
     }
 
     bool GuiRenderer::BeginFrame(const Vector2u screenSize, const u32 pixelRatio) const {
@@ -64,9 +70,40 @@ namespace Flock::Gui {
         }
 
         nvgEndFrame(m_Ctx);
+        Graphics::StateCache::Invalidate();
+
         return true;
     }
 
+    bool GuiRenderer::Render(const GuiList &commands, const Vector2u screenSize) const {
+        if (!BeginFrame(screenSize)) {
+            return false;
+        }
+
+        bool success = true;
+        for (const auto &command: commands) {
+            if (const auto *rect = std::get_if<GuiRect>(&command)) {
+                success &= RenderRect(rect->transform, rect->color);
+            } else if (const auto *image = std::get_if<GuiImage>(&command)) {
+                success &= image->texture ? RenderImage(image->transform, *image->texture, image->uv) : RenderRect(image->transform, Color4u8::White());
+            } else if (const auto *button = std::get_if<GuiButton>(&command)) {
+                success &= RenderButton(button->transform, button->color, button->tint, button->texture);
+            } else if (const auto *text = std::get_if<GuiText>(&command); text && text->font) {
+                success &= RenderText(
+                    text->content,
+                    text->fontSize,
+                    *text->font,
+                    text->transform,
+                    text->color,
+                    text->horizontalAlignment,
+                    text->verticalAlignment
+                );
+            }
+        }
+
+        return EndFrame() && success;
+    }
+
     bool GuiRenderer::RenderText(
         const std::string & text,
         const u32           fontSize,
@@ -168,7 +205,7 @@ namespace Flock::Gui {
         return true;
     }
 
-    bool GuiRenderer::RenderImage(RectTransform transform, const Graphics::Texture &texture) const {
+    bool GuiRenderer::RenderImage(RectTransform transform, const Graphics::Texture &texture, const Rect2f uv) const {
         if (!m_Ctx) {
             return false;
         }
@@ -178,8 +215,15 @@ namespace Flock::Gui {
 
         auto [tw, th] = texture.Size();
 
+        // The pattern spans the whole texture, placed so that the uv rect lands on the transform. Flipped, like
+        // the texture.
+        const f32 patternW = static_cast<f32>(w) / uv.aspect.x;
+        const f32 patternH = static_cast<f32>(h) / uv.aspect.y;
+        const f32 patternX = static_cast<f32>(x) - uv.origin.x * patternW;
+        const f32 patternY = static_cast<f32>(y + h) + uv.origin.y * patternH;
+
         const i32      img = nvglCreateImageFromHandleGL3(m_Ctx, texture.GlId(), tw, th, 0);
-        const NVGpaint p   = nvgImagePattern(m_Ctx, x, y + h, w, -h, 0, img, 1.0F);
+        const NVGpaint p   = nvgImagePattern(m_Ctx, patternX, patternY, patternW, -patternH, 0, img, 1.0F);
 
         nvgBeginPath(m_Ctx);
         nvgRect(m_Ctx, x, y, w, h);
@@ -3,6 +3,8 @@
 
 #include <optional>
 #include <string>
+#include <variant>
+#include <vector>
 
 #include "Common.hpp"
 #include "Font.hpp"
@@ -26,6 +28,37 @@ namespace Flock {
 }     // namespace Flock
 
 namespace Flock::Gui {
+    struct GuiRect {
+        RectTransform transform = {};
+        Color4u8      color     = Color4u8::Black();
+    };
+
+    struct GuiImage {
+        RectTransform            transform = {};
+        const Graphics::Texture *texture   = nullptr;
+        Rect2f                   uv        = {{0.0F, 0.0F}, {1.0F, 1.0F}}; // The part of the texture shown.
+    };
+
+    struct GuiButton {
+        RectTransform            transform = {};
+        Color4u8                 color     = Color4u8::Black();
+        Color4u8                 tint      = Color4u8::Transparent();
+        const Graphics::Texture *texture   = nullptr;
+    };
+
+    struct GuiText {
+        std::string   content             = {};
+        u32           fontSize            = 16;
+        const Font *  font                = nullptr;
+        RectTransform transform           = {};
+        Color4u8      color               = Color4u8::White();
+        AlignmentH    horizontalAlignment = Left;
+        AlignmentV    verticalAlignment   = Top;
+    };
+
+    using GuiCommand = std::variant<GuiRect, GuiImage, GuiButton, GuiText>;
+    using GuiList    = std::vector<GuiCommand>;
+
     class FLK_API GuiRenderer {
         NVGcontext *m_Ctx = nullptr;
 
@@ -46,6 +79,14 @@ namespace Flock::Gui {
         bool BeginFrame(Vector2u screenSize, u32 pixelRatio = 1) const;
         bool EndFrame() const;
 
+        /**
+         * @brief Renders a recorded list of commands as one frame.
+         * @param commands The commands, drawn in order.
+         * @param screenSize The screen size.
+         * @return true if all commands rendered; false otherwise.
+         */
+        bool Render(const GuiList &commands, Vector2u screenSize) const;
+
         bool RenderText(
             const std::string &text,
             u32                fontSize,
@@ -70,7 +111,8 @@ namespace Flock::Gui {
 
         bool RenderImage(
             RectTransform            transform,
-            const Graphics::Texture &texture
+            const Graphics::Texture &texture,
+            Rect2f                   uv = {{0.0F, 0.0F}, {1.0F, 1.0F}}
         ) const;
     };
 }
@@ -7,9 +7,10 @@
 namespace Flock::Gui {
     struct FLK_API Image {
         std::string imagePath;
+        u32         region = FLK_INVALID; // A region of the atlas at imagePath, the whole image if FLK_INVALID.
     };
 
-    FLK_ARCHIVE(Image, imagePath)
+    FLK_ARCHIVE(Image, imagePath, region)
 }
 
 #endif //FLK_GUI_IMAGE_HPP
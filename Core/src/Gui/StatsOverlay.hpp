@@ -0,0 +1,30 @@
+#ifndef FLK_STATSOVERLAY_HPP
+#define FLK_STATSOVERLAY_HPP
+
+#include "Common.hpp"
+#include "Font.hpp"
+#include "Asset/AssetHandle.hpp"
+#include "Math/Color.hpp"
+#include "Math/Vector.hpp"
+#include "Serial/Archive.hpp"
+
+namespace Flock::Gui {
+    /**
+     * @struct StatsOverlay
+     * @brief A resource that shows the Graphics::RenderStats and Debug::FrameProfile of the last frame on top of
+     * the GUI.
+     */
+    struct FLK_API StatsOverlay {
+        bool                     visible    = false;
+        Asset::AssetHandle<Font> font       = {};
+        u32                      fontSize   = 14;
+        Vector2i                 position   = {8, 8};
+        Color4u8                 color      = Color4u8::White();
+        Color4u8                 background = {0, 0, 0, 160};
+        u32                      cpuScopes  = 5; // The most expensive profiled scopes listed.
+    };
+
+    FLK_ARCHIVE(StatsOverlay, visible, font, fontSize, position, color, background, cpuScopes)
+}
+
+#endif //FLK_STATSOVERLAY_HPP
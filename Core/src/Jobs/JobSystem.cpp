@@ -0,0 +1,156 @@
+#include "JobSystem.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "Debug/Profiler.hpp"
+
+namespace Flock::Jobs {
+    namespace {
+        struct Batch {
+            const RangeJob *   job       = nullptr;
+            usize              count     = 0;
+            usize              grainSize = 1;
+            usize              chunks    = 0;
+            std::atomic<usize> next      = 0;
+            std::atomic<usize> done      = 0;
+
+            std::mutex              mutex;
+            std::condition_variable finished;
+
+            // Runs chunks until none are left, returns once this thread has nothing more to take.
+            void Work() {
+                for (usize chunk = next++; chunk < chunks; chunk = next++) {
+                    const usize begin = chunk * grainSize;
+                    const usize end   = std::min(begin + grainSize, count);
+
+                    (*job)(begin, end);
+
+                    if (++done == chunks) {
+                        std::lock_guard lock(mutex);
+                        finished.notify_all();
+                    }
+                }
+            }
+        };
+
+        class WorkerPool {
+            std::vector<std::thread>           m_Threads;
+            std::deque<std::shared_ptr<Batch>> m_Queue;
+            std::mutex                         m_Mutex;
+            std::condition_variable            m_Wake;
+            bool                               m_Stop = false;
+
+        public:
+            WorkerPool() {
+                const usize hardware = std::thread::hardware_concurrency();
+                const usize workers  = hardware > 1 ? hardware - 1 : 0;
+
+                for (usize i = 0; i < workers; i++) {
+                    m_Threads.emplace_back([this, i] {
+                        Debug::Profiler::SetThreadName("Worker " + std::to_string(i));
+                        Loop();
+                    });
+                }
+            }
+
+            ~WorkerPool() {
+                {
+                    std::lock_guard lock(m_Mutex);
+                    m_Stop = true;
+                }
+
+                m_Wake.notify_all();
+                for (auto &thread: m_Threads) {
+                    thread.join();
+                }
+            }
+
+            WorkerPool(const WorkerPool &)            = delete;
+            WorkerPool &operator=(const WorkerPool &) = delete;
+
+            [[nodiscard]] usize Size() const {
+                return m_Threads.size();
+            }
+
+            void Submit(const std::shared_ptr<Batch> &batch, const usize helpers) {
+                {
+                    std::lock_guard lock(m_Mutex);
+                    for (usize i = 0; i < helpers; i++) {
+                        m_Queue.push_back(batch);
+                    }
+                }
+
+                if (helpers == 1) {
+                    m_Wake.notify_one();
+                } else {
+                    m_Wake.notify_all();
+                }
+            }
+
+        private:
+            void Loop() {
+                while (true) {
+                    std::shared_ptr<Batch> batch;
+
+                    {
+                        std::unique_lock lock(m_Mutex);
+                        m_Wake.wait(lock, [this] { return m_Stop || !m_Queue.empty(); });
+
+                        if (m_Stop && m_Queue.empty()) {
+                            return;
+                        }
+
+                        batch = std::move(m_Queue.front());
+                        m_Queue.pop_front();
+                    }
+
+                    FLK_PROFILE_SCOPE("Job batch");
+                    batch->Work();
+                }
+            }
+        };
+
+        WorkerPool &Pool() {
+            static WorkerPool pool;
+            return pool;
+        }
+    }
+
+    usize WorkerCount() {
+        return Pool().Size();
+    }
+
+    void ParallelFor(const usize count, const usize grainSize, const RangeJob &job) {
+        if (count == 0) {
+            return;
+        }
+
+        const usize grain  = std::max<usize>(grainSize, 1);
+        const usize chunks = (count + grain - 1) / grain;
+
+        if (chunks == 1 || WorkerCount() == 0) {
+            job(0, count);
+            return;
+        }
+
+        const auto batch = std::make_shared<Batch>();
+        batch->job       = &job;
+        batch->count     = count;
+        batch->grainSize = grain;
+        batch->chunks    = chunks;
+
+        Pool().Submit(batch, std::min(chunks - 1, WorkerCount()));
+        batch->Work();
+
+        std::unique_lock lock(batch->mutex);
+        batch->finished.wait(lock, [&] { return batch->done == batch->chunks; });
+    }
+}
@@ -0,0 +1,33 @@
+#ifndef FLK_JOBSYSTEM_HPP
+#define FLK_JOBSYSTEM_HPP
+
+#include <functional>
+
+#include "Common.hpp"
+
+namespace Flock::Jobs {
+    /**
+     * @brief A job over the index range [begin, end).
+     */
+    using RangeJob = std::function<void(usize begin, usize end)>;
+
+    /**
+     * @brief Gets the number of background worker threads.
+     * @return The worker count; 0 if jobs run on the calling thread only.
+     */
+    FLK_API usize WorkerCount();
+
+    /**
+     * @brief Splits [0, count) into chunks and runs them on the worker pool.
+     *
+     * The calling thread takes part in the work and returns once every chunk has finished,
+     * so nested calls from inside a job are safe.
+     *
+     * @param count The number of items.
+     * @param grainSize The number of items per chunk.
+     * @param job The job to run for each chunk.
+     */
+    FLK_API void ParallelFor(usize count, usize grainSize, const RangeJob &job);
+}
+
+#endif //FLK_JOBSYSTEM_HPP
@@ -3,9 +3,11 @@
 
 #include <array>
 #include <cmath>
+#include <concepts>
 
 #include "Utils.hpp"
 #include "Quaternion.hpp"
+#include "Simd.hpp"
 #include "Vector.hpp"
 
 namespace Flock {
@@ -14,6 +16,19 @@ namespace Flock {
     private:
         std::array<T, 4 * 4> m;
 
+        Vector3<T> Apply(const Vector3<T> &v, const T w) const {
+            const T in[3] = {v.x, v.y, v.z};
+            T       out[3];
+
+            if constexpr (std::same_as<T, f32>) {
+                Simd::Transform(m.data(), in, w, out);
+            } else {
+                Simd::Kernels::Transform<Simd::ScalarOps<T> >(m.data(), in, w, out);
+            }
+
+            return {out[0], out[1], out[2]};
+        }
+
     public:
         Matrix4() { m = {1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1}; }
 
@@ -31,25 +46,61 @@ namespace Flock {
 
         const T *Data() const { return m.data(); }
 
-        Matrix4 operator*(const Matrix4 &other) {
+        Matrix4 operator*(const Matrix4 &other) const {
             // C[i][j] = Σ(k=0 to n-1) A[i][k] * B[k][j]
 
             Matrix4 mat;
 
-            for (size_t i = 0; i < 4; i++) {
-                for (size_t j = 0; j < 4; j++) {
-                    T sum = 0;
-                    for (size_t k = 0; k < 4; k++) {
-                        sum += At(i, k) * other.At(k, j);
-                    }
+            if constexpr (std::same_as<T, f32>) {
+                Simd::Multiply(m.data(), other.m.data(), mat.m.data());
+            } else {
+                Simd::Kernels::Multiply<Simd::ScalarOps<T> >(m.data(), other.m.data(), mat.m.data());
+            }
+
+            return mat;
+        }
+
+        [[nodiscard]] Matrix4 Transposed() const {
+            Matrix4 mat;
+
+            if constexpr (std::same_as<T, f32>) {
+                Simd::Transpose(m.data(), mat.m.data());
+            } else {
+                Simd::Kernels::Transpose<Simd::ScalarOps<T> >(m.data(), mat.m.data());
+            }
+
+            return mat;
+        }
+
+        /**
+         * @return The inverse matrix, undefined if the matrix is singular.
+         */
+        [[nodiscard]] Matrix4 Inverse() const {
+            Matrix4 mat;
 
-                    mat.At(i, j) = sum;
-                }
+            if constexpr (std::same_as<T, f32>) {
+                Simd::Inverse(m.data(), mat.m.data());
+            } else {
+                Simd::Kernels::Inverse<Simd::ScalarOps<T> >(m.data(), mat.m.data());
             }
 
             return mat;
         }
 
+        /**
+         * @brief Transforms a point, as the row vector (x, y, z, 1). No perspective divide.
+         */
+        [[nodiscard]] Vector3<T> TransformPoint(const Vector3<T> &point) const {
+            return Apply(point, 1);
+        }
+
+        /**
+         * @brief Transforms a direction, as the row vector (x, y, z, 0), so translation is ignored.
+         */
+        [[nodiscard]] Vector3<T> TransformDirection(const Vector3<T> &direction) const {
+            return Apply(direction, 0);
+        }
+
         static Matrix4 Translate(const Vector3<T> &t) {
             Matrix4 mat;
             mat.m = {
@@ -150,6 +201,35 @@ namespace Flock {
             return mat;
         }
 
+        /**
+         * @brief Builds Scale(scale) * Rotate(rotation) * Translate(translation) directly, without the products.
+         */
+        static Matrix4 Compose(const Vector3<T> &translation, const Quaternion &rotation, const Vector3<T> &scale) {
+            const Quaternion &q = rotation;
+
+            const T ww = q.w * q.w;
+            const T xx = q.x * q.x;
+            const T yy = q.y * q.y;
+            const T zz = q.z * q.z;
+
+            const T xy = q.x * q.y;
+            const T xz = q.x * q.z;
+            const T yz = q.y * q.z;
+            const T wx = q.w * q.x;
+            const T wy = q.w * q.y;
+            const T wz = q.w * q.z;
+
+            Matrix4 mat;
+            mat.m = {
+                scale.x * (2 * (ww + xx) - 1), scale.x * (2 * (xy - wz)), scale.x * (2 * (xz + wy)), 0,
+                scale.y * (2 * (xy + wz)), scale.y * (2 * (ww + yy) - 1), scale.y * (2 * (yz - wx)), 0,
+                scale.z * (2 * (xz - wy)), scale.z * (2 * (yz + wx)), scale.z * (2 * (ww + zz) - 1), 0,
+                translation.x, translation.y, translation.z, 1
+            };
+
+            return mat;
+        }
+
         static Matrix4 LookAt(const Vector3<T> &eye, const Vector3<T> &target, const Vector3<T> &up) {
             Vector3<T> z = (target - eye).Normalized();
             Vector3<T> x = up.Cross(z).Normalized();
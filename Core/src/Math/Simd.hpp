@@ -0,0 +1,366 @@
+#ifndef FLK_SIMD_HPP
+#define FLK_SIMD_HPP
+
+#include <array>
+
+#include "Common.hpp"
+
+// Selected at compile time from the target flags, define FLK_NO_SIMD to force the scalar path.
+#if !defined(FLK_NO_SIMD) && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+#define FLK_SIMD_SSE 1
+#include <immintrin.h>
+#if defined(__AVX__)
+#define FLK_SIMD_AVX 1
+#endif
+#elif !defined(FLK_NO_SIMD) && defined(__ARM_NEON) && defined(__aarch64__)
+#define FLK_SIMD_NEON 1
+#include <arm_neon.h>
+#endif
+
+namespace Flock::Simd {
+    /**
+     * @brief Four lanes emulated with plain arithmetic, the fallback and the reference for the SIMD backends.
+     *
+     * Every backend provides the same operations and the kernels below only use those, so all backends do the
+     * same arithmetic in the same order and produce bit-identical results, as long as nothing is fused into an
+     * FMA. FlockCore passes -ffp-contract=off to itself and everything linking it for that.
+     */
+    template<typename T>
+    struct ScalarOps {
+        using Scalar = T;
+        using Vec    = std::array<T, 4>;
+
+        static constexpr u32 Width = 4;
+
+        static Vec Load(const T *p) { return {p[0], p[1], p[2], p[3]}; }
+
+        static void Store(T *p, const Vec &v) {
+            p[0] = v[0];
+            p[1] = v[1];
+            p[2] = v[2];
+            p[3] = v[3];
+        }
+
+        static Vec Splat(const T s) { return {s, s, s, s}; }
+
+        template<u32 I>
+        static Vec SplatLane(const Vec &v) { return {v[I], v[I], v[I], v[I]}; }
+
+        static Vec Add(const Vec &a, const Vec &b) { return {a[0] + b[0], a[1] + b[1], a[2] + b[2], a[3] + b[3]}; }
+        static Vec Sub(const Vec &a, const Vec &b) { return {a[0] - b[0], a[1] - b[1], a[2] - b[2], a[3] - b[3]}; }
+        static Vec Mul(const Vec &a, const Vec &b) { return {a[0] * b[0], a[1] * b[1], a[2] * b[2], a[3] * b[3]}; }
+        static Vec Div(const Vec &a, const Vec &b) { return {a[0] / b[0], a[1] / b[1], a[2] / b[2], a[3] / b[3]}; }
+
+        // {a[I0], a[I1], b[I2], b[I3]}, like _mm_shuffle_ps.
+        template<u32 I0, u32 I1, u32 I2, u32 I3>
+        static Vec Shuffle(const Vec &a, const Vec &b) { return {a[I0], a[I1], b[I2], b[I3]}; }
+
+        static Vec Min(const Vec &a, const Vec &b) { return Map(a, b, [](const T x, const T y) { return x < y ? x : y; }); }
+        static Vec Max(const Vec &a, const Vec &b) { return Map(a, b, [](const T x, const T y) { return x > y ? x : y; }); }
+
+        // Masks hold 1 in true lanes and 0 otherwise, they are only meant for And(), Select() and Any().
+        static Vec GreaterEqual(const Vec &a, const Vec &b) { return Map(a, b, [](const T x, const T y) { return T(x >= y); }); }
+        static Vec And(const Vec &a, const Vec &b) { return Map(a, b, [](const T x, const T y) { return T(x != 0 && y != 0); }); }
+
+        // a where the mask is set, b elsewhere.
+        static Vec Select(const Vec &mask, const Vec &a, const Vec &b) {
+            return {mask[0] != 0 ? a[0] : b[0], mask[1] != 0 ? a[1] : b[1], mask[2] != 0 ? a[2] : b[2], mask[3] != 0 ? a[3] : b[3]};
+        }
+
+        static bool Any(const Vec &mask) { return mask[0] != 0 || mask[1] != 0 || mask[2] != 0 || mask[3] != 0; }
+
+    private:
+        template<typename Func>
+        static Vec Map(const Vec &a, const Vec &b, Func &&func) { return {func(a[0], b[0]), func(a[1], b[1]), func(a[2], b[2]), func(a[3], b[3])}; }
+    };
+
+#if defined(FLK_SIMD_SSE)
+    struct SseOps {
+        using Scalar = f32;
+        using Vec    = __m128;
+
+        static constexpr u32 Width = 4;
+
+        static Vec  Load(const f32 *p) { return _mm_loadu_ps(p); }
+        static void Store(f32 *p, const Vec v) { _mm_storeu_ps(p, v); }
+        static Vec  Splat(const f32 s) { return _mm_set1_ps(s); }
+
+        template<u32 I>
+        static Vec SplatLane(const Vec v) { return _mm_shuffle_ps(v, v, _MM_SHUFFLE(I, I, I, I)); }
+
+        static Vec Add(const Vec a, const Vec b) { return _mm_add_ps(a, b); }
+        static Vec Sub(const Vec a, const Vec b) { return _mm_sub_ps(a, b); }
+        static Vec Mul(const Vec a, const Vec b) { return _mm_mul_ps(a, b); }
+        static Vec Div(const Vec a, const Vec b) { return _mm_div_ps(a, b); }
+
+        template<u32 I0, u32 I1, u32 I2, u32 I3>
+        static Vec Shuffle(const Vec a, const Vec b) { return _mm_shuffle_ps(a, b, _MM_SHUFFLE(I3, I2, I1, I0)); }
+
+        static Vec Min(const Vec a, const Vec b) { return _mm_min_ps(a, b); }
+        static Vec Max(const Vec a, const Vec b) { return _mm_max_ps(a, b); }
+
+        static Vec GreaterEqual(const Vec a, const Vec b) { return _mm_cmpge_ps(a, b); }
+        static Vec And(const Vec a, const Vec b) { return _mm_and_ps(a, b); }
+        static Vec Select(const Vec mask, const Vec a, const Vec b) { return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b)); }
+        static bool Any(const Vec mask) { return _mm_movemask_ps(mask) != 0; }
+    };
+
+    using NativeOps = SseOps;
+
+#if defined(FLK_SIMD_AVX)
+    // Lane-wise arithmetic only, shuffles work within 128-bit halves and don't match the other backends.
+    struct AvxOps {
+        using Scalar = f32;
+        using Vec    = __m256;
+
+        static constexpr u32 Width = 8;
+
+        static Vec  Load(const f32 *p) { return _mm256_loadu_ps(p); }
+        static void Store(f32 *p, const Vec v) { _mm256_storeu_ps(p, v); }
+        static Vec  Splat(const f32 s) { return _mm256_set1_ps(s); }
+
+        static Vec Add(const Vec a, const Vec b) { return _mm256_add_ps(a, b); }
+        static Vec Sub(const Vec a, const Vec b) { return _mm256_sub_ps(a, b); }
+        static Vec Mul(const Vec a, const Vec b) { return _mm256_mul_ps(a, b); }
+        static Vec Div(const Vec a, const Vec b) { return _mm256_div_ps(a, b); }
+
+        static Vec Min(const Vec a, const Vec b) { return _mm256_min_ps(a, b); }
+        static Vec Max(const Vec a, const Vec b) { return _mm256_max_ps(a, b); }
+
+        static Vec GreaterEqual(const Vec a, const Vec b) { return _mm256_cmp_ps(a, b, _CMP_GE_OQ); }
+        static Vec And(const Vec a, const Vec b) { return _mm256_and_ps(a, b); }
+        static Vec Select(const Vec mask, const Vec a, const Vec b) { return _mm256_blendv_ps(b, a, mask); }
+        static bool Any(const Vec mask) { return _mm256_movemask_ps(mask) != 0; }
+    };
+
+    using WideOps = AvxOps;
+#else
+    using WideOps = SseOps;
+#endif
+#elif defined(FLK_SIMD_NEON)
+    struct NeonOps {
+        using Scalar = f32;
+        using Vec    = float32x4_t;
+
+        static constexpr u32 Width = 4;
+
+        static Vec  Load(const f32 *p) { return vld1q_f32(p); }
+        static void Store(f32 *p, const Vec v) { vst1q_f32(p, v); }
+        static Vec  Splat(const f32 s) { return vdupq_n_f32(s); }
+
+        template<u32 I>
+        static Vec SplatLane(const Vec v) { return vdupq_laneq_f32(v, I); }
+
+        static Vec Add(const Vec a, const Vec b) { return vaddq_f32(a, b); }
+        static Vec Sub(const Vec a, const Vec b) { return vsubq_f32(a, b); }
+        static Vec Mul(const Vec a, const Vec b) { return vmulq_f32(a, b); }
+        static Vec Div(const Vec a, const Vec b) { return vdivq_f32(a, b); }
+
+        template<u32 I0, u32 I1, u32 I2, u32 I3>
+        static Vec Shuffle(const Vec a, const Vec b) {
+#if defined(__clang__)
+            return __builtin_shufflevector(a, b, I0, I1, I2 + 4, I3 + 4);
+#else
+            return __builtin_shuffle(a, b, uint32x4_t{I0, I1, I2 + 4, I3 + 4});
+#endif
+        }
+
+        static Vec Min(const Vec a, const Vec b) { return vminq_f32(a, b); }
+        static Vec Max(const Vec a, const Vec b) { return vmaxq_f32(a, b); }
+
+        static Vec GreaterEqual(const Vec a, const Vec b) { return vreinterpretq_f32_u32(vcgeq_f32(a, b)); }
+        static Vec And(const Vec a, const Vec b) { return vreinterpretq_f32_u32(vandq_u32(vreinterpretq_u32_f32(a), vreinterpretq_u32_f32(b))); }
+        static Vec Select(const Vec mask, const Vec a, const Vec b) { return vbslq_f32(vreinterpretq_u32_f32(mask), a, b); }
+        static bool Any(const Vec mask) { return vmaxvq_u32(vreinterpretq_u32_f32(mask)) != 0; }
+    };
+
+    using NativeOps = NeonOps;
+    using WideOps   = NeonOps;
+#else
+    using NativeOps = ScalarOps<f32>;
+    using WideOps   = ScalarOps<f32>;
+#endif
+
+    /**
+     * Kernels over row-major 4x4 matrices, used with row vectors (v * M).
+     */
+    namespace Kernels {
+        template<typename Ops, typename T = typename Ops::Scalar>
+        void Multiply(const T *a, const T *b, T *out) {
+            const auto b0 = Ops::Load(b);
+            const auto b1 = Ops::Load(b + 4);
+            const auto b2 = Ops::Load(b + 8);
+            const auto b3 = Ops::Load(b + 12);
+
+            for (u32 i = 0; i < 4; i++) {
+                const auto row = Ops::Load(a + i * 4);
+
+                auto sum = Ops::Mul(Ops::template SplatLane<0>(row), b0);
+                sum      = Ops::Add(sum, Ops::Mul(Ops::template SplatLane<1>(row), b1));
+                sum      = Ops::Add(sum, Ops::Mul(Ops::template SplatLane<2>(row), b2));
+                sum      = Ops::Add(sum, Ops::Mul(Ops::template SplatLane<3>(row), b3));
+
+                Ops::Store(out + i * 4, sum);
+            }
+        }
+
+        template<typename Ops, typename T = typename Ops::Scalar>
+        void Transpose(const T *m, T *out) {
+            const auto r0 = Ops::Load(m);
+            const auto r1 = Ops::Load(m + 4);
+            const auto r2 = Ops::Load(m + 8);
+            const auto r3 = Ops::Load(m + 12);
+
+            const auto t0 = Ops::template Shuffle<0, 1, 0, 1>(r0, r1);
+            const auto t1 = Ops::template Shuffle<2, 3, 2, 3>(r0, r1);
+            const auto t2 = Ops::template Shuffle<0, 1, 0, 1>(r2, r3);
+            const auto t3 = Ops::template Shuffle<2, 3, 2, 3>(r2, r3);
+
+            Ops::Store(out, Ops::template Shuffle<0, 2, 0, 2>(t0, t2));
+            Ops::Store(out + 4, Ops::template Shuffle<1, 3, 1, 3>(t0, t2));
+            Ops::Store(out + 8, Ops::template Shuffle<0, 2, 0, 2>(t1, t3));
+            Ops::Store(out + 12, Ops::template Shuffle<1, 3, 1, 3>(t1, t3));
+        }
+
+        // 2x2 blocks packed row-major in one vector: A * B, adj(A) * B and A * adj(B).
+        template<typename Ops, typename V>
+        V Mat2Mul(const V &a, const V &b) {
+            return Ops::Add(
+                Ops::Mul(a, Ops::template Shuffle<0, 3, 0, 3>(b, b)),
+                Ops::Mul(Ops::template Shuffle<1, 0, 3, 2>(a, a), Ops::template Shuffle<2, 1, 2, 1>(b, b))
+            );
+        }
+
+        template<typename Ops, typename V>
+        V Mat2AdjMul(const V &a, const V &b) {
+            return Ops::Sub(
+                Ops::Mul(Ops::template Shuffle<3, 3, 0, 0>(a, a), b),
+                Ops::Mul(Ops::template Shuffle<1, 1, 2, 2>(a, a), Ops::template Shuffle<2, 3, 0, 1>(b, b))
+            );
+        }
+
+        template<typename Ops, typename V>
+        V Mat2MulAdj(const V &a, const V &b) {
+            return Ops::Sub(
+                Ops::Mul(a, Ops::template Shuffle<3, 0, 3, 0>(b, b)),
+                Ops::Mul(Ops::template Shuffle<1, 0, 3, 2>(a, a), Ops::template Shuffle<2, 1, 2, 1>(b, b))
+            );
+        }
+
+        /**
+         * General inverse by 2x2 blocks. Singular matrices produce infinities or NaNs.
+         */
+        template<typename Ops, typename T = typename Ops::Scalar>
+        void Inverse(const T *m, T *out) {
+            const auto r0 = Ops::Load(m);
+            const auto r1 = Ops::Load(m + 4);
+            const auto r2 = Ops::Load(m + 8);
+            const auto r3 = Ops::Load(m + 12);
+
+            // M = | A B |
+            //     | C D |
+            const auto a = Ops::template Shuffle<0, 1, 0, 1>(r0, r1);
+            const auto b = Ops::template Shuffle<2, 3, 2, 3>(r0, r1);
+            const auto c = Ops::template Shuffle<0, 1, 0, 1>(r2, r3);
+            const auto d = Ops::template Shuffle<2, 3, 2, 3>(r2, r3);
+
+            // (|A|, |B|, |C|, |D|)
+            const auto detSub = Ops::Sub(
+                Ops::Mul(Ops::template Shuffle<0, 2, 0, 2>(r0, r2), Ops::template Shuffle<1, 3, 1, 3>(r1, r3)),
+                Ops::Mul(Ops::template Shuffle<1, 3, 1, 3>(r0, r2), Ops::template Shuffle<0, 2, 0, 2>(r1, r3))
+            );
+
+            const auto detA = Ops::template SplatLane<0>(detSub);
+            const auto detB = Ops::template SplatLane<1>(detSub);
+            const auto detC = Ops::template SplatLane<2>(detSub);
+            const auto detD = Ops::template SplatLane<3>(detSub);
+
+            const auto dc = Mat2AdjMul<Ops>(d, c);
+            const auto ab = Mat2AdjMul<Ops>(a, b);
+
+            // The adjugates of the inverse's blocks.
+            auto x = Ops::Sub(Ops::Mul(detD, a), Mat2Mul<Ops>(b, dc));
+            auto w = Ops::Sub(Ops::Mul(detA, d), Mat2Mul<Ops>(c, ab));
+            auto y = Ops::Sub(Ops::Mul(detB, c), Mat2MulAdj<Ops>(d, ab));
+            auto z = Ops::Sub(Ops::Mul(detC, b), Mat2MulAdj<Ops>(a, dc));
+
+            // |M| = |A||D| + |B||C| - tr(adj(A) B adj(D) C)
+            auto detM = Ops::Mul(detA, detD);
+            detM      = Ops::Add(detM, Ops::Mul(detB, detC));
+
+            auto trace = Ops::Mul(ab, Ops::template Shuffle<0, 2, 1, 3>(dc, dc));
+            trace      = Ops::Add(trace, Ops::template Shuffle<1, 0, 3, 2>(trace, trace));
+            trace      = Ops::Add(trace, Ops::template Shuffle<2, 3, 0, 1>(trace, trace));
+            detM       = Ops::Sub(detM, trace);
+
+            const T    signs[4] = {1, -1, -1, 1};
+            const auto rcpDet   = Ops::Div(Ops::Load(signs), detM);
+
+            x = Ops::Mul(x, rcpDet);
+            y = Ops::Mul(y, rcpDet);
+            z = Ops::Mul(z, rcpDet);
+            w = Ops::Mul(w, rcpDet);
+
+            // Undoes the adjugates while writing the rows back.
+            Ops::Store(out, Ops::template Shuffle<3, 1, 3, 1>(x, y));
+            Ops::Store(out + 4, Ops::template Shuffle<2, 0, 2, 0>(x, y));
+            Ops::Store(out + 8, Ops::template Shuffle<3, 1, 3, 1>(z, w));
+            Ops::Store(out + 12, Ops::template Shuffle<2, 0, 2, 0>(z, w));
+        }
+
+        /**
+         * @brief Computes (v, w) * M and writes the first three components.
+         */
+        template<typename Ops, typename T = typename Ops::Scalar>
+        void Transform(const T *m, const T *v, const T w, T *out) {
+            auto sum = Ops::Mul(Ops::Splat(v[0]), Ops::Load(m));
+            sum      = Ops::Add(sum, Ops::Mul(Ops::Splat(v[1]), Ops::Load(m + 4)));
+            sum      = Ops::Add(sum, Ops::Mul(Ops::Splat(v[2]), Ops::Load(m + 8)));
+            sum      = Ops::Add(sum, Ops::Mul(Ops::Splat(w), Ops::Load(m + 12)));
+
+            T result[4];
+            Ops::Store(result, sum);
+
+            out[0] = result[0];
+            out[1] = result[1];
+            out[2] = result[2];
+        }
+    }
+
+    inline void Multiply(const f32 *a, const f32 *b, f32 *out) {
+#if defined(FLK_SIMD_AVX)
+        // Two rows per 256-bit register, the lanes see the same operations as the 128-bit kernel.
+        const __m256 b0 = _mm256_broadcast_ps(reinterpret_cast<const __m128 *>(b));
+        const __m256 b1 = _mm256_broadcast_ps(reinterpret_cast<const __m128 *>(b + 4));
+        const __m256 b2 = _mm256_broadcast_ps(reinterpret_cast<const __m128 *>(b + 8));
+        const __m256 b3 = _mm256_broadcast_ps(reinterpret_cast<const __m128 *>(b + 12));
+
+        for (u32 i = 0; i < 2; i++) {
+            const __m256 rows = _mm256_loadu_ps(a + i * 8);
+
+            __m256 sum = _mm256_mul_ps(_mm256_shuffle_ps(rows, rows, 0x00), b0);
+            sum        = _mm256_add_ps(sum, _mm256_mul_ps(_mm256_shuffle_ps(rows, rows, 0x55), b1));
+            sum        = _mm256_add_ps(sum, _mm256_mul_ps(_mm256_shuffle_ps(rows, rows, 0xAA), b2));
+            sum        = _mm256_add_ps(sum, _mm256_mul_ps(_mm256_shuffle_ps(rows, rows, 0xFF), b3));
+
+            _mm256_storeu_ps(out + i * 8, sum);
+        }
+#else
+        Kernels::Multiply<NativeOps>(a, b, out);
+#endif
+    }
+
+    inline void Transpose(const f32 *m, f32 *out) {
+        Kernels::Transpose<NativeOps>(m, out);
+    }
+
+    inline void Inverse(const f32 *m, f32 *out) {
+        Kernels::Inverse<NativeOps>(m, out);
+    }
+
+    inline void Transform(const f32 *m, const f32 *v, const f32 w, f32 *out) {
+        Kernels::Transform<NativeOps>(m, v, w, out);
+    }
+}
+
+#endif //FLK_SIMD_HPP
@@ -13,7 +13,7 @@ namespace Flock {
         Vector3f   eulerAngles = {};
 
         [[nodiscard]] Matrix4f Matrix() const {
-            return Matrix4f::Scale(scale) * Matrix4f::Rotate(rotation) * Matrix4f::Translate(position);
+            return Matrix4f::Compose(position, rotation, scale);
         }
     };
 
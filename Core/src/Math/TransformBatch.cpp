@@ -0,0 +1,172 @@
+#include "TransformBatch.hpp"
+
+#include <algorithm>
+
+#include "Simd.hpp"
+
+namespace Flock {
+    namespace {
+        using Ops = Simd::WideOps;
+
+        constexpr u32 s_Width = Ops::Width;
+
+        enum Component : u32 {
+            PositionX, PositionY, PositionZ,
+            RotationX, RotationY, RotationZ, RotationW,
+            ScaleX, ScaleY, ScaleZ,
+            ComponentCount
+        };
+
+        // Same arithmetic as Matrix4::Compose(), one transform per lane.
+        void ComposeLanes(const f32 *const components[ComponentCount], Matrix4f *out, const usize count) {
+            const auto two = Ops::Splat(2.0F);
+            const auto one = Ops::Splat(1.0F);
+
+            const auto qx = Ops::Load(components[RotationX]);
+            const auto qy = Ops::Load(components[RotationY]);
+            const auto qz = Ops::Load(components[RotationZ]);
+            const auto qw = Ops::Load(components[RotationW]);
+
+            const auto ww = Ops::Mul(qw, qw);
+            const auto xx = Ops::Mul(qx, qx);
+            const auto yy = Ops::Mul(qy, qy);
+            const auto zz = Ops::Mul(qz, qz);
+
+            const auto xy = Ops::Mul(qx, qy);
+            const auto xz = Ops::Mul(qx, qz);
+            const auto yz = Ops::Mul(qy, qz);
+            const auto wx = Ops::Mul(qw, qx);
+            const auto wy = Ops::Mul(qw, qy);
+            const auto wz = Ops::Mul(qw, qz);
+
+            const auto sx = Ops::Load(components[ScaleX]);
+            const auto sy = Ops::Load(components[ScaleY]);
+            const auto sz = Ops::Load(components[ScaleZ]);
+
+            f32 rows[9][s_Width];
+            Ops::Store(rows[0], Ops::Mul(sx, Ops::Sub(Ops::Mul(two, Ops::Add(ww, xx)), one)));
+            Ops::Store(rows[1], Ops::Mul(sx, Ops::Mul(two, Ops::Sub(xy, wz))));
+            Ops::Store(rows[2], Ops::Mul(sx, Ops::Mul(two, Ops::Add(xz, wy))));
+            Ops::Store(rows[3], Ops::Mul(sy, Ops::Mul(two, Ops::Add(xy, wz))));
+            Ops::Store(rows[4], Ops::Mul(sy, Ops::Sub(Ops::Mul(two, Ops::Add(ww, yy)), one)));
+            Ops::Store(rows[5], Ops::Mul(sy, Ops::Mul(two, Ops::Sub(yz, wx))));
+            Ops::Store(rows[6], Ops::Mul(sz, Ops::Mul(two, Ops::Sub(xz, wy))));
+            Ops::Store(rows[7], Ops::Mul(sz, Ops::Mul(two, Ops::Add(yz, wx))));
+            Ops::Store(rows[8], Ops::Mul(sz, Ops::Sub(Ops::Mul(two, Ops::Add(ww, zz)), one)));
+
+            const f32 *px = components[PositionX];
+            const f32 *py = components[PositionY];
+            const f32 *pz = components[PositionZ];
+
+            for (usize i = 0; i < count; i++) {
+                out[i] = Matrix4f({
+                    rows[0][i], rows[1][i], rows[2][i], 0,
+                    rows[3][i], rows[4][i], rows[5][i], 0,
+                    rows[6][i], rows[7][i], rows[8][i], 0,
+                    px[i], py[i], pz[i], 1
+                });
+            }
+        }
+
+        // Identity padding for the lanes past the end of a partial batch.
+        void Gather(const Transform *transforms, const usize count, f32 (&lanes)[ComponentCount][s_Width]) {
+            for (usize i = 0; i < s_Width; i++) {
+                const Transform transform = i < count ? transforms[i] : Transform{};
+
+                lanes[PositionX][i] = transform.position.x;
+                lanes[PositionY][i] = transform.position.y;
+                lanes[PositionZ][i] = transform.position.z;
+                lanes[RotationX][i] = transform.rotation.x;
+                lanes[RotationY][i] = transform.rotation.y;
+                lanes[RotationZ][i] = transform.rotation.z;
+                lanes[RotationW][i] = transform.rotation.w;
+                lanes[ScaleX][i]    = transform.scale.x;
+                lanes[ScaleY][i]    = transform.scale.y;
+                lanes[ScaleZ][i]    = transform.scale.z;
+            }
+        }
+    }
+
+    usize TransformSoA::Size() const {
+        return positionX.size();
+    }
+
+    void TransformSoA::Clear() {
+        for (auto *component: {&positionX, &positionY, &positionZ, &rotationX, &rotationY, &rotationZ, &rotationW,
+                               &scaleX, &scaleY, &scaleZ}) {
+            component->clear();
+        }
+    }
+
+    void TransformSoA::Reserve(const usize capacity) {
+        for (auto *component: {&positionX, &positionY, &positionZ, &rotationX, &rotationY, &rotationZ, &rotationW,
+                               &scaleX, &scaleY, &scaleZ}) {
+            component->reserve(capacity);
+        }
+    }
+
+    void TransformSoA::Push(const Transform &transform) {
+        positionX.push_back(transform.position.x);
+        positionY.push_back(transform.position.y);
+        positionZ.push_back(transform.position.z);
+        rotationX.push_back(transform.rotation.x);
+        rotationY.push_back(transform.rotation.y);
+        rotationZ.push_back(transform.rotation.z);
+        rotationW.push_back(transform.rotation.w);
+        scaleX.push_back(transform.scale.x);
+        scaleY.push_back(transform.scale.y);
+        scaleZ.push_back(transform.scale.z);
+    }
+
+    void ComputeMatrices(const std::span<const Transform> transforms, const std::span<Matrix4f> matrices) {
+        const usize count = std::min(transforms.size(), matrices.size());
+
+        f32        lanes[ComponentCount][s_Width];
+        const f32 *components[ComponentCount];
+        for (u32 c = 0; c < ComponentCount; c++) {
+            components[c] = lanes[c];
+        }
+
+        for (usize i = 0; i < count; i += s_Width) {
+            const usize batch = std::min<usize>(s_Width, count - i);
+
+            Gather(transforms.data() + i, batch, lanes);
+            ComposeLanes(components, matrices.data() + i, batch);
+        }
+    }
+
+    void ComputeMatrices(const TransformSoA &transforms, const std::span<Matrix4f> matrices) {
+        const usize count = std::min(transforms.Size(), matrices.size());
+        const usize full  = count / s_Width * s_Width;
+
+        const std::vector<f32> *sources[ComponentCount] = {
+            &transforms.positionX, &transforms.positionY, &transforms.positionZ,
+            &transforms.rotationX, &transforms.rotationY, &transforms.rotationZ, &transforms.rotationW,
+            &transforms.scaleX, &transforms.scaleY, &transforms.scaleZ
+        };
+
+        const f32 *components[ComponentCount];
+        for (usize i = 0; i < full; i += s_Width) {
+            for (u32 c = 0; c < ComponentCount; c++) {
+                components[c] = sources[c]->data() + i;
+            }
+
+            ComposeLanes(components, matrices.data() + i, s_Width);
+        }
+
+        if (full == count) {
+            return;
+        }
+
+        // The tail is copied out so the loads don't read past the arrays.
+        f32 lanes[ComponentCount][s_Width];
+        for (u32 c = 0; c < ComponentCount; c++) {
+            const f32 padding = c == RotationW || c >= ScaleX ? 1.0F : 0.0F;
+            std::fill_n(lanes[c], s_Width, padding);
+            std::copy(sources[c]->begin() + full, sources[c]->begin() + count, lanes[c]);
+            components[c] = lanes[c];
+        }
+
+        ComposeLanes(components, matrices.data() + full, count - full);
+    }
+}
@@ -0,0 +1,41 @@
+#ifndef FLK_TRANSFORMBATCH_HPP
+#define FLK_TRANSFORMBATCH_HPP
+
+#include <span>
+#include <vector>
+
+#include "Common.hpp"
+#include "Matrix.hpp"
+#include "Transform.hpp"
+
+namespace Flock {
+    /**
+     * @struct TransformSoA
+     * @brief Transforms stored one array per component, so a batch loads straight into SIMD registers.
+     */
+    struct FLK_API TransformSoA {
+        std::vector<f32> positionX, positionY, positionZ;
+        std::vector<f32> rotationX, rotationY, rotationZ, rotationW;
+        std::vector<f32> scaleX, scaleY, scaleZ;
+
+        [[nodiscard]] usize Size() const;
+
+        void Clear();
+        void Reserve(usize capacity);
+        void Push(const Transform &transform);
+    };
+
+    /**
+     * @brief Computes the model matrix of every transform, several transforms at a time.
+     *
+     * Produces the same values as Transform::Matrix(). Extra transforms or matrices are ignored.
+     */
+    FLK_API void ComputeMatrices(std::span<const Transform> transforms, std::span<Matrix4f> matrices);
+
+    /**
+     * @copydoc ComputeMatrices(std::span<const Transform>, std::span<Matrix4f>)
+     */
+    FLK_API void ComputeMatrices(const TransformSoA &transforms, std::span<Matrix4f> matrices);
+}
+
+#endif //FLK_TRANSFORMBATCH_HPP
@@ -0,0 +1,114 @@
+#include "FreeList.hpp"
+
+#include <algorithm>
+#include <iterator>
+
+namespace Flock::Memory {
+    FreeList::FreeList(const usize capacity) {
+        Grow(capacity);
+    }
+
+    std::optional<usize> FreeList::Allocate(const usize size, const usize alignment) {
+        if (size == 0) {
+            return std::nullopt;
+        }
+
+        for (auto it = m_Free.begin(); it != m_Free.end(); ++it) {
+            const auto [offset, length] = *it;
+
+            const usize aligned = (offset + alignment - 1) / alignment * alignment;
+            if (aligned + size > offset + length) {
+                continue;
+            }
+
+            m_Free.erase(it);
+
+            // The padding before the range stays free.
+            if (aligned > offset) {
+                m_Free[offset] = aligned - offset;
+            }
+
+            if (aligned + size < offset + length) {
+                m_Free[aligned + size] = offset + length - aligned - size;
+            }
+
+            m_Used += size;
+            return aligned;
+        }
+
+        return std::nullopt;
+    }
+
+    void FreeList::Free(usize offset, usize size) {
+        if (size == 0) {
+            return;
+        }
+
+        m_Used -= size;
+
+        const auto next = m_Free.lower_bound(offset);
+        if (next != m_Free.end() && offset + size == next->first) {
+            size += next->second;
+            m_Free.erase(next);
+        }
+
+        const auto after = m_Free.lower_bound(offset);
+        if (after != m_Free.begin()) {
+            const auto previous = std::prev(after);
+            if (previous->first + previous->second == offset) {
+                previous->second += size;
+                return;
+            }
+        }
+
+        m_Free[offset] = size;
+    }
+
+    void FreeList::Grow(const usize capacity) {
+        if (capacity <= m_Capacity) {
+            return;
+        }
+
+        const usize previous = m_Capacity;
+        m_Capacity           = capacity;
+
+        // Freeing the new space merges it with a free range at the old end.
+        m_Used += capacity - previous;
+        Free(previous, capacity - previous);
+    }
+
+    void FreeList::Reset(const usize used) {
+        m_Free.clear();
+        m_Used = std::min(used, m_Capacity);
+
+        if (m_Used < m_Capacity) {
+            m_Free[m_Used] = m_Capacity - m_Used;
+        }
+    }
+
+    usize FreeList::Capacity() const {
+        return m_Capacity;
+    }
+
+    usize FreeList::Used() const {
+        return m_Used;
+    }
+
+    usize FreeList::LargestFree() const {
+        usize largest = 0;
+        for (const auto &[offset, size]: m_Free) {
+            largest = std::max(largest, size);
+        }
+
+        return largest;
+    }
+
+    f32 FreeList::Fragmentation() const {
+        const usize free = m_Capacity - m_Used;
+        if (free == 0) {
+            return 0.0F;
+        }
+
+        return 1.0F - static_cast<f32>(LargestFree()) / static_cast<f32>(free);
+    }
+}
@@ -0,0 +1,58 @@
+#ifndef FLK_FREELIST_HPP
+#define FLK_FREELIST_HPP
+
+#include <map>
+#include <optional>
+
+#include "Common.hpp"
+
+namespace Flock::Memory {
+    /**
+     * @class FreeList
+     * @brief A first-fit range allocator, neighboring free ranges are merged when released.
+     *
+     * Only does the bookkeeping, the units are up to the caller.
+     */
+    class FLK_API FreeList {
+        std::map<usize, usize> m_Free; // Offset to size.
+        usize                  m_Capacity = 0;
+        usize                  m_Used     = 0;
+
+    public:
+        explicit FreeList(usize capacity = 0);
+
+        /**
+         * @brief Allocates a range.
+         * @param size The size of the range.
+         * @param alignment The alignment of the offset.
+         * @return The offset of the range if there was room; std::nullopt otherwise.
+         */
+        std::optional<usize> Allocate(usize size, usize alignment = 1);
+
+        /**
+         * @brief Releases a range returned by Allocate().
+         */
+        void Free(usize offset, usize size);
+
+        /**
+         * @brief Extends the capacity, the new space is free.
+         */
+        void Grow(usize capacity);
+
+        /**
+         * @brief Marks [0, used) as allocated and the rest as free, for after the ranges were compacted.
+         */
+        void Reset(usize used);
+
+        [[nodiscard]] usize Capacity() const;
+        [[nodiscard]] usize Used() const;
+        [[nodiscard]] usize LargestFree() const;
+
+        /**
+         * @return 0 when all free space is in one range, approaching 1 as it gets split into many small ones.
+         */
+        [[nodiscard]] f32 Fragmentation() const;
+    };
+}
+
+#endif //FLK_FREELIST_HPP
@@ -90,6 +90,39 @@ TEST(Entities, RegistryForEach) {
     }
 }
 
+TEST(Entities, ChangeTracking) {
+    // Arrange
+    Registry     registry{};
+    const Entity existing = registry.Create(1);
+    registry.TrackChanges<int>();
+
+    const Entity added   = registry.Create(2);
+    const Entity removed = registry.Create(3);
+    registry.TakeChanges<int>();
+
+    // Act
+    const Registry &reader = registry;
+    const int       read   = *reader.Get<int>(existing);
+
+    *registry.Get<int>(added) = 4;
+    registry.ForEach<int>([](int &value) { value++; });
+    registry.Destroy(removed);
+
+    const StorageChanges changes = registry.TakeChanges<int>();
+
+    // Assert
+    ASSERT_EQ(read, 1);
+    ASSERT_TRUE(changes.added.empty());
+    ASSERT_EQ(changes.removed, std::vector<EntityId>{removed.id});
+    ASSERT_EQ(changes.modified, (std::vector<EntityId>{added.id, existing.id, removed.id}));
+    ASSERT_TRUE(registry.TakeChanges<int>().modified.empty());
+
+    int sum = 0;
+    reader.ForEach<int>([&](const int &value) { sum += value; });
+    ASSERT_EQ(sum, 7);
+    ASSERT_TRUE(registry.TakeChanges<int>().modified.empty());
+}
+
 TEST(Entities, Schedule) {
     // Arrange
     World    world{};
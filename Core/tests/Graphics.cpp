@@ -0,0 +1,423 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <optional>
+#include <random>
+#include <vector>
+
+#include "Glfw/Window.hpp"
+#include "Graphics/FrameGraph.hpp"
+#include "Graphics/Gl.hpp"
+#include "Graphics/Image.hpp"
+#include "Graphics/LightClusters.hpp"
+#include "Graphics/Mesh.hpp"
+#include "Graphics/OcclusionBuffer.hpp"
+#include "Graphics/StateCache.hpp"
+#include "Graphics/TextureAtlas.hpp"
+#include "Math/Rect.hpp"
+
+using namespace Flock;
+using namespace Flock::Graphics;
+
+namespace {
+    // Shares a hidden window between the tests that need a context, they are skipped if none can be created.
+    class GlContext : public testing::Test {
+    protected:
+        inline static std::optional<Glfw::Window> s_Window;
+
+        static void SetUpTestSuite() {
+            s_Window = Glfw::Window::Create({.size = {64, 64}, .samplesPerPixel = 0, .vsync = false, .headless = true});
+            if (s_Window) {
+                s_Window->MakeCurrent();
+            }
+        }
+
+        static void TearDownTestSuite() {
+            s_Window.reset();
+        }
+
+        void SetUp() override {
+            if (!s_Window) {
+                GTEST_SKIP() << "No OpenGL context";
+            }
+
+            StateCache::Invalidate();
+        }
+    };
+
+    MeshData Quad() {
+        MeshData quad;
+        quad.vertices.resize(4);
+        quad.vertices[0].position = {-3.0F, -3.0F, 0.0F};
+        quad.vertices[1].position = {3.0F, -3.0F, 0.0F};
+        quad.vertices[2].position = {3.0F, 3.0F, 0.0F};
+        quad.vertices[3].position = {-3.0F, 3.0F, 0.0F};
+        quad.indices              = {0, 1, 2, 0, 2, 3};
+
+        return quad;
+    }
+
+    // The view space box of a cluster, for a perspective camera at the origin looking down +z.
+    void ClusterBox(
+        const Camera & camera,
+        const f32      aspectRatio,
+        const Vector3u dims,
+        const Vector3u cell,
+        Vector3f &     min,
+        Vector3f &     max
+    ) {
+        const f32 halfY = std::tan(DegreesToRadians(camera.fovY) / 2.0F);
+        const f32 halfX = halfY * aspectRatio;
+
+        const f32 nearZ = camera.nearZ * std::pow(camera.farZ / camera.nearZ, static_cast<f32>(cell.z) / dims.z);
+        const f32 farZ  = camera.nearZ * std::pow(camera.farZ / camera.nearZ, static_cast<f32>(cell.z + 1) / dims.z);
+
+        const f32 x0 = (-1.0F + 2.0F * cell.x / dims.x) * halfX;
+        const f32 x1 = (-1.0F + 2.0F * (cell.x + 1) / dims.x) * halfX;
+        const f32 y0 = (-1.0F + 2.0F * cell.y / dims.y) * halfY;
+        const f32 y1 = (-1.0F + 2.0F * (cell.y + 1) / dims.y) * halfY;
+
+        min = {std::min(x0 * nearZ, x0 * farZ), std::min(y0 * nearZ, y0 * farZ), nearZ};
+        max = {std::max(x1 * nearZ, x1 * farZ), std::max(y1 * nearZ, y1 * farZ), farZ};
+    }
+
+    bool SphereOverlapsBox(const Vector3f center, const f32 radius, const Vector3f min, const Vector3f max) {
+        const f32 dx = std::max({0.0F, min.x - center.x, center.x - max.x});
+        const f32 dy = std::max({0.0F, min.y - center.y, center.y - max.y});
+        const f32 dz = std::max({0.0F, min.z - center.z, center.z - max.z});
+
+        return dx * dx + dy * dy + dz * dz <= radius * radius;
+    }
+}
+
+TEST(FrameGraph, CullsUnreadPasses) {
+    // Arrange
+    FrameGraph graph;
+    const auto screen = graph.Import("Screen");
+
+    graph.AddPass("Unread", [](PassBuilder &builder) {
+        builder.Write(builder.Create("Unused", {.size = {64, 64}}));
+    }, {});
+
+    graph.AddPass("Present", [&](PassBuilder &builder) {
+        builder.Write(screen);
+    }, {});
+
+    // Act
+    const bool compiled = graph.Compile();
+
+    // Assert
+    ASSERT_TRUE(compiled);
+    ASSERT_EQ(graph.Order(), std::vector<u32>{1});
+    ASSERT_EQ(graph.SlotCount(), 0U);
+}
+
+TEST(FrameGraph, WritersRunBeforeReaders) {
+    // Arrange
+    FrameGraph graph;
+    const auto screen = graph.Import("Screen");
+    const auto scene  = graph.Create("Scene", {.size = {64, 64}});
+
+    graph.AddPass("Present", [&](PassBuilder &builder) {
+        builder.Read(scene);
+        builder.Write(screen);
+    }, {});
+
+    graph.AddPass("Scene", [&](PassBuilder &builder) {
+        builder.Write(scene);
+    }, {});
+
+    // Act
+    const bool compiled = graph.Compile();
+
+    // Assert
+    ASSERT_TRUE(compiled);
+    ASSERT_EQ(graph.Order(), (std::vector<u32>{1, 0}));
+}
+
+TEST(FrameGraph, DisjointTransientsShareSlot) {
+    // Arrange
+    FrameGraph       graph;
+    const TargetDesc desc   = {.size = {64, 64}};
+    const auto       screen = graph.Import("Screen");
+
+    FrameResource a = FLK_INVALID;
+    FrameResource b = FLK_INVALID;
+    FrameResource c = FLK_INVALID;
+
+    graph.AddPass("A", [&](PassBuilder &builder) {
+        a = builder.Write(builder.Create("A", desc));
+    }, {});
+
+    graph.AddPass("B", [&](PassBuilder &builder) {
+        builder.Read(a);
+        b = builder.Write(builder.Create("B", desc));
+    }, {});
+
+    graph.AddPass("C", [&](PassBuilder &builder) {
+        builder.Read(b);
+        c = builder.Write(builder.Create("C", desc));
+    }, {});
+
+    graph.AddPass("Present", [&](PassBuilder &builder) {
+        builder.Read(c);
+        builder.Write(screen);
+    }, {});
+
+    // Act
+    const bool compiled = graph.Compile();
+
+    // Assert
+    ASSERT_TRUE(compiled);
+    ASSERT_EQ(graph.Order(), (std::vector<u32>{0, 1, 2, 3}));
+    ASSERT_EQ(graph.SlotCount(), 2U);
+    ASSERT_EQ(graph.SlotOf(a), graph.SlotOf(c)); // A is last read before C is first written.
+    ASSERT_NE(graph.SlotOf(a), graph.SlotOf(b));
+    ASSERT_EQ(graph.SlotOf(screen), FLK_INVALID);
+}
+
+TEST(FrameGraph, CycleFailsToCompile) {
+    // Arrange
+    FrameGraph graph;
+    const auto x = graph.Create("X", {.size = {64, 64}});
+    const auto y = graph.Create("Y", {.size = {64, 64}});
+
+    graph.AddPass("A", [&](PassBuilder &builder) {
+        builder.Read(y);
+        builder.Write(x);
+        builder.SideEffect();
+    }, {});
+
+    graph.AddPass("B", [&](PassBuilder &builder) {
+        builder.Read(x);
+        builder.Write(y);
+        builder.SideEffect();
+    }, {});
+
+    // Act
+    const bool compiled = graph.Compile();
+
+    // Assert
+    ASSERT_FALSE(compiled);
+    ASSERT_TRUE(graph.Order().empty());
+}
+
+TEST(OcclusionBuffer, QuadHidesOnlyWhatIsBehindIt) {
+    // Arrange
+    const MeshData     quad     = Quad();
+    const OccluderMesh occluder = {.data = &quad, .model = Matrix4f::Translate({0.0F, 0.0F, 5.0F})};
+    const Matrix4f     viewProj = Matrix4f::Perspective(60.0F, 320.0F / 192.0F, 0.1F, 100.0F);
+
+    OcclusionBuffer buffer;
+    buffer.Resize({320, 192});
+
+    // Act
+    buffer.Render(std::span(&occluder, 1), viewProj);
+
+    // Assert
+    ASSERT_EQ(buffer.Stats().triangles, 2U);
+    ASSERT_FALSE(buffer.IsVisible({.center = {0.0F, 0.0F, 10.0F}, .radius = 1.0F}));
+    ASSERT_TRUE(buffer.IsVisible({.center = {0.0F, 0.0F, 2.0F}, .radius = 1.0F}));
+    ASSERT_TRUE(buffer.IsVisible({.center = {8.0F, 0.0F, 10.0F}, .radius = 1.0F}));
+}
+
+TEST(AtlasPacker, InsertsDisjointRectanglesInBounds) {
+    // Arrange
+    const Vector2u                     size = {256, 256};
+    AtlasPacker                        packer(size);
+    std::mt19937                       rng(12);
+    std::uniform_int_distribution<u32> dist(1, 48);
+    std::vector<Rect2u>                packed;
+
+    // Act
+    for (u32 i = 0; i < 200; i++) {
+        const Vector2u                rectSize = {dist(rng), dist(rng)};
+        const std::optional<Vector2u> corner   = packer.Insert(rectSize);
+        if (corner) {
+            packed.emplace_back(*corner, rectSize);
+        }
+    }
+
+    // Assert
+    ASSERT_GT(packed.size(), 20U);
+
+    u64 area = 0;
+    for (usize i = 0; i < packed.size(); i++) {
+        const Rect2u &a = packed[i];
+        ASSERT_LE(a.origin.x + a.aspect.x, size.x);
+        ASSERT_LE(a.origin.y + a.aspect.y, size.y);
+        area += static_cast<u64>(a.aspect.x) * a.aspect.y;
+
+        for (usize j = i + 1; j < packed.size(); j++) {
+            const Rect2u &b     = packed[j];
+            const bool    apart = a.origin.x + a.aspect.x <= b.origin.x || b.origin.x + b.aspect.x <= a.origin.x ||
+                                  a.origin.y + a.aspect.y <= b.origin.y || b.origin.y + b.aspect.y <= a.origin.y;
+            ASSERT_TRUE(apart) << "rectangles " << i << " and " << j << " overlap";
+        }
+    }
+
+    ASSERT_FLOAT_EQ(packer.Occupancy(), static_cast<f32>(area) / static_cast<f32>(size.x * size.y));
+}
+
+TEST(AtlasPacker, FullPackerRejectsUntilReset) {
+    // Arrange
+    AtlasPacker packer({64, 64});
+
+    // Act
+    const auto tooLarge = packer.Insert({65, 1});
+    const auto empty    = packer.Insert({0, 8});
+    const auto left     = packer.Insert({32, 64});
+    const auto right    = packer.Insert({32, 64});
+    const auto full     = packer.Insert({1, 1}); // TextureAtlas starts a new page here.
+    packer.Reset();
+    const auto reset = packer.Insert({64, 64});
+
+    // Assert
+    ASSERT_FALSE(tooLarge);
+    ASSERT_FALSE(empty);
+    ASSERT_EQ(left, (Vector2u{0, 0}));
+    ASSERT_EQ(right, (Vector2u{32, 0}));
+    ASSERT_FALSE(full);
+    ASSERT_FLOAT_EQ(packer.Occupancy(), 1.0F);
+    ASSERT_EQ(reset, (Vector2u{0, 0}));
+}
+
+TEST(LightClusters, LightsLandInOverlappedClusters) {
+    // Arrange
+    const ClusterConfig config = {.dimensions = {4, 3, 6}};
+    const Camera        camera = {
+        .transform  = {.position = {0.0F, 0.0F, 0.0F}},
+        .projection = Projection::Perspective,
+        .nearZ      = 0.1F,
+        .farZ       = 100.0F,
+    };
+
+    const std::vector<Light> lights = {
+        {.position = {0.0F, 0.0F, 5.0F}, .radius = 1.0F},
+        {.position = {-3.0F, 1.5F, 20.0F}, .radius = 6.0F},
+        {.position = {0.5F, -0.3F, 0.4F}, .radius = 0.2F},
+        {.position = {0.0F, 0.0F, -50.0F}, .radius = 5.0F}, // Behind the camera.
+    };
+
+    LightClusters clusters(config);
+
+    // Act
+    clusters.Cull(lights, camera, {{0, 0}, {400, 300}});
+
+    // Assert
+    const Vector3u dims = config.dimensions;
+    ASSERT_EQ(clusters.ClusterCount(), static_cast<usize>(dims.x) * dims.y * dims.z);
+
+    std::vector<usize> hits(lights.size(), 0);
+    for (u32 z = 0; z < dims.z; z++) {
+        for (u32 y = 0; y < dims.y; y++) {
+            for (u32 x = 0; x < dims.x; x++) {
+                Vector3f min;
+                Vector3f max;
+                ClusterBox(camera, 400.0F / 300.0F, dims, {x, y, z}, min, max);
+
+                const std::vector<u32> actual = clusters.ClusterLights((z * dims.y + y) * dims.x + x);
+                for (u32 l = 0; l < lights.size(); l++) {
+                    const bool expected = SphereOverlapsBox(lights[l].position, lights[l].radius, min, max);
+                    ASSERT_EQ(std::ranges::count(actual, l), expected ? 1 : 0)
+                        << "light " << l << " in cluster " << x << ", " << y << ", " << z;
+                    hits[l] += expected;
+                }
+            }
+        }
+    }
+
+    ASSERT_GT(hits[0], 0U);
+    ASSERT_GT(hits[1], hits[0]);
+    ASSERT_GT(hits[2], 0U);
+    ASSERT_EQ(hits[3], 0U);
+}
+
+TEST_F(GlContext, MeshesKeepTheirIndexBuffers) {
+    // Arrange
+    const MeshData quad = Quad();
+
+    // Act
+    const std::optional<Mesh> first  = Mesh::Create(quad);
+    const std::optional<Mesh> second = Mesh::Create(quad);
+
+    // Assert
+    ASSERT_TRUE(first && second);
+
+    // Creating the second mesh must not touch the vertex arrays of the first one.
+    ASSERT_TRUE(first->BindDepth());
+    ASSERT_NE(GetInteger(GL_ELEMENT_ARRAY_BUFFER_BINDING), 0);
+
+    ASSERT_TRUE(first->Bind());
+    ASSERT_NE(GetInteger(GL_ELEMENT_ARRAY_BUFFER_BINDING), 0);
+}
+
+TEST_F(GlContext, AtlasAddsPageWhenFull) {
+    // Arrange
+    TextureAtlas atlas = TextureAtlas::CreateEmpty({32, 32});
+    const Image  image = Image::SingleColor({20, 20}, Color4u8::White());
+
+    // Act
+    const std::optional<u32> first    = atlas.Insert(image);
+    const std::optional<u32> second   = atlas.Insert(image);
+    const std::optional<u32> tooLarge = atlas.Insert(Image::SingleColor({31, 31}, Color4u8::White()));
+    atlas.Flush();
+
+    // Assert
+    ASSERT_TRUE(first && second);
+    ASSERT_FALSE(tooLarge); // Doesn't fit with the padding.
+    ASSERT_EQ(atlas.PageCount(), 2U);
+    ASSERT_EQ(atlas.Region(*first)->page, 0U);
+    ASSERT_EQ(atlas.Region(*second)->page, 1U);
+    ASSERT_EQ(atlas.Region(*second)->pixels.origin, (Vector2u{1, 1}));
+}
+
+TEST_F(GlContext, PassesOnlyKeepTheTargetsTheyWrite) {
+    // Arrange
+    FrameGraph       graph;
+    RenderTargetPool pool;
+    const auto       screen = graph.Import("Screen");
+
+    FrameResource depth = FLK_INVALID;
+    FrameResource color = FLK_INVALID;
+
+    u32 depthPassColor = FLK_INVALID;
+    u32 depthPassDepth = 0;
+    u32 colorPassColor = 0;
+    u32 colorPassDepth = FLK_INVALID;
+
+    graph.AddPass("Depth", [&](PassBuilder &builder) {
+        depth = builder.Write(builder.Create("Depth", {.size = {64, 64}, .format = TextureFormat::Depth}));
+    }, [&](const PassContext &context) {
+        depthPassColor = context.Target()->AttachedTexture(Attachment::Color);
+        depthPassDepth = context.Target()->AttachedTexture(Attachment::Depth);
+    });
+
+    graph.AddPass("Color", [&](PassBuilder &builder) {
+        builder.Read(depth);
+        color = builder.Write(builder.Create("Color", {.size = {32, 32}}));
+    }, [&](const PassContext &context) {
+        colorPassColor = context.Target()->AttachedTexture(Attachment::Color);
+        colorPassDepth = context.Target()->AttachedTexture(Attachment::Depth);
+    });
+
+    graph.AddPass("Present", [&](PassBuilder &builder) {
+        builder.Read(color);
+        builder.Write(screen);
+    }, [&](const PassContext &context) {
+        ASSERT_EQ(context.Target(), nullptr);
+    });
+
+    // Act
+    const bool compiled = graph.Compile();
+    const bool executed = graph.Execute(pool);
+
+    // Assert
+    ASSERT_TRUE(compiled);
+    ASSERT_TRUE(executed);
+    ASSERT_EQ(depthPassColor, 0U);
+    ASSERT_NE(depthPassDepth, 0U);
+    ASSERT_NE(colorPassColor, 0U);
+    ASSERT_EQ(colorPassDepth, 0U); // The depth pass's target is sampled here, it must not stay attached.
+}
@@ -0,0 +1,364 @@
+#include <gtest/gtest.h>
+
+#include <array>
+#include <bit>
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include "Graphics/Vertex.hpp"
+#include "Math/Matrix.hpp"
+#include "Math/Simd.hpp"
+#include "Math/Transform.hpp"
+#include "Math/TransformBatch.hpp"
+
+using namespace Flock;
+
+namespace {
+    using ScalarOps = Simd::ScalarOps<f32>;
+
+    std::array<f32, 16> RandomMatrix(std::mt19937 &rng) {
+        std::uniform_real_distribution<f32> dist(-10.0F, 10.0F);
+
+        std::array<f32, 16> m = {};
+        for (f32 &value: m) {
+            value = dist(rng);
+        }
+
+        return m;
+    }
+
+    std::array<f32, 16> RandomTransform(std::mt19937 &rng) {
+        std::uniform_real_distribution<f32> dist(-10.0F, 10.0F);
+        std::uniform_real_distribution<f32> scale(0.1F, 4.0F);
+
+        const Transform transform = {
+            .position = {dist(rng), dist(rng), dist(rng)},
+            .rotation = Quaternion::Euler({dist(rng) * 18.0F, dist(rng) * 18.0F, dist(rng) * 18.0F}),
+            .scale    = {scale(rng), scale(rng), scale(rng)},
+        };
+
+        const Matrix4f      matrix = transform.Matrix();
+        std::array<f32, 16> m      = {};
+        std::copy_n(matrix.Data(), 16, m.begin());
+
+        return m;
+    }
+
+    std::vector<Transform> RandomTransforms(std::mt19937 &rng, const usize count) {
+        std::uniform_real_distribution<f32> dist(-10.0F, 10.0F);
+        std::uniform_real_distribution<f32> scale(0.1F, 4.0F);
+
+        std::vector<Transform> transforms(count);
+        for (auto &transform: transforms) {
+            transform = {
+                .position = {dist(rng), dist(rng), dist(rng)},
+                .rotation = Quaternion::Euler({dist(rng) * 18.0F, dist(rng) * 18.0F, dist(rng) * 18.0F}),
+                .scale    = {scale(rng), scale(rng), scale(rng)},
+            };
+        }
+
+        return transforms;
+    }
+
+    void ExpectBitwiseEqual(const f32 *expected, const f32 *actual, const usize count) {
+        for (usize i = 0; i < count; i++) {
+            EXPECT_EQ(std::bit_cast<u32>(expected[i]), std::bit_cast<u32>(actual[i])) << "at element " << i;
+        }
+    }
+}
+
+TEST(Math, MatrixMultiplyMatchesScalar) {
+    // Arrange
+    std::mt19937 rng(1);
+
+    for (u32 i = 0; i < 1000; i++) {
+        const auto a = RandomMatrix(rng);
+        const auto b = RandomMatrix(rng);
+
+        // Act
+        std::array<f32, 16> scalar = {};
+        std::array<f32, 16> native = {};
+        Simd::Kernels::Multiply<ScalarOps>(a.data(), b.data(), scalar.data());
+        Simd::Multiply(a.data(), b.data(), native.data());
+
+        // Assert
+        ExpectBitwiseEqual(scalar.data(), native.data(), 16);
+    }
+}
+
+TEST(Math, MatrixMultiplyMatchesDefinition) {
+    // Arrange
+    std::mt19937 rng(2);
+    const auto   a = RandomMatrix(rng);
+    const auto   b = RandomMatrix(rng);
+
+    // Act
+    const Matrix4f product = Matrix4f(a) * Matrix4f(b);
+
+    // Assert
+    for (u32 row = 0; row < 4; row++) {
+        for (u32 col = 0; col < 4; col++) {
+            f64 expected = 0.0;
+            for (u32 k = 0; k < 4; k++) {
+                expected += static_cast<f64>(a[row * 4 + k]) * static_cast<f64>(b[k * 4 + col]);
+            }
+
+            EXPECT_NEAR(product.At(row, col), expected, 1e-3);
+        }
+    }
+}
+
+TEST(Math, MatrixTransposeMatchesScalar) {
+    // Arrange
+    std::mt19937 rng(3);
+    const auto   m = RandomMatrix(rng);
+
+    // Act
+    std::array<f32, 16> scalar     = {};
+    const Matrix4f      transposed = Matrix4f(m).Transposed();
+    Simd::Kernels::Transpose<ScalarOps>(m.data(), scalar.data());
+
+    // Assert
+    ExpectBitwiseEqual(scalar.data(), transposed.Data(), 16);
+    for (u32 row = 0; row < 4; row++) {
+        for (u32 col = 0; col < 4; col++) {
+            EXPECT_EQ(transposed.At(row, col), m[col * 4 + row]);
+        }
+    }
+}
+
+TEST(Math, MatrixInverseMatchesScalar) {
+    // Arrange
+    std::mt19937 rng(4);
+
+    for (u32 i = 0; i < 1000; i++) {
+        const auto m = i % 2 == 0 ? RandomMatrix(rng) : RandomTransform(rng);
+
+        // Act
+        std::array<f32, 16> scalar = {};
+        std::array<f32, 16> native = {};
+        Simd::Kernels::Inverse<ScalarOps>(m.data(), scalar.data());
+        Simd::Inverse(m.data(), native.data());
+
+        // Assert
+        ExpectBitwiseEqual(scalar.data(), native.data(), 16);
+    }
+}
+
+TEST(Math, MatrixInverseIsInverse) {
+    // Arrange
+    std::mt19937 rng(5);
+
+    for (u32 i = 0; i < 100; i++) {
+        const Matrix4f m = RandomTransform(rng);
+
+        // Act
+        const Matrix4f identity = m * m.Inverse();
+
+        // Assert
+        for (u32 row = 0; row < 4; row++) {
+            for (u32 col = 0; col < 4; col++) {
+                EXPECT_NEAR(identity.At(row, col), row == col ? 1.0F : 0.0F, 1e-4F);
+            }
+        }
+    }
+}
+
+TEST(Math, MatrixTransformMatchesScalar) {
+    // Arrange
+    std::mt19937                        rng(6);
+    std::uniform_real_distribution<f32> dist(-100.0F, 100.0F);
+
+    for (u32 i = 0; i < 1000; i++) {
+        const auto     m = RandomMatrix(rng);
+        const Vector3f v = {dist(rng), dist(rng), dist(rng)};
+
+        // Act
+        const f32 in[3]     = {v.x, v.y, v.z};
+        f32       point[3]  = {};
+        f32       vector[3] = {};
+        Simd::Kernels::Transform<ScalarOps>(m.data(), in, 1.0F, point);
+        Simd::Kernels::Transform<ScalarOps>(m.data(), in, 0.0F, vector);
+
+        const Vector3f nativePoint  = Matrix4f(m).TransformPoint(v);
+        const Vector3f nativeVector = Matrix4f(m).TransformDirection(v);
+
+        // Assert
+        ExpectBitwiseEqual(point, &nativePoint.x, 1);
+        ExpectBitwiseEqual(point + 1, &nativePoint.y, 1);
+        ExpectBitwiseEqual(point + 2, &nativePoint.z, 1);
+        ExpectBitwiseEqual(vector, &nativeVector.x, 1);
+        ExpectBitwiseEqual(vector + 1, &nativeVector.y, 1);
+        ExpectBitwiseEqual(vector + 2, &nativeVector.z, 1);
+    }
+}
+
+TEST(Math, MatrixTransformPoint) {
+    // Arrange
+    const Matrix4f translate = Matrix4f::Translate({1, 2, 3});
+
+    // Act
+    const Vector3f point     = translate.TransformPoint({1, 1, 1});
+    const Vector3f direction = translate.TransformDirection({1, 1, 1});
+
+    // Assert
+    EXPECT_EQ(point.x, 2.0F);
+    EXPECT_EQ(point.y, 3.0F);
+    EXPECT_EQ(point.z, 4.0F);
+    EXPECT_EQ(direction.x, 1.0F);
+    EXPECT_EQ(direction.y, 1.0F);
+    EXPECT_EQ(direction.z, 1.0F);
+}
+
+TEST(Math, ComposeMatchesProducts) {
+    // Arrange
+    std::mt19937 rng(7);
+
+    for (const auto &transform: RandomTransforms(rng, 1000)) {
+        // Act
+        const Matrix4f composed = transform.Matrix();
+        const Matrix4f product  = Matrix4f::Scale(transform.scale) * Matrix4f::Rotate(transform.rotation) *
+                                  Matrix4f::Translate(transform.position);
+
+        // Assert
+        for (u32 i = 0; i < 16; i++) {
+            EXPECT_EQ(composed.Data()[i], product.Data()[i]) << "at element " << i;
+        }
+    }
+}
+
+TEST(Math, ComputeMatricesMatchesTransform) {
+    // Arrange
+    std::mt19937                 rng(8);
+    const std::vector<Transform> transforms = RandomTransforms(rng, 1003);
+
+    TransformSoA soa;
+    for (const auto &transform: transforms) {
+        soa.Push(transform);
+    }
+
+    // Act
+    std::vector<Matrix4f> fromAos(transforms.size());
+    std::vector<Matrix4f> fromSoa(transforms.size());
+    ComputeMatrices(transforms, fromAos);
+    ComputeMatrices(soa, fromSoa);
+
+    // Assert
+    for (usize i = 0; i < transforms.size(); i++) {
+        const Matrix4f expected = transforms[i].Matrix();
+        ExpectBitwiseEqual(expected.Data(), fromAos[i].Data(), 16);
+        ExpectBitwiseEqual(expected.Data(), fromSoa[i].Data(), 16);
+    }
+}
+
+TEST(Math, MaskedOpsMatchScalar) {
+    // Arrange
+    using WideOps = Simd::WideOps;
+
+    std::mt19937                        rng(8);
+    std::uniform_real_distribution<f32> dist(-1.0F, 1.0F);
+
+    for (u32 i = 0; i < 1000; i++) {
+        std::array<f32, WideOps::Width> a = {};
+        std::array<f32, WideOps::Width> b = {};
+        for (u32 lane = 0; lane < WideOps::Width; lane++) {
+            a[lane] = dist(rng);
+            b[lane] = i % 4 == 0 ? a[lane] : dist(rng); // Equal lanes must pass GreaterEqual.
+        }
+
+        // Act
+        std::array<f32, WideOps::Width> scalar = {};
+        bool                            any    = false;
+        for (u32 lane = 0; lane < WideOps::Width; lane += ScalarOps::Width) {
+            const auto x    = ScalarOps::Load(a.data() + lane);
+            const auto y    = ScalarOps::Load(b.data() + lane);
+            const auto mask = ScalarOps::And(ScalarOps::GreaterEqual(x, y), ScalarOps::GreaterEqual(x, ScalarOps::Splat(0.0F)));
+            ScalarOps::Store(scalar.data() + lane, ScalarOps::Select(mask, ScalarOps::Min(x, y), ScalarOps::Max(x, y)));
+            any = any || ScalarOps::Any(mask);
+        }
+
+        std::array<f32, WideOps::Width> wide = {};
+        const auto                      x    = WideOps::Load(a.data());
+        const auto                      y    = WideOps::Load(b.data());
+        const auto                      mask = WideOps::And(WideOps::GreaterEqual(x, y), WideOps::GreaterEqual(x, WideOps::Splat(0.0F)));
+        WideOps::Store(wide.data(), WideOps::Select(mask, WideOps::Min(x, y), WideOps::Max(x, y)));
+
+        // Assert
+        ExpectBitwiseEqual(scalar.data(), wide.data(), WideOps::Width);
+        EXPECT_EQ(any, WideOps::Any(mask));
+    }
+}
+
+TEST(Math, HalfRoundTrip) {
+    for (u32 bits = 0; bits <= 0xFFFF; bits++) {
+        // Act
+        const u16 half    = static_cast<u16>(bits);
+        const f32 value   = Graphics::FromHalf(half);
+        const u16 encoded = Graphics::ToHalf(value);
+
+        // Assert
+        if (std::isnan(value)) {
+            EXPECT_TRUE(std::isnan(Graphics::FromHalf(encoded))) << "for bits " << bits;
+        } else {
+            EXPECT_EQ(half, encoded) << "for bits " << bits;
+        }
+    }
+}
+
+TEST(Math, HalfRoundsToNearest) {
+    // Arrange
+    std::mt19937                        rng(9);
+    std::uniform_real_distribution<f32> exponent(-14.0F, 15.0F);
+    std::uniform_real_distribution<f32> mantissa(1.0F, 2.0F);
+
+    for (u32 i = 0; i < 10000; i++) {
+        const f32 value = std::ldexp(mantissa(rng), static_cast<i32>(exponent(rng))) * (i % 2 == 0 ? 1.0F : -1.0F);
+
+        // Act
+        const f32 decoded = Graphics::FromHalf(Graphics::ToHalf(value));
+
+        // Assert
+        EXPECT_LE(std::abs(decoded - value), std::abs(value) * std::ldexp(1.0F, -11)) << "for " << value;
+    }
+
+    EXPECT_EQ(Graphics::FromHalf(Graphics::ToHalf(1.0F + std::ldexp(1.0F, -11))), 1.0F); // Ties go to even.
+    EXPECT_EQ(Graphics::FromHalf(Graphics::ToHalf(65504.0F)), 65504.0F);
+    EXPECT_TRUE(std::isinf(Graphics::FromHalf(Graphics::ToHalf(1e6F))));
+    EXPECT_EQ(Graphics::FromHalf(Graphics::ToHalf(1e-9F)), 0.0F);
+}
+
+TEST(Math, OctEncodingRoundTrip) {
+    // Arrange
+    std::mt19937                        rng(10);
+    std::uniform_real_distribution<f32> dist(-1.0F, 1.0F);
+
+    const auto snorm16 = [](const f32 value) { return std::round(value * 32767.0F) / 32767.0F; };
+
+    for (u32 i = 0; i < 10000; i++) {
+        Vector3f direction = {dist(rng), dist(rng), dist(rng)};
+        if (direction.Magnitude() < 0.01F) {
+            continue;
+        }
+
+        direction = direction.Normalized();
+
+        // Act
+        const Vector2f encoded   = Graphics::OctEncode(direction);
+        const Vector3f exact     = Graphics::OctDecode(encoded);
+        const Vector3f quantized = Graphics::OctDecode({snorm16(encoded.x), snorm16(encoded.y)});
+
+        // Assert
+        EXPECT_LE(std::abs(encoded.x), 1.0F);
+        EXPECT_LE(std::abs(encoded.y), 1.0F);
+        EXPECT_LT((exact - direction).Magnitude(), 1e-6F);
+        EXPECT_LT((quantized - direction).Magnitude(), 1e-4F); // About 0.006 degrees, snorm16 allows ~0.004.
+    }
+
+    for (const Vector3f axis: {Vector3f{1, 0, 0}, Vector3f{0, -1, 0}, Vector3f{0, 0, 1}, Vector3f{0, 0, -1}}) {
+        const Vector3f decoded = Graphics::OctDecode(Graphics::OctEncode(axis));
+        EXPECT_NEAR(decoded.x, axis.x, 1e-6F);
+        EXPECT_NEAR(decoded.y, axis.y, 1e-6F);
+        EXPECT_NEAR(decoded.z, axis.z, 1e-6F);
+    }
+}
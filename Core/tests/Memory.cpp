@@ -0,0 +1,89 @@
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include "Memory/FreeList.hpp"
+
+using namespace Flock;
+using namespace Flock::Memory;
+
+TEST(FreeList, AlignmentPaddingStaysFree) {
+    // Arrange
+    FreeList list(64);
+
+    // Act
+    const auto first  = list.Allocate(3);
+    const auto second = list.Allocate(8, 16);
+    const auto filler = list.Allocate(13);
+
+    // Assert
+    ASSERT_EQ(first, 0U);
+    ASSERT_EQ(second, 16U);
+    ASSERT_EQ(filler, 3U); // Fits the padding between the two.
+    ASSERT_EQ(list.Used(), 24U);
+    ASSERT_EQ(list.LargestFree(), 40U);
+}
+
+TEST(FreeList, FreeMergesWithBothNeighbors) {
+    // Arrange
+    FreeList   list(30);
+    const auto a = list.Allocate(10);
+    const auto b = list.Allocate(10);
+    const auto c = list.Allocate(10);
+
+    // Act
+    list.Free(*a, 10);
+    list.Free(*c, 10);
+    const usize split = list.LargestFree();
+    list.Free(*b, 10);
+
+    // Assert
+    ASSERT_EQ(split, 10U);
+    ASSERT_EQ(list.Used(), 0U);
+    ASSERT_EQ(list.LargestFree(), 30U);
+    ASSERT_EQ(list.Allocate(30), 0U);
+}
+
+TEST(FreeList, GrowMergesWithFreeTail) {
+    // Arrange
+    FreeList list(32);
+    ASSERT_EQ(list.Allocate(24), 0U);
+
+    // Act
+    list.Grow(64);
+    list.Grow(48); // Never shrinks.
+
+    // Assert
+    ASSERT_EQ(list.Capacity(), 64U);
+    ASSERT_EQ(list.Used(), 24U);
+    ASSERT_EQ(list.LargestFree(), 40U);
+    ASSERT_EQ(list.Allocate(40), 24U);
+    ASSERT_EQ(list.Allocate(1), std::nullopt);
+}
+
+TEST(FreeList, Fragmentation) {
+    // Arrange
+    FreeList list(100);
+    ASSERT_FLOAT_EQ(list.Fragmentation(), 0.0F);
+
+    std::vector<usize> offsets;
+    for (u32 i = 0; i < 10; i++) {
+        offsets.push_back(*list.Allocate(10));
+    }
+
+    ASSERT_FLOAT_EQ(list.Fragmentation(), 0.0F); // Full, nothing to fragment.
+
+    // Act
+    for (u32 i = 0; i < 10; i += 2) {
+        list.Free(offsets[i], 10);
+    }
+
+    const f32 fragmented = list.Fragmentation();
+    list.Reset(50);
+
+    // Assert
+    ASSERT_FLOAT_EQ(fragmented, 1.0F - 10.0F / 50.0F);
+    ASSERT_FLOAT_EQ(list.Fragmentation(), 0.0F);
+    ASSERT_EQ(list.Used(), 50U);
+    ASSERT_EQ(list.LargestFree(), 50U);
+}
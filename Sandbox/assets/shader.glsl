@@ -6,24 +6,76 @@ in vec3 aPosition;
 in vec3 aNormal;
 in vec2 aTexCoords;
 
+uniform mat4 uDequantize;
 uniform mat4 uModel;
 uniform mat4 uView;
 uniform mat4 uProj;
 
+// Packed meshes store octahedral normals, see Graphics::VertexFormat.
+uniform int uPackedVertices;
+
+// Batched materials come from instance data, see Graphics::Renderer::RenderBatched.
+uniform int uInstanced;
+uniform int uInstanceBase;
+uniform samplerBuffer uInstanceData;
+
+uniform vec4 uColor;
+uniform float uMetallic;
+uniform float uRoughness;
+uniform float uAlphaCutoff;
+
+invariant gl_Position;
+
 out VS_OUT {
     vec3 worldPos;
     vec3 worldNormal;
     vec2 uv;
     float viewDepth;
+    flat vec4 color;
+    flat vec3 material;
+    flat vec3 layers;
 } vs_out;
 
+vec3 octDecode(vec2 e)
+{
+    vec3 n = vec3(e, 1.0 - abs(e.x) - abs(e.y));
+    float t = max(-n.z, 0.0);
+    n.x += n.x >= 0.0 ? -t : t;
+    n.y += n.y >= 0.0 ? -t : t;
+    return normalize(n);
+}
+
 void main()
 {
-    vec4 localPos  = vec4(aPosition, 1.0);
-    vec4 worldPos4 = localPos * uModel;
+    mat4 model = uModel;
+
+    vs_out.color    = uColor;
+    vs_out.material = vec3(uMetallic, uRoughness, uAlphaCutoff);
+    vs_out.layers   = vec3(-1.0);
+
+    if (uInstanced != 0)
+    {
+        int base = (uInstanceBase + gl_InstanceID) * 7;
+
+        // The texels are the matrix rows.
+        model = transpose(mat4(
+            texelFetch(uInstanceData, base),
+            texelFetch(uInstanceData, base + 1),
+            texelFetch(uInstanceData, base + 2),
+            texelFetch(uInstanceData, base + 3)
+        ));
+
+        vs_out.color    = texelFetch(uInstanceData, base + 4);
+        vs_out.material = texelFetch(uInstanceData, base + 5).xyz;
+        vs_out.layers   = texelFetch(uInstanceData, base + 6).xyz;
+    }
+
+    vec4 localPos  = vec4(aPosition, 1.0) * uDequantize;
+    vec4 worldPos4 = localPos * model;
     vec4 viewPos   = worldPos4 * uView;
 
-    vec3 worldNormal = normalize((vec4(aNormal, 0.0) * transpose(inverse(uModel))).xyz);
+    vec3 normal      = uPackedVertices != 0 ? octDecode(aNormal.xy) : aNormal;
+    vec3 worldNormal = normalize((vec4(normal, 0.0) * transpose(inverse(model))).xyz);
 
     vs_out.worldPos    = worldPos4.xyz;
     vs_out.worldNormal = worldNormal;
@@ -42,20 +94,27 @@ in VS_OUT {
     vec3 worldNormal;
     vec2 uv;
     float viewDepth;
+    flat vec4 color;
+    flat vec3 material;
+    flat vec3 layers;
 } fs_in;
 
 uniform sampler2D uColorMap;
 uniform sampler2D uMetallicMap;
 uniform sampler2D uRoughnessMap;
-uniform vec4 uColor;
-uniform float uMetallic;
-uniform float uRoughness;
+
+// Layers of batched materials, a negative layer reads the unbatched map.
+uniform sampler2DArray uColorMaps;
+uniform sampler2DArray uMetallicMaps;
+uniform sampler2DArray uRoughnessMaps;
 uniform vec3 uAmbientColor;
 uniform float uAmbientIntensity;
 
 #define MAX_LIGHTS 16
 #define MAX_SHADOW_CASCADES 8
 
+// Directional lights
+
 uniform int uNumLights;
 uniform vec3 uLightPositions[MAX_LIGHTS];
 uniform vec3 uLightColors[MAX_LIGHTS];
@@ -69,48 +128,17 @@ uniform int uShadowCascadeCount;
 uniform float uShadowCascadeRanges[MAX_SHADOW_CASCADES];
 uniform sampler2DArrayShadow uShadowMaps;
 
-uniform vec3 uCameraPosition;
-
-const float PI = 3.14159265359;
-const float EPSILON = 1e-4;
-
-float saturate(float x)
-{
-    return clamp(x, 0.0, 1.0);
-}
-
-vec3 fresnelSchlick(float cosTheta, vec3 F0)
-{
-    return F0 + (1.0 - F0) * pow(1.0 - saturate(cosTheta), 5.0);
-}
+// Clustered point lights
+uniform samplerBuffer uLightData;
+uniform usamplerBuffer uLightGrid;
+uniform usamplerBuffer uLightIndices;
+uniform vec3 uClusterDimensions;
+uniform vec2 uClusterDepth;
+uniform vec4 uClusterViewport;
 
-float distributionGGX(vec3 N, vec3 H, float roughness)
-{
-    float a  = roughness * roughness;
-    float a2 = a * a;
-
-    float NdotH  = saturate(dot(N, H));
-    float NdotH2 = NdotH * NdotH;
-
-    float denom = NdotH2 * (a2 - 1.0) + 1.0;
-    return a2 / max(PI * denom * denom, EPSILON);
-}
+uniform vec3 uCameraPosition;
 
-float geometrySchlickGGX(float NdotV, float roughness)
-{
-    float r = roughness + 1.0;
-    float k = (r * r) / 8.0;
-    return NdotV / max(NdotV * (1.0 - k) + k, EPSILON);
-}
-
-float geometrySmith(vec3 N, vec3 V, vec3 L, float roughness)
-{
-    float NdotV = saturate(dot(N, V));
-    float NdotL = saturate(dot(N, L));
-    float ggxV = geometrySchlickGGX(NdotV, roughness);
-    float ggxL = geometrySchlickGGX(NdotL, roughness);
-    return ggxV * ggxL;
-}
+#include "brdf.glsl"
 
 int selectCascade(float viewDepth)
 {
@@ -125,6 +153,10 @@ int selectCascade(float viewDepth)
 
 float sampleDirectionalShadow(int lightIndex, vec3 N, vec3 L)
 {
+#ifdef NO_SHADOWS
+    return 1.0;
+#endif
+
     int shadowMapSet = uLightShadowMapIndices[lightIndex];
     if (shadowMapSet < 0 || uShadowCascadeCount <= 0) return 1.0;
 
@@ -164,43 +196,17 @@ float sampleDirectionalShadow(int lightIndex, vec3 N, vec3 L)
     return shadow / pow(kernelSize * 2 + 1, 2);
 }
 
-vec3 evaluateLight(
+vec3 shadeLight(
     vec3 N,
     vec3 V,
+    vec3 L,
+    vec3 radiance,
     vec3 albedo,
     float metallic,
     float roughness,
-    vec3 F0,
-    int lightIndex
+    vec3 F0
 )
 {
-    vec3 L;
-    vec3 radiance;
-    float shadow = 1.0;
-
-    if (uLightRadii[lightIndex] == 0.0)
-    {
-        L = normalize(uLightPositions[lightIndex]);
-        radiance = uLightColors[lightIndex] * uLightIntensities[lightIndex];
-        shadow = sampleDirectionalShadow(lightIndex, N, L);
-    }
-    else
-    {
-        vec3 toLight = uLightPositions[lightIndex] - fs_in.worldPos;
-        float dist = length(toLight);
-        if (dist <= EPSILON)
-        return vec3(0.0);
-
-        L = toLight / dist;
-
-        float radius = uLightRadii[lightIndex];
-        float falloff = clamp(1.0 - (dist * dist) / max(radius * radius, EPSILON), 0.0, 1.0);
-        falloff *= falloff;
-
-        float attenuation = falloff / max(dist * dist, 1.0);
-        radiance = uLightColors[lightIndex] * uLightIntensities[lightIndex] * attenuation;
-    }
-
     vec3 H = normalize(V + L);
 
     float NdotL = saturate(dot(N, L));
@@ -222,7 +228,70 @@ vec3 evaluateLight(
     vec3 kD = (vec3(1.0) - kS) * (1.0 - metallic);
     vec3 diffuse = kD * albedo / PI;
 
-    return (diffuse + specular) * radiance * NdotL * shadow;
+    return (diffuse + specular) * radiance * NdotL;
+}
+
+vec3 evaluateLight(
+    vec3 N,
+    vec3 V,
+    vec3 albedo,
+    float metallic,
+    float roughness,
+    vec3 F0,
+    int lightIndex
+)
+{
+    vec3 L = normalize(uLightPositions[lightIndex]);
+    vec3 radiance = uLightColors[lightIndex] * uLightIntensities[lightIndex];
+    float shadow = sampleDirectionalShadow(lightIndex, N, L);
+
+    return shadeLight(N, V, L, radiance, albedo, metallic, roughness, F0) * shadow;
+}
+
+vec3 evaluatePointLight(
+    vec3 N,
+    vec3 V,
+    vec3 albedo,
+    float metallic,
+    float roughness,
+    vec3 F0,
+    int lightIndex
+)
+{
+    vec4 positionRadius = texelFetch(uLightData, lightIndex * 2);
+    vec3 color = texelFetch(uLightData, lightIndex * 2 + 1).rgb;
+
+    vec3 toLight = positionRadius.xyz - fs_in.worldPos;
+    float dist = length(toLight);
+    if (dist <= EPSILON)
+    return vec3(0.0);
+
+    float radius = positionRadius.w;
+    float falloff = clamp(1.0 - (dist * dist) / max(radius * radius, EPSILON), 0.0, 1.0);
+    falloff *= falloff;
+
+    float attenuation = falloff / max(dist * dist, 1.0);
+
+    return shadeLight(N, V, toLight / dist, color * attenuation, albedo, metallic, roughness, F0);
+}
+
+int clusterIndex()
+{
+    ivec3 dims = ivec3(uClusterDimensions);
+
+    vec2 screen = (gl_FragCoord.xy - uClusterViewport.xy) / max(uClusterViewport.zw, vec2(1.0));
+    ivec2 tile = clamp(ivec2(screen * vec2(dims.xy)), ivec2(0), dims.xy - 1);
+
+    int slice = int(floor(log(max(fs_in.viewDepth, EPSILON)) * uClusterDepth.x + uClusterDepth.y));
+    if (slice < 0 || slice >= dims.z)
+    return -1;
+
+    return (slice * dims.y + tile.y) * dims.x + tile.x;
+}
+
+vec4 sampleMap(sampler2D map, sampler2DArray maps, float layer)
+{
+    return layer < 0.0 ? texture(map, fs_in.uv) : texture(maps, vec3(fs_in.uv, layer));
 }
 
 void main()
@@ -230,11 +299,16 @@ void main()
     vec3 N = normalize(fs_in.worldNormal);
     vec3 V = normalize(uCameraPosition - fs_in.worldPos);
 
-    vec4 baseSample = texture(uColorMap, fs_in.uv) * uColor;
+    vec4 baseSample = sampleMap(uColorMap, uColorMaps, fs_in.layers.x) * fs_in.color;
+    if (baseSample.a < fs_in.material.z)
+    {
+        discard;
+    }
+
     vec3 albedo = pow(baseSample.rgb, vec3(2.2));
 
-    float metallic  = clamp(texture(uMetallicMap, fs_in.uv).r * uMetallic, 0.0, 1.0);
-    float roughness = clamp(texture(uRoughnessMap, fs_in.uv).r * uRoughness, 0.045, 1.0);
+    float metallic  = clamp(sampleMap(uMetallicMap, uMetallicMaps, fs_in.layers.y).r * fs_in.material.x, 0.0, 1.0);
+    float roughness = clamp(sampleMap(uRoughnessMap, uRoughnessMaps, fs_in.layers.z).r * fs_in.material.y, 0.045, 1.0);
 
     vec3 F0 = mix(vec3(0.04), albedo, metallic);
 
@@ -246,6 +320,17 @@ void main()
         Lo += evaluateLight(N, V, albedo, metallic, roughness, F0, i);
     }
 
+    int cluster = clusterIndex();
+    if (cluster >= 0)
+    {
+        uvec2 range = texelFetch(uLightGrid, cluster).xy;
+        for (uint i = 0u; i < range.y; ++i)
+        {
+            int lightIndex = int(texelFetch(uLightIndices, int(range.x + i)).r);
+            Lo += evaluatePointLight(N, V, albedo, metallic, roughness, F0, lightIndex);
+        }
+    }
+
     vec3 color = ambient + Lo;
 
     color = color / (color + vec3(1.0));
@@ -6,20 +6,31 @@ in vec3 aPosition;
 in vec3 aNormal;
 in vec2 aTexCoords;
 
+uniform mat4 uDequantize;
 uniform mat4 uModel;
 uniform mat4 uView;
 uniform mat4 uProj;
+uniform int uPackedVertices;
 
 out vec3 vWorldPos;
 out vec3 vNormal;
 out vec2 vTexCoords;
 
+vec3 octDecode(vec2 e) {
+    vec3 n = vec3(e, 1.0 - abs(e.x) - abs(e.y));
+    float t = max(-n.z, 0.0);
+    n.x += n.x >= 0.0 ? -t : t;
+    n.y += n.y >= 0.0 ? -t : t;
+    return normalize(n);
+}
+
 void main() {
-    vec4 worldPos = vec4(aPosition, 1.0) * uModel;
+    vec4 worldPos = vec4(aPosition, 1.0) * uDequantize * uModel;
     mat3 normalMatrix = transpose(inverse(mat3(uModel)));
 
     vWorldPos = worldPos.xyz;
-    vNormal = normalize(aNormal * normalMatrix);
+    vec3 normal = uPackedVertices != 0 ? octDecode(aNormal.xy) : aNormal;
+    vNormal = normalize(normal * normalMatrix);
     vTexCoords = aTexCoords;
 
     gl_Position = worldPos * uView * uProj;
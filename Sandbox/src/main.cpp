@@ -9,7 +9,10 @@ using namespace Flock::Asset;
 
 i32 main() {
     App app = App::Create({
-        .windowConfig = {.size = {1080, 800}},
+        .windowConfig     = {.size = {1080, 800}},
+        .packingConfig    = {.enabled = true},
+        .materialBatching = true,
+        .renderThread     = true,
     }).value();
 
     app.AddSystem(Stage::Startup, [](World &world) {
@@ -57,7 +60,8 @@ i32 main() {
                 .position = {0.0F, -20.0F, 0.0F},
                 .scale    = {100.0F, 0.5F, 100.0F}
             },
-            ModelRenderer{.model = assets.loader.Register<Model>(std::move(model))},
+            ModelRenderer{.model = assets.loader.Register<Model>(std::move(model)), .isStatic = true},
+            Occluder{},
             Physics::BoxCollider{},
             Physics::RigidBody{.mode = Physics::SimulationMode::Static}
         );
@@ -68,6 +72,10 @@ i32 main() {
             .intensity = 5.0F,
         });
 
+        world.Resource<Gui::StatsOverlay>().font = assets.Load<Gui::Font>("../../../assets/font.ttf");
+
+        world.Resource<OcclusionConfig>().enabled = true;
+
         world.Resource<InputState>().cursorMode = CursorMode::Disabled;
 
         world.Save("../../../assets/world.json");
@@ -85,6 +93,14 @@ i32 main() {
         if (input.IsKeyDown(Key::Escape)) {
             input.cursorMode = CursorMode::Normal;
         }
+        if (input.IsKeyPressed(Key::F3)) {
+            auto &overlay   = world.Resource<Gui::StatsOverlay>();
+            overlay.visible = !overlay.visible;
+        }
+        if (input.IsKeyPressed(Key::F4)) {
+            auto &occlusion     = world.Resource<OcclusionConfig>();
+            occlusion.debugView = !occlusion.debugView;
+        }
         if (input.IsMouseDown()) {
             input.cursorMode = CursorMode::Disabled;
         }